@@ -0,0 +1,60 @@
+#include <getopt.h>
+#include <iostream>
+
+#include "KEMFileInterface.hh"
+
+using namespace KEMField;
+
+int main(int argc, char* argv[])
+{
+  std::string usage =
+    "\n"
+    "Usage: RebuildEMFileIndex [options] <directory>\n"
+    "\n"
+    "This program rescans the KEMField files in a directory and rewrites its\n"
+    "lookup index. It is only needed if files were copied into the directory\n"
+    "by hand; the index is otherwise maintained automatically.\n"
+    "If no directory is given, the default KEMField cache directory is used.\n"
+    "\n"
+    "\tAvailable options:\n"
+    "\t -h, --help               (shows this message and exits)\n"
+    "\n";
+
+  static struct option longOptions[] = {
+    {"help", no_argument, 0, 'h'},
+  };
+
+  static const char *optString = "h";
+
+  while(1) {
+    char optId = getopt_long(argc, argv,optString, longOptions, NULL);
+    if(optId == -1) break;
+    switch(optId) {
+    case('h'): // help
+      //
+    default: // unrecognized option
+      std::cout<<usage<<std::endl;
+      return 1;
+    }
+  }
+
+  std::string directory = KEMFileInterface::GetInstance()->ActiveDirectory();
+  if (optind < argc)
+    directory = argv[optind];
+
+  if (!KEMFileInterface::GetInstance()->DirectoryExists(directory))
+  {
+    std::cout<<"Error: directory \""<<directory<<"\" cannot be read."<<std::endl;
+    return 1;
+  }
+
+  if (!KEMFileInterface::GetInstance()->RebuildIndex(directory))
+  {
+    std::cout<<"Error: index for directory \""<<directory<<"\" could not be written."<<std::endl;
+    return 1;
+  }
+
+  std::cout<<"Indexed "<<KEMFileInterface::GetInstance()->FileList(directory).size()<<" files in directory \""<<directory<<"\"."<<std::endl;
+
+  return 0;
+}
@@ -7,7 +7,15 @@
 #include "KZonalHarmonicSourcePoint.hh"
 #include "KZonalHarmonicParameters.hh"
 
+#include "KZonalHarmonicFlatFile.hh"
+
 #include "KMD5HashGenerator.hh"
+#include "KEMMappedFile.hh"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
 
 namespace KEMField
 {
@@ -30,6 +38,11 @@ namespace KEMField
 
     void ComputeCoefficients() { ComputeCoefficients(-1); }
 
+    // flat, memory-mappable representation of the computed coefficients
+    static std::string FlatFileSuffix() { return ".kzh"; }
+    bool WriteFlat(std::string fileName) const;
+    bool MapFlat(std::string fileName);
+
     ElementContainer& GetElementContainer() { return fElementContainer; }
     const ElementContainer& GetElementContainer() const { return fElementContainer; }
     const KEMCoordinateSystem& GetCoordinateSystem() const { return fCoordinateSystem; }
@@ -48,6 +61,10 @@ namespace KEMField
     void ComputeCoefficients(int level);
     void ConstructSubContainers(int level=-1);
 
+    void FlattenNodes(std::vector<KZonalHarmonicFlatNode>& nodes,std::vector<KZonalHarmonicFlatSourcePoint>& sourcePoints,unsigned long long& nCoefficients) const;
+    void WriteFlatCoefficients(std::ofstream& file) const;
+    bool MapFlatNodes(const KZonalHarmonicFlatHeader& header,const KEMMappedFile& file,unsigned long long& nodeIndex,bool apply);
+
     ElementContainer& fElementContainer;
     KEMCoordinateSystem fCoordinateSystem;
     SourcePointVector fCentralSourcePoints;
@@ -57,6 +74,8 @@ namespace KEMField
 
     bool fHead;
 
+    KEMMappedFile* fMappedFile;
+
     template <typename Stream>
     friend Stream& operator>>(Stream& s,KZonalHarmonicContainer<Basis>& c)
     {
@@ -170,7 +189,8 @@ namespace KEMField
     fElementContainer(elementContainer),
     fCoordinateSystem(gGlobalCoordinateSystem),
     fParameters(parameters),
-    fHead(true)
+    fHead(true),
+    fMappedFile(NULL)
   {
     if (!fParameters)
       fParameters = new KZonalHarmonicParameters();
@@ -195,6 +215,241 @@ namespace KEMField
 
     for (typename std::vector<KZonalHarmonicContainer<Basis>*>::iterator it=fSubContainers.begin();it!=fSubContainers.end();++it)
       delete * it;
+
+    // source points of the whole tree may refer to the mapping
+    delete fMappedFile;
+  }
+
+  /**
+   * Writes the container tree in the flat layout of KZonalHarmonicFlatFile.hh.
+   * The file is written under a temporary name and renamed into place, so that
+   * concurrent readers never map an incomplete file.
+   */
+  template <class Basis>
+  bool KZonalHarmonicContainer<Basis>::WriteFlat(std::string fileName) const
+  {
+    std::vector<KZonalHarmonicFlatNode> nodes;
+    std::vector<KZonalHarmonicFlatSourcePoint> sourcePoints;
+    unsigned long long nCoefficients = 0;
+    FlattenNodes(nodes,sourcePoints,nCoefficients);
+
+    KZonalHarmonicFlatHeader header;
+    header.Initialize();
+
+    KMD5HashGenerator containerHashGenerator;
+    KZonalHarmonicFlatHeader::SetHash(header.fContainerHash,containerHashGenerator.GenerateHash(fElementContainer));
+    KMD5HashGenerator parameterHashGenerator;
+    KZonalHarmonicFlatHeader::SetHash(header.fParameterHash,parameterHashGenerator.GenerateHash(*fParameters));
+
+    header.fNodeCount = nodes.size();
+    header.fNodeOffset = sizeof(KZonalHarmonicFlatHeader);
+    header.fSourcePointCount = sourcePoints.size();
+    header.fSourcePointOffset = header.fNodeOffset + nodes.size()*sizeof(KZonalHarmonicFlatNode);
+    header.fCoefficientCount = nCoefficients;
+    header.fCoefficientOffset = header.fSourcePointOffset + sourcePoints.size()*sizeof(KZonalHarmonicFlatSourcePoint);
+    header.fFileSize = header.fCoefficientOffset + nCoefficients*sizeof(double);
+
+    std::stringstream s;
+    s << fileName << "." << getpid() << ".tmp";
+    std::string temporaryName = s.str();
+
+    std::ofstream file(temporaryName.c_str(),std::ios::out|std::ios::binary|std::ios::trunc);
+    if (!file.is_open())
+      return false;
+
+    file.write(reinterpret_cast<const char*>(&header),sizeof(KZonalHarmonicFlatHeader));
+    if (!nodes.empty())
+      file.write(reinterpret_cast<const char*>(&nodes[0]),nodes.size()*sizeof(KZonalHarmonicFlatNode));
+    if (!sourcePoints.empty())
+      file.write(reinterpret_cast<const char*>(&sourcePoints[0]),sourcePoints.size()*sizeof(KZonalHarmonicFlatSourcePoint));
+    WriteFlatCoefficients(file);
+
+    bool good = file.good();
+    file.close();
+
+    if (!good || std::rename(temporaryName.c_str(),fileName.c_str()) != 0)
+    {
+      std::remove(temporaryName.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Maps a flat file written by WriteFlat() read-only into memory and points
+   * the source points of the container tree at the mapped coefficients.  The
+   * file is rejected if its layout, element container or parameters do not
+   * match this container.
+   */
+  template <class Basis>
+  bool KZonalHarmonicContainer<Basis>::MapFlat(std::string fileName)
+  {
+    if (!fHead)
+      return false;
+
+    KEMMappedFile* file = new KEMMappedFile();
+    if (!file->Open(fileName))
+    {
+      delete file;
+      return false;
+    }
+
+    const KZonalHarmonicFlatHeader* header = file->At<KZonalHarmonicFlatHeader>(0);
+
+    bool valid = (header != NULL &&
+		  header->IsValid() &&
+		  header->fFileSize == file->Size() &&
+		  file->At<KZonalHarmonicFlatNode>(header->fNodeOffset,header->fNodeCount) != NULL &&
+		  file->At<KZonalHarmonicFlatSourcePoint>(header->fSourcePointOffset,header->fSourcePointCount) != NULL &&
+		  file->At<double>(header->fCoefficientOffset,header->fCoefficientCount) != NULL);
+
+    if (valid)
+    {
+      KMD5HashGenerator parameterHashGenerator;
+      valid = KZonalHarmonicFlatHeader::HashMatches(header->fParameterHash,parameterHashGenerator.GenerateHash(*fParameters));
+    }
+    if (valid)
+    {
+      KMD5HashGenerator containerHashGenerator;
+      valid = KZonalHarmonicFlatHeader::HashMatches(header->fContainerHash,containerHashGenerator.GenerateHash(fElementContainer));
+    }
+    if (!valid)
+    {
+      delete file;
+      return false;
+    }
+
+    KZHLegendreCoefficients::GetInstance()->InitializeLegendrePolynomialArrays((fParameters->GetNCentralCoefficients() > fParameters->GetNRemoteCoefficients() ? fParameters->GetNCentralCoefficients() : fParameters->GetNRemoteCoefficients()));
+
+    // recreate the subcontainers, as when streaming in a container
+    for (typename ZonalHarmonicContainerVector::iterator it=fSubContainers.begin();it!=fSubContainers.end();++it)
+      delete * it;
+    fSubContainers.clear();
+    ConstructSubContainers();
+
+    // validate the complete tree before modifying any source point
+    unsigned long long nodeIndex = 0;
+    if (!MapFlatNodes(*header,*file,nodeIndex,false) || nodeIndex != header->fNodeCount)
+    {
+      delete file;
+      return false;
+    }
+
+    nodeIndex = 0;
+    MapFlatNodes(*header,*file,nodeIndex,true);
+
+    delete fMappedFile;
+    fMappedFile = file;
+    return true;
+  }
+
+  template <class Basis>
+  void KZonalHarmonicContainer<Basis>::FlattenNodes(std::vector<KZonalHarmonicFlatNode>& nodes,std::vector<KZonalHarmonicFlatSourcePoint>& sourcePoints,unsigned long long& nCoefficients) const
+  {
+    KZonalHarmonicFlatNode node;
+    for (unsigned int i=0;i<3;i++)
+    {
+      node.fOrigin[i] = fCoordinateSystem.GetOrigin()[i];
+      node.fXAxis[i] = fCoordinateSystem.GetXAxis()[i];
+      node.fYAxis[i] = fCoordinateSystem.GetYAxis()[i];
+      node.fZAxis[i] = fCoordinateSystem.GetZAxis()[i];
+    }
+    node.fFirstSourcePoint = sourcePoints.size();
+    node.fNCentralSourcePoints = fCentralSourcePoints.size();
+    node.fNRemoteSourcePoints = fRemoteSourcePoints.size();
+    node.fNSubContainers = fSubContainers.size();
+    node.fPadding = 0;
+    nodes.push_back(node);
+
+    for (unsigned int i=0;i<fCentralSourcePoints.size()+fRemoteSourcePoints.size();i++)
+    {
+      const KZonalHarmonicSourcePoint* sP = (i<fCentralSourcePoints.size() ? fCentralSourcePoints.at(i) : fRemoteSourcePoints.at(i-fCentralSourcePoints.size()));
+      KZonalHarmonicFlatSourcePoint flatSP;
+      flatSP.fZ0 = sP->GetZ0();
+      flatSP.fRho = sP->GetRho();
+      flatSP.fFirstCoefficient = nCoefficients;
+      flatSP.fNCoefficients = sP->GetNCoeffs();
+      flatSP.fPadding = 0;
+      sourcePoints.push_back(flatSP);
+      nCoefficients += flatSP.fNCoefficients;
+    }
+
+    for (unsigned int i=0;i<fSubContainers.size();i++)
+      fSubContainers.at(i)->FlattenNodes(nodes,sourcePoints,nCoefficients);
+  }
+
+  template <class Basis>
+  void KZonalHarmonicContainer<Basis>::WriteFlatCoefficients(std::ofstream& file) const
+  {
+    for (unsigned int i=0;i<fCentralSourcePoints.size()+fRemoteSourcePoints.size();i++)
+    {
+      const KZonalHarmonicSourcePoint* sP = (i<fCentralSourcePoints.size() ? fCentralSourcePoints.at(i) : fRemoteSourcePoints.at(i-fCentralSourcePoints.size()));
+      if (sP->GetNCoeffs() > 0)
+	file.write(reinterpret_cast<const char*>(sP->GetRawPointerToCoeff()),sP->GetNCoeffs()*sizeof(double));
+    }
+
+    for (unsigned int i=0;i<fSubContainers.size();i++)
+      fSubContainers.at(i)->WriteFlatCoefficients(file);
+  }
+
+  template <class Basis>
+  bool KZonalHarmonicContainer<Basis>::MapFlatNodes(const KZonalHarmonicFlatHeader& header,const KEMMappedFile& file,unsigned long long& nodeIndex,bool apply)
+  {
+    if (nodeIndex >= header.fNodeCount)
+      return false;
+
+    const KZonalHarmonicFlatNode& node = *(file.At<KZonalHarmonicFlatNode>(header.fNodeOffset) + nodeIndex);
+    nodeIndex++;
+
+    unsigned long long nSourcePoints = (unsigned long long)node.fNCentralSourcePoints + node.fNRemoteSourcePoints;
+    if (node.fNSubContainers != fSubContainers.size() ||
+	node.fFirstSourcePoint > header.fSourcePointCount ||
+	nSourcePoints > header.fSourcePointCount - node.fFirstSourcePoint)
+      return false;
+
+    const KZonalHarmonicFlatSourcePoint* flatSPs = file.At<KZonalHarmonicFlatSourcePoint>(header.fSourcePointOffset) + node.fFirstSourcePoint;
+    const double* coefficients = file.At<double>(header.fCoefficientOffset);
+
+    for (unsigned long long i=0;i<nSourcePoints;i++)
+    {
+      if (flatSPs[i].fFirstCoefficient > header.fCoefficientCount ||
+	  flatSPs[i].fNCoefficients > header.fCoefficientCount - flatSPs[i].fFirstCoefficient)
+	return false;
+    }
+
+    if (apply)
+    {
+      fCoordinateSystem.SetValues(KPosition(node.fOrigin[0],node.fOrigin[1],node.fOrigin[2]),
+				  KDirection(node.fXAxis[0],node.fXAxis[1],node.fXAxis[2]),
+				  KDirection(node.fYAxis[0],node.fYAxis[1],node.fYAxis[2]),
+				  KDirection(node.fZAxis[0],node.fZAxis[1],node.fZAxis[2]));
+
+      for (unsigned int i=0;i<fCentralSourcePoints.size();i++)
+	delete fCentralSourcePoints.at(i);
+      fCentralSourcePoints.clear();
+      for (unsigned int i=0;i<fRemoteSourcePoints.size();i++)
+	delete fRemoteSourcePoints.at(i);
+      fRemoteSourcePoints.clear();
+
+      for (unsigned long long i=0;i<nSourcePoints;i++)
+      {
+	KZonalHarmonicSourcePoint* sP = new KZonalHarmonicSourcePoint();
+	sP->SetValues(flatSPs[i].fZ0,
+		      flatSPs[i].fRho,
+		      (flatSPs[i].fNCoefficients > 0 ? coefficients + flatSPs[i].fFirstCoefficient : NULL),
+		      flatSPs[i].fNCoefficients);
+	if (i < node.fNCentralSourcePoints)
+	  fCentralSourcePoints.push_back(sP);
+	else
+	  fRemoteSourcePoints.push_back(sP);
+      }
+    }
+
+    for (unsigned int i=0;i<fSubContainers.size();i++)
+      if (!fSubContainers.at(i)->MapFlatNodes(header,file,nodeIndex,apply))
+	return false;
+
+    return true;
   }
 
   template <class Basis>
@@ -0,0 +1,70 @@
+#ifndef KZONALHARMONICFLATFILE_DEF
+#define KZONALHARMONICFLATFILE_DEF
+
+#include "KEMFlatFile.hh"
+
+namespace KEMField
+{
+  /**
+   * @file KZonalHarmonicFlatFile.hh
+   *
+   * @brief Flat, memory-mappable binary layout for zonal harmonic containers.
+   *
+   * A flat file consists of a header, followed by one node record per
+   * (sub)container in depth-first order, one record per source point and a
+   * single contiguous block of coefficients.  All records are 8-byte aligned,
+   * so that a read-only mapping of the file can be used by the field solver
+   * without deserialization.  The header carries the hashes of the element
+   * container and of the parameters the coefficients were computed with.
+   */
+
+  struct KZonalHarmonicFlatHeader : public KEMFlatFileHeader
+  {
+    static const char* Magic() { return "KEMZHFL"; }
+    static unsigned int Version() { return 1; }
+
+    void Initialize()
+    {
+      std::memset(this,0,sizeof(KZonalHarmonicFlatHeader));
+      KEMFlatFileHeader::Initialize(Magic(),Version());
+    }
+
+    bool IsValid() const
+    {
+      return KEMFlatFileHeader::IsValid(Magic(),Version());
+    }
+
+    char fContainerHash[HashLength];
+    char fParameterHash[HashLength];
+    unsigned long long fNodeCount;
+    unsigned long long fNodeOffset;
+    unsigned long long fSourcePointCount;
+    unsigned long long fSourcePointOffset;
+    unsigned long long fCoefficientCount;
+    unsigned long long fCoefficientOffset;
+  };
+
+  struct KZonalHarmonicFlatNode
+  {
+    double fOrigin[3];
+    double fXAxis[3];
+    double fYAxis[3];
+    double fZAxis[3];
+    unsigned long long fFirstSourcePoint;
+    unsigned int fNCentralSourcePoints;
+    unsigned int fNRemoteSourcePoints;
+    unsigned int fNSubContainers;
+    unsigned int fPadding;
+  };
+
+  struct KZonalHarmonicFlatSourcePoint
+  {
+    double fZ0;
+    double fRho;
+    unsigned long long fFirstCoefficient;
+    unsigned int fNCoefficients;
+    unsigned int fPadding;
+  };
+}
+
+#endif /* KZONALHARMONICFLATFILE_DEF */
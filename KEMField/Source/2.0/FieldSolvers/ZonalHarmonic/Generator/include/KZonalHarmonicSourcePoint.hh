@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <string>
+#include <cstddef>
 
 namespace KEMField
 {
@@ -20,7 +21,9 @@ namespace KEMField
   class KZonalHarmonicSourcePoint
   {
   public:
-    KZonalHarmonicSourcePoint() {}
+    KZonalHarmonicSourcePoint() : fCoeffs(NULL), fNCoeffs(0) {}
+    KZonalHarmonicSourcePoint(const KZonalHarmonicSourcePoint& sp);
+    KZonalHarmonicSourcePoint& operator=(const KZonalHarmonicSourcePoint& sp);
 
     static std::string Name() { return "ZonalHarmonicSourcePoint"; }
 
@@ -28,20 +31,27 @@ namespace KEMField
 		   double rho,
 		   std::vector<double>& coeffs);
 
+    // refer to externally stored (e.g. memory-mapped) coefficients, which must
+    // outlive the source point
+    void SetValues(double z0,
+		   double rho,
+		   const double* coeffs,
+		   unsigned int nCoeffs);
+
     virtual ~KZonalHarmonicSourcePoint() { fCoeffVec.clear(); }
 
     void SetZ0(const double& d)  { fZ0 = d; fFloatZ0 = (float)d; }
     void SetRho(const double& d) { fRho = d; fRhosquared = (float)fRho*(float)fRho; f1overRhosquared=1./fRhosquared; }
 
-    int    GetNCoeffs()      const { return (int)fCoeffVec.size(); }
+    int    GetNCoeffs()      const { return (int)fNCoeffs; }
     double GetZ0()           const { return fZ0; }
     float GetFloatZ0()       const { return fZ0; }
     double GetRho()          const { return fRho; }
     float GetRhosquared()      const { return fRhosquared; }
     float Get1overRhosquared() const { return f1overRhosquared; }
-    double GetCoeff(int i) const { return fCoeffVec[i]; }
+    double GetCoeff(int i) const { return fCoeffs[i]; }
 
-    const double* GetRawPointerToCoeff() const {return &(fCoeffVec[0]);};
+    const double* GetRawPointerToCoeff() const {return fCoeffs;};
 
   private:
 
@@ -50,7 +60,9 @@ namespace KEMField
     double fRho;                   ///< Rho values for source point.
     float fRhosquared;
     float f1overRhosquared;
-    std::vector<double> fCoeffVec; ///< Vector of coefficients.
+    std::vector<double> fCoeffVec; ///< Vector of coefficients (if owned).
+    const double* fCoeffs;         ///< Coefficients in use.
+    unsigned int fNCoeffs;
 
   public:
     template <typename Stream>
@@ -69,6 +81,8 @@ namespace KEMField
 	s >> coeff;
 	sp.fCoeffVec.push_back(coeff);
       }
+      sp.fCoeffs = sp.fCoeffVec.empty() ? NULL : &(sp.fCoeffVec[0]);
+      sp.fNCoeffs = sp.fCoeffVec.size();
       s.PostStreamInAction(sp);
       return s;
     }
@@ -79,9 +93,9 @@ namespace KEMField
       s.PreStreamOutAction(sp);
       s << sp.fZ0;
       s << sp.fRho;
-      s << (unsigned int)(sp.fCoeffVec.size());
-      for (unsigned int i=0;i<sp.fCoeffVec.size();i++)
-	s << sp.fCoeffVec.at(i);
+      s << sp.fNCoeffs;
+      for (unsigned int i=0;i<sp.fNCoeffs;i++)
+	s << sp.fCoeffs[i];
       s.PostStreamOutAction(sp);
       return s;
     }
@@ -17,5 +17,51 @@ namespace KEMField{
     f1overRhosquared = 1./ fRhosquared;
 
     fCoeffVec = coeffs;
+    fCoeffs = fCoeffVec.empty() ? NULL : &(fCoeffVec[0]);
+    fNCoeffs = fCoeffVec.size();
+  }
+
+  void KZonalHarmonicSourcePoint::SetValues(double z0,
+					    double rho,
+					    const double* coeffs,
+					    unsigned int nCoeffs)
+  {
+    fZ0  = z0;
+    fFloatZ0 = (float)z0;
+    fRho = rho;
+    fRhosquared = rho*rho;
+    f1overRhosquared = 1./ fRhosquared;
+
+    fCoeffVec.clear();
+    fCoeffs = coeffs;
+    fNCoeffs = nCoeffs;
+  }
+
+  KZonalHarmonicSourcePoint::KZonalHarmonicSourcePoint(const KZonalHarmonicSourcePoint& sp)
+  {
+    *this = sp;
+  }
+
+/**
+ * Copies a source point.  Owned coefficients are duplicated, externally stored
+ * coefficients are shared.
+ */
+  KZonalHarmonicSourcePoint& KZonalHarmonicSourcePoint::operator=(const KZonalHarmonicSourcePoint& sp)
+  {
+    if (this == &sp)
+      return *this;
+
+    fZ0 = sp.fZ0;
+    fFloatZ0 = sp.fFloatZ0;
+    fRho = sp.fRho;
+    fRhosquared = sp.fRhosquared;
+    f1overRhosquared = sp.f1overRhosquared;
+    fCoeffVec = sp.fCoeffVec;
+    fNCoeffs = sp.fNCoeffs;
+    if (sp.fCoeffVec.empty())
+      fCoeffs = sp.fCoeffs;
+    else
+      fCoeffs = &(fCoeffVec[0]);
+    return *this;
   }
 }
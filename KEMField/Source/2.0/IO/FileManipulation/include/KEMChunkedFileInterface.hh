@@ -42,13 +42,7 @@ class KEMChunkedFileInterface
         //check if file exists in order to open it, or so we can avoid overwriting it
         bool DoesFileExist(std::string file_name)
         {
-            std::string full_file_name = KEMFileInterface::GetInstance()->ActiveDirectory() + "/" + file_name;
-            std::set< std::string > file_list = KEMFileInterface::GetInstance()->CompleteFileList();
-            for(std::set<std::string>::iterator it=file_list.begin(); it!=file_list.end(); ++it)
-            {
-                if(full_file_name == *it){return true;};
-            }
-            return false;
+            return KEMFileInterface::GetInstance()->DoesFileExist(file_name);
         }
 
         bool OpenFileForWriting(std::string file_name)
@@ -158,6 +158,9 @@ namespace KEMField
     Key KeyForHashed(string,string);
     Key KeyForLabeled(string,string,unsigned int index=0);
 
+    // called after the contents of a file have been written or modified
+    virtual void FileUpdated(string) {}
+
   };
 
   template <class Writable>
@@ -248,6 +251,8 @@ namespace KEMField
     fStreamer << key;
 
     fStreamer.close();
+
+    FileUpdated(fileName);
   }
 
   template <class Writable>
@@ -314,6 +319,8 @@ namespace KEMField
     fStreamer << writable;
 
     fStreamer.close();
+
+    FileUpdated(fileName);
   }
 
   template <class Readable>
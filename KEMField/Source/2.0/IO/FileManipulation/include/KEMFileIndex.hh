@@ -0,0 +1,122 @@
+#ifndef KEMFILEINDEX_DEF
+#define KEMFILEINDEX_DEF
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace KEMField
+{
+
+  /**
+   * @class KEMFileIndex
+   *
+   * @brief A persistent index of the keys stored in a directory of KEMField files.
+   *
+   * KEMFileIndex maps object names, hashes and labels to the file, key location
+   * and object extent of every element stored in the .kbd files of a single
+   * directory.  The index is kept in a binary file inside the directory it
+   * describes.  Updates are serialized between processes with an advisory
+   * lock on a companion lock file, and the index file itself is always
+   * replaced atomically, so concurrent readers never see a partially written
+   * index.  Each indexed file carries a stamp (size and modification time) so
+   * that lookups can detect files that were modified behind the index's back.
+   */
+
+  class KEMFileIndex
+  {
+  public:
+    struct Entry
+    {
+      std::string fFileName;
+      std::string fObjectName;
+      std::string fClassName;
+      std::string fObjectHash;
+      std::vector<std::string> fLabels;
+      size_t fKeyLocation;
+      size_t fObjectLocation;
+      size_t fObjectSize;
+    };
+
+    struct Stamp
+    {
+      Stamp() : fSize(0), fModificationTime(0) {}
+
+      bool operator==(const Stamp& s) const { return fSize == s.fSize && fModificationTime == s.fModificationTime; }
+      bool operator!=(const Stamp& s) const { return !(*this == s); }
+
+      unsigned long fSize;
+      long fModificationTime;
+    };
+
+    KEMFileIndex();
+    KEMFileIndex(std::string directory);
+    virtual ~KEMFileIndex();
+
+    static std::string IndexFileName() { return ".KEMFileIndex"; }
+    static std::string LockFileName() { return ".KEMFileIndex.lock"; }
+    static unsigned int Version() { return 1; }
+
+    void Directory(std::string directory);
+    const std::string& Directory() const { return fDirectory; }
+
+    // synchronize with the on-disk index; returns false if none exists
+    bool Refresh();
+
+    // exclusive inter-process lock guarding read-modify-write cycles
+    bool Lock();
+    void Unlock();
+
+    bool Load();
+    bool Save();
+
+    void Clear();
+
+    // replace (or remove) all of the entries recorded for a single file
+    void SetFile(std::string fileName,const Stamp& stamp,const std::vector<Entry>& entries);
+    void RemoveFile(std::string fileName);
+
+    bool HasFile(std::string fileName) const;
+    bool IsCurrent(std::string fileName) const;
+    std::set<std::string> FileNames() const;
+
+    const Entry* FindByName(std::string name) const;
+    const Entry* FindByHash(std::string hash) const;
+    std::vector<const Entry*> FindByLabels(const std::vector<std::string>& labels) const;
+
+    static bool StampFile(std::string path,Stamp& stamp);
+
+  private:
+    struct FileRecord
+    {
+      Stamp fStamp;
+      std::vector<Entry> fEntries;
+    };
+
+    void BuildLookupTables();
+
+    std::string IndexPath() const { return fDirectory + "/" + IndexFileName(); }
+    std::string LockPath() const { return fDirectory + "/" + LockFileName(); }
+
+    std::string fDirectory;
+
+    std::map<std::string,FileRecord> fFiles;
+
+    // flattened view of fFiles, ordered by file name and key location
+    std::vector<const Entry*> fEntries;
+    std::map<std::string,unsigned int> fNameTable;
+    std::map<std::string,unsigned int> fHashTable;
+    std::map<std::string,std::vector<unsigned int> > fLabelTable;
+
+    // identity of the index file that is currently loaded
+    bool fLoaded;
+    unsigned long fLoadedInode;
+    Stamp fLoadedStamp;
+
+    int fLockDescriptor;
+  };
+
+}
+
+#endif /* KEMFILEINDEX_DEF */
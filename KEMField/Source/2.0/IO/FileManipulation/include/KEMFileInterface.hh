@@ -4,6 +4,7 @@
 #include <set>
 
 #include "KEMFile.hh"
+#include "KEMFileIndex.hh"
 
 #include "KSAInputNode.hh"
 #include "KSAOutputNode.hh"
@@ -65,14 +66,34 @@ namespace KEMField
     void ActiveDirectory(string directory);
     string ActiveDirectory() const { return fActiveDirectory; }
 
+    // lookups go through a persistent per-directory key index (default: on)
+    void UseIndex(bool useIndex) { fUseIndex = useIndex; }
+    bool UseIndex() const { return fUseIndex; }
+
+    bool RebuildIndex(string directory="");
+
+  protected:
+    void FileUpdated(string fileName);
+
   private:
     KEMFileInterface();
     virtual ~KEMFileInterface() {}
 
+    bool SynchronizeIndex() const;
+    bool ValidateIndexEntry(const KEMFileIndex::Entry& entry) const;
+    void IndexFile(KEMFileIndex& index,string fileName) const;
+
+    template <class Readable>
+    void ReadIndexed(const KEMFileIndex::Entry& entry,Readable& readable);
+
     static KEMFileInterface* fEMFileInterface;
 
     string fActiveDirectory;
 
+    bool fUseIndex;
+    mutable KEMFileIndex fIndex;
+    mutable bool fIndexInMemory;
+
     static bool fNullResult;
   };
 
@@ -80,6 +101,18 @@ namespace KEMField
   void KEMFileInterface::FindByName(Readable& readable,string name,bool& result)
   {
     result = true;
+
+    if (fUseIndex && SynchronizeIndex())
+    {
+      const KEMFileIndex::Entry* entry = fIndex.FindByName(name);
+      if (entry && !ValidateIndexEntry(*entry))
+	entry = fIndex.FindByName(name);
+      if (entry)
+	return ReadIndexed(*entry,readable);
+      result = false;
+      return;
+    }
+
     set<string> fileList = FileList();
 
     for (set<string>::iterator it=fileList.begin();it!=fileList.end();++it)
@@ -94,6 +127,18 @@ namespace KEMField
   void KEMFileInterface::FindByHash(Readable& readable,string hash,bool& result)
   {
     result = true;
+
+    if (fUseIndex && SynchronizeIndex())
+    {
+      const KEMFileIndex::Entry* entry = fIndex.FindByHash(hash);
+      if (entry && !ValidateIndexEntry(*entry))
+	entry = fIndex.FindByHash(hash);
+      if (entry)
+	return ReadIndexed(*entry,readable);
+      result = false;
+      return;
+    }
+
     set<string> fileList = FileList();
 
     for (set<string>::iterator it=fileList.begin();it!=fileList.end();++it)
@@ -107,6 +152,9 @@ namespace KEMField
   template <class Readable>
   void KEMFileInterface::FindByLabel(Readable& readable,string label,unsigned int index,bool& result)
   {
+    if (fUseIndex)
+      return FindByLabels(readable,vector<string>(1,label),index,result);
+
     result = true;
     set<string> fileList = FileList();
 
@@ -127,6 +175,18 @@ namespace KEMField
   void KEMFileInterface::FindByLabels(Readable& readable,vector<string> labels,unsigned int index,bool& result)
   {
     result = true;
+
+    if (fUseIndex && SynchronizeIndex())
+    {
+      vector<const KEMFileIndex::Entry*> entries = fIndex.FindByLabels(labels);
+      if (index < entries.size() && !ValidateIndexEntry(*entries.at(index)))
+	entries = fIndex.FindByLabels(labels);
+      if (index < entries.size())
+	return ReadIndexed(*entries.at(index),readable);
+      result = false;
+      return;
+    }
+
     set<string> fileList = FileList();
 
     for (set<string>::iterator it=fileList.begin();it!=fileList.end();++it)
@@ -141,6 +201,21 @@ namespace KEMField
     }
     result = false;
   }
+
+  template <class Readable>
+  void KEMFileInterface::ReadIndexed(const KEMFileIndex::Entry& entry,Readable& readable)
+  {
+    if (entry.fClassName != Readable::Name())
+    {
+      KEMField::cout<<"Element <"<<entry.fObjectName<<"> is stored as a "<<entry.fClassName<<KEMField::endl;
+      return;
+    }
+
+    fStreamer.open(fActiveDirectory + "/" + entry.fFileName,"read");
+    fStreamer.Stream().seekg(entry.fObjectLocation,fStreamer.Stream().beg);
+    fStreamer >> readable;
+    fStreamer.close();
+  }
 }
 
 #endif /* KEMFILEINTERFACE_DEF */
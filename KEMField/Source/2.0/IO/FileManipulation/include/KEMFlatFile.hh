@@ -0,0 +1,61 @@
+#ifndef KEMFLATFILE_DEF
+#define KEMFLATFILE_DEF
+
+#include <string>
+#include <cstring>
+
+namespace KEMField
+{
+  /**
+   * @file KEMFlatFile.hh
+   *
+   * @brief Common header of flat, memory-mappable binary files.
+   *
+   * Every flat file starts with a magic string naming the file type, the
+   * format version, a byte order mark and the total file size.  File types
+   * derive their header from KEMFlatFileHeader and append their hashes,
+   * record counts and offsets.  Records are stored in native byte order, so a
+   * file written on a machine of different endianness is rejected.
+   */
+
+  struct KEMFlatFileHeader
+  {
+    enum { HashLength = 48 };
+
+    static unsigned int ByteOrder() { return 0x01020304; }
+
+    void Initialize(const char* magic,unsigned int version)
+    {
+      std::memset(fMagic,0,sizeof(fMagic));
+      std::strncpy(fMagic,magic,sizeof(fMagic));
+      fVersion = version;
+      fByteOrder = ByteOrder();
+      fFileSize = 0;
+    }
+
+    bool IsValid(const char* magic,unsigned int version) const
+    {
+      return (std::strncmp(fMagic,magic,sizeof(fMagic)) == 0 &&
+	      fVersion == version &&
+	      fByteOrder == ByteOrder());
+    }
+
+    static void SetHash(char* target,const std::string& hash)
+    {
+      std::memset(target,0,HashLength);
+      std::strncpy(target,hash.c_str(),HashLength-1);
+    }
+
+    static bool HashMatches(const char* stored,const std::string& hash)
+    {
+      return std::strncmp(stored,hash.c_str(),HashLength) == 0;
+    }
+
+    char fMagic[8];
+    unsigned int fVersion;
+    unsigned int fByteOrder;
+    unsigned long long fFileSize;
+  };
+}
+
+#endif /* KEMFLATFILE_DEF */
@@ -0,0 +1,61 @@
+#ifndef KEMMAPPEDFILE_DEF
+#define KEMMAPPEDFILE_DEF
+
+#include <string>
+
+namespace KEMField
+{
+
+  /**
+   * @class KEMMappedFile
+   *
+   * @brief A read-only memory mapping of a file.
+   *
+   * KEMMappedFile maps an entire file into memory with read-only, shared
+   * pages.  Data stored in a flat layout can then be used in place without
+   * deserialization, and all processes on a node that map the same file share
+   * the same physical pages.
+   */
+
+  class KEMMappedFile
+  {
+  public:
+    KEMMappedFile();
+    virtual ~KEMMappedFile();
+
+    bool Open(std::string fileName);
+    void Close();
+
+    bool IsOpen() const { return fData != NULL; }
+
+    const char* Data() const { return fData; }
+    size_t Size() const { return fSize; }
+
+    const std::string& GetFileName() const { return fFileName; }
+
+    template <typename Type>
+    const Type* At(size_t offset,size_t count=1) const;
+
+  private:
+    KEMMappedFile(const KEMMappedFile&);
+    KEMMappedFile& operator=(const KEMMappedFile&);
+
+    std::string fFileName;
+    const char* fData;
+    size_t fSize;
+  };
+
+  /**
+   * Returns a typed pointer into the mapping, or NULL if the requested range
+   * does not lie within the file.
+   */
+  template <typename Type>
+  const Type* KEMMappedFile::At(size_t offset,size_t count) const
+  {
+    if (fData == NULL || offset > fSize || count > (fSize - offset)/sizeof(Type))
+      return NULL;
+    return reinterpret_cast<const Type*>(fData + offset);
+  }
+}
+
+#endif /* KEMMAPPEDFILE_DEF */
@@ -0,0 +1,398 @@
+#include "KEMFileIndex.hh"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <algorithm>
+#include <sstream>
+
+#include "KBinaryDataStreamer.hh"
+
+namespace KEMField
+{
+  KEMFileIndex::KEMFileIndex()
+    : fDirectory("."),
+      fLoaded(false),
+      fLoadedInode(0),
+      fLockDescriptor(-1)
+  {
+  }
+
+  KEMFileIndex::KEMFileIndex(std::string directory)
+    : fDirectory(directory),
+      fLoaded(false),
+      fLoadedInode(0),
+      fLockDescriptor(-1)
+  {
+  }
+
+  KEMFileIndex::~KEMFileIndex()
+  {
+    Unlock();
+  }
+
+  void KEMFileIndex::Directory(std::string directory)
+  {
+    if (directory == fDirectory)
+      return;
+    Unlock();
+    Clear();
+    fDirectory = directory;
+  }
+
+  void KEMFileIndex::Clear()
+  {
+    fFiles.clear();
+    fLoaded = false;
+    fLoadedInode = 0;
+    fLoadedStamp = Stamp();
+    BuildLookupTables();
+  }
+
+  bool KEMFileIndex::StampFile(std::string path,Stamp& stamp)
+  {
+    struct stat fileInfo;
+    if (stat(path.c_str(),&fileInfo) != 0)
+      return false;
+    stamp.fSize = fileInfo.st_size;
+    stamp.fModificationTime = fileInfo.st_mtime;
+    return true;
+  }
+
+  /**
+   * Reloads the index if the index file on disk has been replaced since it was
+   * last read.  The check costs a single stat() call.
+   */
+  bool KEMFileIndex::Refresh()
+  {
+    struct stat fileInfo;
+    if (stat(IndexPath().c_str(),&fileInfo) != 0)
+    {
+      fLoaded = false;
+      return false;
+    }
+
+    Stamp stamp;
+    stamp.fSize = fileInfo.st_size;
+    stamp.fModificationTime = fileInfo.st_mtime;
+
+    if (fLoaded && fLoadedInode == (unsigned long)fileInfo.st_ino && fLoadedStamp == stamp)
+      return true;
+
+    return Load();
+  }
+
+  bool KEMFileIndex::Lock()
+  {
+    if (fLockDescriptor >= 0)
+      return true;
+
+    fLockDescriptor = open(LockPath().c_str(),O_RDWR|O_CREAT,0666);
+    if (fLockDescriptor < 0)
+      return false;
+
+    // POSIX record locks are honored across hosts on shared file systems
+    struct flock lock;
+    lock.l_type = F_WRLCK;
+    lock.l_whence = SEEK_SET;
+    lock.l_start = 0;
+    lock.l_len = 0;
+
+    while (fcntl(fLockDescriptor,F_SETLKW,&lock) == -1)
+    {
+      if (errno != EINTR)
+      {
+	close(fLockDescriptor);
+	fLockDescriptor = -1;
+	return false;
+      }
+    }
+    return true;
+  }
+
+  void KEMFileIndex::Unlock()
+  {
+    if (fLockDescriptor < 0)
+      return;
+
+    struct flock lock;
+    lock.l_type = F_UNLCK;
+    lock.l_whence = SEEK_SET;
+    lock.l_start = 0;
+    lock.l_len = 0;
+    fcntl(fLockDescriptor,F_SETLK,&lock);
+
+    close(fLockDescriptor);
+    fLockDescriptor = -1;
+  }
+
+  bool KEMFileIndex::Load()
+  {
+    struct stat fileInfo;
+    if (stat(IndexPath().c_str(),&fileInfo) != 0)
+    {
+      Clear();
+      return false;
+    }
+
+    KBinaryDataStreamer streamer;
+    streamer.open(IndexPath(),"read");
+    if (!streamer.Stream().is_open())
+    {
+      Clear();
+      return false;
+    }
+
+    std::string header;
+    unsigned int version = 0;
+    unsigned int nFiles = 0;
+    streamer >> header;
+    if (streamer.Stream().good())
+      streamer >> version;
+    if (!streamer.Stream().good() || header != IndexFileName() || version != Version())
+    {
+      streamer.close();
+      Clear();
+      return false;
+    }
+
+    std::map<std::string,FileRecord> files;
+
+    streamer >> nFiles;
+    for (unsigned int i=0;i<nFiles && streamer.Stream().good();i++)
+    {
+      std::string fileName;
+      unsigned int nEntries;
+      streamer >> fileName;
+      FileRecord& record = files[fileName];
+      streamer >> record.fStamp.fSize;
+      streamer >> record.fStamp.fModificationTime;
+      streamer >> nEntries;
+      for (unsigned int j=0;j<nEntries && streamer.Stream().good();j++)
+      {
+	Entry entry;
+	unsigned int nLabels;
+	entry.fFileName = fileName;
+	streamer >> entry.fObjectName;
+	streamer >> entry.fClassName;
+	streamer >> entry.fObjectHash;
+	streamer >> nLabels;
+	for (unsigned int k=0;k<nLabels && streamer.Stream().good();k++)
+	{
+	  std::string label;
+	  streamer >> label;
+	  entry.fLabels.push_back(label);
+	}
+	streamer >> entry.fKeyLocation;
+	streamer >> entry.fObjectLocation;
+	streamer >> entry.fObjectSize;
+	record.fEntries.push_back(entry);
+      }
+    }
+
+    bool good = !streamer.Stream().fail();
+    streamer.close();
+
+    if (!good)
+    {
+      Clear();
+      return false;
+    }
+
+    fFiles.swap(files);
+    fLoaded = true;
+    fLoadedInode = fileInfo.st_ino;
+    fLoadedStamp.fSize = fileInfo.st_size;
+    fLoadedStamp.fModificationTime = fileInfo.st_mtime;
+    BuildLookupTables();
+    return true;
+  }
+
+  /**
+   * Writes the index to a uniquely named temporary file and renames it over
+   * the existing index, so that readers only ever observe complete indices.
+   */
+  bool KEMFileIndex::Save()
+  {
+    char hostName[256] = "localhost";
+    gethostname(hostName,sizeof(hostName)-1);
+    hostName[sizeof(hostName)-1] = '\0';
+
+    std::stringstream s;
+    s << IndexPath() << "." << hostName << "." << getpid();
+    std::string temporaryPath = s.str();
+
+    KBinaryDataStreamer streamer;
+    streamer.open(temporaryPath,"overwrite");
+    if (!streamer.Stream().is_open())
+      return false;
+
+    streamer << IndexFileName();
+    streamer << Version();
+    streamer << (unsigned int)(fFiles.size());
+    for (std::map<std::string,FileRecord>::const_iterator it=fFiles.begin();it!=fFiles.end();++it)
+    {
+      streamer << it->first;
+      streamer << it->second.fStamp.fSize;
+      streamer << it->second.fStamp.fModificationTime;
+      streamer << (unsigned int)(it->second.fEntries.size());
+      for (std::vector<Entry>::const_iterator e=it->second.fEntries.begin();e!=it->second.fEntries.end();++e)
+      {
+	streamer << e->fObjectName;
+	streamer << e->fClassName;
+	streamer << e->fObjectHash;
+	streamer << (unsigned int)(e->fLabels.size());
+	for (unsigned int k=0;k<e->fLabels.size();k++)
+	  streamer << e->fLabels.at(k);
+	streamer << e->fKeyLocation;
+	streamer << e->fObjectLocation;
+	streamer << e->fObjectSize;
+      }
+    }
+
+    bool good = !streamer.Stream().fail();
+    streamer.close();
+
+    if (!good || std::rename(temporaryPath.c_str(),IndexPath().c_str()) != 0)
+    {
+      std::remove(temporaryPath.c_str());
+      return false;
+    }
+
+    struct stat fileInfo;
+    if (stat(IndexPath().c_str(),&fileInfo) == 0)
+    {
+      fLoaded = true;
+      fLoadedInode = fileInfo.st_ino;
+      fLoadedStamp.fSize = fileInfo.st_size;
+      fLoadedStamp.fModificationTime = fileInfo.st_mtime;
+    }
+    return true;
+  }
+
+  void KEMFileIndex::SetFile(std::string fileName,const Stamp& stamp,const std::vector<Entry>& entries)
+  {
+    FileRecord& record = fFiles[fileName];
+    record.fStamp = stamp;
+    record.fEntries = entries;
+    for (std::vector<Entry>::iterator it=record.fEntries.begin();it!=record.fEntries.end();++it)
+      it->fFileName = fileName;
+    BuildLookupTables();
+  }
+
+  void KEMFileIndex::RemoveFile(std::string fileName)
+  {
+    if (fFiles.erase(fileName))
+      BuildLookupTables();
+  }
+
+  bool KEMFileIndex::HasFile(std::string fileName) const
+  {
+    return fFiles.find(fileName) != fFiles.end();
+  }
+
+  bool KEMFileIndex::IsCurrent(std::string fileName) const
+  {
+    std::map<std::string,FileRecord>::const_iterator it = fFiles.find(fileName);
+    if (it == fFiles.end())
+      return false;
+
+    Stamp stamp;
+    if (!StampFile(fDirectory + "/" + fileName,stamp))
+      return false;
+    return stamp == it->second.fStamp;
+  }
+
+  std::set<std::string> KEMFileIndex::FileNames() const
+  {
+    std::set<std::string> fileNames;
+    for (std::map<std::string,FileRecord>::const_iterator it=fFiles.begin();it!=fFiles.end();++it)
+      fileNames.insert(it->first);
+    return fileNames;
+  }
+
+  const KEMFileIndex::Entry* KEMFileIndex::FindByName(std::string name) const
+  {
+    std::map<std::string,unsigned int>::const_iterator it = fNameTable.find(name);
+    if (it == fNameTable.end())
+      return NULL;
+    return fEntries.at(it->second);
+  }
+
+  const KEMFileIndex::Entry* KEMFileIndex::FindByHash(std::string hash) const
+  {
+    std::map<std::string,unsigned int>::const_iterator it = fHashTable.find(hash);
+    if (it == fHashTable.end())
+      return NULL;
+    return fEntries.at(it->second);
+  }
+
+  /**
+   * Returns all entries carrying every one of the given labels, in the same
+   * order in which a sequential scan of the directory would encounter them.
+   */
+  std::vector<const KEMFileIndex::Entry*> KEMFileIndex::FindByLabels(const std::vector<std::string>& labels) const
+  {
+    std::vector<const Entry*> result;
+    if (labels.empty())
+    {
+      result = fEntries;
+      return result;
+    }
+
+    // start from the shortest posting list and filter by the remaining labels
+    const std::vector<unsigned int>* shortest = NULL;
+    for (std::vector<std::string>::const_iterator it=labels.begin();it!=labels.end();++it)
+    {
+      std::map<std::string,std::vector<unsigned int> >::const_iterator posting = fLabelTable.find(*it);
+      if (posting == fLabelTable.end())
+	return result;
+      if (shortest == NULL || posting->second.size() < shortest->size())
+	shortest = &(posting->second);
+    }
+
+    for (std::vector<unsigned int>::const_iterator it=shortest->begin();it!=shortest->end();++it)
+    {
+      const Entry* entry = fEntries.at(*it);
+      bool hasLabels = true;
+      for (std::vector<std::string>::const_iterator label=labels.begin();label!=labels.end();++label)
+      {
+	if (std::find(entry->fLabels.begin(),entry->fLabels.end(),*label) == entry->fLabels.end())
+	{
+	  hasLabels = false;
+	  break;
+	}
+      }
+      if (hasLabels)
+	result.push_back(entry);
+    }
+    return result;
+  }
+
+  void KEMFileIndex::BuildLookupTables()
+  {
+    fEntries.clear();
+    fNameTable.clear();
+    fHashTable.clear();
+    fLabelTable.clear();
+
+    for (std::map<std::string,FileRecord>::const_iterator it=fFiles.begin();it!=fFiles.end();++it)
+    {
+      for (std::vector<Entry>::const_iterator e=it->second.fEntries.begin();e!=it->second.fEntries.end();++e)
+      {
+	unsigned int id = fEntries.size();
+	fEntries.push_back(&(*e));
+
+	// first occurrence wins, as it would for a sequential scan
+	fNameTable.insert(std::make_pair(e->fObjectName,id));
+	fHashTable.insert(std::make_pair(e->fObjectHash,id));
+
+	std::set<std::string> uniqueLabels(e->fLabels.begin(),e->fLabels.end());
+	for (std::set<std::string>::const_iterator label=uniqueLabels.begin();label!=uniqueLabels.end();++label)
+	  fLabelTable[*label].push_back(id);
+      }
+    }
+  }
+}
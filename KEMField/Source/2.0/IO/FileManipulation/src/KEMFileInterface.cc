@@ -20,7 +20,9 @@ namespace KEMField
   bool KEMFileInterface::fNullResult = 0;
 
   KEMFileInterface::KEMFileInterface()
-    : KEMFile()
+    : KEMFile(),
+      fUseIndex(true),
+      fIndexInMemory(false)
   {
     ActiveDirectory(DEFAULT_SAVED_FILE_DIR);
   }
@@ -37,6 +39,9 @@ namespace KEMField
 
   unsigned int KEMFileInterface::NumberWithLabel(string label) const
   {
+    if (fUseIndex && SynchronizeIndex())
+      return fIndex.FindByLabels(vector<string>(1,label)).size();
+
     unsigned int value = 0;
     set<string> fileList = FileList();
 
@@ -47,6 +52,9 @@ namespace KEMField
 
   unsigned int KEMFileInterface::NumberWithLabels(vector<string> labels) const
   {
+    if (fUseIndex && SynchronizeIndex())
+      return fIndex.FindByLabels(labels).size();
+
     unsigned int value = 0;
     set<string> fileList = FileList();
 
@@ -57,9 +65,18 @@ namespace KEMField
 
   set<string> KEMFileInterface::FileNamesWithLabels(vector<string> labels) const
   {
-    set<string> fileList = FileList();
     set<string> labeledFileList;
 
+    if (fUseIndex && SynchronizeIndex())
+    {
+      vector<const KEMFileIndex::Entry*> entries = fIndex.FindByLabels(labels);
+      for (vector<const KEMFileIndex::Entry*>::iterator it=entries.begin();it!=entries.end();++it)
+	labeledFileList.insert(fActiveDirectory + "/" + (*it)->fFileName);
+      return labeledFileList;
+    }
+
+    set<string> fileList = FileList();
+
     for (set<string>::iterator it=fileList.begin();it!=fileList.end();++it)
     {
         if(NumberOfLabeled(*it,labels))
@@ -125,7 +142,11 @@ namespace KEMField
     if (!DirectoryExists(directory))
       CreateDirectory(directory);
     if (DirectoryExists(directory))
+    {
       fActiveDirectory = directory;
+      fIndex.Directory(directory);
+      fIndexInMemory = false;
+    }
     else
       KEMField::cout<<"Cannot access directory "<<directory<<KEMField::endl;
   }
@@ -154,20 +175,183 @@ namespace KEMField
   bool KEMFileInterface::RemoveFileFromActiveDirectory(string file_name)
   {
     string full_file_name = fActiveDirectory + "/" + file_name;
-    return std::remove(full_file_name.c_str());
+    bool status = std::remove(full_file_name.c_str());
+
+    if (fUseIndex && fIndex.HasFile(file_name))
+    {
+      if (fIndexInMemory)
+	fIndex.RemoveFile(file_name);
+      else
+      {
+	KEMFileIndex index(fActiveDirectory);
+	index.Lock();
+	if (index.Load())
+	{
+	  index.RemoveFile(file_name);
+	  index.Save();
+	}
+	index.Unlock();
+      }
+    }
+    return status;
   }
 
     bool KEMFileInterface::DoesFileExist(std::string file_name)
     {
-        std::string full_file_name = KEMFileInterface::GetInstance()->ActiveDirectory() + "/" + file_name;
-        std::set< std::string > file_list = KEMFileInterface::GetInstance()->CompleteFileList();
-        for(std::set<std::string>::iterator it=file_list.begin(); it!=file_list.end(); ++it)
-        {
-            if(full_file_name == *it){return true;};
-        }
-        return false;
+        std::string full_file_name = ActiveDirectory() + "/" + file_name;
+        return FileExists(full_file_name);
     }
 
+  /**
+   * Scans every KEMField file in the directory and replaces its index.  This
+   * is only needed if files were added to the directory by means other than
+   * KEMFileInterface; files that were modified are re-indexed automatically.
+   */
+  bool KEMFileInterface::RebuildIndex(string directory)
+  {
+    if (directory == "")
+      directory = fActiveDirectory;
+
+    KEMFileIndex index(directory);
+    bool locked = index.Lock();
+
+    set<string> fileList = FileList(directory);
+    for (set<string>::iterator it=fileList.begin();it!=fileList.end();++it)
+      IndexFile(index,it->substr(directory.size() + 1));
+
+    bool saved = locked && index.Save();
+    index.Unlock();
+
+    if (directory == fActiveDirectory)
+    {
+      if (saved)
+      {
+	fIndexInMemory = false;
+	fIndex.Load();
+      }
+      else
+      {
+	// the directory is not writable; keep the index for this session only
+	fIndexInMemory = true;
+	fIndex.Clear();
+	for (set<string>::iterator it=fileList.begin();it!=fileList.end();++it)
+	  IndexFile(fIndex,it->substr(directory.size() + 1));
+      }
+    }
+    return saved;
+  }
+
+  bool KEMFileInterface::SynchronizeIndex() const
+  {
+    if (fIndexInMemory || fIndex.Refresh())
+      return true;
+
+    const_cast<KEMFileInterface*>(this)->RebuildIndex();
+    return true;
+  }
+
+  /**
+   * Checks that the file holding an indexed element is unchanged since it was
+   * indexed.  If it is not, the file is re-indexed and false is returned, so
+   * that the caller can repeat its lookup.
+   */
+  bool KEMFileInterface::ValidateIndexEntry(const KEMFileIndex::Entry& entry) const
+  {
+    string fileName = entry.fFileName;
+    if (fIndex.IsCurrent(fileName))
+      return true;
+
+    const_cast<KEMFileInterface*>(this)->FileUpdated(fActiveDirectory + "/" + fileName);
+    if (!fIndexInMemory)
+      fIndex.Refresh();
+    if (!fIndex.IsCurrent(fileName))
+      IndexFile(fIndex,fileName);
+    return false;
+  }
+
+  void KEMFileInterface::IndexFile(KEMFileIndex& index,string fileName) const
+  {
+    string fullFileName = index.Directory() + "/" + fileName;
+
+    KEMFileIndex::Stamp stamp;
+    if (!KEMFileIndex::StampFile(fullFileName,stamp))
+    {
+      index.RemoveFile(fileName);
+      return;
+    }
+
+    vector<KEMFileIndex::Entry> entries;
+
+    fStreamer.open(fullFileName,"read");
+
+    Key key;
+
+    size_t readPoint = 0;
+    fStreamer.Stream().seekg(0, fStreamer.Stream().end);
+    size_t end = fStreamer.Stream().tellg();
+    fStreamer.Stream().seekg(0, fStreamer.Stream().beg);
+
+    while (readPoint < end)
+    {
+      fStreamer.Stream().seekg(readPoint, fStreamer.Stream().beg);
+      fStreamer >> key;
+      if (!fStreamer.Stream().good())
+	break;
+
+      KEMFileIndex::Entry entry;
+      entry.fObjectName = key.fObjectName;
+      entry.fClassName = key.fClassName;
+      entry.fObjectHash = key.fObjectHash;
+      entry.fLabels = key.fLabels;
+      entry.fKeyLocation = readPoint;
+      entry.fObjectLocation = key.fObjectLocation;
+      entry.fObjectSize = key.fObjectSize;
+      entries.push_back(entry);
+
+      if (key.NextKey() <= readPoint)
+	break;
+      readPoint = key.NextKey();
+    }
+
+    fStreamer.close();
+
+    index.SetFile(fileName,stamp,entries);
+  }
+
+  /**
+   * Keeps the index of the file's directory current after KEMFile has written
+   * to it.  If the directory has no index yet, it is built on first lookup.
+   */
+  void KEMFileInterface::FileUpdated(string fileName)
+  {
+    if (!fUseIndex)
+      return;
+
+    string directory = ".";
+    string baseName = fileName;
+    if (fileName.find_last_of("/") != string::npos)
+    {
+      directory = fileName.substr(0,fileName.find_last_of("/"));
+      baseName = fileName.substr(fileName.find_last_of("/") + 1);
+    }
+
+    if (fIndexInMemory && directory == fActiveDirectory)
+    {
+      IndexFile(fIndex,baseName);
+      return;
+    }
+
+    KEMFileIndex index(directory);
+    if (!index.Lock())
+      return;
+    if (index.Load())
+    {
+      IndexFile(index,baseName);
+      index.Save();
+    }
+    index.Unlock();
+  }
+
     void
     KEMFileInterface::ReadKSAFile(KSAInputNode* node, string file_name, bool& result)
     {
@@ -238,20 +422,13 @@ namespace KEMField
     KEMFileInterface::SaveKSAFileToActiveDirectory(KSAOutputNode* node, string file_name, bool& result, bool forceOverwrite)
     {
         result = false;
-        set<string> fileList = CompleteFileList();
         std::string full_file_name = ActiveDirectory() + "/" + file_name;
 
-        for(set<string>::iterator it=fileList.begin(); it!=fileList.end(); ++it)
+        if( !forceOverwrite && FileExists(full_file_name) )
         {
-            if( *it == full_file_name )
-            {
-                if(!forceOverwrite)
-                {
-                    //file already exists, and we do not want to overwrite it
-                    result = false;
-                    return;
-                }
-            }
+            //file already exists, and we do not want to overwrite it
+            result = false;
+            return;
         }
 
         //file doesn't already exist or we can overwrite it, safe to write
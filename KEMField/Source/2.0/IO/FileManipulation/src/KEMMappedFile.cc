@@ -0,0 +1,59 @@
+#include "KEMMappedFile.hh"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace KEMField
+{
+  KEMMappedFile::KEMMappedFile()
+    : fFileName(""),
+      fData(NULL),
+      fSize(0)
+  {
+  }
+
+  KEMMappedFile::~KEMMappedFile()
+  {
+    Close();
+  }
+
+  bool KEMMappedFile::Open(std::string fileName)
+  {
+    Close();
+
+    int descriptor = open(fileName.c_str(),O_RDONLY);
+    if (descriptor < 0)
+      return false;
+
+    struct stat fileInfo;
+    if (fstat(descriptor,&fileInfo) != 0 || fileInfo.st_size == 0)
+    {
+      close(descriptor);
+      return false;
+    }
+
+    void* data = mmap(NULL,fileInfo.st_size,PROT_READ,MAP_SHARED,descriptor,0);
+
+    // the mapping remains valid after the descriptor is closed
+    close(descriptor);
+
+    if (data == MAP_FAILED)
+      return false;
+
+    fFileName = fileName;
+    fData = static_cast<const char*>(data);
+    fSize = fileInfo.st_size;
+    return true;
+  }
+
+  void KEMMappedFile::Close()
+  {
+    if (fData != NULL)
+      munmap(const_cast<char*>(fData),fSize);
+    fData = NULL;
+    fSize = 0;
+    fFileName = "";
+  }
+}
@@ -0,0 +1,45 @@
+#ifndef KCHARGEDENSITYFLATFILE_DEF
+#define KCHARGEDENSITYFLATFILE_DEF
+
+#include "KEMFlatFile.hh"
+
+namespace KEMField
+{
+  /**
+   * @file KChargeDensityFlatFile.hh
+   *
+   * @brief Flat, memory-mappable binary layout for BEM charge densities.
+   *
+   * A flat file consists of a header followed by one contiguous block with the
+   * basis values of all elements, in container order.  The header carries the
+   * shape and shape+boundary hashes of the surface container the values were
+   * solved for, the hash of the full solution as written to the .kbd cache and
+   * the residual threshold the solution was computed to.
+   */
+
+  struct KChargeDensityFlatHeader : public KEMFlatFileHeader
+  {
+    static const char* Magic() { return "KEMCDFL"; }
+    static unsigned int Version() { return 1; }
+
+    void Initialize()
+    {
+      std::memset(this,0,sizeof(KChargeDensityFlatHeader));
+      KEMFlatFileHeader::Initialize(Magic(),Version());
+    }
+
+    bool IsValid() const
+    {
+      return KEMFlatFileHeader::IsValid(Magic(),Version());
+    }
+
+    char fShapeHash[HashLength];
+    char fShapeBoundaryHash[HashLength];
+    char fSolutionHash[HashLength];
+    double fResidualThreshold;
+    unsigned long long fValueCount;
+    unsigned long long fValueOffset;
+  };
+}
+
+#endif /* KCHARGEDENSITYFLATFILE_DEF */
@@ -10,6 +10,8 @@
 
 #include "KSurfaceContainer.hh"
 
+#include <string>
+
 namespace KEMField{
 
 class KChargeDensitySolver
@@ -33,6 +35,11 @@ protected:
 private:
     virtual void InitializeCore(KSurfaceContainer& container) = 0;
 
+    // flat copies of the cached charge densities, see KChargeDensityFlatFile.hh
+    static std::string FlatFileName(const std::string& shapeBoundaryHash);
+    bool MapFlatSolution(double threshold, KSurfaceContainer& container, const std::string& shapeHash, const std::string& shapeBoundaryHash);
+    void WriteFlatSolution(double threshold, KSurfaceContainer& container, const std::string& shapeHash, const std::string& shapeBoundaryHash, const std::string& solutionHash);
+
     unsigned int fHashMaskedBits;
     double fHashThreshold;
     bool fInitialized;
@@ -10,6 +10,8 @@
 #include "KTypeManipulation.hh"
 #include "KMD5HashGenerator.hh"
 #include "KEMFileInterface.hh"
+#include "KEMMappedFile.hh"
+#include "KChargeDensityFlatFile.hh"
 
 #include "KSuperpositionSolver.hh"
 #include "KProjectionSolver.hh"
@@ -27,6 +29,11 @@
 
 #include "KIterativeStateWriter.hh"
 
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
 #ifdef KEMFIELD_USE_MPI
 	#include "KMPIInterface.hh"
     #ifndef MPI_SINGLE_PROCESS
@@ -69,6 +76,14 @@ bool KChargeDensitySolver::FindSolution( double aThreshold, KSurfaceContainer& a
 
     //fieldmsg_debug( "<shape+boundary> hash is <" << tShapeBoundaryHash << ">" << eom )
 
+    // the flat copy of a previous solution is copied in without streaming the container
+    if( MapFlatSolution( aThreshold, aContainer, tShapeHash, tShapeBoundaryHash ) == true )
+    {
+        MPI_SINGLE_PROCESS
+            cout << "previously computed solution found (mapped)" << endl;
+        return true;
+    }
+
     vector< string > tLabels;
     unsigned int tCount;
     bool tSolution;
@@ -118,6 +133,10 @@ bool KChargeDensitySolver::FindSolution( double aThreshold, KSurfaceContainer& a
 
         if( tSolution == true )
         {
+            MPI_SINGLE_PROCESS
+            {
+                WriteFlatSolution( tMinResidualThreshold.fResidualThreshold, aContainer, tShapeHash, tShapeBoundaryHash, tMinResidualThreshold.fGeometryHash );
+            }
             return true;
         }
     }
@@ -260,6 +279,127 @@ void KChargeDensitySolver::SaveSolution( double aThreshold, KSurfaceContainer& a
         KEMFileInterface::GetInstance()->Write( aContainer, tContainerName, tContainerLabels );
     }
 
+    // write flat copy of the charge densities
+    MPI_SINGLE_PROCESS
+    {
+        WriteFlatSolution( aThreshold, aContainer, tShapeHash, tShapeBoundaryHash, tShapeBoundarySolutionHash );
+    }
+
+    return;
+}
+
+string KChargeDensitySolver::FlatFileName( const string& aShapeBoundaryHash )
+{
+    return KEMFileInterface::GetInstance()->ActiveDirectory() + string( "/" ) + KResidualThreshold::Name() + string( "_" ) + aShapeBoundaryHash + string( ".kcd" );
+}
+
+/**
+ * Maps the flat charge density file of the shape+boundary hash read-only and
+ * copies its values into the basis of the container elements.  The file is
+ * rejected if its layout, hashes or size do not match the container, or if
+ * its residual threshold is above the requested one.
+ */
+bool KChargeDensitySolver::MapFlatSolution( double aThreshold, KSurfaceContainer& aContainer, const string& aShapeHash, const string& aShapeBoundaryHash )
+{
+    KEMMappedFile tFile;
+    if( tFile.Open( FlatFileName( aShapeBoundaryHash ) ) == false )
+    {
+        return false;
+    }
+
+    const KChargeDensityFlatHeader* tHeader = tFile.At< KChargeDensityFlatHeader >( 0 );
+    unsigned long long tValueCount = aContainer.size() * KElectrostaticBasis::Dimension;
+
+    if( tHeader == NULL ||
+        tHeader->IsValid() == false ||
+        tHeader->fFileSize != tFile.Size() ||
+        KChargeDensityFlatHeader::HashMatches( tHeader->fShapeHash, aShapeHash ) == false ||
+        KChargeDensityFlatHeader::HashMatches( tHeader->fShapeBoundaryHash, aShapeBoundaryHash ) == false ||
+        tHeader->fResidualThreshold > aThreshold ||
+        tHeader->fValueCount != tValueCount )
+    {
+        return false;
+    }
+
+    const double* tValues = tFile.At< double >( tHeader->fValueOffset, tHeader->fValueCount );
+    if( tValues == NULL )
+    {
+        return false;
+    }
+
+    KElectrostaticBoundaryIntegrator tIntegrator {KEBIFactory::MakeDefault()};
+    KBoundaryIntegralSolutionVector< KElectrostaticBoundaryIntegrator > tSolutionVector( aContainer, tIntegrator );
+    for( unsigned int i = 0; i < tSolutionVector.Dimension(); i++ )
+    {
+        tSolutionVector[ i ] = tValues[ i ];
+    }
+    return true;
+}
+
+/**
+ * Writes the basis values of the container in the flat layout of
+ * KChargeDensityFlatFile.hh.  An existing file with a lower residual threshold
+ * for the same shape+boundary hash is kept.  The file is written under a
+ * temporary name and renamed into place, so that concurrent readers never map
+ * an incomplete file.
+ */
+void KChargeDensitySolver::WriteFlatSolution( double aThreshold, KSurfaceContainer& aContainer, const string& aShapeHash, const string& aShapeBoundaryHash, const string& aSolutionHash )
+{
+    string tFileName = FlatFileName( aShapeBoundaryHash );
+
+    KEMMappedFile tExistingFile;
+    if( tExistingFile.Open( tFileName ) == true )
+    {
+        const KChargeDensityFlatHeader* tExisting = tExistingFile.At< KChargeDensityFlatHeader >( 0 );
+        if( tExisting != NULL &&
+            tExisting->IsValid() == true &&
+            tExisting->fFileSize == tExistingFile.Size() &&
+            KChargeDensityFlatHeader::HashMatches( tExisting->fShapeBoundaryHash, aShapeBoundaryHash ) == true &&
+            tExisting->fResidualThreshold < aThreshold )
+        {
+            return;
+        }
+        tExistingFile.Close();
+    }
+
+    KElectrostaticBoundaryIntegrator tIntegrator {KEBIFactory::MakeDefault()};
+    KBoundaryIntegralSolutionVector< KElectrostaticBoundaryIntegrator > tSolutionVector( aContainer, tIntegrator );
+    vector< double > tValues( tSolutionVector.Dimension() );
+    for( unsigned int i = 0; i < tSolutionVector.Dimension(); i++ )
+    {
+        tValues[ i ] = tSolutionVector( i );
+    }
+
+    KChargeDensityFlatHeader tHeader;
+    tHeader.Initialize();
+    KChargeDensityFlatHeader::SetHash( tHeader.fShapeHash, aShapeHash );
+    KChargeDensityFlatHeader::SetHash( tHeader.fShapeBoundaryHash, aShapeBoundaryHash );
+    KChargeDensityFlatHeader::SetHash( tHeader.fSolutionHash, aSolutionHash );
+    tHeader.fResidualThreshold = aThreshold;
+    tHeader.fValueCount = tValues.size();
+    tHeader.fValueOffset = sizeof(KChargeDensityFlatHeader);
+    tHeader.fFileSize = tHeader.fValueOffset + tValues.size() * sizeof(double);
+
+    stringstream tTemporaryName;
+    tTemporaryName << tFileName << "." << getpid() << ".tmp";
+
+    ofstream tFile( tTemporaryName.str().c_str(), ios::out | ios::binary | ios::trunc );
+    if( tFile.is_open() == false )
+    {
+        return;
+    }
+    tFile.write( reinterpret_cast< const char* >( &tHeader ), sizeof(KChargeDensityFlatHeader) );
+    if( tValues.empty() == false )
+    {
+        tFile.write( reinterpret_cast< const char* >( &tValues[ 0 ] ), tValues.size() * sizeof(double) );
+    }
+    bool tGood = tFile.good();
+    tFile.close();
+
+    if( tGood == false || rename( tTemporaryName.str().c_str(), tFileName.c_str() ) != 0 )
+    {
+        remove( tTemporaryName.str().c_str() );
+    }
     return;
 }
 
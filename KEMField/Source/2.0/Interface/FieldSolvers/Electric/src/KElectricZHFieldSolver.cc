@@ -78,23 +78,39 @@ void KElectricZHFieldSolver::InitializeCore( KSurfaceContainer& container )
 
         fZHContainer = new KZonalHarmonicContainer< KElectrostaticBasis >( container, fParameters );
 
-        bool containerFound = false;
+        // flat copy of the container, which is mapped into memory instead of being read
+        string zhFlatFileName = KEMFileInterface::GetInstance()->ActiveDirectory() + string( "/" ) + zhContainerName + KZonalHarmonicContainer< KElectrostaticBasis >::FlatFileSuffix();
 
-        KEMFileInterface::GetInstance()->FindByLabels( *fZHContainer, zhContainerLabels, 0, containerFound );
+        bool containerFound = false;
 
-        if( containerFound == true )
+        if( fZHContainer->MapFlat( zhFlatFileName ) == true )
         {
-            KEMField::cout << "zonal harmonic container found." << KEMField::endl;
+            KEMField::cout << "zonal harmonic container found (mapped)." << KEMField::endl;
+            containerFound = true;
         }
         else
         {
-            //KEMField::cout << "no zonal harmonic container found." << KEMField::endl;
+            KEMFileInterface::GetInstance()->FindByLabels( *fZHContainer, zhContainerLabels, 0, containerFound );
+
+            if( containerFound == true )
+            {
+                KEMField::cout << "zonal harmonic container found." << KEMField::endl;
+            }
+            else
+            {
+                //KEMField::cout << "no zonal harmonic container found." << KEMField::endl;
 
-            fZHContainer->ComputeCoefficients();
+                fZHContainer->ComputeCoefficients();
+
+                MPI_SINGLE_PROCESS
+                {
+                    KEMFileInterface::GetInstance()->Write( *fZHContainer, zhContainerName, zhContainerLabels );
+                }
+            }
 
             MPI_SINGLE_PROCESS
             {
-                KEMFileInterface::GetInstance()->Write( *fZHContainer, zhContainerName, zhContainerLabels );
+                fZHContainer->WriteFlat( zhFlatFileName );
             }
         }
 
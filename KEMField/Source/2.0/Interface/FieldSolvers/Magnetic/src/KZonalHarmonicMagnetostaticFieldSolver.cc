@@ -53,21 +53,33 @@ void KZonalHarmonicMagnetostaticFieldSolver::InitializeCore( KElectromagnetConta
 
     fZHContainer = new KZonalHarmonicContainer< KMagnetostaticBasis >( container, tParametersCopy );
 
-    bool containerFound = false;
+    // flat copy of the container, which is mapped into memory instead of being read
+    string zhFlatFileName = KEMFileInterface::GetInstance()->ActiveDirectory() + string( "/" ) + zhContainerName + KZonalHarmonicContainer< KMagnetostaticBasis >::FlatFileSuffix();
 
-    KEMFileInterface::GetInstance()->FindByLabels( *fZHContainer, zhContainerLabels, 0, containerFound );
+    bool containerFound = false;
 
-    if( containerFound == true )
+    if( fZHContainer->MapFlat( zhFlatFileName ) == true )
     {
-        KEMField::cout << "zonal harmonic container found." << endl;
+        KEMField::cout << "zonal harmonic container found (mapped)." << endl;
     }
     else
     {
-        //KEMField::cout << "no zonal harmonic container found." << endl;
+        KEMFileInterface::GetInstance()->FindByLabels( *fZHContainer, zhContainerLabels, 0, containerFound );
+
+        if( containerFound == true )
+        {
+            KEMField::cout << "zonal harmonic container found." << endl;
+        }
+        else
+        {
+            //KEMField::cout << "no zonal harmonic container found." << endl;
+
+            fZHContainer->ComputeCoefficients();
 
-        fZHContainer->ComputeCoefficients();
+            KEMFileInterface::GetInstance()->Write( *fZHContainer, zhContainerName, zhContainerLabels );
+        }
 
-        KEMFileInterface::GetInstance()->Write( *fZHContainer, zhContainerName, zhContainerLabels );
+        fZHContainer->WriteFlat( zhFlatFileName );
     }
 
     fZonalHarmonicFieldSolver = new KZonalHarmonicFieldSolver< KMagnetostaticBasis >( *fZHContainer, fIntegrator );
@@ -48,6 +48,10 @@ public:
 
     void SetName(std::string name){fName = name;}
 
+    // true if the field may be evaluated from several threads at once,
+    // i.e. the ...Core methods do not modify any state
+    virtual bool IsThreadSafe() const { return false; }
+
 private:
 
     virtual double PotentialCore( const KPosition& P,const double& time) const = 0;
@@ -17,6 +17,8 @@ public:
 	KElectricQuadrupoleField();
 	virtual ~KElectricQuadrupoleField();
 
+	bool IsThreadSafe() const { return true; }
+
 	void SetLocation( const KPosition& aLocation );
 	void SetStrength( const double& aStrength );
 	void SetLength( const double& aLength );
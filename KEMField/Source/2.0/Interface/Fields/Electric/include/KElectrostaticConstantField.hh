@@ -23,6 +23,8 @@ namespace KEMField
 
     static std::string Name() { return "ElectrostaticConstantFieldSolver"; }
 
+    bool IsThreadSafe() const { return true; }
+
 private:
     virtual double PotentialCore(const KPosition& P) const {
     	return fField.Dot(P);
@@ -16,6 +16,8 @@ class KMagneticDipoleField: public KMagnetostaticField {
 public:
     KMagneticDipoleField();
     virtual ~KMagneticDipoleField();
+
+    bool IsThreadSafe() const { return true; }
 private:
     KEMThreeVector MagneticPotentialCore( const KPosition& aSamplePoint ) const;
     KEMThreeVector MagneticFieldCore( const KPosition& aSamplePoint ) const;
@@ -53,6 +53,10 @@ public:
 
     void SetName(std::string name){fName = name;}
 
+    // true if the field may be evaluated from several threads at once,
+    // i.e. the ...Core methods do not modify any state
+    virtual bool IsThreadSafe() const { return false; }
+
 protected:
 
 	virtual KEMThreeVector MagneticPotentialCore(
@@ -31,6 +31,9 @@ public:
 
     void SetUseCaching( bool useCaching ) {fUseCaching = useCaching;}
 
+    // the caches are shared between all callers
+    bool IsThreadSafe() const;
+
 private:
     void InitializeCore();
 
@@ -202,6 +202,16 @@ KGradient KMagneticSuperpositionField::CalculateDirectGradient(
     return gradient;
 }
 
+bool KMagneticSuperpositionField::IsThreadSafe() const {
+    if( fUseCaching && !fCachingBlock )
+        return false;
+    for (auto field : fMagneticFields ){
+        if( !field->IsThreadSafe() )
+            return false;
+    }
+    return true;
+}
+
 bool KMagneticSuperpositionField::AreAllFieldsStatic() {
     bool allStatic ( true );
     for (auto field : fMagneticFields ){
@@ -231,11 +231,12 @@ namespace KGeoBag
 
             void Clear();
 
-            std::vector< Triangle* > fTriangles;
-            std::vector< Rectangle* > fRectangles;
-            std::vector< LineSegment* > fLineSegments;
-            std::vector< ConicSection* > fConicSections;
-            std::vector< Ring* > fRings;
+            //the plain elements are stored by value, so their storage is contiguous and is reused from one surface to the next
+            std::vector< Triangle > fTriangles;
+            std::vector< Rectangle > fRectangles;
+            std::vector< LineSegment > fLineSegments;
+            std::vector< ConicSection > fConicSections;
+            std::vector< Ring > fRings;
             std::vector< SymmetricTriangle* > fSymmetricTriangles;
             std::vector< SymmetricRectangle* > fSymmetricRectangles;
             std::vector< SymmetricLineSegment* > fSymmetricLineSegments;
@@ -312,51 +313,51 @@ namespace KGeoBag
             {
                 //cout << "adding bem surface of type < " << XBasisPolicy::Name() << ", " << XBoundaryPolicy::Name() << " >..." << endl;
 
-                for( vector< Triangle* >::iterator tTriangleIt = fTriangles.begin(); tTriangleIt != fTriangles.end(); tTriangleIt++ )
-                {
-                    fSurfaceContainer->push_back( new KSurface< XBasisPolicy, XBoundaryPolicy, KTriangle >( *aBEM, *aBEM, **tTriangleIt ) );
-                }
-                for( vector< Rectangle* >::iterator tRectangleIt = fRectangles.begin(); tRectangleIt != fRectangles.end(); tRectangleIt++ )
-                {
-                    fSurfaceContainer->push_back( new KSurface< XBasisPolicy, XBoundaryPolicy, KRectangle >( *aBEM, *aBEM, **tRectangleIt ) );
-                }
-                for( vector< LineSegment* >::iterator tLineSegmentIt = fLineSegments.begin(); tLineSegmentIt != fLineSegments.end(); tLineSegmentIt++ )
-                {
-                    fSurfaceContainer->push_back( new KSurface< XBasisPolicy, XBoundaryPolicy, KLineSegment >( *aBEM, *aBEM, **tLineSegmentIt ) );
-                }
-                for( vector< ConicSection* >::iterator tConicSectionIt = fConicSections.begin(); tConicSectionIt != fConicSections.end(); tConicSectionIt++ )
-                {
-                    fSurfaceContainer->push_back( new KSurface< XBasisPolicy, XBoundaryPolicy, KConicSection >( *aBEM, *aBEM, **tConicSectionIt ) );
-                }
-                for( vector< Ring* >::iterator tRingIt = fRings.begin(); tRingIt != fRings.end(); tRingIt++ )
-                {
-                    fSurfaceContainer->push_back( new KSurface< XBasisPolicy, XBoundaryPolicy, KRing >( *aBEM, *aBEM, **tRingIt ) );
-                }
-                for( vector< SymmetricTriangle* >::iterator tTriangleIt = fSymmetricTriangles.begin(); tTriangleIt != fSymmetricTriangles.end(); tTriangleIt++ )
-                {
-                    fSurfaceContainer->push_back( new KSurface< XBasisPolicy, XBoundaryPolicy, KSymmetryGroup< KTriangle > >( *aBEM, *aBEM, **tTriangleIt ) );
-                }
-                for( vector< SymmetricRectangle* >::iterator tRectangleIt = fSymmetricRectangles.begin(); tRectangleIt != fSymmetricRectangles.end(); tRectangleIt++ )
-                {
-                    fSurfaceContainer->push_back( new KSurface< XBasisPolicy, XBoundaryPolicy, KSymmetryGroup< KRectangle > >( *aBEM, *aBEM, **tRectangleIt ) );
-                }
-                for( vector< SymmetricLineSegment* >::iterator tLineSegmentIt = fSymmetricLineSegments.begin(); tLineSegmentIt != fSymmetricLineSegments.end(); tLineSegmentIt++ )
-                {
-                    fSurfaceContainer->push_back( new KSurface< XBasisPolicy, XBoundaryPolicy, KSymmetryGroup< KLineSegment > >( *aBEM, *aBEM, **tLineSegmentIt ) );
-                }
-                for( vector< SymmetricConicSection* >::iterator tConicSectionIt = fSymmetricConicSections.begin(); tConicSectionIt != fSymmetricConicSections.end(); tConicSectionIt++ )
+                //the surfaces of one type are allocated together in a block owned by the container
+                AddBlock< KTriangle >( aBEM, fTriangles );
+                AddBlock< KRectangle >( aBEM, fRectangles );
+                AddBlock< KLineSegment >( aBEM, fLineSegments );
+                AddBlock< KConicSection >( aBEM, fConicSections );
+                AddBlock< KRing >( aBEM, fRings );
+                AddBlock< KSymmetryGroup< KTriangle > >( aBEM, fSymmetricTriangles );
+                AddBlock< KSymmetryGroup< KRectangle > >( aBEM, fSymmetricRectangles );
+                AddBlock< KSymmetryGroup< KLineSegment > >( aBEM, fSymmetricLineSegments );
+                AddBlock< KSymmetryGroup< KConicSection > >( aBEM, fSymmetricConicSections );
+                AddBlock< KSymmetryGroup< KRing > >( aBEM, fSymmetricRings );
+
+                //cout << "...surface container has <" << fSurfaceContainer->size() << "> elements." << endl;
+                return;
+            }
+
+            template< class XShapePolicy, class XElement >
+            void AddBlock( KGBEMData< XBasisPolicy, XBoundaryPolicy >* aBEM, const vector< XElement >& anElements )
+            {
+                if( anElements.empty() == true )
                 {
-                    fSurfaceContainer->push_back( new KSurface< XBasisPolicy, XBoundaryPolicy, KSymmetryGroup< KConicSection > >( *aBEM, *aBEM, **tConicSectionIt ) );
+                    return;
                 }
-                for( vector< SymmetricRing* >::iterator tRingIt = fSymmetricRings.begin(); tRingIt != fSymmetricRings.end(); tRingIt++ )
+
+                typedef KSurface< XBasisPolicy, XBoundaryPolicy, XShapePolicy > Surface;
+                KSurfaceContainer::KSurfaceBlockOf< Surface >* tBlock = new KSurfaceContainer::KSurfaceBlockOf< Surface >( anElements.size() );
+                for( typename vector< XElement >::const_iterator tElementIt = anElements.begin(); tElementIt != anElements.end(); tElementIt++ )
                 {
-                    fSurfaceContainer->push_back( new KSurface< XBasisPolicy, XBoundaryPolicy, KSymmetryGroup< KRing > >( *aBEM, *aBEM, **tRingIt ) );
+                    tBlock->push_back( Surface( *aBEM, *aBEM, Element( *tElementIt ) ) );
                 }
-
-                //cout << "...surface container has <" << fSurfaceContainer->size() << "> elements." << endl;
+                fSurfaceContainer->push_back( tBlock );
                 return;
             }
 
+            template< class XElement >
+            static const XElement& Element( const XElement& anElement )
+            {
+                return anElement;
+            }
+            template< class XElement >
+            static const XElement& Element( XElement* anElement )
+            {
+                return *anElement;
+            }
+
     };
 
     class KGBEMMeshConverter :
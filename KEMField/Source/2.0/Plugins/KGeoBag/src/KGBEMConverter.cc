@@ -38,34 +38,11 @@ namespace KGeoBag
     {
         //cout << "clearing content" << endl;
 
-        for( std::vector< Triangle* >::iterator tTriangleIt = fTriangles.begin(); tTriangleIt != fTriangles.end(); ++tTriangleIt )
-        {
-            delete *tTriangleIt;
-        }
+        //the plain elements keep their storage for the next surface
         fTriangles.clear();
-
-        for( std::vector< Rectangle* >::iterator tRectangleIt = fRectangles.begin(); tRectangleIt != fRectangles.end(); ++tRectangleIt )
-        {
-            delete *tRectangleIt;
-        }
         fRectangles.clear();
-
-        for( std::vector< LineSegment* >::iterator tLineSegmentIt = fLineSegments.begin(); tLineSegmentIt != fLineSegments.end(); ++tLineSegmentIt )
-        {
-            delete *tLineSegmentIt;
-        }
         fLineSegments.clear();
-
-        for( std::vector< ConicSection* >::iterator tConicSectionIt = fConicSections.begin(); tConicSectionIt != fConicSections.end(); ++tConicSectionIt )
-        {
-            delete *tConicSectionIt;
-        }
         fConicSections.clear();
-
-        for( std::vector< Ring* >::iterator tRingIt = fRings.begin(); tRingIt != fRings.end(); ++tRingIt )
-        {
-            delete *tRingIt;
-        }
         fRings.clear();
 
         for( std::vector< SymmetricTriangle* >::iterator tTriangleIt = fSymmetricTriangles.begin(); tTriangleIt != fSymmetricTriangles.end(); ++tTriangleIt )
@@ -228,12 +205,14 @@ namespace KGeoBag
         KGMeshRectangle* tMeshRectangle;
         KGMeshWire* tMeshWire;
 
-        Triangle* tTriangle;
-        Rectangle* tRectangle;
-        LineSegment* tLineSegment;
-
         if( aData != NULL )
         {
+            //the elements of a surface are usually all of one kind, so each list may need room for all of them
+            const size_t tCount = aData->Elements()->size();
+            fTriangles.reserve( fTriangles.size() + tCount );
+            fRectangles.reserve( fRectangles.size() + tCount );
+            fLineSegments.reserve( fLineSegments.size() + tCount );
+
             for( vector< KGMeshElement* >::iterator tElementIt = aData->Elements()->begin(); tElementIt != aData->Elements()->end(); tElementIt++ )
             {
                 tMeshElement = *tElementIt;
@@ -241,27 +220,24 @@ namespace KGeoBag
                 tMeshTriangle = dynamic_cast< KGMeshTriangle* >( tMeshElement );
                 if( (tMeshTriangle != NULL) && (tMeshTriangle->Area() > fMinimumArea) &&  (tMeshTriangle->Aspect() < fMaximumAspectRatio) )
                 {
-                    tTriangle = new Triangle();
-                    tTriangle->SetValues( LocalToInternal( tMeshTriangle->GetP0() ), LocalToInternal( tMeshTriangle->GetP1() ), LocalToInternal( tMeshTriangle->GetP2() ) );
-                    fTriangles.push_back( tTriangle );
+                    fTriangles.push_back( Triangle() );
+                    fTriangles.back().SetValues( LocalToInternal( tMeshTriangle->GetP0() ), LocalToInternal( tMeshTriangle->GetP1() ), LocalToInternal( tMeshTriangle->GetP2() ) );
                     continue;
                 }
 
                 tMeshRectangle = dynamic_cast< KGMeshRectangle* >( tMeshElement );
                 if( (tMeshRectangle != NULL) && (tMeshRectangle->Area() > fMinimumArea) && (tMeshRectangle->Aspect() < fMaximumAspectRatio) )
                 {
-                    tRectangle = new Rectangle();
-                    tRectangle->SetValues( LocalToInternal( tMeshRectangle->GetP0() ), LocalToInternal( tMeshRectangle->GetP1() ), LocalToInternal( tMeshRectangle->GetP2() ), LocalToInternal( tMeshRectangle->GetP3() ) );
-                    fRectangles.push_back( tRectangle );
+                    fRectangles.push_back( Rectangle() );
+                    fRectangles.back().SetValues( LocalToInternal( tMeshRectangle->GetP0() ), LocalToInternal( tMeshRectangle->GetP1() ), LocalToInternal( tMeshRectangle->GetP2() ), LocalToInternal( tMeshRectangle->GetP3() ) );
                     continue;
                 }
 
                 tMeshWire = dynamic_cast< KGMeshWire* >( tMeshElement );
                 if( (tMeshWire != NULL) && (tMeshWire->Area() > fMinimumArea) && (tMeshWire->Aspect() < fMaximumAspectRatio))
                 {
-                    tLineSegment = new LineSegment();
-                    tLineSegment->SetValues( LocalToInternal( tMeshWire->GetP0() ), LocalToInternal( tMeshWire->GetP1() ), tMeshWire->GetDiameter() );
-                    fLineSegments.push_back( tLineSegment );
+                    fLineSegments.push_back( LineSegment() );
+                    fLineSegments.back().SetValues( LocalToInternal( tMeshWire->GetP0() ), LocalToInternal( tMeshWire->GetP1() ), tMeshWire->GetDiameter() );
                     continue;
                 }
             }
@@ -298,9 +274,6 @@ namespace KGeoBag
         KGAxialMeshLoop* tAxialMeshLoop;
         KGAxialMeshRing* tAxialMeshRing;
 
-        ConicSection* tConicSection;
-        Ring* tRing;
-
         if( aData != NULL )
         {
             //cout << "adding axial mesh surface..." << endl;
@@ -315,6 +288,10 @@ namespace KGeoBag
                 return;
             }
 
+            const size_t tCount = aData->Elements()->size();
+            fConicSections.reserve( fConicSections.size() + tCount );
+            fRings.reserve( fRings.size() + tCount );
+
             for( vector< KGAxialMeshElement* >::iterator tElementIt = aData->Elements()->begin(); tElementIt != aData->Elements()->end(); tElementIt++ )
             {
                 tAxialMeshElement = *tElementIt;
@@ -322,18 +299,16 @@ namespace KGeoBag
                 tAxialMeshLoop = dynamic_cast< KGAxialMeshLoop* >( tAxialMeshElement );
                 if( (tAxialMeshLoop != NULL) && (tAxialMeshLoop->Area() > fMinimumArea) )
                 {
-                    tConicSection = new ConicSection();
-                    tConicSection->SetValues( LocalToInternal( tAxialMeshLoop->GetP0() ), LocalToInternal( tAxialMeshLoop->GetP1() ) );
-                    fConicSections.push_back( tConicSection );
+                    fConicSections.push_back( ConicSection() );
+                    fConicSections.back().SetValues( LocalToInternal( tAxialMeshLoop->GetP0() ), LocalToInternal( tAxialMeshLoop->GetP1() ) );
                     continue;
                 }
 
                 tAxialMeshRing = dynamic_cast< KGAxialMeshRing* >( tAxialMeshElement );
                 if( (tAxialMeshRing != NULL) && (tAxialMeshRing->Area() > fMinimumArea) )
                 {
-                    tRing = new Ring();
-                    tRing->SetValues( LocalToInternal( tAxialMeshRing->GetP0() ) );
-                    fRings.push_back( tRing );
+                    fRings.push_back( Ring() );
+                    fRings.back().SetValues( LocalToInternal( tAxialMeshRing->GetP0() ) );
                     continue;
                 }
             }
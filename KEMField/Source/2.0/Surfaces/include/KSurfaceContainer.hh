@@ -2,6 +2,7 @@
 #define KSURFACECONTAINER_DEF
 
 #include <vector>
+#include <map>
 
 #include "KSurface.hh"
 #include "KSmartPointer.hh"
@@ -139,6 +140,59 @@ namespace KEMField
       SmartDataPointer fData;
     };
 
+/**
+* @class KSurfaceContainer::KSurfaceBlock
+*
+* @brief A block of surfaces that are allocated together.
+*
+* Surfaces that are added to the container through a block are stored by
+* value in a single allocation instead of being allocated one by one.  The
+* container takes ownership of the block and releases it as a whole in
+* clear(); surfaces of a block are never deleted individually.
+*/
+
+    class KSurfaceBlock
+    {
+    public:
+      KSurfaceBlock() {}
+      virtual ~KSurfaceBlock() {}
+
+      virtual unsigned int size() const = 0;
+      virtual KSurfacePrimitive* at(unsigned int i) = 0;
+
+      // address range of the stored surfaces
+      virtual const char* Begin() const = 0;
+      virtual const char* End() const = 0;
+    };
+
+    template <class Surface>
+    class KSurfaceBlockOf : public KSurfaceBlock
+    {
+    public:
+      KSurfaceBlockOf(unsigned int capacity) { fSurfaces.reserve(capacity); }
+      virtual ~KSurfaceBlockOf() {}
+
+      // the capacity is fixed, since growing the block would move the surfaces
+      bool push_back(const Surface& aSurface)
+      {
+	if (fSurfaces.size() == fSurfaces.capacity())
+	  return false;
+	fSurfaces.push_back(aSurface);
+	return true;
+      }
+
+      unsigned int size() const { return fSurfaces.size(); }
+      KSurfacePrimitive* at(unsigned int i) { return &(fSurfaces.at(i)); }
+
+      const char* Begin() const
+      { return fSurfaces.empty() ? NULL : reinterpret_cast<const char*>(&(fSurfaces[0])); }
+      const char* End() const
+      { return fSurfaces.empty() ? NULL : reinterpret_cast<const char*>(&(fSurfaces[0]) + fSurfaces.size()); }
+
+    private:
+      std::vector<Surface> fSurfaces;
+    };
+
     KSurfaceContainer();
     virtual ~KSurfaceContainer();
 
@@ -150,6 +204,9 @@ namespace KEMField
     // Add a surface via pointer to base
     void push_back(KSurfacePrimitive* aSurface);
 
+    // Add all surfaces of a block, the container takes ownership of the block
+    void push_back(KSurfaceBlock* aBlock);
+
     //
     // Methods for querying types of the elements of the container:
     //
@@ -223,10 +280,15 @@ namespace KEMField
     template <class Policy>
     SmartDataPointer GetSurfaceData() const;
 
+    bool InBlock(const KSurfacePrimitive* aSurface) const;
+
     KSurfaceData fSurfaceData;
 
     bool fIsOwner;
 
+    std::vector<KSurfaceBlock*> fBlocks;
+    std::map<const char*,const char*> fBlockRanges;
+
     mutable SmartDataPointer fPartialSurfaceData[Length<KEMField::KBoundaryTypes>::value+1][Length<KEMField::KShapeTypes>::value+1];
 
     // Generalized streaming methods to facilitate recursive serialization (see
@@ -407,8 +469,10 @@ namespace KEMField
 	{
 	  if (fIsOwner)
 	  {
+	    // surfaces of a block are released with the block in clear()
 	    for (KSurfaceArrayIt arrayIt=(*it)->begin();arrayIt!=(*it)->end();++arrayIt)
-	      delete *arrayIt;
+	      if (!InBlock(*arrayIt))
+		delete *arrayIt;
 	  }
 	  (*it)->clear();
 	}
@@ -429,8 +493,10 @@ namespace KEMField
 	{
 	  if (fIsOwner)
 	  {
+	    // surfaces of a block are released with the block in clear()
 	    for (KSurfaceArrayIt arrayIt=(*it)->begin();arrayIt!=(*it)->end();++arrayIt)
-	      delete *arrayIt;
+	      if (!InBlock(*arrayIt))
+		delete *arrayIt;
 	  }
 	  (*it)->clear();
 	}
@@ -48,6 +48,30 @@ namespace KEMField
     fSurfaceData.push_back(new KSurfaceArray(1,aSurface));
   }
 
+  void KSurfaceContainer::push_back(KSurfaceBlock* aBlock)
+  {
+    fBlocks.push_back(aBlock);
+    if (aBlock->size() == 0)
+      return;
+
+    fBlockRanges[aBlock->Begin()] = aBlock->End();
+    for (unsigned int i=0;i<aBlock->size();i++)
+      push_back(aBlock->at(i));
+  }
+
+  bool KSurfaceContainer::InBlock(const KSurfacePrimitive* aSurface) const
+  {
+    if (fBlockRanges.empty())
+      return false;
+
+    const char* address = reinterpret_cast<const char*>(aSurface);
+    std::map<const char*,const char*>::const_iterator it = fBlockRanges.upper_bound(address);
+    if (it == fBlockRanges.begin())
+      return false;
+    --it;
+    return address < it->second;
+  }
+
   KSurfacePrimitive* KSurfaceContainer::FirstSurfaceType(unsigned int i) const
   {
     return (i<fSurfaceData.size() ? fSurfaceData.at(i)->at(0) : NULL);
@@ -122,11 +146,17 @@ namespace KEMField
     {
       if (fIsOwner)
 	for (arrayIt=(*dataIt)->begin();arrayIt!=(*dataIt)->end();++arrayIt)
-	  delete *arrayIt;
+	  if (!InBlock(*arrayIt))
+	    delete *arrayIt;
       (*dataIt)->clear();
       delete *dataIt;
     }
     fSurfaceData.clear();
+
+    for (std::vector<KSurfaceBlock*>::iterator blockIt=fBlocks.begin();blockIt!=fBlocks.end();++blockIt)
+      delete *blockIt;
+    fBlocks.clear();
+    fBlockRanges.clear();
   }
 
   KSurfaceContainer::SmartDataPointer KSurfaceContainer::GetSurfaceData() const
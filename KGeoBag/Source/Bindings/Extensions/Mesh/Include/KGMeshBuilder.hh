@@ -18,9 +18,13 @@ namespace KGeoBag
             void AddSurface( KGSurface* aSurface );
             void AddSpace( KGSpace* aSpace );
 
+            //number of threads used for meshing, one by default, zero selects the number of online processors
+            void SetNThreads( unsigned int aNumber );
+
         private:
             std::vector< KGSurface* > fSurfaces;
             std::vector< KGSpace* > fSpaces;
+            unsigned int fNThreads;
     };
 
 }
@@ -81,6 +85,11 @@ namespace katrin
             }
             return true;
         }
+        if( aContainer->GetName() == "threads" )
+        {
+            fObject->SetNThreads( aContainer->AsReference< unsigned int >() );
+            return true;
+        }
         return false;
     }
 
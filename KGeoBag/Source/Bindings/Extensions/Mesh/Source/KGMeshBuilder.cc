@@ -1,5 +1,5 @@
 #include "KGMeshBuilder.hh"
-#include "KGMesher.hh"
+#include "KGParallelMesher.hh"
 
 using namespace std;
 using namespace KGeoBag;
@@ -9,30 +9,34 @@ namespace KGeoBag
 
     KGMeshAttributor::KGMeshAttributor() :
             fSurfaces(),
-            fSpaces()
+            fSpaces(),
+            fNThreads( 1 )
     {
     }
 
     KGMeshAttributor::~KGMeshAttributor()
     {
-        KGMesher tMesher;
+        KGParallelMesher tMesher;
+        tMesher.SetNThreads( fNThreads );
 
         KGMeshSurface* tMeshSurface;
         for( vector< KGSurface* >::iterator tIt = fSurfaces.begin(); tIt != fSurfaces.end(); tIt++ )
         {
             tMeshSurface = (*tIt)->MakeExtension< KGMesh >();
-            (*tIt)->AcceptNode( &tMesher );
             tMeshSurface->SetName( GetName() );
             tMeshSurface->SetTags( GetTags() );
+            tMesher.AddSurface( *tIt );
         }
         KGMeshSpace* tMeshSpace;
         for( vector< KGSpace* >::iterator tIt = fSpaces.begin(); tIt != fSpaces.end(); tIt++ )
         {
             tMeshSpace = (*tIt)->MakeExtension< KGMesh >();
-            (*tIt)->AcceptNode( &tMesher );
             tMeshSpace->SetName( GetName() );
             tMeshSpace->SetTags( GetTags() );
+            tMesher.AddSpace( *tIt );
         }
+
+        tMesher.Mesh();
     }
 
     void KGMeshAttributor::AddSurface( KGSurface* aSurface )
@@ -45,6 +49,11 @@ namespace KGeoBag
         fSpaces.push_back( aSpace );
         return;
     }
+    void KGMeshAttributor::SetNThreads( unsigned int aNumber )
+    {
+        fNThreads = aNumber;
+        return;
+    }
 
 }
 
@@ -61,7 +70,8 @@ namespace katrin
     STATICINT sKGMeshStructure =
         KGMeshBuilder::Attribute< string >( "name" ) +
         KGMeshBuilder::Attribute< string >( "surfaces" ) +
-        KGMeshBuilder::Attribute< string >( "spaces" );
+        KGMeshBuilder::Attribute< string >( "spaces" ) +
+        KGMeshBuilder::Attribute< unsigned int >( "threads" );
 
     STATICINT sKGMesh =
       KGInterfaceBuilder::ComplexElement< KGMeshAttributor >( "mesh" );
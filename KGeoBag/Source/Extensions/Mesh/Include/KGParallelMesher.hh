@@ -0,0 +1,54 @@
+#ifndef KGeoBag_KGParallelMesher_hh_
+#define KGeoBag_KGParallelMesher_hh_
+
+#include "KGCore.hh"
+
+#include <map>
+#include <vector>
+#include <pthread.h>
+
+namespace KGeoBag
+{
+
+    //meshes a list of surfaces and spaces on several threads, each thread visits with its own mesher.
+    //surfaces and spaces that share an area or volume are meshed one after the other by the same thread,
+    //since meshing may initialize or modify the shared shape. the mesh extensions must already exist.
+    class KGParallelMesher
+    {
+        public:
+            KGParallelMesher();
+            virtual ~KGParallelMesher();
+
+        public:
+            //one by default, zero selects the number of online processors
+            void SetNThreads( unsigned int aNumber );
+            unsigned int GetNThreads() const;
+
+            void AddSurface( KGSurface* aSurface );
+            void AddSpace( KGSpace* aSpace );
+
+            void Mesh();
+
+        private:
+            class Group
+            {
+                public:
+                    std::vector< KGSurface* > fSurfaces;
+                    std::vector< KGSpace* > fSpaces;
+            };
+
+            Group& GetGroup( const void* aShape );
+
+            static void* MeshThread( void* aMesher );
+
+            unsigned int fNThreads;
+            std::vector< Group > fGroups;
+            std::map< const void*, unsigned int > fGroupIndices;
+
+            unsigned int fNextGroup;
+            pthread_mutex_t fGroupMutex;
+    };
+
+}
+
+#endif
@@ -8,6 +8,7 @@
 #include "KGMeshElement.hh"
 #include "KGIdentitySet.hh"
 #include "KGNavigableMeshElementContainer.hh"
+#include "KGNavigableMeshLeafBlock.hh"
 #include "KGSpaceTreeProperties.hh"
 
 
@@ -31,7 +32,8 @@ typedef KGCube< KGMESH_DIM > kg_mesh_cube;
 
 typedef KGSpaceTreeProperties< KGMESH_DIM > kg_mesh_tree_properties;
 
-typedef KGTYPELIST_4(kg_mesh_cube, kg_mesh_tree_properties, KGIdentitySet, KGNavigableMeshElementContainer) KGMeshNavigationNodeObjects;
+//leaf nodes may also carry a packed copy of their planar elements (attached by KGNavigableMeshLeafBlockBuilder)
+typedef KGTYPELIST_5(kg_mesh_cube, kg_mesh_tree_properties, KGIdentitySet, KGNavigableMeshElementContainer, KGNavigableMeshLeafBlock) KGMeshNavigationNodeObjects;
 
 typedef KGNode< KGMeshNavigationNodeObjects > KGMeshNavigationNode;
 
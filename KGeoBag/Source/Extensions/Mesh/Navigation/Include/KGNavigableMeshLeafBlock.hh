@@ -0,0 +1,100 @@
+#ifndef KGNavigableMeshLeafBlock_HH__
+#define KGNavigableMeshLeafBlock_HH__
+
+#include <vector>
+
+#include "KThreeVector.hh"
+
+#include "KGIdentitySet.hh"
+#include "KGNavigableMeshElementContainer.hh"
+
+//number of elements processed together by the packed kernels
+#define KGMESH_LEAF_BLOCK_WIDTH 4
+
+namespace KGeoBag
+{
+
+/*
+*
+*@file KGNavigableMeshLeafBlock.hh
+*@class KGNavigableMeshLeafBlock
+*@brief packed copy of the planar mesh elements of an octree leaf
+*@details
+* triangles and rectangles are stored as structure-of-arrays (origin, edge vectors,
+* unit normal and the dual basis of the edges), padded to a multiple of the block
+* width, so that the segment tests of a group of elements are evaluated
+* with branch free arithmetic the compiler can vectorize. wires are packed in the
+* same way (end point, axis and diameter) for the distance test only. elements without
+* a packed representation are listed separately and have to be tested through their
+* KGMeshElement. blocks are attached to the leaves by KGNavigableMeshLeafBlockBuilder
+* once the tree is complete.
+*
+*/
+
+class KGNavigableMeshLeafBlock
+{
+    public:
+        KGNavigableMeshLeafBlock();
+        virtual ~KGNavigableMeshLeafBlock();
+
+        void Fill(KGNavigableMeshElementContainer* container, const KGIdentitySet* element_list);
+
+        unsigned int GetNPackedElements() const {return fPackedIDs.size();};
+        const std::vector< unsigned int >* GetUnpackedElementIDs() const {return &fUnpackedIDs;};
+
+        unsigned int GetNPackedWires() const {return fWireIDs.size();};
+        //elements which neither the intersection nor the distance test covers
+        const std::vector< unsigned int >* GetGenericElementIDs() const {return &fGenericIDs;};
+
+        //finds the nearest intersection of the packed elements with the segment start + t*direction, t in [0, length],
+        //direction must be a unit vector, returns false if no packed element is intersected
+        bool FirstIntersection(const KThreeVector& start, const KThreeVector& direction, double length, double& distance, unsigned int& element_id) const;
+
+        //smallest KGMeshElement::NearestDistance of the packed planar elements and wires to the point,
+        //returns as soon as a distance below limit is found, infinity if the block has no packed element
+        double NearestDistance(const KThreeVector& point, double limit) const;
+
+    private:
+
+        enum
+        {
+            eP0X = 0, eP0Y, eP0Z,
+            eE1X, eE1Y, eE1Z,
+            eE2X, eE2Y, eE2Z,
+            eNX, eNY, eNZ,
+            eF1X, eF1Y, eF1Z,
+            eF2X, eF2Y, eF2Z,
+            eRectangle,
+            eValid,
+            eNRows
+        };
+
+        enum
+        {
+            eWP0X = 0, eWP0Y, eWP0Z,
+            eWDX, eWDY, eWDZ,
+            eWDiameter,
+            eWValid,
+            eNWireRows
+        };
+
+        const double* Row(unsigned int row) const {return &(fData[row*fNPadded]);};
+        double* Row(unsigned int row) {return &(fData[row*fNPadded]);};
+
+        const double* WireRow(unsigned int row) const {return &(fWireData[row*fNWiresPadded]);};
+        double* WireRow(unsigned int row) {return &(fWireData[row*fNWiresPadded]);};
+
+        unsigned int fNPadded;
+        std::vector< double > fData;
+        std::vector< unsigned int > fPackedIDs;
+        std::vector< unsigned int > fUnpackedIDs;
+
+        unsigned int fNWiresPadded;
+        std::vector< double > fWireData;
+        std::vector< unsigned int > fWireIDs;
+        std::vector< unsigned int > fGenericIDs;
+};
+
+}
+
+#endif /* KGNavigableMeshLeafBlock_HH__ */
@@ -0,0 +1,46 @@
+#ifndef KGNavigableMeshLeafBlockBuilder_HH__
+#define KGNavigableMeshLeafBlockBuilder_HH__
+
+#include "KGMeshNavigationNode.hh"
+
+#include "KGNodeActor.hh"
+#include "KGObjectRetriever.hh"
+#include "KGIdentitySet.hh"
+
+#include "KGNavigableMeshLeafBlock.hh"
+
+namespace KGeoBag
+{
+
+/*
+*
+*@file KGNavigableMeshLeafBlockBuilder.hh
+*@class KGNavigableMeshLeafBlockBuilder
+*@brief attaches the packed element data to every leaf of a finished tree
+*@details
+* has to be applied once after a tree has been constructed or restored, the blocks
+* are owned by the leaf nodes. the navigation actors only read them, so a tree may be
+* searched by several actors at once.
+*
+*/
+
+class KGNavigableMeshLeafBlockBuilder: public KGNodeActor< KGMeshNavigationNode >
+{
+    public:
+        KGNavigableMeshLeafBlockBuilder():fContainer(NULL){};
+        virtual ~KGNavigableMeshLeafBlockBuilder(){};
+
+        void SetMeshElementContainer(KGNavigableMeshElementContainer* container){fContainer = container;};
+
+        virtual void ApplyAction( KGMeshNavigationNode* node);
+
+    private:
+
+        KGNavigableMeshElementContainer* fContainer;
+
+};
+
+
+}
+
+#endif /* KGNavigableMeshLeafBlockBuilder_H__ */
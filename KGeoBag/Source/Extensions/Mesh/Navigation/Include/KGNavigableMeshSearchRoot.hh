@@ -0,0 +1,53 @@
+#ifndef KGNavigableMeshSearchRoot_H__
+#define KGNavigableMeshSearchRoot_H__
+
+#include <vector>
+
+#include "KThreeVector.hh"
+
+#include "KGCube.hh"
+#include "KGMeshNavigationNode.hh"
+#include "KGNavigableMeshTree.hh"
+
+namespace KGeoBag
+{
+
+/**
+*
+*@file KGNavigableMeshSearchRoot.hh
+*@class KGNavigableMeshSearchRoot
+*@brief finds the deepest node of a navigation tree which fully contains a ball
+*@details
+*the path from the root node to the last result is kept, so that a query for a ball close to the previous one
+*only climbs up until the ball fits and descends from there, instead of starting at the root node
+*
+*/
+
+class KGNavigableMeshSearchRoot
+{
+    public:
+        KGNavigableMeshSearchRoot();
+        virtual ~KGNavigableMeshSearchRoot();
+
+        //setting the tree forgets the cached path
+        void SetTree(KGNavigableMeshTree* tree);
+        void Clear();
+
+        //returns the root node if the ball is not contained in the world cube
+        KGMeshNavigationNode* Find(const KThreeVector& center, double radius);
+
+        //depth of the node the last search descended from, zero if it had to start at the root node
+        unsigned int GetStartDepth() const {return fStartDepth;};
+
+        static bool BallInsideNode(const KThreeVector& center, double radius, KGMeshNavigationNode* node);
+
+    private:
+
+        KGNavigableMeshTree* fTree;
+        std::vector< KGMeshNavigationNode* > fPath;
+        unsigned int fStartDepth;
+};
+
+}
+
+#endif /* end of include guard: KGNavigableMeshSearchRoot_H__ */
@@ -3,6 +3,11 @@
 
 #include "KGNavigableMeshTree.hh"
 #include "KGNavigableMeshElementContainer.hh"
+#include "KGSubdivisionCondition.hh"
+#include "KGNavigableMeshElementSorter.hh"
+
+#include <vector>
+#include <pthread.h>
 
 
 namespace KGeoBag
@@ -28,6 +33,10 @@ class KGNavigableMeshTreeBuilder
         void SetNAllowedElements(unsigned int n){fNAllowedElements = n;};
         unsigned GetNAllowedElements() const {return fNAllowedElements;};
 
+        //number of threads used to subdivide independent sub-trees, zero selects the number of online processors
+        void SetNThreads(unsigned int n){fNThreads = n;};
+        unsigned int GetNThreads() const {return fNThreads;};
+
         //access to the region tree, tree builder does not own the tree!
         void SetTree(KGNavigableMeshTree* tree);
         KGNavigableMeshTree* GetTree();
@@ -43,6 +52,29 @@ class KGNavigableMeshTreeBuilder
         void ConstructRootNode();
         void PerformSpatialSubdivision();
 
+        //the actors needed to subdivide a node, every thread owns its own set
+        class Subdivider
+        {
+            public:
+                Subdivider(KGNavigableMeshElementContainer* container, unsigned int n_allowed);
+
+                //subdivides a single node and distributes its elements to the children,
+                //returns true if children were created
+                bool Apply(KGMeshNavigationNode* node);
+
+            private:
+                KGSubdivisionCondition fCondition;
+                KGSpaceNodeProgenitor<KGMESH_DIM, KGMeshNavigationNodeObjects> fProgenitor;
+                KGNavigableMeshElementSorter fSorter;
+        };
+
+        void SubdivideRecursively(KGMeshNavigationNode* node, Subdivider& subdivider);
+
+        //assigns node ids in breadth first order and restores the shared tree properties
+        void EnumerateNodes();
+
+        static void* SubdivisionThread(void* builder);
+
         bool fUseAuto; //default is true
         bool fUseSpatialResolution;
         double fSpatialResolution;
@@ -57,6 +89,13 @@ class KGNavigableMeshTreeBuilder
         //container to the mesh elements
         KGNavigableMeshElementContainer* fContainer;
 
+        //nodes whose sub-trees are still to be built by the worker threads
+        std::vector< KGMeshNavigationNode* > fPendingNodes;
+        unsigned int fNextPendingNode;
+        pthread_mutex_t fPendingMutex;
+
+        unsigned int fNThreads;
+
         std::string fInfoString;
 };
 
@@ -276,33 +276,39 @@ KGNavigableMeshFirstIntersectionFinder::ApplyAction(KGMeshNavigationNode* node)
                     double min_distance = std::numeric_limits<double>::max();
                     double dist;
 
-                    unsigned int n_elem = element_list->GetSize();
+                    //triangles and rectangles are tested together on the packed leaf data,
+                    //which the tree builder attaches to every leaf
+                    const KGNavigableMeshLeafBlock* block = KGObjectRetriever<KGMeshNavigationNodeObjects, KGNavigableMeshLeafBlock >::GetNodeObject(fTempNode);
+                    unsigned int packed_id;
+                    if( block != NULL && block->FirstIntersection(fStartPoint, fDirection, fLength, dist, packed_id) )
+                    {
+                        min_distance = dist;
+                        fFirstIntersection = fStartPoint + dist*fDirection;
+                        fIntersectedElement = fContainer->GetElement(packed_id);
+                        fHaveIntersection = true;
+                    }
+
+                    //the remaining elements (all of them if the leaf has no block) are tested individually
+                    const std::vector< unsigned int >* unpacked_ids = (block != NULL) ? block->GetUnpackedElementIDs() : NULL;
+                    unsigned int n_elem = (block != NULL) ? unpacked_ids->size() : element_list->GetSize();
                     for(unsigned int i=0; i<n_elem; i++)
                     {
+                        unsigned int id = (block != NULL) ? (*unpacked_ids)[i] : element_list->GetID(i);
+
                         //first check if the line intersects the bounding ball of the element
-                        KGBall<KGMESH_DIM> bball = fContainer->GetElementBoundingBall(element_list->GetID(i));
+                        KGBall<KGMESH_DIM> bball = fContainer->GetElementBoundingBall(id);
                         double lin_seg_to_bball = LineSegmentDistanceToPoint( KThreeVector(bball.GetCenter()) );
                         if(lin_seg_to_bball <= bball.GetRadius())
                         {
-                            bool inter = fContainer->GetElement(element_list->GetID(i))->GetMeshElement()->NearestIntersection(fStartPoint, fEndPoint, anIntersection);
+                            bool inter = fContainer->GetElement(id)->GetMeshElement()->NearestIntersection(fStartPoint, fEndPoint, anIntersection);
                             if(inter)
                             {
-                                if(fHaveIntersection)
-                                {
-                                    dist = (anIntersection - fStartPoint).Magnitude();
-                                    if( dist < min_distance )
-                                    {
-                                        min_distance = dist;
-                                        fFirstIntersection = anIntersection;
-                                        fIntersectedElement = fContainer->GetElement(element_list->GetID(i));
-                                        fHaveIntersection = true;
-                                    }
-                                }
-                                else
+                                dist = (anIntersection - fStartPoint).Magnitude();
+                                if( !fHaveIntersection || dist < min_distance )
                                 {
-                                    min_distance = (anIntersection - fStartPoint).Magnitude();
+                                    min_distance = dist;
                                     fFirstIntersection = anIntersection;
-                                    fIntersectedElement = fContainer->GetElement(element_list->GetID(i));
+                                    fIntersectedElement = fContainer->GetElement(id);
                                     fHaveIntersection = true;
                                 }
                             }
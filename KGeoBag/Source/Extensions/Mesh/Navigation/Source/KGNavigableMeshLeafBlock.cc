@@ -0,0 +1,332 @@
+#include "KGNavigableMeshLeafBlock.hh"
+
+#include "KGMeshTriangle.hh"
+#include "KGMeshRectangle.hh"
+#include "KGMeshWire.hh"
+
+#include <cmath>
+#include <limits>
+
+//same tolerance as used by the triangle and rectangle intersection tests
+#define KGMESH_LEAF_BLOCK_PARALLEL_EPS 1e-6
+
+namespace KGeoBag
+{
+
+KGNavigableMeshLeafBlock::KGNavigableMeshLeafBlock():
+    fNPadded(0),
+    fNWiresPadded(0)
+{
+}
+
+KGNavigableMeshLeafBlock::~KGNavigableMeshLeafBlock()
+{
+}
+
+void
+KGNavigableMeshLeafBlock::Fill(KGNavigableMeshElementContainer* container, const KGIdentitySet* element_list)
+{
+    fPackedIDs.clear();
+    fUnpackedIDs.clear();
+    fWireIDs.clear();
+    fGenericIDs.clear();
+
+    //collect the edge representation of all planar elements
+    std::vector< KThreeVector > origins;
+    std::vector< KThreeVector > first_edges;
+    std::vector< KThreeVector > second_edges;
+    std::vector< double > is_rectangle;
+    std::vector< const KGMeshWire* > wires;
+
+    unsigned int n_elem = (element_list != NULL) ? element_list->GetSize() : 0;
+    for(unsigned int i=0; i<n_elem; i++)
+    {
+        unsigned int id = element_list->GetID(i);
+        KGNavigableMeshElement* element = container->GetElement(id);
+
+        KThreeVector p0, e1, e2;
+        double rectangle = 0.0;
+        if( element->GetMeshElementType() == KGMESH_TRIANGLE_ID )
+        {
+            const KGMeshTriangle* triangle = static_cast< const KGMeshTriangle* >( element->GetMeshElement() );
+            p0 = triangle->GetP0();
+            e1 = triangle->GetA()*triangle->GetN1();
+            e2 = triangle->GetB()*triangle->GetN2();
+        }
+        else if( element->GetMeshElementType() == KGMESH_RECTANGLE_ID )
+        {
+            const KGMeshRectangle* rectangle_element = static_cast< const KGMeshRectangle* >( element->GetMeshElement() );
+            p0 = rectangle_element->GetP0();
+            e1 = rectangle_element->GetA()*rectangle_element->GetN1();
+            e2 = rectangle_element->GetB()*rectangle_element->GetN2();
+            rectangle = 1.0;
+        }
+        else
+        {
+            fUnpackedIDs.push_back(id);
+            const KGMeshWire* wire = (element->GetMeshElementType() == KGMESH_WIRE_ID) ? static_cast< const KGMeshWire* >( element->GetMeshElement() ) : NULL;
+            if( wire != NULL && (wire->GetP1() - wire->GetP0()).MagnitudeSquared() > 0.0 )
+            {
+                fWireIDs.push_back(id);
+                wires.push_back(wire);
+            }
+            else
+            {
+                fGenericIDs.push_back(id);
+            }
+            continue;
+        }
+
+        if( e1.Cross(e2).Magnitude() <= 0.0 )
+        {
+            //degenerate, leave it to the element itself
+            fUnpackedIDs.push_back(id);
+            fGenericIDs.push_back(id);
+            continue;
+        }
+
+        fPackedIDs.push_back(id);
+        origins.push_back(p0);
+        first_edges.push_back(e1);
+        second_edges.push_back(e2);
+        is_rectangle.push_back(rectangle);
+    }
+
+    //pad to a multiple of the block width, padding lanes are marked invalid
+    unsigned int n_packed = fPackedIDs.size();
+    fNPadded = KGMESH_LEAF_BLOCK_WIDTH*( (n_packed + KGMESH_LEAF_BLOCK_WIDTH - 1)/KGMESH_LEAF_BLOCK_WIDTH );
+    fData.assign(eNRows*fNPadded, 0.0);
+
+    for(unsigned int i=0; i<n_packed; i++)
+    {
+        const KThreeVector& p0 = origins[i];
+        const KThreeVector& e1 = first_edges[i];
+        const KThreeVector& e2 = second_edges[i];
+        KThreeVector n = e1.Cross(e2).Unit();
+
+        //dual basis of the edges in the element plane, so that u = f1*(x - p0) and v = f2*(x - p0)
+        KThreeVector f1 = e2.Cross(n);
+        f1 = f1/(e1.Dot(f1));
+        KThreeVector f2 = n.Cross(e1);
+        f2 = f2/(e2.Dot(f2));
+
+        for(unsigned int k=0; k<3; k++)
+        {
+            Row(eP0X + k)[i] = p0[k];
+            Row(eE1X + k)[i] = e1[k];
+            Row(eE2X + k)[i] = e2[k];
+            Row(eNX + k)[i] = n[k];
+            Row(eF1X + k)[i] = f1[k];
+            Row(eF2X + k)[i] = f2[k];
+        }
+        Row(eRectangle)[i] = is_rectangle[i];
+        Row(eValid)[i] = 1.0;
+    }
+
+    unsigned int n_wires = fWireIDs.size();
+    fNWiresPadded = KGMESH_LEAF_BLOCK_WIDTH*( (n_wires + KGMESH_LEAF_BLOCK_WIDTH - 1)/KGMESH_LEAF_BLOCK_WIDTH );
+    fWireData.assign(eNWireRows*fNWiresPadded, 0.0);
+
+    for(unsigned int i=0; i<n_wires; i++)
+    {
+        KThreeVector axis = wires[i]->GetP1() - wires[i]->GetP0();
+        for(unsigned int k=0; k<3; k++)
+        {
+            WireRow(eWP0X + k)[i] = wires[i]->GetP0()[k];
+            WireRow(eWDX + k)[i] = axis[k];
+        }
+        WireRow(eWDiameter)[i] = wires[i]->GetDiameter();
+        WireRow(eWValid)[i] = 1.0;
+    }
+}
+
+bool
+KGNavigableMeshLeafBlock::FirstIntersection(const KThreeVector& start, const KThreeVector& direction, double length, double& distance, unsigned int& element_id) const
+{
+    const double inf = std::numeric_limits<double>::infinity();
+
+    const double sx = start[0]; const double sy = start[1]; const double sz = start[2];
+    const double vx = direction[0]; const double vy = direction[1]; const double vz = direction[2];
+
+    const double* p0x = Row(eP0X); const double* p0y = Row(eP0Y); const double* p0z = Row(eP0Z);
+    const double* nx = Row(eNX); const double* ny = Row(eNY); const double* nz = Row(eNZ);
+    const double* f1x = Row(eF1X); const double* f1y = Row(eF1Y); const double* f1z = Row(eF1Z);
+    const double* f2x = Row(eF2X); const double* f2y = Row(eF2Y); const double* f2z = Row(eF2Z);
+    const double* rect = Row(eRectangle);
+    const double* valid = Row(eValid);
+
+    double best = inf;
+    unsigned int best_index = 0;
+
+    double t_lane[KGMESH_LEAF_BLOCK_WIDTH];
+    for(unsigned int offset=0; offset<fNPadded; offset += KGMESH_LEAF_BLOCK_WIDTH)
+    {
+        for(unsigned int lane=0; lane<KGMESH_LEAF_BLOCK_WIDTH; lane++)
+        {
+            unsigned int i = offset + lane;
+
+            //distance along the segment to the element plane
+            double ndotv = nx[i]*vx + ny[i]*vy + nz[i]*vz;
+            double dx = sx - p0x[i];
+            double dy = sy - p0y[i];
+            double dz = sz - p0z[i];
+            bool parallel = std::fabs(ndotv) < KGMESH_LEAF_BLOCK_PARALLEL_EPS;
+            double t = -1.0*(nx[i]*dx + ny[i]*dy + nz[i]*dz)/(parallel ? 1.0 : ndotv);
+
+            //edge coordinates of the plane intersection
+            double rx = dx + t*vx;
+            double ry = dy + t*vy;
+            double rz = dz + t*vz;
+            double u = f1x[i]*rx + f1y[i]*ry + f1z[i]*rz;
+            double v = f2x[i]*rx + f2y[i]*ry + f2z[i]*rz;
+
+            bool hit = (valid[i] != 0.0) && !parallel && (t >= 0.0) && (t <= length) &&
+                       (u >= 0.0) && (v >= 0.0) && (u <= 1.0) && (v <= 1.0) && (u + v <= 1.0 + rect[i]);
+            t_lane[lane] = hit ? t : inf;
+        }
+
+        //horizontal minimum over the lanes
+        for(unsigned int lane=0; lane<KGMESH_LEAF_BLOCK_WIDTH; lane++)
+        {
+            if(t_lane[lane] < best)
+            {
+                best = t_lane[lane];
+                best_index = offset + lane;
+            }
+        }
+    }
+
+    if(best == inf)
+    {
+        return false;
+    }
+
+    distance = best;
+    element_id = fPackedIDs[best_index];
+    return true;
+}
+
+double
+KGNavigableMeshLeafBlock::NearestDistance(const KThreeVector& point, double limit) const
+{
+    const double inf = std::numeric_limits<double>::infinity();
+
+    const double cx = point[0]; const double cy = point[1]; const double cz = point[2];
+
+    const double* p0x = Row(eP0X); const double* p0y = Row(eP0Y); const double* p0z = Row(eP0Z);
+    const double* e1x = Row(eE1X); const double* e1y = Row(eE1Y); const double* e1z = Row(eE1Z);
+    const double* e2x = Row(eE2X); const double* e2y = Row(eE2Y); const double* e2z = Row(eE2Z);
+    const double* nx = Row(eNX); const double* ny = Row(eNY); const double* nz = Row(eNZ);
+    const double* f1x = Row(eF1X); const double* f1y = Row(eF1Y); const double* f1z = Row(eF1Z);
+    const double* f2x = Row(eF2X); const double* f2y = Row(eF2Y); const double* f2z = Row(eF2Z);
+    const double* rect = Row(eRectangle);
+    const double* valid = Row(eValid);
+
+    double best = inf;
+    double d_lane[KGMESH_LEAF_BLOCK_WIDTH];
+    for(unsigned int offset=0; offset<fNPadded; offset += KGMESH_LEAF_BLOCK_WIDTH)
+    {
+        for(unsigned int lane=0; lane<KGMESH_LEAF_BLOCK_WIDTH; lane++)
+        {
+            unsigned int i = offset + lane;
+            double r = rect[i];
+            double s = 1.0 - r;
+
+            //height above the plane and edge coordinates of the projection
+            double dx = cx - p0x[i];
+            double dy = cy - p0y[i];
+            double dz = cz - p0z[i];
+            double h = nx[i]*dx + ny[i]*dy + nz[i]*dz;
+            double u = f1x[i]*dx + f1y[i]*dy + f1z[i]*dz;
+            double v = f2x[i]*dx + f2y[i]*dy + f2z[i]*dz;
+            bool inside = (u >= 0.0) && (v >= 0.0) && (u <= 1.0) && (v <= 1.0) && (u + v <= 1.0 + r);
+
+            //the boundary is traversed as four edges, for triangles the last edge is repeated
+            //edge 0: p0 -> p0 + e1
+            //edge 1: p0 + e1 -> p0 + e2 (+ e1 for rectangles)
+            //edge 2: p0 + e2 (+ e1) -> p0 + e2 (rectangles) or p0 (triangles)
+            //edge 3: p0 + e2 -> p0
+            double ax[4], ay[4], az[4], ex[4], ey[4], ez[4];
+            ax[0] = 0.0; ay[0] = 0.0; az[0] = 0.0;
+            ex[0] = e1x[i]; ey[0] = e1y[i]; ez[0] = e1z[i];
+            ax[1] = e1x[i]; ay[1] = e1y[i]; az[1] = e1z[i];
+            ex[1] = e2x[i] - s*e1x[i]; ey[1] = e2y[i] - s*e1y[i]; ez[1] = e2z[i] - s*e1z[i];
+            ax[2] = e2x[i] + r*e1x[i]; ay[2] = e2y[i] + r*e1y[i]; az[2] = e2z[i] + r*e1z[i];
+            ex[2] = -1.0*(s*e2x[i] + r*e1x[i]); ey[2] = -1.0*(s*e2y[i] + r*e1y[i]); ez[2] = -1.0*(s*e2z[i] + r*e1z[i]);
+            ax[3] = e2x[i]; ay[3] = e2y[i]; az[3] = e2z[i];
+            ex[3] = -1.0*e2x[i]; ey[3] = -1.0*e2y[i]; ez[3] = -1.0*e2z[i];
+
+            double edge_d2 = inf;
+            for(unsigned int k=0; k<4; k++)
+            {
+                double wx = dx - ax[k];
+                double wy = dy - ay[k];
+                double wz = dz - az[k];
+                double ee = ex[k]*ex[k] + ey[k]*ey[k] + ez[k]*ez[k];
+                double t = (wx*ex[k] + wy*ey[k] + wz*ez[k])/(ee > 0.0 ? ee : 1.0);
+                t = (t < 0.0) ? 0.0 : ( (t > 1.0) ? 1.0 : t );
+                wx -= t*ex[k];
+                wy -= t*ey[k];
+                wz -= t*ez[k];
+                double d2 = wx*wx + wy*wy + wz*wz;
+                edge_d2 = (d2 < edge_d2) ? d2 : edge_d2;
+            }
+
+            double d = std::sqrt(inside ? h*h : edge_d2);
+            d_lane[lane] = (valid[i] != 0.0) ? d : inf;
+        }
+
+        //horizontal minimum over the lanes
+        for(unsigned int lane=0; lane<KGMESH_LEAF_BLOCK_WIDTH; lane++)
+        {
+            best = (d_lane[lane] < best) ? d_lane[lane] : best;
+        }
+        if(best < limit)
+        {
+            return best;
+        }
+    }
+
+    const double* wp0x = WireRow(eWP0X); const double* wp0y = WireRow(eWP0Y); const double* wp0z = WireRow(eWP0Z);
+    const double* wdx = WireRow(eWDX); const double* wdy = WireRow(eWDY); const double* wdz = WireRow(eWDZ);
+    const double* diameter = WireRow(eWDiameter);
+    const double* wvalid = WireRow(eWValid);
+
+    for(unsigned int offset=0; offset<fNWiresPadded; offset += KGMESH_LEAF_BLOCK_WIDTH)
+    {
+        for(unsigned int lane=0; lane<KGMESH_LEAF_BLOCK_WIDTH; lane++)
+        {
+            unsigned int i = offset + lane;
+
+            //distance to the axis segment, the diameter is only subtracted between the end points
+            //(see KGMeshWire::NearestDistance)
+            double dx = cx - wp0x[i];
+            double dy = cy - wp0y[i];
+            double dz = cz - wp0z[i];
+            double dd = wdx[i]*wdx[i] + wdy[i]*wdy[i] + wdz[i]*wdz[i];
+            double t = (dx*wdx[i] + dy*wdy[i] + dz*wdz[i])/(dd > 0.0 ? dd : 1.0);
+            bool between = (t >= 0.0) && (t <= 1.0);
+            t = (t < 0.0) ? 0.0 : ( (t > 1.0) ? 1.0 : t );
+            dx -= t*wdx[i];
+            dy -= t*wdy[i];
+            dz -= t*wdz[i];
+            double d = std::sqrt(dx*dx + dy*dy + dz*dz);
+            double surface = (d < diameter[i]) ? 0.0 : d - diameter[i];
+            d = between ? surface : d;
+            d_lane[lane] = (wvalid[i] != 0.0) ? d : inf;
+        }
+
+        for(unsigned int lane=0; lane<KGMESH_LEAF_BLOCK_WIDTH; lane++)
+        {
+            best = (d_lane[lane] < best) ? d_lane[lane] : best;
+        }
+        if(best < limit)
+        {
+            return best;
+        }
+    }
+
+    return best;
+}
+
+}
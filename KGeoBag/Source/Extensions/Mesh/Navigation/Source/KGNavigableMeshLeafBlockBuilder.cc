@@ -0,0 +1,30 @@
+#include "KGNavigableMeshLeafBlockBuilder.hh"
+
+namespace KGeoBag
+{
+
+void
+KGNavigableMeshLeafBlockBuilder::ApplyAction( KGMeshNavigationNode* node)
+{
+    //replace any block left over from an earlier pass, the node owns it
+    KGNavigableMeshLeafBlock* block = KGObjectRetriever<KGMeshNavigationNodeObjects, KGNavigableMeshLeafBlock >::GetNodeObject(node);
+    delete block;
+    KGObjectRetriever<KGMeshNavigationNodeObjects, KGNavigableMeshLeafBlock >::SetNodeObject(NULL, node);
+
+    if(node->HasChildren())
+    {
+        return;
+    }
+
+    KGIdentitySet* element_list = KGObjectRetriever<KGMeshNavigationNodeObjects, KGIdentitySet >::GetNodeObject(node);
+    if(element_list == NULL || element_list->GetSize() == 0)
+    {
+        return;
+    }
+
+    block = new KGNavigableMeshLeafBlock();
+    block->Fill(fContainer, element_list);
+    KGObjectRetriever<KGMeshNavigationNodeObjects, KGNavigableMeshLeafBlock >::SetNodeObject(block, node);
+}
+
+}
@@ -197,10 +197,21 @@ KGNavigableMeshProximityCheck::ApplyAction(KGMeshNavigationNode* node)
             KGIdentitySet* element_list =
             KGObjectRetriever<KGMeshNavigationNodeObjects, KGIdentitySet >::GetNodeObject(fLeafNodes[i]);
 
-            unsigned int n_elem = element_list->GetSize();
+            //triangles, rectangles and wires are tested together on the packed leaf data
+            const KGNavigableMeshLeafBlock* block = KGObjectRetriever<KGMeshNavigationNodeObjects, KGNavigableMeshLeafBlock >::GetNodeObject(fLeafNodes[i]);
+            if( block != NULL && block->NearestDistance(fPoint, fRadius) < fRadius )
+            {
+                fSphereIntersectsMesh = true;
+                return;
+            }
+
+            //the remaining elements (all of them if the leaf has no block) are tested individually
+            const std::vector< unsigned int >* generic_ids = (block != NULL) ? block->GetGenericElementIDs() : NULL;
+            unsigned int n_elem = (block != NULL) ? generic_ids->size() : element_list->GetSize();
             for(unsigned int j=0; j<n_elem; j++)
             {
-                double edist = fContainer->GetElement(element_list->GetID(j))->GetMeshElement()->NearestDistance(fPoint);
+                unsigned int id = (block != NULL) ? (*generic_ids)[j] : element_list->GetID(j);
+                double edist = fContainer->GetElement(id)->GetMeshElement()->NearestDistance(fPoint);
                 if(edist < fRadius)
                 {
                     fSphereIntersectsMesh = true;
@@ -0,0 +1,102 @@
+#include "KGNavigableMeshSearchRoot.hh"
+
+namespace KGeoBag
+{
+
+KGNavigableMeshSearchRoot::KGNavigableMeshSearchRoot():
+    fTree(NULL),
+    fPath(),
+    fStartDepth(0)
+{
+}
+
+KGNavigableMeshSearchRoot::~KGNavigableMeshSearchRoot(){}
+
+void
+KGNavigableMeshSearchRoot::SetTree(KGNavigableMeshTree* tree)
+{
+    fTree = tree;
+    Clear();
+}
+
+void
+KGNavigableMeshSearchRoot::Clear()
+{
+    fPath.clear();
+    fStartDepth = 0;
+}
+
+KGMeshNavigationNode*
+KGNavigableMeshSearchRoot::Find(const KThreeVector& center, double radius)
+{
+    //climb up the cached path until the node contains the ball
+    while( !fPath.empty() && !BallInsideNode(center, radius, fPath.back()) )
+    {
+        fPath.pop_back();
+    }
+
+    if( fPath.empty() )
+    {
+        fStartDepth = 0;
+        KGMeshNavigationNode* root = fTree->GetRootNode();
+        if( root == NULL || !BallInsideNode(center, radius, root) )
+        {
+            //ball leaves the world cube, search the whole tree
+            return root;
+        }
+        fPath.push_back(root);
+    }
+    else
+    {
+        fStartDepth = fPath.size() - 1;
+    }
+
+    //descend as long as one of the children contains the ball
+    KGMeshNavigationNode* node = fPath.back();
+    while( node->HasChildren() )
+    {
+        KGMeshNavigationNode* next = NULL;
+        for(unsigned int i=0; i<8; i++)
+        {
+            KGMeshNavigationNode* child = node->GetChild(i);
+            if( child != NULL && BallInsideNode(center, radius, child) )
+            {
+                next = child;
+                break;
+            }
+        }
+
+        if(next == NULL)
+        {
+            break;
+        }
+
+        node = next;
+        fPath.push_back(node);
+    }
+
+    return node;
+}
+
+bool
+KGNavigableMeshSearchRoot::BallInsideNode(const KThreeVector& center, double radius, KGMeshNavigationNode* node)
+{
+    KGCube<KGMESH_DIM>* cube = KGObjectRetriever<KGMeshNavigationNodeObjects, KGCube<KGMESH_DIM> >::GetNodeObject(node);
+    if(cube == NULL)
+    {
+        return false;
+    }
+
+    KGPoint<KGMESH_DIM> cube_center = cube->GetCenter();
+    double len_over_two = cube->GetLength()/2.0;
+    for(unsigned int i=0; i<KGMESH_DIM; i++)
+    {
+        if( center[i] - radius < cube_center[i] - len_over_two || center[i] + radius > cube_center[i] + len_over_two )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
@@ -3,6 +3,10 @@
 #include "KGSubdivisionCondition.hh"
 #include "KGNavigableMeshElementSorter.hh"
 #include "KGNavigableMeshTreeInformationExtractor.hh"
+#include "KGNavigableMeshLeafBlockBuilder.hh"
+
+#include <queue>
+#include <unistd.h>
 
 #define KGBBALL_EPS 1e-14
 //#define KGNavigableMeshTreeBuilder_DEBUG__
@@ -16,12 +20,18 @@ KGNavigableMeshTreeBuilder::KGNavigableMeshTreeBuilder():
     fMaximumTreeDepth(0),
     fNAllowedElements(1),
     fTree(NULL),
-    fContainer(NULL)
+    fContainer(NULL),
+    fNextPendingNode(0),
+    fNThreads(0)
 {
     fInfoString = "";
+    pthread_mutex_init(&fPendingMutex, NULL);
 };
 
-KGNavigableMeshTreeBuilder::~KGNavigableMeshTreeBuilder(){};
+KGNavigableMeshTreeBuilder::~KGNavigableMeshTreeBuilder()
+{
+    pthread_mutex_destroy(&fPendingMutex);
+};
 
 void
 KGNavigableMeshTreeBuilder::SetNavigableMeshElementContainer(KGNavigableMeshElementContainer* container)
@@ -52,6 +62,11 @@ KGNavigableMeshTreeBuilder::ConstructTree()
 {
     ConstructRootNode();
     PerformSpatialSubdivision();
+
+    //pack the elements of the leaves once, the navigation actors only read them
+    KGNavigableMeshLeafBlockBuilder block_builder;
+    block_builder.SetMeshElementContainer(fContainer);
+    fTree->ApplyCorecursiveAction(&block_builder);
 }
 
 void
@@ -173,18 +188,76 @@ KGNavigableMeshTreeBuilder::ConstructRootNode()
 void
 KGNavigableMeshTreeBuilder::PerformSpatialSubdivision()
 {
-    //conditions for subdivision of a node
-    KGSubdivisionCondition sub_cond;
-    sub_cond.SetMeshElementContainer(fContainer);
-    sub_cond.SetNAllowedElements(fNAllowedElements);
-    fTree->SetSubdivisionCondition(&sub_cond);
+    unsigned int n_threads = fNThreads;
+    if(n_threads == 0)
+    {
+        long n_processors = sysconf(_SC_NPROCESSORS_ONLN);
+        n_threads = (n_processors > 0) ? n_processors : 1;
+    }
+
+    //the progenitor registers every new node with the tree properties, which is not thread safe,
+    //so the nodes are created with private copies and enumerated once the tree is complete
+    KGSpaceTreeProperties<KGMESH_DIM>* tree_prop = fTree->GetTreeProperties();
+    std::vector< KGSpaceTreeProperties<KGMESH_DIM>* > local_props;
+    local_props.push_back( new KGSpaceTreeProperties<KGMESH_DIM>(*tree_prop) );
+
+    KGMeshNavigationNode* root = fTree->GetRootNode();
+    KGObjectRetriever<KGMeshNavigationNodeObjects, KGSpaceTreeProperties<KGMESH_DIM> >::SetNodeObject(local_props.back(), root);
+
+    //subdivide the top levels breadth first, until there are enough independent sub-trees to keep all threads busy
+    std::vector< KGMeshNavigationNode* > frontier;
+    frontier.push_back(root);
+    if(n_threads > 1)
+    {
+        Subdivider subdivider(fContainer, fNAllowedElements);
+        while( !frontier.empty() && frontier.size() < 8*n_threads )
+        {
+            std::vector< KGMeshNavigationNode* > next_frontier;
+            for(unsigned int i=0; i<frontier.size(); i++)
+            {
+                if( subdivider.Apply(frontier[i]) )
+                {
+                    for(unsigned int j=0; j<frontier[i]->GetNChildren(); j++)
+                    {
+                        next_frontier.push_back( frontier[i]->GetChild(j) );
+                    }
+                }
+            }
+            frontier.swap(next_frontier);
+        }
+    }
+
+    fPendingNodes = frontier;
+    fNextPendingNode = 0;
+    for(unsigned int i=0; i<fPendingNodes.size(); i++)
+    {
+        local_props.push_back( new KGSpaceTreeProperties<KGMESH_DIM>(*tree_prop) );
+        KGObjectRetriever<KGMeshNavigationNodeObjects, KGSpaceTreeProperties<KGMESH_DIM> >::SetNodeObject(local_props.back(), fPendingNodes[i]);
+    }
 
-    //things to do on a node after it has been visited by the progenitor
-    KGNavigableMeshElementSorter element_sorter;
-    element_sorter.SetMeshElementContainer(fContainer);
-    fTree->AddPostSubdivisionAction(&element_sorter);
+    //build the remaining sub-trees in parallel
+    if(n_threads > fPendingNodes.size()){n_threads = fPendingNodes.size();};
+    std::vector< pthread_t > threads;
+    for(unsigned int i=1; i<n_threads; i++)
+    {
+        pthread_t thread;
+        if( pthread_create(&thread, NULL, &KGNavigableMeshTreeBuilder::SubdivisionThread, this) == 0 )
+        {
+            threads.push_back(thread);
+        }
+    }
+    SubdivisionThread(this);
+    for(unsigned int i=0; i<threads.size(); i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    fPendingNodes.clear();
 
-    fTree->ConstructTree();
+    EnumerateNodes();
+    for(unsigned int i=0; i<local_props.size(); i++)
+    {
+        delete local_props[i];
+    }
 
     KGNavigableMeshTreeInformationExtractor extractor;
     extractor.SetNElements(fContainer->GetNElements());
@@ -199,4 +272,95 @@ KGNavigableMeshTreeBuilder::PerformSpatialSubdivision()
 
 
 
+KGNavigableMeshTreeBuilder::Subdivider::Subdivider(KGNavigableMeshElementContainer* container, unsigned int n_allowed)
+{
+    fCondition.SetMeshElementContainer(container);
+    fCondition.SetNAllowedElements(n_allowed);
+    fSorter.SetMeshElementContainer(container);
+}
+
+bool
+KGNavigableMeshTreeBuilder::Subdivider::Apply(KGMeshNavigationNode* node)
+{
+    //same sequence of actions as the compound actor of the space tree
+    if( fCondition.ConditionIsSatisfied(node) )
+    {
+        fProgenitor.ApplyAction(node);
+    }
+    fSorter.ApplyAction(node);
+    return node->HasChildren();
+}
+
+void
+KGNavigableMeshTreeBuilder::SubdivideRecursively(KGMeshNavigationNode* node, Subdivider& subdivider)
+{
+    std::vector< KGMeshNavigationNode* > stack;
+    stack.push_back(node);
+    while( !stack.empty() )
+    {
+        KGMeshNavigationNode* current = stack.back();
+        stack.pop_back();
+        if( subdivider.Apply(current) )
+        {
+            for(unsigned int i=current->GetNChildren(); i>0; i--)
+            {
+                stack.push_back( current->GetChild(i-1) );
+            }
+        }
+    }
+}
+
+void*
+KGNavigableMeshTreeBuilder::SubdivisionThread(void* builder)
+{
+    KGNavigableMeshTreeBuilder* self = static_cast< KGNavigableMeshTreeBuilder* >(builder);
+    Subdivider subdivider(self->fContainer, self->fNAllowedElements);
+
+    while(true)
+    {
+        KGMeshNavigationNode* node = NULL;
+        pthread_mutex_lock(&(self->fPendingMutex));
+        if(self->fNextPendingNode < self->fPendingNodes.size())
+        {
+            node = self->fPendingNodes[self->fNextPendingNode];
+            self->fNextPendingNode++;
+        }
+        pthread_mutex_unlock(&(self->fPendingMutex));
+
+        if(node == NULL)
+        {
+            break;
+        }
+        self->SubdivideRecursively(node, subdivider);
+    }
+
+    return NULL;
+}
+
+void
+KGNavigableMeshTreeBuilder::EnumerateNodes()
+{
+    //the root node keeps the id it was registered with,
+    //all other nodes are numbered breadth first, independent of the thread count
+    KGSpaceTreeProperties<KGMESH_DIM>* tree_prop = fTree->GetTreeProperties();
+    std::queue< KGMeshNavigationNode* > node_queue;
+    node_queue.push( fTree->GetRootNode() );
+    while( !node_queue.empty() )
+    {
+        KGMeshNavigationNode* node = node_queue.front();
+        node_queue.pop();
+
+        KGObjectRetriever<KGMeshNavigationNodeObjects, KGSpaceTreeProperties<KGMESH_DIM> >::SetNodeObject(tree_prop, node);
+        if(node != fTree->GetRootNode())
+        {
+            node->SetID( tree_prop->RegisterNode() );
+        }
+
+        for(unsigned int i=0; i<node->GetNChildren(); i++)
+        {
+            node_queue.push( node->GetChild(i) );
+        }
+    }
+}
+
 }
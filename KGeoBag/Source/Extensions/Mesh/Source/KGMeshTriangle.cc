@@ -163,12 +163,13 @@ namespace KGeoBag
         KThreeVector ca = NearestPointOnLineSegment(fP0 + fB*fN2, fP0, aPoint);
         double dist_ca =  (ca - aPoint).Magnitude();
 
-        if( dist_ab < dist_bc && dist_ab < dist_ca)
+        //ties occur when the nearest point is a shared corner
+        if( dist_ab <= dist_bc && dist_ab <= dist_ca)
         {
             return ab;
         }
 
-        if( dist_bc < dist_ab && dist_bc < dist_ca)
+        if( dist_bc <= dist_ca)
         {
             return bc;
         }
@@ -301,7 +302,7 @@ namespace KGeoBag
     KGMeshTriangle::NearestPointOnLineSegment(const KThreeVector& a, const KThreeVector& b, const KThreeVector& point) const
     {
         KThreeVector diff = b - a;
-        double t = ((point - a)*diff);
+        double t = ((point - a)*diff)/(diff*diff);
         if(t < 0.){return a;};
         if(t > 1.){return b;};
         return a + t*diff;
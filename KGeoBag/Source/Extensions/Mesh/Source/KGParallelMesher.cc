@@ -0,0 +1,142 @@
+#include "KGParallelMesher.hh"
+#include "KGMesher.hh"
+
+#include <algorithm>
+#include <unistd.h>
+
+namespace KGeoBag
+{
+
+    KGParallelMesher::KGParallelMesher() :
+        fNThreads( 1 ),
+        fGroups(),
+        fGroupIndices(),
+        fNextGroup( 0 )
+    {
+        pthread_mutex_init( &fGroupMutex, NULL );
+    }
+    KGParallelMesher::~KGParallelMesher()
+    {
+        pthread_mutex_destroy( &fGroupMutex );
+    }
+
+    void KGParallelMesher::SetNThreads( unsigned int aNumber )
+    {
+        fNThreads = aNumber;
+        return;
+    }
+    unsigned int KGParallelMesher::GetNThreads() const
+    {
+        return fNThreads;
+    }
+
+    void KGParallelMesher::AddSurface( KGSurface* aSurface )
+    {
+        //a surface that is added twice is only meshed once
+        const KSmartPointer< KGArea >& tArea = aSurface->Area();
+        Group& tGroup = GetGroup( tArea.Null() ? NULL : &(*tArea) );
+        if( std::find( tGroup.fSurfaces.begin(), tGroup.fSurfaces.end(), aSurface ) == tGroup.fSurfaces.end() )
+        {
+            tGroup.fSurfaces.push_back( aSurface );
+        }
+        return;
+    }
+    void KGParallelMesher::AddSpace( KGSpace* aSpace )
+    {
+        const KSmartPointer< KGVolume >& tVolume = aSpace->Volume();
+        Group& tGroup = GetGroup( tVolume.Null() ? NULL : &(*tVolume) );
+        if( std::find( tGroup.fSpaces.begin(), tGroup.fSpaces.end(), aSpace ) == tGroup.fSpaces.end() )
+        {
+            tGroup.fSpaces.push_back( aSpace );
+        }
+        return;
+    }
+
+    KGParallelMesher::Group& KGParallelMesher::GetGroup( const void* aShape )
+    {
+        //objects without a shape have nothing to share
+        if( aShape == NULL )
+        {
+            fGroups.push_back( Group() );
+            return fGroups.back();
+        }
+
+        std::map< const void*, unsigned int >::iterator tIt = fGroupIndices.find( aShape );
+        if( tIt != fGroupIndices.end() )
+        {
+            return fGroups[ tIt->second ];
+        }
+        fGroupIndices[ aShape ] = fGroups.size();
+        fGroups.push_back( Group() );
+        return fGroups.back();
+    }
+
+    void KGParallelMesher::Mesh()
+    {
+        unsigned int tNThreads = fNThreads;
+        if( tNThreads == 0 )
+        {
+            long tNProcessors = sysconf( _SC_NPROCESSORS_ONLN );
+            tNThreads = (tNProcessors > 0) ? tNProcessors : 1;
+        }
+        if( tNThreads > fGroups.size() )
+        {
+            tNThreads = fGroups.size();
+        }
+
+        fNextGroup = 0;
+        std::vector< pthread_t > tThreads;
+        for( unsigned int tIndex = 1; tIndex < tNThreads; tIndex++ )
+        {
+            pthread_t tThread;
+            if( pthread_create( &tThread, NULL, &KGParallelMesher::MeshThread, this ) == 0 )
+            {
+                tThreads.push_back( tThread );
+            }
+        }
+        MeshThread( this );
+        for( unsigned int tIndex = 0; tIndex < tThreads.size(); tIndex++ )
+        {
+            pthread_join( tThreads[ tIndex ], NULL );
+        }
+
+        fGroups.clear();
+        fGroupIndices.clear();
+        return;
+    }
+
+    void* KGParallelMesher::MeshThread( void* aMesher )
+    {
+        KGParallelMesher* tSelf = static_cast< KGParallelMesher* >( aMesher );
+        KGMesher tMesher;
+
+        while( true )
+        {
+            Group* tGroup = NULL;
+            pthread_mutex_lock( &(tSelf->fGroupMutex) );
+            if( tSelf->fNextGroup < tSelf->fGroups.size() )
+            {
+                tGroup = &(tSelf->fGroups[ tSelf->fNextGroup ]);
+                tSelf->fNextGroup++;
+            }
+            pthread_mutex_unlock( &(tSelf->fGroupMutex) );
+
+            if( tGroup == NULL )
+            {
+                break;
+            }
+
+            for( std::vector< KGSurface* >::iterator tIt = tGroup->fSurfaces.begin(); tIt != tGroup->fSurfaces.end(); tIt++ )
+            {
+                (*tIt)->AcceptNode( &tMesher );
+            }
+            for( std::vector< KGSpace* >::iterator tIt = tGroup->fSpaces.begin(); tIt != tGroup->fSpaces.end(); tIt++ )
+            {
+                (*tIt)->AcceptNode( &tMesher );
+            }
+        }
+
+        return NULL;
+    }
+
+}
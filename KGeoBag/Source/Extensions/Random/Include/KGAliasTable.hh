@@ -0,0 +1,39 @@
+#ifndef KGALIASTABLE_DEF
+#define KGALIASTABLE_DEF
+
+#include <vector>
+
+namespace KGeoBag
+{
+  /**
+   * \brief Walker alias table for drawing an index with
+   * probability proportional to a list of weights.
+   *
+   * \detail The table is built once in linear time from the
+   * weights (e.g. surface areas or volumes), afterwards every
+   * draw costs two uniform numbers and a single lookup,
+   * independent of the number of entries.
+   */
+  class KGAliasTable
+  {
+  public:
+    KGAliasTable();
+    virtual ~KGAliasTable();
+
+    void Initialize(const std::vector<double>& weights);
+    void Clear();
+
+    unsigned int GetSize() const { return fProbability.size(); }
+    double GetTotalWeight() const { return fTotalWeight; }
+
+    /// draws an index from two uniform numbers in [0,1)
+    unsigned int Sample(double uniform1, double uniform2) const;
+
+  private:
+    std::vector<double> fProbability;
+    std::vector<unsigned int> fAlias;
+    double fTotalWeight;
+  };
+}
+
+#endif /* KGALIASTABLE_DEF */
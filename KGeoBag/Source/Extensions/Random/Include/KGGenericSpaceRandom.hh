@@ -12,17 +12,29 @@
 #include "KGVolume.hh"
 #include "KGRandomMessage.hh"
 
+#include <map>
+#include <vector>
+
 namespace KGeoBag
 {
   /**
    * \brief Class for implementation of a generic code
    * for dicing a point inside an arbitrary space.
+   *
+   * \detail On the first visit of a volume its bounding box is
+   * determined from boundary points seen from far away, and the
+   * box is divided into a grid of voxels. Voxels with none of their
+   * corners and centers inside the volume are dropped. A point is
+   * diced uniformly in a random occupied voxel and accepted if it is
+   * inside the volume, so that the acceptance rate stays high even
+   * for thin or complex volumes. Features smaller than a voxel may
+   * be missed, the grid resolution can be raised for those.
    */
   class KGGenericSpaceRandom : virtual public KGShapeRandom,
 				 public KGVolume::Visitor
   {
   public:
-	  KGGenericSpaceRandom() : KGShapeRandom() {}
+	  KGGenericSpaceRandom() : KGShapeRandom(), fGridResolution(32), fMaxTrials(100000), fGrids() {}
     virtual ~KGGenericSpaceRandom() {}
 
     /**
@@ -32,6 +44,28 @@ namespace KGeoBag
      * \brief aVolume
      */
     virtual void VisitVolume(KGVolume* aVolume);
+
+    /**
+     * \brief Sets the number of voxels per axis of the
+     * occupancy grid, applies to volumes visited afterwards.
+     */
+    void SetGridResolution(unsigned int aResolution) { fGridResolution = (aResolution > 0 ? aResolution : 1); }
+    unsigned int GetGridResolution() const { return fGridResolution; }
+
+  private:
+    struct VoxelGrid
+    {
+      KThreeVector fLower;
+      KThreeVector fCellSize;
+      unsigned int fResolution;
+      std::vector<unsigned int> fOccupied;
+    };
+
+    const VoxelGrid& GetGrid(KGVolume* aVolume);
+
+    unsigned int fGridResolution;
+    unsigned int fMaxTrials;
+    std::map<const KGVolume*, VoxelGrid> fGrids;
   };
 }
 
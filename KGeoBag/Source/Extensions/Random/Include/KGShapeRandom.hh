@@ -4,6 +4,8 @@
 #include "KGCore.hh"
 #include "KGMetrics.hh"
 
+#include "KGAliasTable.hh"
+
 namespace KGeoBag
 {
   class KGShapeRandom : public KGVisitor
@@ -19,6 +21,10 @@ namespace KGeoBag
     KThreeVector Random(std::vector<KGSurface*>& surfaces);
     KThreeVector Random(std::vector<KGSpace*>& spaces);
 
+    // forgets the area and volume tables, to be called when a list of surfaces
+    // or spaces passed before is modified in place
+    void ResetTables();
+
   protected:
 
     void SetRandomPoint(KThreeVector& random) const { fRandom = random; }
@@ -27,6 +33,40 @@ namespace KGeoBag
 
   private:
     mutable KThreeVector fRandom;
+
+    // identifies the list a table was built for by its address, size and end
+    // elements, so that the check per draw does not depend on the list length
+    class TableKey
+    {
+    public:
+      TableKey() : fList(NULL), fSize(0), fFront(NULL), fBack(NULL) {}
+
+      template<class T>
+      bool Matches(const std::vector<T*>& list) const
+      {
+        return fList == &list && fSize == list.size() && fFront == list.front() && fBack == list.back();
+      }
+
+      template<class T>
+      void Set(const std::vector<T*>& list)
+      {
+        fList = &list; fSize = list.size(); fFront = list.front(); fBack = list.back();
+      }
+
+      void Clear() { fList = NULL; fSize = 0; fFront = NULL; fBack = NULL; }
+
+    private:
+      const void* fList;
+      size_t fSize;
+      const void* fFront;
+      const void* fBack;
+    };
+
+    // area and volume tables of the last lists of surfaces and spaces
+    TableKey fSurfaceKey;
+    KGAliasTable fSurfaceTable;
+    TableKey fSpaceKey;
+    KGAliasTable fSpaceTable;
   };
 }
 
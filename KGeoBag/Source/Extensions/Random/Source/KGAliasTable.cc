@@ -0,0 +1,83 @@
+#include "KGAliasTable.hh"
+
+namespace KGeoBag
+{
+  KGAliasTable::KGAliasTable() :
+    fProbability(),
+    fAlias(),
+    fTotalWeight(0.)
+  {
+  }
+
+  KGAliasTable::~KGAliasTable()
+  {
+  }
+
+  void KGAliasTable::Initialize(const std::vector<double>& weights)
+  {
+    unsigned int n = weights.size();
+
+    fProbability.assign(n, 1.);
+    fAlias.resize(n);
+    fTotalWeight = 0.;
+
+    for(unsigned int i = 0; i < n; i++) {
+      fAlias[i] = i;
+      if(weights[i] > 0.)
+        fTotalWeight += weights[i];
+    }
+
+    if(n == 0 || fTotalWeight <= 0.)
+      return;
+
+    // scale the weights to a mean of one and split the
+    // entries into those below and those above the mean
+    std::vector<unsigned int> small;
+    std::vector<unsigned int> large;
+    for(unsigned int i = 0; i < n; i++) {
+      fProbability[i] = (weights[i] > 0. ? weights[i] : 0.) * n / fTotalWeight;
+      if(fProbability[i] < 1.)
+        small.push_back(i);
+      else
+        large.push_back(i);
+    }
+
+    // fill every small column up to one with a piece of a large one
+    while(!small.empty() && !large.empty()) {
+      unsigned int s = small.back();
+      small.pop_back();
+      unsigned int l = large.back();
+
+      fAlias[s] = l;
+      fProbability[l] -= 1. - fProbability[s];
+
+      if(fProbability[l] < 1.) {
+        large.pop_back();
+        small.push_back(l);
+      }
+    }
+
+    // whatever is left over is one up to rounding
+    for(unsigned int i = 0; i < large.size(); i++)
+      fProbability[large[i]] = 1.;
+    for(unsigned int i = 0; i < small.size(); i++)
+      fProbability[small[i]] = 1.;
+  }
+
+  void KGAliasTable::Clear()
+  {
+    fProbability.clear();
+    fAlias.clear();
+    fTotalWeight = 0.;
+  }
+
+  unsigned int KGAliasTable::Sample(double uniform1, double uniform2) const
+  {
+    unsigned int n = fProbability.size();
+    unsigned int i = static_cast<unsigned int>(uniform1 * n);
+    if(i >= n)
+      i = n - 1;
+
+    return (uniform2 < fProbability[i]) ? i : fAlias[i];
+  }
+}
@@ -7,15 +7,117 @@
 
 #include "KGGenericSpaceRandom.hh"
 
-void KGeoBag::KGGenericSpaceRandom::VisitVolume(KGVolume* /*aVolume*/) {
+#include <cmath>
+#include <limits>
+
+void KGeoBag::KGGenericSpaceRandom::VisitVolume(KGVolume* aVolume) {
 	KThreeVector point;
+	point[0] = point[1] = point[2] = std::numeric_limits<double>::quiet_NaN();
+
+	const VoxelGrid& grid = GetGrid(aVolume);
+	if(grid.fOccupied.empty()) {
+		randommsg( eWarning ) << "Could not find any voxel inside the volume, no random point diced." << eom;
+		SetRandomPoint(point);
+		return;
+	}
+
+	unsigned int n = grid.fResolution;
+	for(unsigned int trial = 0; trial < fMaxTrials; trial++) {
+		unsigned int index = static_cast<unsigned int>(Uniform() * grid.fOccupied.size());
+		if(index >= grid.fOccupied.size())
+			index = grid.fOccupied.size() - 1;
+		unsigned int cell = grid.fOccupied[index];
 
-	// ToDo: Implement generic function
-	randommsg( eWarning ) << "You are using the generic function to calculate a random point inside a volume. "
-			<< "But at the moment there is no algorithm implemented. "
-			<< "Do you want to do this?" << eom;
+		unsigned int i = cell % n;
+		unsigned int j = (cell / n) % n;
+		unsigned int k = cell / (n * n);
 
+		KThreeVector candidate(grid.fLower[0] + (i + Uniform()) * grid.fCellSize[0],
+				grid.fLower[1] + (j + Uniform()) * grid.fCellSize[1],
+				grid.fLower[2] + (k + Uniform()) * grid.fCellSize[2]);
+
+		if(!aVolume->Outside(candidate)) {
+			SetRandomPoint(candidate);
+			return;
+		}
+	}
+
+	randommsg( eWarning ) << "No random point found inside the volume after " << fMaxTrials << " trials." << eom;
 	SetRandomPoint(point);
 }
 
+const KGeoBag::KGGenericSpaceRandom::VoxelGrid& KGeoBag::KGGenericSpaceRandom::GetGrid(KGVolume* aVolume) {
+	std::map<const KGVolume*, VoxelGrid>::iterator it = fGrids.find(aVolume);
+	if(it != fGrids.end()) {
+		return it->second;
+	}
+
+	// the boundary point closest to a far away point center + L*u is, for growing L,
+	// the point of the volume that extends furthest into the direction u, so six
+	// queries along the axes give the bounding box. a second pass centered on the
+	// first estimate removes most of the finite distance error.
+	KThreeVector center(0., 0., 0.);
+	KThreeVector lower;
+	KThreeVector upper;
+	double scale = 1.;
+	for(unsigned int pass = 0; pass < 2; pass++) {
+		double distance = 1.e4 * scale;
+		for(unsigned int axis = 0; axis < 3; axis++) {
+			KThreeVector direction(0., 0., 0.);
+			direction[axis] = distance;
+			upper[axis] = aVolume->Point(center + direction)[axis];
+			lower[axis] = aVolume->Point(center - direction)[axis];
+		}
+		center = 0.5 * (lower + upper);
+		scale = 0.;
+		for(unsigned int axis = 0; axis < 3; axis++) {
+			scale = std::max(scale, upper[axis] - lower[axis]);
+		}
+		if(!(scale > 0.)) {
+			scale = 1.;
+		}
+	}
 
+	// pad the box, so that the boundary does not coincide with the outermost voxel faces
+	for(unsigned int axis = 0; axis < 3; axis++) {
+		double pad = 0.01 * std::max(upper[axis] - lower[axis], 1.e-3 * scale);
+		lower[axis] -= pad;
+		upper[axis] += pad;
+	}
+
+	VoxelGrid& grid = fGrids[aVolume];
+	unsigned int n = fGridResolution;
+	grid.fResolution = n;
+	grid.fLower = lower;
+	grid.fCellSize = KThreeVector((upper[0] - lower[0]) / n, (upper[1] - lower[1]) / n, (upper[2] - lower[2]) / n);
+
+	// inside flags of all voxel corners, each corner is shared by up to eight voxels
+	unsigned int m = n + 1;
+	std::vector<char> corners(m * m * m);
+	for(unsigned int k = 0; k < m; k++)
+		for(unsigned int j = 0; j < m; j++)
+			for(unsigned int i = 0; i < m; i++) {
+				KThreeVector corner(lower[0] + i * grid.fCellSize[0], lower[1] + j * grid.fCellSize[1], lower[2] + k * grid.fCellSize[2]);
+				corners[i + m * (j + m * k)] = aVolume->Outside(corner) ? 0 : 1;
+			}
+
+	for(unsigned int k = 0; k < n; k++)
+		for(unsigned int j = 0; j < n; j++)
+			for(unsigned int i = 0; i < n; i++) {
+				bool occupied = false;
+				for(unsigned int c = 0; c < 8 && !occupied; c++) {
+					occupied = (corners[(i + (c & 1)) + m * ((j + ((c >> 1) & 1)) + m * (k + ((c >> 2) & 1)))] != 0);
+				}
+				if(!occupied) {
+					KThreeVector middle(lower[0] + (i + 0.5) * grid.fCellSize[0], lower[1] + (j + 0.5) * grid.fCellSize[1], lower[2] + (k + 0.5) * grid.fCellSize[2]);
+					occupied = !aVolume->Outside(middle);
+				}
+				if(occupied) {
+					grid.fOccupied.push_back(i + n * (j + n * k));
+				}
+			}
+
+	randommsg( eDebug ) << "Generic volume sampler uses " << grid.fOccupied.size() << " of " << n * n * n << " voxels." << eom;
+
+	return grid;
+}
@@ -32,30 +32,23 @@ namespace KGeoBag
 		return fRandom;
 	}
 
-    double totalArea = 0;
-    for(std::vector<KGSurface*>::const_iterator s = surfaces.begin();
-    		s != surfaces.end(); ++s) {
-    	KGSurface* surface = *s;
+    if(!fSurfaceKey.Matches(surfaces)) {
+    	std::vector<double> areas;
+    	for(std::vector<KGSurface*>::const_iterator s = surfaces.begin();
+    			s != surfaces.end(); ++s) {
+    		KGSurface* surface = *s;
 
-    	if(!surface->HasExtension<KGMetrics>()) {
-    		surface->MakeExtension<KGMetrics>();
-    	}
+    		if(!surface->HasExtension<KGMetrics>()) {
+    			surface->MakeExtension<KGMetrics>();
+    		}
 
-    	totalArea += surface->AsExtension<KGMetrics>()->GetArea();
+    		areas.push_back(surface->AsExtension<KGMetrics>()->GetArea());
+    	}
+    	fSurfaceTable.Initialize(areas);
+    	fSurfaceKey.Set(surfaces);
     }
 
-    KGSurface* selectedSurface = 0;
-    double decision = Uniform(0, totalArea);
-    for(std::vector<KGSurface*>::const_iterator s = surfaces.begin();
-			s != surfaces.end(); ++s) {
-		selectedSurface = *s;
-
-		totalArea -= selectedSurface->AsExtension<KGMetrics>()->GetArea();
-
-		if(decision > totalArea) {
-			break;
-		}
-	}
+    KGSurface* selectedSurface = surfaces[fSurfaceTable.Sample(Uniform(), Uniform())];
 
     return Random(selectedSurface);
   }
@@ -68,34 +61,33 @@ namespace KGeoBag
     	return fRandom;
     }
 
-    double totalVolume = 0;
-    for(std::vector<KGSpace*>::const_iterator v = spaces.begin();
-    		v != spaces.end(); ++v) {
-    	KGSpace* space = *v;
+    if(!fSpaceKey.Matches(spaces)) {
+    	std::vector<double> volumes;
+    	for(std::vector<KGSpace*>::const_iterator v = spaces.begin();
+    			v != spaces.end(); ++v) {
+    		KGSpace* space = *v;
 
-    	if(!space->HasExtension<KGMetrics>()) {
-    		space->MakeExtension<KGMetrics>();
-    	}
+    		if(!space->HasExtension<KGMetrics>()) {
+    			space->MakeExtension<KGMetrics>();
+    		}
 
-    	totalVolume += space->AsExtension<KGMetrics>()->GetVolume();
+    		volumes.push_back(space->AsExtension<KGMetrics>()->GetVolume());
+    	}
+    	fSpaceTable.Initialize(volumes);
+    	fSpaceKey.Set(spaces);
     }
 
-    KGSpace* selectedSpace = 0;
-    double decision = Uniform(0, totalVolume);
-    for(std::vector<KGSpace*>::const_iterator v = spaces.begin();
-			v != spaces.end(); ++v) {
-		selectedSpace = *v;
-
-		totalVolume -= selectedSpace->AsExtension<KGMetrics>()->GetVolume();
-
-		if(decision > totalVolume) {
-			break;
-		}
-	}
+    KGSpace* selectedSpace = spaces[fSpaceTable.Sample(Uniform(), Uniform())];
 
     return Random(selectedSpace);
   }
 
+  void KGShapeRandom::ResetTables()
+  {
+    fSurfaceKey.Clear();
+    fSpaceKey.Clear();
+  }
+
   double KGShapeRandom::Uniform(double min,double max) const
   {
     return katrin::KRandom::GetInstance().Uniform(min,max);
@@ -0,0 +1,201 @@
+#ifndef KG2DBOUNDINGBOXTREE_HH_
+#define KG2DBOUNDINGBOXTREE_HH_
+
+#include "KTwoVector.hh"
+
+#include <vector>
+#include <limits>
+#include <cmath>
+
+// the tree is split at the median, so its depth and the number of pending nodes
+// of a search stay below the number of bits of the segment index
+#define KG2DBOUNDINGBOXTREE_STACK_SIZE 64
+
+namespace KGeoBag
+{
+  /**
+   * \brief Static bounding box hierarchy over the segments of a 2D profile.
+   *
+   * \detail Every segment is entered with an axis aligned box that encloses
+   * it, the tree is built once with Build() and can then answer which boxes
+   * overlap a given x coordinate and which segment is nearest to a query
+   * point. For the latter the caller supplies the exact distance of a
+   * segment, the boxes are only used to skip subtrees that can not hold a
+   * closer segment, so both queries scale with the logarithm of the number
+   * of segments for profiles whose segments do not overlap much. The
+   * queries do not allocate and only read the tree, so a built tree can be
+   * searched from several threads.
+   */
+  class KG2DBoundingBoxTree
+  {
+  public:
+    KG2DBoundingBoxTree();
+    virtual ~KG2DBoundingBoxTree() {}
+
+    void Clear();
+    void Add(double aXMin, double aXMax, double aYMin, double aYMax);
+    void Build();
+
+    unsigned int GetSize() const { return fBoxes.size(); }
+    bool IsBuilt() const { return fBuilt; }
+
+    /// returns true as soon as aPredicate(index) is true for a box with aXMin <= anX <= aXMax
+    template<class XPredicate>
+    bool AnyOverlapping(double anX, XPredicate& aPredicate) const;
+
+    /// returns the index of the segment with the smallest aDistance(index, aPoint),
+    /// ties are resolved to the lowest index as in a linear scan
+    template<class XDistance>
+    unsigned int FindNearest(const KTwoVector& aPoint, XDistance& aDistance) const;
+
+  private:
+    struct Box
+    {
+      double fMin[2];
+      double fMax[2];
+
+      void Merge(const Box& aBox);
+      double Distance(const KTwoVector& aPoint) const;
+    };
+
+    struct Node
+    {
+      Box fBox;
+      // children for inner nodes, range in fOrder for leaves
+      unsigned int fFirst;
+      unsigned int fSecond;
+      bool fLeaf;
+    };
+
+    // orders segment indices by the box center along one axis
+    class CenterCompare
+    {
+    public:
+      CenterCompare(const std::vector<Box>& aBoxes, unsigned int anAxis) : fBoxes(aBoxes), fAxis(anAxis) {}
+      bool operator()(unsigned int aLeft, unsigned int aRight) const
+      {
+        return fBoxes[aLeft].fMin[fAxis] + fBoxes[aLeft].fMax[fAxis] < fBoxes[aRight].fMin[fAxis] + fBoxes[aRight].fMax[fAxis];
+      }
+
+    private:
+      const std::vector<Box>& fBoxes;
+      unsigned int fAxis;
+    };
+
+    unsigned int BuildNode(unsigned int aBegin, unsigned int anEnd);
+
+    std::vector<Box> fBoxes;
+    std::vector<Node> fNodes;
+    std::vector<unsigned int> fOrder;
+    bool fBuilt;
+  };
+
+  inline double KG2DBoundingBoxTree::Box::Distance(const KTwoVector& aPoint) const
+  {
+    double tDistance2 = 0.;
+    for(unsigned int i = 0; i < 2; i++)
+    {
+      double tDelta = 0.;
+      if(aPoint[i] < fMin[i])
+        tDelta = fMin[i] - aPoint[i];
+      else if(aPoint[i] > fMax[i])
+        tDelta = aPoint[i] - fMax[i];
+      tDistance2 += tDelta * tDelta;
+    }
+    return sqrt(tDistance2);
+  }
+
+  template<class XDistance>
+  unsigned int KG2DBoundingBoxTree::FindNearest(const KTwoVector& aPoint, XDistance& aDistance) const
+  {
+    double tBestDistance = std::numeric_limits<double>::max();
+    unsigned int tBestIndex = 0;
+
+    if(fNodes.empty())
+      return tBestIndex;
+
+    unsigned int tStack[KG2DBOUNDINGBOXTREE_STACK_SIZE];
+    unsigned int tStackSize = 0;
+    tStack[tStackSize++] = 0;
+
+    while(tStackSize != 0)
+    {
+      const Node& tNode = fNodes[tStack[--tStackSize]];
+
+      // strictly larger, so that a segment with the same distance but a lower index is still visited
+      if(tNode.fBox.Distance(aPoint) > tBestDistance)
+        continue;
+
+      if(tNode.fLeaf)
+      {
+        for(unsigned int i = tNode.fFirst; i < tNode.fSecond; i++)
+        {
+          unsigned int tIndex = fOrder[i];
+          if(fBoxes[tIndex].Distance(aPoint) > tBestDistance)
+            continue;
+
+          double tDistance = aDistance(tIndex, aPoint);
+          if(tDistance < tBestDistance || (tDistance == tBestDistance && tIndex < tBestIndex))
+          {
+            tBestDistance = tDistance;
+            tBestIndex = tIndex;
+          }
+        }
+        continue;
+      }
+
+      // the closer child goes on top of the stack
+      double tFirstDistance = fNodes[tNode.fFirst].fBox.Distance(aPoint);
+      double tSecondDistance = fNodes[tNode.fSecond].fBox.Distance(aPoint);
+      if(tFirstDistance < tSecondDistance)
+      {
+        tStack[tStackSize++] = tNode.fSecond;
+        tStack[tStackSize++] = tNode.fFirst;
+      }
+      else
+      {
+        tStack[tStackSize++] = tNode.fFirst;
+        tStack[tStackSize++] = tNode.fSecond;
+      }
+    }
+
+    return tBestIndex;
+  }
+
+  template<class XPredicate>
+  bool KG2DBoundingBoxTree::AnyOverlapping(double anX, XPredicate& aPredicate) const
+  {
+    if(fNodes.empty())
+      return false;
+
+    unsigned int tStack[KG2DBOUNDINGBOXTREE_STACK_SIZE];
+    unsigned int tStackSize = 0;
+    tStack[tStackSize++] = 0;
+
+    while(tStackSize != 0)
+    {
+      const Node& tNode = fNodes[tStack[--tStackSize]];
+
+      if(anX < tNode.fBox.fMin[0] || anX > tNode.fBox.fMax[0])
+        continue;
+
+      if(tNode.fLeaf)
+      {
+        for(unsigned int i = tNode.fFirst; i < tNode.fSecond; i++)
+        {
+          const Box& tBox = fBoxes[fOrder[i]];
+          if(anX >= tBox.fMin[0] && anX <= tBox.fMax[0] && aPredicate(fOrder[i]))
+            return true;
+        }
+        continue;
+      }
+
+      tStack[tStackSize++] = tNode.fSecond;
+      tStack[tStackSize++] = tNode.fFirst;
+    }
+
+    return false;
+  }
+}
+
+#endif
@@ -0,0 +1,94 @@
+#include "KG2DBoundingBoxTree.hh"
+
+#include <algorithm>
+
+// number of segments below which a node is not split any further
+#define KG2DBOUNDINGBOXTREE_LEAF_SIZE 4
+
+namespace KGeoBag
+{
+  KG2DBoundingBoxTree::KG2DBoundingBoxTree() :
+    fBoxes(),
+    fNodes(),
+    fOrder(),
+    fBuilt(false)
+  {
+  }
+
+  void KG2DBoundingBoxTree::Clear()
+  {
+    fBoxes.clear();
+    fNodes.clear();
+    fOrder.clear();
+    fBuilt = false;
+  }
+
+  void KG2DBoundingBoxTree::Add(double aXMin, double aXMax, double aYMin, double aYMax)
+  {
+    Box tBox;
+    tBox.fMin[0] = std::min(aXMin, aXMax);
+    tBox.fMax[0] = std::max(aXMin, aXMax);
+    tBox.fMin[1] = std::min(aYMin, aYMax);
+    tBox.fMax[1] = std::max(aYMin, aYMax);
+    fBoxes.push_back(tBox);
+    fBuilt = false;
+  }
+
+  void KG2DBoundingBoxTree::Build()
+  {
+    fNodes.clear();
+    fOrder.resize(fBoxes.size());
+    for(unsigned int i = 0; i < fOrder.size(); i++)
+      fOrder[i] = i;
+
+    if(!fBoxes.empty())
+    {
+      fNodes.reserve(2 * fBoxes.size());
+      BuildNode(0, fOrder.size());
+    }
+
+    fBuilt = true;
+  }
+
+  void KG2DBoundingBoxTree::Box::Merge(const Box& aBox)
+  {
+    for(unsigned int i = 0; i < 2; i++)
+    {
+      fMin[i] = std::min(fMin[i], aBox.fMin[i]);
+      fMax[i] = std::max(fMax[i], aBox.fMax[i]);
+    }
+  }
+
+  unsigned int KG2DBoundingBoxTree::BuildNode(unsigned int aBegin, unsigned int anEnd)
+  {
+    unsigned int tNodeIndex = fNodes.size();
+    fNodes.push_back(Node());
+
+    Box tBox = fBoxes[fOrder[aBegin]];
+    for(unsigned int i = aBegin + 1; i < anEnd; i++)
+      tBox.Merge(fBoxes[fOrder[i]]);
+    fNodes[tNodeIndex].fBox = tBox;
+
+    if(anEnd - aBegin <= KG2DBOUNDINGBOXTREE_LEAF_SIZE)
+    {
+      fNodes[tNodeIndex].fLeaf = true;
+      fNodes[tNodeIndex].fFirst = aBegin;
+      fNodes[tNodeIndex].fSecond = anEnd;
+      return tNodeIndex;
+    }
+
+    // split at the median of the box centers along the longer side
+    unsigned int tAxis = (tBox.fMax[0] - tBox.fMin[0] >= tBox.fMax[1] - tBox.fMin[1]) ? 0 : 1;
+    unsigned int tMiddle = aBegin + (anEnd - aBegin) / 2;
+    std::nth_element(fOrder.begin() + aBegin, fOrder.begin() + tMiddle, fOrder.begin() + anEnd, CenterCompare(fBoxes, tAxis));
+
+    // the vector may grow during the recursion, so the node is only addressed by index
+    unsigned int tFirst = BuildNode(aBegin, tMiddle);
+    unsigned int tSecond = BuildNode(tMiddle, anEnd);
+    fNodes[tNodeIndex].fLeaf = false;
+    fNodes[tNodeIndex].fFirst = tFirst;
+    fNodes[tNodeIndex].fSecond = tSecond;
+
+    return tNodeIndex;
+  }
+}
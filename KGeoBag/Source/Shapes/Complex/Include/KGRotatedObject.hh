@@ -6,6 +6,8 @@
 #include <cmath>
 #include <string>
 
+#include "KG2DBoundingBoxTree.hh"
+
 namespace KGeoBag
 {
 
@@ -15,18 +17,20 @@ namespace KGeoBag
     KGRotatedObject() : fNPolyBegin(0),
 			fNPolyEnd(0),
 			fNSegments(0),
-			fDiscretizationPower(2.) {}
+			fDiscretizationPower(2.),
+			fSegmentIndex() {}
 
     KGRotatedObject(unsigned int nPolyBegin,
 		    unsigned int nPolyEnd) : fNPolyBegin(nPolyBegin),
 					     fNPolyEnd(nPolyEnd),
 					     fNSegments(0),
-					     fDiscretizationPower(2.) {}
+					     fDiscretizationPower(2.),
+					     fSegmentIndex() {}
     virtual ~KGRotatedObject();
 
     static std::string Name() { return "rotated_object"; }
 
-    virtual void Initialize() const {}
+    virtual void Initialize() const;
 
     virtual KGRotatedObject* Clone() const;
 
@@ -258,6 +262,13 @@ namespace KGeoBag
 
     double fDiscretizationPower;
 
+    // (z,r) bounding boxes of the segments, built by Initialize(); until
+    // then the queries test every segment
+    void BuildSegmentIndex() const;
+    mutable KG2DBoundingBoxTree fSegmentIndex;
+
+    class SegmentDistance;
+    class SegmentContains;
   };
 
 }
@@ -6,6 +6,35 @@
 
 namespace KGeoBag
 {
+  // distance of a point to a single segment, used for the nearest segment search
+  class KGRotatedObject::SegmentDistance
+  {
+  public:
+    SegmentDistance(const std::vector< KGRotatedObject::Line* >& segments,
+		    const double* P) : fSegments(segments), fP(P) {}
+
+    double operator()(unsigned int i,const KTwoVector&) const
+    { return fSegments[i]->DistanceTo(fP); }
+
+  private:
+    const std::vector< KGRotatedObject::Line* >& fSegments;
+    const double* fP;
+  };
+
+  class KGRotatedObject::SegmentContains
+  {
+  public:
+    SegmentContains(const std::vector< KGRotatedObject::Line* >& segments,
+		    const double* P) : fSegments(segments), fP(P) {}
+
+    bool operator()(unsigned int i) const
+    { return fSegments[i]->ContainsPoint(fP); }
+
+  private:
+    const std::vector< KGRotatedObject::Line* >& fSegments;
+    const double* fP;
+  };
+
   KGRotatedObject::~KGRotatedObject()
   {
     for( unsigned int i = 0; i < fSegments.size(); i++ )
@@ -26,10 +55,16 @@ namespace KGeoBag
 
     for(size_t i=0;i<fSegments.size();i++)
       tClone->fSegments.push_back(fSegments[i]->Clone(tClone));
+    tClone->fSegmentIndex = fSegmentIndex;
 
     return tClone;
   }
 
+  void KGRotatedObject::Initialize() const
+  {
+    BuildSegmentIndex();
+  }
+
   void KGRotatedObject::AddLine( const double p1[2], const double p2[2] )
   {
     // Adds line segment (p1,p2) to the rotated surface.
@@ -42,6 +77,7 @@ namespace KGeoBag
 
     fSegments.push_back(new KGRotatedObject::Line(this,p1,p2));
     fSegments.back()->SetOrder(fNSegments++);
+    fSegmentIndex.Clear();
   }
 
   void KGRotatedObject::AddArc(const double p1[2],
@@ -59,6 +95,7 @@ namespace KGeoBag
 
     fSegments.push_back(new KGRotatedObject::Arc(this,p1,p2,radius,positiveOrientation));
     fSegments.back()->SetOrder(fNSegments++);
+    fSegmentIndex.Clear();
 
   }
 
@@ -69,12 +106,20 @@ namespace KGeoBag
     line->SetRotated(this);
     fSegments.push_back(line);
     fSegments.back()->SetOrder(fNSegments++);
+    fSegmentIndex.Clear();
   }
 
   bool KGRotatedObject::ContainsPoint(const double* P) const
   {
     // Determines if point <aPoint> is contained by the geometry.
 
+    // only segments whose z-range covers the point can contain it
+    if (fSegmentIndex.IsBuilt())
+    {
+      SegmentContains segmentContains(fSegments,P);
+      return fSegmentIndex.AnyOverlapping(P[2],segmentContains);
+    }
+
     for (unsigned int i=0; i<fSegments.size(); i++)
       if (fSegments.at(i)->ContainsPoint(P))
 	return true;
@@ -100,25 +145,65 @@ namespace KGeoBag
 
   double KGRotatedObject::DistanceTo(const double* P,double* P_in,double* P_norm) const
   {
-    double distance = std::numeric_limits<double>::max();
+    if (fSegments.empty())
+      return std::numeric_limits<double>::max();
+
+    unsigned int nearest = 0;
+    if (fSegmentIndex.IsBuilt())
+    {
+      // all segments measure the distance in the (z,r) plane, so the segment
+      // boxes bound it from below
+      SegmentDistance segmentDistance(fSegments,P);
+      KTwoVector zr(P[2],sqrt(P[0]*P[0]+P[1]*P[1]));
+      nearest = fSegmentIndex.FindNearest(zr,segmentDistance);
+    }
+    else
+    {
+      double distance = std::numeric_limits<double>::max();
+      for (unsigned int i=0; i<fSegments.size(); i++)
+      {
+	double distance1 = fSegments.at(i)->DistanceTo(P);
+	if (distance1<distance)
+	{
+	  distance = distance1;
+	  nearest = i;
+	}
+      }
+    }
 
-    double distance1;
     double P_in1[3];
     double P_norm1[3];
+    double distance = fSegments.at(nearest)->DistanceTo(P,P_in1,P_norm1);
+    for (unsigned int j=0;j<3;j++)
+    {
+      if (P_in) P_in[j] = P_in1[j];
+      if (P_norm) P_norm[j] = P_norm1[j];
+    }
+    return distance;
+  }
+
+  void KGRotatedObject::BuildSegmentIndex() const
+  {
+    fSegmentIndex.Clear();
 
     for (unsigned int i=0; i<fSegments.size(); i++)
     {
-      distance1 = fSegments.at(i)->DistanceTo(P,P_in1,P_norm1);
-      if (distance1<distance)
+      const KGRotatedObject::Line* segment = fSegments.at(i);
+      if (segment->IsArc())
       {
-	for (unsigned int j=0;j<3;j++)
-	{
-	  if (P_in) P_in[j] = P_in1[j];
-	  if (P_norm) P_norm[j] = P_norm1[j];
-	}
+	// the whole circle, which also covers the z-range of the end points
+	const KGRotatedObject::Arc* arc = static_cast<const KGRotatedObject::Arc*>(segment);
+	fSegmentIndex.Add(arc->GetCenter(0) - arc->GetRadius(),
+			  arc->GetCenter(0) + arc->GetRadius(),
+			  arc->GetCenter(1) - arc->GetRadius(),
+			  arc->GetCenter(1) + arc->GetRadius());
       }
+      else
+	fSegmentIndex.Add(segment->GetP1(0),segment->GetP2(0),
+			  segment->GetP1(1),segment->GetP2(1));
     }
-    return distance;
+
+    fSegmentIndex.Build();
   }
 
   KGRotatedObject::Line::Line(KGRotatedObject* rO,
@@ -5,6 +5,8 @@
 #include "KGPlanarLineSegment.hh"
 #include "KGPlanarArcSegment.hh"
 
+#include "KG2DBoundingBoxTree.hh"
+
 namespace KGeoBag
 {
 
@@ -55,6 +57,12 @@ namespace KGeoBag
             void Initialize() const;
             mutable bool fInitialized;
 
+            //bounding boxes of the elements for the nearest element search, rebuilt by Initialize after every change
+            mutable KG2DBoundingBoxTree fIndex;
+
+            class ElementDistance;
+            unsigned int NearestElement( const KTwoVector& aQuery ) const;
+
         public:
             class StartPointArguments
             {
@@ -1,16 +1,36 @@
 #include "KGPlanarPolyLine.hh"
 #include "KGShapeMessage.hh"
 
+#include <limits>
+
 namespace KGeoBag
 {
 
+    class KGPlanarPolyLine::ElementDistance
+    {
+        public:
+            ElementDistance( const KGPlanarPolyLine::Set& anElements ) :
+                    fElements( anElements )
+            {
+            }
+
+            double operator()( unsigned int anIndex, const KTwoVector& aQuery ) const
+            {
+                return (fElements[ anIndex ]->Point( aQuery ) - aQuery).Magnitude();
+            }
+
+        private:
+            const KGPlanarPolyLine::Set& fElements;
+    };
+
     KGPlanarPolyLine::KGPlanarPolyLine() :
             fElements(),
             fLength( 0. ),
             fCentroid( 0., 0. ),
             fStart( 0., 0. ),
             fEnd( 0., 0. ),
-            fInitialized( false )
+            fInitialized( false ),
+            fIndex()
     {
     }
     KGPlanarPolyLine::KGPlanarPolyLine( const KGPlanarPolyLine& aCopy ) :
@@ -19,7 +39,8 @@ namespace KGeoBag
             fCentroid( aCopy.fCentroid ),
             fStart( aCopy.fStart ),
             fEnd( aCopy.fEnd ),
-            fInitialized( aCopy.fInitialized )
+            fInitialized( false ),
+            fIndex()
     {
         const KGPlanarOpenPath* tElement;
         const KGPlanarLineSegment* tLineSegment;
@@ -42,6 +63,8 @@ namespace KGeoBag
                 continue;
             }
         }
+
+        Initialize();
     }
     KGPlanarPolyLine::~KGPlanarPolyLine()
     {
@@ -65,7 +88,7 @@ namespace KGeoBag
         fCentroid = aCopy.fCentroid;
         fStart = aCopy.fStart;
         fEnd = aCopy.fEnd;
-        fInitialized = aCopy.fInitialized;
+        fInitialized = false;
 
         const KGPlanarOpenPath* tElement;
         for( It tIt = fElements.begin(); tIt != fElements.end(); tIt++ )
@@ -96,6 +119,8 @@ namespace KGeoBag
             }
         }
 
+        Initialize();
+
         return;
     }
 
@@ -114,6 +139,8 @@ namespace KGeoBag
         fStart = aPoint;
         fEnd = aPoint;
 
+        Initialize();
+
         return;
     }
     void KGPlanarPolyLine::NextLine( const KTwoVector& aVertex, const unsigned int aCount, const double aPower )
@@ -124,6 +151,8 @@ namespace KGeoBag
         fElements.push_back( new KGPlanarLineSegment( fEnd, aVertex, aCount, aPower ) );
         fEnd = aVertex;
 
+        Initialize();
+
         return;
     }
     void KGPlanarPolyLine::NextArc( const KTwoVector& aVertex, const double& aRadius, const bool& aLeft, const bool& aLong, const unsigned int aCount )
@@ -134,6 +163,8 @@ namespace KGeoBag
         fElements.push_back( new KGPlanarArcSegment( fEnd, aVertex, aRadius, aLeft, aLong, aCount ) );
         fEnd = aVertex;
 
+        Initialize();
+
         return;
     }
     void KGPlanarPolyLine::PreviousLine( const KTwoVector& aVertex, const unsigned int aCount, const double aPower )
@@ -144,6 +175,8 @@ namespace KGeoBag
         fElements.push_back( new KGPlanarLineSegment( aVertex, fStart, aCount, aPower ) );
         fStart = aVertex;
 
+        Initialize();
+
         return;
     }
     void KGPlanarPolyLine::PreviousArc( const KTwoVector& aVertex, const double& aRadius, const bool& aLeft, const bool& aLong, const unsigned int aCount )
@@ -154,6 +187,8 @@ namespace KGeoBag
         fElements.push_back( new KGPlanarArcSegment( aVertex, fStart, aRadius, aLeft, aLong, aCount ) );
         fStart = aVertex;
 
+        Initialize();
+
         return;
     }
 
@@ -240,33 +275,7 @@ namespace KGeoBag
             Initialize();
         }
 
-        KTwoVector tCurrentPoint;
-        double tCurrentDistance;
-
-        KTwoVector tNearestPoint;
-        double tNearestDistance;
-
-        CIt tIt = fElements.begin();
-
-        tNearestPoint = (*tIt)->Point( aQuery );
-        tNearestDistance = (tNearestPoint - aQuery).Magnitude();
-        tIt++;
-
-        while( tIt != fElements.end() )
-        {
-            tCurrentPoint = (*tIt)->Point( aQuery );
-            tCurrentDistance = (tCurrentPoint - aQuery).Magnitude();
-
-            if( tCurrentDistance < tNearestDistance )
-            {
-                tNearestPoint = tCurrentPoint;
-                tNearestDistance = tCurrentDistance;
-            }
-
-            tIt++;
-        }
-
-        return tNearestPoint;
+        return fElements[ NearestElement( aQuery ) ]->Point( aQuery );
     }
     KTwoVector KGPlanarPolyLine::Normal( const KTwoVector& aQuery ) const
     {
@@ -275,100 +284,37 @@ namespace KGeoBag
             Initialize();
         }
 
-        KTwoVector tFirstPoint;
-        KTwoVector tFirstNormal;
-        double tFirstDistance;
+        unsigned int tNearest = NearestElement( aQuery );
+
+        KTwoVector tNearestPoint = fElements[ tNearest ]->Point( aQuery );
+        KTwoVector tNearestNormal = fElements[ tNearest ]->Normal( aQuery );
 
         KTwoVector tSecondPoint;
         KTwoVector tSecondNormal;
-        double tSecondDistance;
 
         KTwoVector tAveragePoint;
         KTwoVector tAverageNormal;
-        double tAverageDistance;
-
-        KTwoVector tNearestPoint;
-        KTwoVector tNearestNormal;
-        double tNearestDistance;
 
-        CIt tIt = fElements.begin();
-
-        tFirstPoint = (*tIt)->Point( aQuery );
-        tFirstNormal = (*tIt)->Normal( aQuery );
-        tFirstDistance = (aQuery - tFirstPoint).Magnitude();
-
-        tNearestPoint = tFirstPoint;
-        tNearestNormal = tFirstNormal;
-        tNearestDistance = tFirstDistance;
-
-        tIt++;
-
-        for( ; tIt != fElements.end(); tIt++ )
+        //if the nearest point is the vertex shared with a neighboring element, the normal points along the query direction
+        for( unsigned int tNeighbor = (tNearest > 0 ? tNearest - 1 : tNearest + 1); tNeighbor <= tNearest + 1 && tNeighbor < fElements.size(); tNeighbor += 2 )
         {
-            tSecondPoint = (*tIt)->Point( aQuery );
-            tSecondNormal = (*tIt)->Normal( aQuery );
-            tSecondDistance = (aQuery - tSecondPoint).Magnitude();
+            tSecondPoint = fElements[ tNeighbor ]->Point( aQuery );
+            tSecondNormal = fElements[ tNeighbor ]->Normal( aQuery );
 
-            tAveragePoint = .5 * (tFirstPoint + tSecondPoint);
-            tAverageNormal = (tFirstNormal + tSecondNormal).Unit();
-            tAverageDistance = .5 * (tFirstDistance + tSecondDistance);
+            tAveragePoint = .5 * (tNearestPoint + tSecondPoint);
+            tAverageNormal = (tNearestNormal + tSecondNormal).Unit();
 
-            if( ((tFirstPoint - tSecondPoint).Magnitude() / (tAveragePoint).Magnitude()) < 1.e-12 )
+            if( ((tNearestPoint - tSecondPoint).Magnitude() / (tAveragePoint).Magnitude()) < 1.e-12 )
             {
-                if( (fabs( tAverageDistance - tNearestDistance ) / tNearestDistance) < 1.e-12 )
+                if( tAverageNormal.Dot( aQuery - tAveragePoint ) > 0. )
                 {
-                    tNearestPoint = tAveragePoint;
-                    if( tAverageNormal.Dot( aQuery - tAveragePoint ) > 0. )
-                    {
-                        tNearestNormal = 1. * (aQuery - tAveragePoint).Unit();
-                    }
-                    else
-                    {
-                        tNearestNormal = -1. * (aQuery - tAveragePoint).Unit();
-                    }
-                    tNearestDistance = tAverageDistance;
-
-                    tFirstPoint = tSecondPoint;
-                    tFirstNormal = tSecondNormal;
-                    tFirstDistance = tSecondDistance;
-                    continue;
+                    return 1. * (aQuery - tAveragePoint).Unit();
                 }
-
-                if( tAverageDistance < tNearestDistance )
+                else
                 {
-                    tNearestPoint = tAveragePoint;
-                    if( tAverageNormal.Dot( aQuery - tAveragePoint ) > 0. )
-                    {
-                        tNearestNormal = 1. * (aQuery - tAveragePoint).Unit();
-                    }
-                    else
-                    {
-                        tNearestNormal = -1. * (aQuery - tAveragePoint).Unit();
-                    }
-                    tNearestDistance = tAverageDistance;
-
-                    tFirstPoint = tSecondPoint;
-                    tFirstNormal = tSecondNormal;
-                    tFirstDistance = tSecondDistance;
-                    continue;
+                    return -1. * (aQuery - tAveragePoint).Unit();
                 }
             }
-
-            if( tSecondDistance < tNearestDistance )
-            {
-                tNearestPoint = tSecondPoint;
-                tNearestNormal = tSecondNormal;
-                tNearestDistance = tSecondDistance;
-
-                tFirstPoint = tSecondPoint;
-                tFirstNormal = tSecondNormal;
-                tFirstDistance = tSecondDistance;
-                continue;
-            }
-
-            tFirstPoint = tSecondPoint;
-            tFirstNormal = tSecondNormal;
-            tFirstDistance = tSecondDistance;
         }
 
         return tNearestNormal;
@@ -391,6 +337,12 @@ namespace KGeoBag
         return false;
     }
 
+    unsigned int KGPlanarPolyLine::NearestElement( const KTwoVector& aQuery ) const
+    {
+        ElementDistance tDistance( fElements );
+        return fIndex.FindNearest( aQuery, tDistance );
+    }
+
     void KGPlanarPolyLine::Initialize() const
     {
         shapemsg_debug( "initializing a planar poly line" << eom );
@@ -406,6 +358,33 @@ namespace KGeoBag
         }
         fCentroid /= fLength;
 
+        fIndex.Clear();
+        const KGPlanarLineSegment* tLineSegment;
+        const KGPlanarArcSegment* tArcSegment;
+        for( CIt tIt = fElements.begin(); tIt != fElements.end(); tIt++ )
+        {
+            tLineSegment = dynamic_cast< const KGPlanarLineSegment* >( *tIt );
+            if( tLineSegment != NULL )
+            {
+                fIndex.Add( tLineSegment->X1(), tLineSegment->X2(), tLineSegment->Y1(), tLineSegment->Y2() );
+                continue;
+            }
+
+            tArcSegment = dynamic_cast< const KGPlanarArcSegment* >( *tIt );
+            if( tArcSegment != NULL )
+            {
+                //the full circle, the arc lies inside of it
+                const KTwoVector& tOrigin = tArcSegment->Origin();
+                const double& tRadius = tArcSegment->Radius();
+                fIndex.Add( tOrigin.X() - tRadius, tOrigin.X() + tRadius, tOrigin.Y() - tRadius, tOrigin.Y() + tRadius );
+                continue;
+            }
+
+            //unknown elements get an unbounded box and are always tested
+            fIndex.Add( -std::numeric_limits< double >::max(), std::numeric_limits< double >::max(), -std::numeric_limits< double >::max(), std::numeric_limits< double >::max() );
+        }
+        fIndex.Build();
+
         fInitialized = true;
 
         return;
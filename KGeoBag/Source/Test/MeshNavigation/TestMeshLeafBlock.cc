@@ -0,0 +1,165 @@
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "KGLinearCongruentialGenerator.hh"
+
+#include "KGNavigableMeshElementContainer.hh"
+#include "KGNavigableMeshLeafBlock.hh"
+#include "KGNavigableMeshTree.hh"
+#include "KGNavigableMeshTreeBuilder.hh"
+#include "KGNavigableMeshProximityCheck.hh"
+
+using namespace KGeoBag;
+
+namespace
+{
+    KGLinearCongruentialGenerator sGenerator;
+
+    double Uniform(double low, double high)
+    {
+        return low + (high - low)*sGenerator.Random();
+    }
+
+    KThreeVector RandomPoint(double half_width)
+    {
+        return KThreeVector(Uniform(-half_width, half_width), Uniform(-half_width, half_width), Uniform(-half_width, half_width));
+    }
+
+    KThreeVector RandomDirection()
+    {
+        KThreeVector direction;
+        do
+        {
+            direction = RandomPoint(1.);
+        }
+        while(direction.Magnitude() < 1e-3 || direction.Magnitude() > 1.);
+        return direction.Unit();
+    }
+}
+
+//checks that the packed distance test of the leaf blocks agrees with KGMeshElement::NearestDistance
+//for triangles, rectangles and wires, and that the proximity check finds the same elements as a brute force search
+int main()
+{
+    KGNavigableMeshElementContainer tContainer;
+
+    //small elements scattered through a cube, of all three types
+    for(unsigned int i=0; i<600; i++)
+    {
+        KThreeVector tP0 = RandomPoint(.5);
+        KGNavigableMeshElement* tElement = new KGNavigableMeshElement();
+        if(i%3 == 0)
+        {
+            tElement->SetMeshElement(new KGMeshTriangle(tP0, tP0 + .05*RandomPoint(1.), tP0 + .05*RandomPoint(1.)));
+        }
+        else if(i%3 == 1)
+        {
+            KThreeVector tN1 = RandomDirection();
+            KThreeVector tN2 = tN1.Cross(RandomDirection()).Unit();
+            tElement->SetMeshElement(new KGMeshRectangle(Uniform(.01, .05), Uniform(.01, .05), tP0, tN1, tN2));
+        }
+        else
+        {
+            tElement->SetMeshElement(new KGMeshWire(tP0, tP0 + .05*RandomPoint(1.), Uniform(1e-4, 1e-2)));
+        }
+        tContainer.Add(tElement);
+    }
+
+    unsigned int tFailures = 0;
+
+    //the packed distance of one block holding all elements against the element classes
+    KGIdentitySet tAll;
+    for(unsigned int i=0; i<tContainer.GetNElements(); i++)
+    {
+        tAll.AddID(i);
+    }
+    KGNavigableMeshLeafBlock tBlock;
+    tBlock.Fill(&tContainer, &tAll);
+    if(tBlock.GetNPackedElements() + tBlock.GetNPackedWires() + tBlock.GetGenericElementIDs()->size() != tContainer.GetNElements())
+    {
+        std::cout << "leaf block lost elements" << std::endl;
+        tFailures++;
+    }
+    if(tBlock.GetNPackedWires() == 0)
+    {
+        std::cout << "leaf block did not pack any wire" << std::endl;
+        tFailures++;
+    }
+
+    const unsigned int tPoints = 2000;
+    for(unsigned int i=0; i<tPoints; i++)
+    {
+        KThreeVector tPoint = RandomPoint(.6);
+
+        double tReference = std::numeric_limits<double>::infinity();
+        for(unsigned int j=0; j<tContainer.GetNElements(); j++)
+        {
+            double tDistance = tContainer.GetElement(j)->GetMeshElement()->NearestDistance(tPoint);
+            tReference = (tDistance < tReference) ? tDistance : tReference;
+        }
+
+        double tPacked = tBlock.NearestDistance(tPoint, 0.);
+        if(std::fabs(tPacked - tReference) > 1e-12 + 1e-9*tReference)
+        {
+            std::cout << "point " << i << ": packed distance " << tPacked << " differs from nearest distance " << tReference << std::endl;
+            tFailures++;
+        }
+    }
+
+    //the proximity check on the tree with leaf blocks against a brute force search
+    KGNavigableMeshTree tTree;
+    KGNavigableMeshTreeBuilder tBuilder;
+    tBuilder.SetMaxTreeDepth(5);
+    tBuilder.SetNAllowedElements(8);
+    tBuilder.SetNavigableMeshElementContainer(&tContainer);
+    tBuilder.SetTree(&tTree);
+    tBuilder.ConstructTree();
+
+    KGNavigableMeshProximityCheck tCheck;
+    tCheck.SetMeshElementContainer(&tContainer);
+
+    unsigned int tHits = 0;
+    for(unsigned int i=0; i<tPoints; i++)
+    {
+        KThreeVector tPoint = RandomPoint(.55);
+        double tRadius = Uniform(1e-3, 3e-2);
+
+        double tReference = std::numeric_limits<double>::infinity();
+        for(unsigned int j=0; j<tContainer.GetNElements(); j++)
+        {
+            double tDistance = tContainer.GetElement(j)->GetMeshElement()->NearestDistance(tPoint);
+            tReference = (tDistance < tReference) ? tDistance : tReference;
+        }
+        if(std::fabs(tReference - tRadius) < 1e-9)
+        {
+            //too close to the sphere to be decided reliably
+            continue;
+        }
+
+        tCheck.SetPointAndRadius(tPoint, tRadius);
+        tCheck.ApplyAction(tTree.GetRootNode());
+
+        if(tCheck.SphereIntersectsMesh() != (tReference < tRadius))
+        {
+            std::cout << "sphere " << i << " with radius " << tRadius << " at distance " << tReference << " was " << (tCheck.SphereIntersectsMesh() ? "" : "not ") << "found to intersect the mesh" << std::endl;
+            tFailures++;
+        }
+        if(tReference < tRadius)
+        {
+            tHits++;
+        }
+    }
+
+    std::cout << tHits << " of " << tPoints << " spheres intersect the mesh" << std::endl;
+
+    if(tFailures != 0)
+    {
+        std::cout << "TestMeshLeafBlock failed with " << tFailures << " errors" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "TestMeshLeafBlock passed" << std::endl;
+    return EXIT_SUCCESS;
+}
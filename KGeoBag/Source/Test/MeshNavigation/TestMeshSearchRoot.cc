@@ -0,0 +1,97 @@
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "KGBox.hh"
+#include "KGMesher.hh"
+
+#include "KGMeshElementCollector.hh"
+#include "KGNavigableMeshElementContainer.hh"
+#include "KGNavigableMeshTree.hh"
+#include "KGNavigableMeshTreeBuilder.hh"
+#include "KGNavigableMeshSearchRoot.hh"
+
+using namespace KGeoBag;
+
+//checks that consecutive search root queries for nearby balls start below the root node
+//and that they find the same node as a search which starts at the root node
+int main()
+{
+    KGBox* box = new KGBox();
+    box->SetX0(-.5); box->SetX1(.5); box->SetXMeshCount(20); box->SetXMeshPower(1);
+    box->SetY0(-.5); box->SetY1(.5); box->SetYMeshCount(20); box->SetYMeshPower(1);
+    box->SetZ0(-.5); box->SetZ1(.5); box->SetZMeshCount(20); box->SetZMeshPower(1);
+
+    KGSurface* cube = new KGSurface(box);
+    cube->SetName("box");
+    cube->MakeExtension<KGMesh>();
+
+    KGMesher tMesher;
+    cube->AcceptNode(&tMesher);
+
+    KGNavigableMeshElementContainer tContainer;
+    KGMeshElementCollector tCollector;
+    tCollector.SetMeshElementContainer(&tContainer);
+    cube->AcceptNode(&tCollector);
+
+    KGNavigableMeshTree tTree;
+    KGNavigableMeshTreeBuilder tBuilder;
+    tBuilder.SetMaxTreeDepth(6);
+    tBuilder.SetNavigableMeshElementContainer(&tContainer);
+    tBuilder.SetTree(&tTree);
+    tBuilder.ConstructTree();
+
+    KGNavigableMeshSearchRoot tCached;
+    tCached.SetTree(&tTree);
+
+    unsigned int tFailures = 0;
+    unsigned int tCachedStarts = 0;
+    const unsigned int tQueries = 200;
+    for(unsigned int i=0; i<tQueries; i++)
+    {
+        //a short track along the face of the box
+        KThreeVector tCenter(-.4 + .8*i/tQueries, .1, .49);
+        double tRadius = 1e-3;
+
+        KGMeshNavigationNode* tNode = tCached.Find(tCenter, tRadius);
+
+        KGNavigableMeshSearchRoot tFresh;
+        tFresh.SetTree(&tTree);
+        KGMeshNavigationNode* tReference = tFresh.Find(tCenter, tRadius);
+
+        if(tNode != tReference)
+        {
+            std::cout << "query " << i << " found a different node than a search from the root node" << std::endl;
+            tFailures++;
+        }
+        if(i > 0 && tCached.GetStartDepth() > 0)
+        {
+            tCachedStarts++;
+        }
+    }
+
+    if(tCachedStarts == 0)
+    {
+        std::cout << "no query started below the root node" << std::endl;
+        tFailures++;
+    }
+
+    //a ball leaving the world cube falls back to the root node
+    if(tCached.Find(KThreeVector(0., 0., 0.), 10.) != tTree.GetRootNode() || tCached.GetStartDepth() != 0)
+    {
+        std::cout << "ball outside the world cube did not return the root node" << std::endl;
+        tFailures++;
+    }
+
+    std::cout << tCachedStarts << " of " << tQueries - 1 << " consecutive queries started below the root node" << std::endl;
+
+    delete cube;
+
+    if(tFailures != 0)
+    {
+        std::cout << "TestMeshSearchRoot failed with " << tFailures << " errors" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "TestMeshSearchRoot passed" << std::endl;
+    return EXIT_SUCCESS;
+}
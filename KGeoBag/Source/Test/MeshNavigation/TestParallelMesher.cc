@@ -0,0 +1,208 @@
+#include <cstdlib>
+#include <iostream>
+#include <typeinfo>
+#include <vector>
+
+#include "KGBox.hh"
+#include "KGCylinder.hh"
+#include "KGRotatedObject.hh"
+#include "KGTorusSpace.hh"
+
+#include "KGMesh.hh"
+#include "KGMesher.hh"
+#include "KGParallelMesher.hh"
+
+using namespace KGeoBag;
+
+namespace
+{
+    //builds the same set of surfaces and spaces on every call, including two surfaces that share one area
+    void BuildGeometry( std::vector< KGSurface* >& aSurfaces, std::vector< KGSpace* >& aSpaces )
+    {
+        for( unsigned int i = 0; i < 6; i++ )
+        {
+            KGCylinder* tCylinder = new KGCylinder();
+            tCylinder->SetP0( KThreeVector( 0.1 * i, 0., -1. ) );
+            tCylinder->SetP1( KThreeVector( 0.1 * i, 0.2 * i, 1. ) );
+            tCylinder->SetRadius( 0.2 + 0.05 * i );
+            tCylinder->SetAxialMeshCount( 12 + 4 * i );
+            tCylinder->SetLongitudinalMeshCount( 10 + 3 * i );
+            tCylinder->SetLongitudinalMeshPower( 1. + 0.5 * i );
+            aSurfaces.push_back( new KGSurface( tCylinder ) );
+        }
+
+        KGCylinder* tSharedCylinder = new KGCylinder();
+        tSharedCylinder->SetP0( KThreeVector( 0., 0., 2. ) );
+        tSharedCylinder->SetP1( KThreeVector( 0., 0., 3. ) );
+        tSharedCylinder->SetRadius( 0.5 );
+        tSharedCylinder->SetAxialMeshCount( 24 );
+        tSharedCylinder->SetLongitudinalMeshCount( 16 );
+        KGSurface* tShared = new KGSurface( tSharedCylinder );
+        KGSurface* tCopy = new KGSurface();
+        tCopy->Area( tShared->Area() );
+        aSurfaces.push_back( tShared );
+        aSurfaces.push_back( tCopy );
+
+        double tP1[ 2 ] = { -1., 0. };
+        double tP2[ 2 ] = { 0., 1. };
+        KGRotatedObject* tHemisphere = new KGRotatedObject( 20, 20 );
+        tHemisphere->AddArc( tP2, tP1, 1., true );
+        aSurfaces.push_back( new KGSurface( new KGRotatedSurface( tHemisphere ) ) );
+
+        KGBox* tBox = new KGBox();
+        tBox->SetX0( -.5 );
+        tBox->SetX1( .5 );
+        tBox->SetXMeshCount( 10 );
+        tBox->SetXMeshPower( 3 );
+        tBox->SetY0( -.5 );
+        tBox->SetY1( .5 );
+        tBox->SetYMeshCount( 12 );
+        tBox->SetYMeshPower( 3 );
+        tBox->SetZ0( -.5 );
+        tBox->SetZ1( .5 );
+        tBox->SetZMeshCount( 14 );
+        tBox->SetZMeshPower( 3 );
+        aSurfaces.push_back( new KGSurface( tBox ) );
+
+        for( unsigned int i = 0; i < 3; i++ )
+        {
+            KGTorusSpace* tTorus = new KGTorusSpace();
+            tTorus->Z( 1. * i );
+            tTorus->R( 2. + 0.5 * i );
+            tTorus->Radius( 0.3 );
+            tTorus->ToroidalMeshCount( 24 + 8 * i );
+            tTorus->AxialMeshCount( 12 );
+            aSpaces.push_back( new KGSpace( tTorus ) );
+        }
+
+        for( std::vector< KGSurface* >::iterator tIt = aSurfaces.begin(); tIt != aSurfaces.end(); tIt++ )
+        {
+            (*tIt)->MakeExtension< KGMesh >();
+        }
+        for( std::vector< KGSpace* >::iterator tIt = aSpaces.begin(); tIt != aSpaces.end(); tIt++ )
+        {
+            (*tIt)->MakeExtension< KGMesh >();
+        }
+    }
+
+    void DeleteGeometry( std::vector< KGSurface* >& aSurfaces, std::vector< KGSpace* >& aSpaces )
+    {
+        for( std::vector< KGSurface* >::iterator tIt = aSurfaces.begin(); tIt != aSurfaces.end(); tIt++ )
+        {
+            delete *tIt;
+        }
+        for( std::vector< KGSpace* >::iterator tIt = aSpaces.begin(); tIt != aSpaces.end(); tIt++ )
+        {
+            delete *tIt;
+        }
+        aSurfaces.clear();
+        aSpaces.clear();
+    }
+
+    //two meshes are equal if they hold elements of the same types with identical edges, in the same order
+    bool MeshesEqual( const KGMeshElementVector* aFirst, const KGMeshElementVector* aSecond )
+    {
+        if( aFirst->size() != aSecond->size() )
+        {
+            return false;
+        }
+        for( unsigned int i = 0; i < aFirst->size(); i++ )
+        {
+            const KGMeshElement* tFirst = aFirst->at( i );
+            const KGMeshElement* tSecond = aSecond->at( i );
+            if( typeid( *tFirst ) != typeid( *tSecond ) || tFirst->Area() != tSecond->Area() || tFirst->GetNumberOfEdges() != tSecond->GetNumberOfEdges() )
+            {
+                return false;
+            }
+            for( unsigned int j = 0; j < tFirst->GetNumberOfEdges(); j++ )
+            {
+                KThreeVector tFirstStart, tFirstEnd, tSecondStart, tSecondEnd;
+                tFirst->GetEdge( tFirstStart, tFirstEnd, j );
+                tSecond->GetEdge( tSecondStart, tSecondEnd, j );
+                if( tFirstStart != tSecondStart || tFirstEnd != tSecondEnd )
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+//checks that meshing on several threads with KGParallelMesher gives the same mesh as the serial KGMesher
+int main()
+{
+    std::vector< KGSurface* > tSerialSurfaces;
+    std::vector< KGSpace* > tSerialSpaces;
+    BuildGeometry( tSerialSurfaces, tSerialSpaces );
+
+    KGMesher tMesher;
+    for( std::vector< KGSurface* >::iterator tIt = tSerialSurfaces.begin(); tIt != tSerialSurfaces.end(); tIt++ )
+    {
+        (*tIt)->AcceptNode( &tMesher );
+    }
+    for( std::vector< KGSpace* >::iterator tIt = tSerialSpaces.begin(); tIt != tSerialSpaces.end(); tIt++ )
+    {
+        (*tIt)->AcceptNode( &tMesher );
+    }
+
+    unsigned int tFailures = 0;
+    unsigned int tElements = 0;
+
+    const unsigned int tThreadCounts[ 4 ] = { 1, 2, 4, 8 };
+    for( unsigned int tThreadIndex = 0; tThreadIndex < 4; tThreadIndex++ )
+    {
+        std::vector< KGSurface* > tSurfaces;
+        std::vector< KGSpace* > tSpaces;
+        BuildGeometry( tSurfaces, tSpaces );
+
+        KGParallelMesher tParallelMesher;
+        tParallelMesher.SetNThreads( tThreadCounts[ tThreadIndex ] );
+        for( std::vector< KGSurface* >::iterator tIt = tSurfaces.begin(); tIt != tSurfaces.end(); tIt++ )
+        {
+            tParallelMesher.AddSurface( *tIt );
+        }
+        for( std::vector< KGSpace* >::iterator tIt = tSpaces.begin(); tIt != tSpaces.end(); tIt++ )
+        {
+            tParallelMesher.AddSpace( *tIt );
+        }
+        tParallelMesher.Mesh();
+
+        for( unsigned int i = 0; i < tSurfaces.size(); i++ )
+        {
+            const KGMeshElementVector* tSerial = tSerialSurfaces[ i ]->AsExtension< KGMesh >()->Elements();
+            const KGMeshElementVector* tParallel = tSurfaces[ i ]->AsExtension< KGMesh >()->Elements();
+            if( tSerial->empty() || MeshesEqual( tSerial, tParallel ) == false )
+            {
+                std::cout << "surface " << i << " meshed with " << tThreadCounts[ tThreadIndex ] << " threads differs from the serial mesh" << std::endl;
+                tFailures++;
+            }
+            tElements += tParallel->size();
+        }
+        for( unsigned int i = 0; i < tSpaces.size(); i++ )
+        {
+            const KGMeshElementVector* tSerial = tSerialSpaces[ i ]->AsExtension< KGMesh >()->Elements();
+            const KGMeshElementVector* tParallel = tSpaces[ i ]->AsExtension< KGMesh >()->Elements();
+            if( tSerial->empty() || MeshesEqual( tSerial, tParallel ) == false )
+            {
+                std::cout << "space " << i << " meshed with " << tThreadCounts[ tThreadIndex ] << " threads differs from the serial mesh" << std::endl;
+                tFailures++;
+            }
+            tElements += tParallel->size();
+        }
+
+        DeleteGeometry( tSurfaces, tSpaces );
+    }
+
+    DeleteGeometry( tSerialSurfaces, tSerialSpaces );
+
+    std::cout << "compared " << tElements << " mesh elements" << std::endl;
+
+    if( tFailures != 0 )
+    {
+        std::cout << "TestParallelMesher failed with " << tFailures << " errors" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "TestParallelMesher passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -1,33 +1,89 @@
 #include "KSMainMessage.h"
+#include "KSMutex.h"
 #include "KRootFile.h"
 
 #include "TFile.h"
 #include "TObjString.h"
 #include "TTree.h"
-#include "TObjArray.h"
-#include "TBranch.h"
-#include "TLeaf.h"
+#include "TTreeCloner.h"
+#include "TROOT.h"
+#include "RVersion.h"
+
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cstdlib>
 
 #include <string>
+#include <vector>
 #include <iostream>
-#include <map>
 
 using namespace std;
 using namespace katrin;
 using namespace Kassiopeia;
 
-typedef vector< pair< string, TTree* > > DataTreeVector;
+// reading files from several threads requires ROOT's global locks, which are only available since ROOT 6.06
+#if ROOT_VERSION_CODE >= ROOT_VERSION( 6, 6, 0 )
+#define ROOTFILEMERGE_USE_THREADS
+#endif
+
+enum Level
+{
+    eRun = 0, eEvent = 1, eTrack = 2, eStep = 3, eLevels = 4
+};
+
+static const string sLevelNames[ eLevels ] = { "RUN", "EVENT", "TRACK", "STEP" };
+
+static const int sBufferSize = 64000;
+static const size_t sPrefetchSize = 4 * 1024 * 1024;
+static const int sSplitSize = 99;
+
+// label and type of every component of one output group
+typedef vector< pair< string, string > > GroupStructure;
+
+// all output groups of one level, in the order of the key tree
+struct LevelStructure
+{
+    vector< string > fKeys;
+    vector< GroupStructure > fGroups;
+
+    bool operator==( const LevelStructure& aStructure ) const
+    {
+        return (fKeys == aStructure.fKeys) && (fGroups == aStructure.fGroups);
+    }
+};
 
-struct Trees {
-    TTree *tRunTree;
-    TTree *tEventTree;
-    TTree *tTrackTree;
-    TTree *tStepTree;
+struct InputFile
+{
+    InputFile( const string& aName ) :
+        fName( aName ),
+        fError( "" )
+    {
+        for( unsigned int tLevel = 0; tLevel < eLevels; tLevel++ )
+        {
+            fEntries[ tLevel ] = 0;
+        }
+    }
 
-    TTree *tRunKeysTree;
-    TTree *tEventKeysTree;
-    TTree *tTrackKeysTree;
-    TTree *tStepKeysTree;
+    string fName;
+    string fError;
+    LevelStructure fStructure[ eLevels ];
+    Long64_t fEntries[ eLevels ];
+};
+
+struct ScanQueue
+{
+    vector< InputFile >* fFiles;
+    unsigned int fNext;
+    KSMutex fMutex;
+};
+
+// file read ahead of the merge into the page cache
+struct Prefetch
+{
+    string fName;
+    pthread_t fThread;
+    bool fRunning;
 };
 
 struct Indices {
@@ -38,810 +94,578 @@ struct Indices {
     unsigned int tRunLastTrack;
     unsigned int tRunFirstStep;
     unsigned int tRunLastStep;
+
     unsigned int tEventIndex;
     unsigned int tEventFirstTrack;
     unsigned int tEventLastTrack;
     unsigned int tEventFirstStep;
     unsigned int tEventLastStep;
+
     unsigned int tTrackIndex;
     unsigned int tTrackFirstStep;
     unsigned int tTrackLastStep;
+
     unsigned int tStepIndex;
 };
 
-struct DataMap {
-
-    DataMap() :
-        tStructureLabelPointer( &tStructureLabel ),
-        tStructureLabelHandle( &tStructureLabelPointer ),
-        tStructureTypePointer( &tStructureType ),
-        tStructureTypeHandle( &tStructureTypePointer ),
-        tPresenceIndex( 0 ),
-        tPresenceIndexPointer( &tPresenceIndex ),
-        tPresenceLength( 0 ),
-        tPresenceLengthPointer( &tPresenceLength )
-    {
-    }
-
-    string tStructureLabel;
-    string *tStructureLabelPointer;
-    string **tStructureLabelHandle;
-    string tStructureType;
-    string *tStructureTypePointer;
-    string **tStructureTypeHandle;
-    unsigned int tPresenceIndex;
-    unsigned int *tPresenceIndexPointer;
-    unsigned int tPresenceLength;
-    unsigned int *tPresenceLengthPointer;
-    map< string, Bool_t > tBoolMap;
-    map< string, UChar_t > tUCharMap;
-    map< string, Char_t > tCharMap;
-    map< string, UShort_t > tUShortMap;
-    map< string, Short_t > tShortMap;
-    map< string, UInt_t > tUIntMap;
-    map< string, Int_t > tIntMap;
-    map< string, ULong64_t > tULongMap;
-    map< string, Long64_t > tLongMap;
-    map< string, Float_t > tFloatMap;
-    map< string, Double_t > tDoubleMap;
-    map< string, string > tStringMap;
-    map< string, string* > tStringPointerMap;
-    map< string, Double_t > tTwoVectorXMap;
-    map< string, Double_t > tTwoVectorYMap;
-    map< string, Double_t > tThreeVectorXMap;
-    map< string, Double_t > tThreeVectorYMap;
-    map< string, Double_t > tThreeVectorZMap;
+// output trees of one level
+struct OutputLevel
+{
+    TTree* fKeys;
+    TTree* fIndices;
+    vector< TTree* > fStructures;
+    vector< TTree* > fPresences;
+    vector< TTree* > fData;
 };
 
 //function declarations
-TTree* GetTree( KRootFile *tInputRootFile, TString tName );
-void CheckLabel( KRootFile *tInputRootFile );
-void GetIndicesBranchAddresses( Trees *tTrees, Indices *tIndices );
-void GetDataTrees( KRootFile *tInputFile, TTree *tKeyTree, DataTreeVector *tDataTreeVector, bool first );
-void GetDataBranches( TTree *tStructureTree, TTree *tPresenceTree, TTree *tDataTree, DataMap *tDataMap );
-void WriteIndexTrees( KRootFile *tRootFile, Trees *tTrees, Indices *tIndices, const int tBufferSize, const int tSplitSize );
-void WriteDataTrees( KRootFile *tRootFile, DataTreeVector *tOutputDataTreeVector, DataTreeVector *tDataTreeVector );
-void WriteDataBranches( TTree *tStructureTree, TTree *tPresenceTree, TTree *tDataTree, DataMap *tDataMap, const int tBufferSize, const int tSplitSize );
-void FillDataStructureBranch( TTree *tOutputStructureTree, TTree *tInputStructureTree );
-void GetWriteFillKeyTrees( KRootFile *tRootFile, Trees *tInputTrees, Trees *tOutputTrees, const int tBufferSize, const int tSplitSize );
-void FillIndexTrees( Trees *tOutputTrees, Trees *tInputTrees, Indices *tIndices );
-void FillDataBranches( TTree *tOutputDataTree, TTree *tInputDataTree );
-void FillDataPresenceBranch( TTree *tOutputDataPresenceTree, TTree *tInputDataPresenceTree, DataMap *tDataMap );
-
+bool ScanFile( InputFile& aFile );
+void* ScanWorker( void* aQueue );
+void ScanFiles( vector< InputFile >& aFiles, unsigned int aThreads );
+bool ReadStructure( TFile* aFile, const string& aLevelName, LevelStructure& aStructure, string& anError );
+void StartPrefetch( Prefetch& aPrefetch, const string& aName );
+void FinishPrefetch( Prefetch& aPrefetch );
+void* PrefetchWorker( void* aPrefetch );
+
+void SetIndexBranches( TTree* aTree, const Level& aLevel, Indices* anIndices, bool aWrite );
+void CreateOutputLevel( TFile* aFile, const Level& aLevel, const LevelStructure& aStructure, OutputLevel& anOutput, Indices* anIndices );
+void FillIndexTree( TTree* anOutputTree, TTree* anInputTree, const Level& aLevel, Indices* anIndices, const Long64_t* anOffsets );
+void FillPresenceTree( TTree* anOutputTree, TTree* anInputTree, const Long64_t& anOffset );
+void CopyDataTree( TFile* anOutputFile, TTree*& anOutputTree, TTree* anInputTree );
 
 int main( int argc, char** argv )
 {
     KMessageTable::GetInstance().SetTerminalVerbosity( eNormal );
     KMessageTable::GetInstance().SetLogVerbosity( eNormal );
 
-    const int tBufferSize = 64000;
-    const int tSplitSize = 99;
+    unsigned int tThreads = sysconf( _SC_NPROCESSORS_ONLN );
+    int tFirstArgument = 1;
+    if( argc > 2 && string( argv[ 1 ] ) == string( "-j" ) )
+    {
+        tThreads = atoi( argv[ 2 ] );
+        tFirstArgument = 3;
+    }
 
-    if( argc < 4 )
+    if( argc - tFirstArgument < 3 )
     {
-        cout << "usage: ./ROOTFileMerge <input_file_1> <input_file_2> [<input_file_3> <...>] <output_file>" << endl;
+        cout << "usage: ./ROOTFileMerge [-j <threads>] <input_file_1> <input_file_2> [<input_file_3> <...>] <output_file>" << endl;
         exit( -1 );
     }
-    mainmsg( eNormal ) << "Analyzing " << argc - 2 << " files" << eom;
 
-    Trees *tInputTrees = new Trees();
-    Trees *tOutputTrees = new Trees();
-
-    Indices *tIndices = new Indices();
-
-    DataTreeVector *tRunDataTrees = new DataTreeVector();
-    DataTreeVector *tEventDataTrees = new DataTreeVector();
-    DataTreeVector *tTrackDataTrees = new DataTreeVector();
-    DataTreeVector *tStepDataTrees = new DataTreeVector();
-    DataTreeVector *tOutputRunDataTrees = new DataTreeVector();
-    DataTreeVector *tOutputEventDataTrees = new DataTreeVector();
-    DataTreeVector *tOutputTrackDataTrees = new DataTreeVector();
-    DataTreeVector *tOutputStepDataTrees = new DataTreeVector();
+    vector< InputFile > tInputFiles;
+    for( int tArgument = tFirstArgument; tArgument < argc - 1; tArgument++ )
+    {
+        tInputFiles.push_back( InputFile( argv[ tArgument ] ) );
+    }
 
-    //maps for data
-    vector< DataMap * > tRunDataMapVector;
-    vector< DataMap * > tEventDataMapVector;
-    vector< DataMap * > tTrackDataMapVector;
-    vector< DataMap * > tStepDataMapVector;
+    //make the output file '.root'
+    string tOutputname( argv[ argc - 1 ] );
+    if( tOutputname.length() < 5 || tOutputname.substr( tOutputname.length() - 5, tOutputname.length() - 1 ) != ".root" )
+    {
+        tOutputname += string( ".root" );
+    }
 
-    //save number of indices in each data output
-    vector< unsigned int > tNumRunDataEntries;
-    vector< unsigned int > tNumEventDataEntries;
-    vector< unsigned int > tNumTrackDataEntries;
-    vector< unsigned int > tNumStepDataEntries;
+    //scan and validate all input files before anything is written
+    mainmsg( eNormal ) << "Analyzing " << tInputFiles.size() << " files" << eom;
+    ScanFiles( tInputFiles, tThreads );
 
-    KRootFile* tInputRootFile;
-    string tInputname;
+    bool tValid = true;
+    const InputFile& tReference = tInputFiles.front();
+    for( vector< InputFile >::iterator tIt = tInputFiles.begin(); tIt != tInputFiles.end(); tIt++ )
+    {
+        if( ! tIt->fError.empty() )
+        {
+            mainmsg( eWarning ) << "File <" << tIt->fName << ">: " << tIt->fError << eom;
+            tValid = false;
+            continue;
+        }
+        for( unsigned int tLevel = 0; tLevel < eLevels; tLevel++ )
+        {
+            if( ! (tIt->fStructure[ tLevel ] == tReference.fStructure[ tLevel ]) )
+            {
+                mainmsg( eWarning ) << "File <" << tIt->fName << "> has a different " << sLevelNames[ tLevel ] << " output structure than <" << tReference.fName << ">" << eom;
+                tValid = false;
+            }
+        }
+    }
+    if( tValid == false )
+    {
+        mainmsg( eError ) << "Input files can not be merged. Exiting..." << eom;
+        exit( -1 );
+    }
 
     //make output file
     KRootFile* tOutputRootFile = new KRootFile();
-    string tOutputname( argv[argc-1] );
-
-    //make the output file '.root'
-    if( tOutputname.length() < 5 || tOutputname.substr( tOutputname.length()-5, tOutputname.length()-1 ) != ".root")
-    {
-        tOutputname+=string(".root");
-    }
     tOutputRootFile->AddToNames( tOutputname );
-
     if( tOutputRootFile->Open( KFile::eWrite ) == false )
     {
         mainmsg( eError ) << "Could not make file: <" << tOutputname << "> Exiting..." << eom;
         exit( -1 );
     }
+    TFile* tOutputFile = tOutputRootFile->File();
 
     //set kassiopeia label for output file
     TObjString* fLabel = new TObjString( string( "KASSIOPEIA_TREE_DATA" ).c_str() );
     fLabel->Write( "LABEL", TObject::kOverwrite );
+
     TTree::SetBranchStyle( 1 );
 
+    Indices* tIndices = new Indices();
+    OutputLevel tOutput[ eLevels ];
+    for( unsigned int tLevel = 0; tLevel < eLevels; tLevel++ )
+    {
+        CreateOutputLevel( tOutputFile, (Level) tLevel, tReference.fStructure[ tLevel ], tOutput[ tLevel ], tIndices );
+    }
+
+    //index offsets of the current input file in the merged output
+    Long64_t tOffsets[ eLevels ] = { 0, 0, 0, 0 };
 
-    //loop over all input files
-    for( int i = 0; i < argc - 2; ++i )
+    //while one file is merged, the next one is read from disk by a second thread
+    Prefetch tPrefetch;
+    tPrefetch.fRunning = false;
+
+    for( unsigned int tFileIndex = 0; tFileIndex < tInputFiles.size(); tFileIndex++ )
     {
-        tInputRootFile = new KRootFile();
-        tInputname = argv[i+1];
-        tInputRootFile->AddToNames( tInputname );
-        mainmsg( eNormal ) << "Analyzing file " << i+1 << " of " << argc - 2 << ": <" << tInputname << ">" << eom;
+        const InputFile& tInput = tInputFiles.at( tFileIndex );
+        mainmsg( eNormal ) << "Merging file " << tFileIndex + 1 << " of " << tInputFiles.size() << ": <" << tInput.fName << ">" << eom;
 
-        //read input file
-        if( tInputRootFile->Open( KFile::eRead ) == false )
+        FinishPrefetch( tPrefetch );
+        if( tThreads > 1 && tFileIndex + 1 < tInputFiles.size() )
         {
-            mainmsg( eError ) << "Could not read file: <" << tInputname << ">. Exiting..." << eom;
-            exit( -1 );
+            StartPrefetch( tPrefetch, tInputFiles.at( tFileIndex + 1 ).fName );
         }
 
-        //check input file for kassiopeia label
-        CheckLabel( tInputRootFile );
-
-        mainmsg( eDebug ) << "Getting indices and key trees..." << eom;
-        //get all index and key trees included in any kassiopeia root file
-        tInputTrees->tRunTree = GetTree( tInputRootFile, "RUN_DATA" );
-        tInputTrees->tEventTree = GetTree( tInputRootFile, "EVENT_DATA" );
-        tInputTrees->tTrackTree = GetTree( tInputRootFile, "TRACK_DATA" );
-        tInputTrees->tStepTree = GetTree( tInputRootFile, "STEP_DATA" );
-        tInputTrees->tRunKeysTree = GetTree( tInputRootFile, "RUN_KEYS" );
-        tInputTrees->tEventKeysTree = GetTree( tInputRootFile, "EVENT_KEYS" );
-        tInputTrees->tTrackKeysTree = GetTree( tInputRootFile, "TRACK_KEYS" );
-        tInputTrees->tStepKeysTree = GetTree( tInputRootFile, "STEP_KEYS" );
-
-        mainmsg( eDebug ) << "GetIndicesBranchAddresses..." << eom;
-        //set all local addresses to the addresses in the input file
-        GetIndicesBranchAddresses( tInputTrees, tIndices );
-
-        //create basic output tree structures after reading the first file
-        if( i == 0 )
+        TFile* tInputFile = TFile::Open( tInput.fName.c_str(), "READ" );
+        if( tInputFile == NULL || tInputFile->IsZombie() )
         {
-            mainmsg( eDebug ) << "Getting all data trees..." << eom;
-            //get all data trees which may be included in the input file
-            GetDataTrees( tInputRootFile, tInputTrees->tRunKeysTree, tRunDataTrees, true );
-            GetDataTrees( tInputRootFile, tInputTrees->tEventKeysTree, tEventDataTrees, true );
-            GetDataTrees( tInputRootFile, tInputTrees->tTrackKeysTree, tTrackDataTrees, true );
-            GetDataTrees( tInputRootFile, tInputTrees->tStepKeysTree, tStepDataTrees, true );
-
-            mainmsg( eDebug ) << "Getting all data branches..." << eom;
-            //get all data branches in any data trees found before
-            for( DataTreeVector::iterator tIt = tRunDataTrees->begin(); tIt != tRunDataTrees->end(); tIt += 3 )
-            {
-                tRunDataMapVector.push_back( new DataMap() );
-                GetDataBranches( (*tIt).second, (*(tIt+1)).second, (*(tIt+2)).second, tRunDataMapVector.back() );
-            }
-            for( DataTreeVector::iterator tIt = tEventDataTrees->begin(); tIt != tEventDataTrees->end(); tIt += 3 )
-            {
-                tEventDataMapVector.push_back( new DataMap() );
-                GetDataBranches( (*tIt).second, (*(tIt+1)).second, (*(tIt+2)).second, tEventDataMapVector.back() );
-            }
-            for( DataTreeVector::iterator tIt = tTrackDataTrees->begin(); tIt != tTrackDataTrees->end(); tIt += 3 )
-            {
-                tTrackDataMapVector.push_back( new DataMap() );
-                GetDataBranches( (*tIt).second, (*(tIt+1)).second, (*(tIt+2)).second, tTrackDataMapVector.back() );
-            }
-            for( DataTreeVector::iterator tIt = tStepDataTrees->begin(); tIt != tStepDataTrees->end(); tIt += 3 )
-            {
-                tStepDataMapVector.push_back( new DataMap() );
-                GetDataBranches( (*tIt).second, (*(tIt+1)).second, (*(tIt+2)).second, tStepDataMapVector.back() );
-            }
+            mainmsg( eError ) << "Could not read file: <" << tInput.fName << ">. Exiting..." << eom;
+            exit( -1 );
+        }
 
-            //initialize numlength variables
-            for( unsigned int tI = 0; tI < tRunDataMapVector.size(); ++tI )
-            {
-                tNumRunDataEntries.push_back( 0 );
-            }
-            for( unsigned int tI = 0; tI < tEventDataMapVector.size(); ++tI )
-            {
-                tNumEventDataEntries.push_back( 0 );
-            }
-            for( unsigned int tI = 0; tI < tTrackDataMapVector.size(); ++tI )
-            {
-                tNumTrackDataEntries.push_back( 0 );
-            }
-            for( unsigned int tI = 0; tI < tStepDataMapVector.size(); ++tI )
-            {
-                tNumStepDataEntries.push_back( 0 );
-            }
+        for( unsigned int tLevel = 0; tLevel < eLevels; tLevel++ )
+        {
+            const LevelStructure& tStructure = tReference.fStructure[ tLevel ];
+            OutputLevel& tOutputLevel = tOutput[ tLevel ];
 
-            //write the tree structure into the output file
-            WriteIndexTrees( tOutputRootFile, tOutputTrees, tIndices, tBufferSize, tSplitSize );
+            //only the index and presence trees need their contents rewritten
+            TTree* tIndexTree = (TTree*) (tInputFile->Get( (sLevelNames[ tLevel ] + string( "_DATA" )).c_str() ));
+            FillIndexTree( tOutputLevel.fIndices, tIndexTree, (Level) tLevel, tIndices, tOffsets );
 
-            //get, write and fill the key trees
-            GetWriteFillKeyTrees( tOutputRootFile, tInputTrees, tOutputTrees, tBufferSize, tSplitSize );
+            for( unsigned int tGroup = 0; tGroup < tStructure.fKeys.size(); tGroup++ )
+            {
+                const string& tKey = tStructure.fKeys.at( tGroup );
 
-            //write all data trees which may be included in the input file
-            WriteDataTrees( tOutputRootFile, tOutputRunDataTrees, tRunDataTrees );
-            WriteDataTrees( tOutputRootFile, tOutputEventDataTrees, tEventDataTrees );
-            WriteDataTrees( tOutputRootFile, tOutputTrackDataTrees, tTrackDataTrees );
-            WriteDataTrees( tOutputRootFile, tOutputStepDataTrees, tStepDataTrees );
+                TTree* tPresenceTree = (TTree*) (tInputFile->Get( (tKey + string( "_PRESENCE" )).c_str() ));
+                FillPresenceTree( tOutputLevel.fPresences.at( tGroup ), tPresenceTree, tOffsets[ tLevel ] );
 
-            //write all data branches in any data trees
-            for( unsigned int tI = 0; tI < tOutputRunDataTrees->size(); tI += 3 )
-            {
-                WriteDataBranches( tOutputRunDataTrees->at( tI ).second, tOutputRunDataTrees->at( tI+1 ).second, tOutputRunDataTrees->at( tI+2 ).second, tRunDataMapVector[tI/3], tBufferSize, tSplitSize );
-                FillDataStructureBranch( tOutputRunDataTrees->at( tI ).second, tRunDataTrees->at( tI ).second );
-            }
-            for( unsigned int tI = 0; tI < tOutputEventDataTrees->size(); tI += 3 )
-            {
-                WriteDataBranches( tOutputEventDataTrees->at( tI ).second, tOutputEventDataTrees->at( tI+1 ).second, tOutputEventDataTrees->at( tI+2 ).second, tEventDataMapVector[tI/3], tBufferSize, tSplitSize );
-                FillDataStructureBranch( tOutputEventDataTrees->at( tI ).second, tEventDataTrees->at( tI ).second );
-            }
-            for( unsigned int tI = 0; tI < tOutputTrackDataTrees->size(); tI += 3 )
-            {
-                WriteDataBranches( tOutputTrackDataTrees->at( tI ).second, tOutputTrackDataTrees->at( tI+1 ).second, tOutputTrackDataTrees->at( tI+2 ).second, tTrackDataMapVector[tI/3], tBufferSize, tSplitSize );
-                FillDataStructureBranch( tOutputTrackDataTrees->at( tI ).second, tTrackDataTrees->at( tI ).second );
-            }
-            for( unsigned int tI = 0; tI < tOutputStepDataTrees->size(); tI += 3 )
-            {
-                WriteDataBranches( tOutputStepDataTrees->at( tI ).second, tOutputStepDataTrees->at( tI+1 ).second, tOutputStepDataTrees->at( tI+2 ).second, tStepDataMapVector[tI/3], tBufferSize, tSplitSize );
-                FillDataStructureBranch( tOutputStepDataTrees->at( tI ).second, tStepDataTrees->at( tI ).second );
+                TTree* tDataTree = (TTree*) (tInputFile->Get( (tKey + string( "_DATA" )).c_str() ));
+                CopyDataTree( tOutputFile, tOutputLevel.fData.at( tGroup ), tDataTree );
             }
         }
-        else
-        {
-            mainmsg( eDebug ) << "Getting all data trees..." << eom;
-            //get all data trees which may be included in the input file
-            GetDataTrees( tInputRootFile, tInputTrees->tRunKeysTree, tRunDataTrees, false );
-            GetDataTrees( tInputRootFile, tInputTrees->tEventKeysTree, tEventDataTrees, false );
-            GetDataTrees( tInputRootFile, tInputTrees->tTrackKeysTree, tTrackDataTrees, false );
-            GetDataTrees( tInputRootFile, tInputTrees->tStepKeysTree, tStepDataTrees, false );
-
-            mainmsg( eDebug ) << "Getting all data branches..." << eom;
-            //get all data branches in any data trees found before
-            unsigned int tIndex = 0;
-            for( DataTreeVector::iterator tIt = tRunDataTrees->begin(); tIt != tRunDataTrees->end(); tIt += 3 )
-            {
-                GetDataBranches( (*tIt).second, (*(tIt+1)).second, (*(tIt+2)).second, tRunDataMapVector.at(tIndex) );
-                ++tIndex;
-            }
-            tIndex = 0;
-            for( DataTreeVector::iterator tIt = tEventDataTrees->begin(); tIt != tEventDataTrees->end(); tIt += 3 )
-            {
-                GetDataBranches( (*tIt).second, (*(tIt+1)).second, (*(tIt+2)).second, tEventDataMapVector.at(tIndex) );
-                ++tIndex;
-            }
-            tIndex = 0;
-            for( DataTreeVector::iterator tIt = tTrackDataTrees->begin(); tIt != tTrackDataTrees->end(); tIt += 3 )
-            {
-                GetDataBranches( (*tIt).second, (*(tIt+1)).second, (*(tIt+2)).second, tTrackDataMapVector.at(tIndex) );
-                ++tIndex;
-            }
-            tIndex = 0;
-            for( DataTreeVector::iterator tIt = tStepDataTrees->begin(); tIt != tStepDataTrees->end(); tIt += 3 )
-            {
-                GetDataBranches( (*tIt).second, (*(tIt+1)).second, (*(tIt+2)).second, tStepDataMapVector.at(tIndex) );
-                ++tIndex;
-            }
-        }
-
-        mainmsg( eDebug ) << "FillIndexTrees..." << eom;
-        //put new index data in the combined output file
-        FillIndexTrees( tOutputTrees, tInputTrees, tIndices );
 
-        mainmsg( eDebug ) << "FillDataBranches..." << eom;
-        //fill data branches in the combined output file
-        for( unsigned int tI = 0; tI < tOutputRunDataTrees->size(); tI += 3 )
-        {
-            FillDataPresenceBranch( tOutputRunDataTrees->at( tI+1 ).second, tRunDataTrees->at( tI+1 ).second, tRunDataMapVector.at( tI/3 ) );
-            FillDataBranches( tOutputRunDataTrees->at( tI+2 ).second, tRunDataTrees->at( tI+2 ).second );
-        }
-        for( unsigned int tI = 0; tI < tOutputEventDataTrees->size(); tI += 3 )
-        {
-            FillDataPresenceBranch( tOutputEventDataTrees->at( tI+1 ).second, tEventDataTrees->at( tI+1 ).second, tEventDataMapVector.at( tI/3 ) );
-            FillDataBranches( tOutputEventDataTrees->at( tI+2 ).second, tEventDataTrees->at( tI+2 ).second );
-        }
-        for( unsigned int tI = 0; tI < tOutputTrackDataTrees->size(); tI += 3 )
+        for( unsigned int tLevel = 0; tLevel < eLevels; tLevel++ )
         {
-            FillDataPresenceBranch( tOutputTrackDataTrees->at( tI+1 ).second, tTrackDataTrees->at( tI+1 ).second, tTrackDataMapVector.at( tI/3 ) );
-            FillDataBranches( tOutputTrackDataTrees->at( tI+2 ).second, tTrackDataTrees->at( tI+2 ).second );
-        }
-        for( unsigned int tI = 0; tI < tOutputStepDataTrees->size(); tI += 3 )
-        {
-            FillDataPresenceBranch( tOutputStepDataTrees->at( tI+1 ).second, tStepDataTrees->at( tI+1 ).second, tStepDataMapVector.at( tI/3 ) );
-            FillDataBranches( tOutputStepDataTrees->at( tI+2 ).second, tStepDataTrees->at( tI+2 ).second );
+            tOffsets[ tLevel ] += tInput.fEntries[ tLevel ];
         }
 
-        //close file and delete file pointer before analyzing next file
-        tInputRootFile->Close();
-        delete tInputRootFile;
+        tInputFile->Close();
+        delete tInputFile;
     }
+    FinishPrefetch( tPrefetch );
 
-    mainmsg( eNormal ) << "Writing file: <" << tOutputname << ">. This can take a while..." << eom;
-
-    tOutputRootFile->File()->Write( "", TObject::kOverwrite );
+    mainmsg( eNormal ) << "Writing file: <" << tOutputname << ">" << eom;
+    tOutputFile->Write( "", TObject::kOverwrite );
     tOutputRootFile->Close();
+    delete tOutputRootFile;
+    delete tIndices;
 
-    mainmsg( eNormal ) << "Wrote file: <" << tOutputname << ">" << eom;
+    mainmsg( eNormal ) << "Wrote " << tOffsets[ eRun ] << " runs, " << tOffsets[ eEvent ] << " events, " << tOffsets[ eTrack ] << " tracks and " << tOffsets[ eStep ] << " steps to file: <" << tOutputname << ">" << eom;
     mainmsg( eNormal ) << "Merge completed. Exiting..." << eom;
-}
-
 
-TTree* GetTree( KRootFile *tInputRootFile, TString tName )
-{
-    TTree *tTree = (TTree*) (tInputRootFile->File()->Get( tName ) );
-    if( !tTree )
-    {
-        mainmsg( eError ) << "File <" << tInputRootFile->GetName() << "> has no Tree " << tName << ". Exiting..." << eom;
-        exit( -1 );
-    }
-    return tTree;
+    return 0;
 }
 
-void CheckLabel( KRootFile *tInputRootFile )
+void ScanFiles( vector< InputFile >& aFiles, unsigned int aThreads )
 {
-    TObjString *tLabel = (TObjString*) (tInputRootFile->File()->Get( "LABEL" ));
-    if( !tLabel )
+    ScanQueue tQueue;
+    tQueue.fFiles = &aFiles;
+    tQueue.fNext = 0;
+
+#ifdef ROOTFILEMERGE_USE_THREADS
+    if( aThreads > aFiles.size() )
     {
-        mainmsg( eError ) << "File <" << tInputRootFile->GetName() << "> has no LABEL. Probably not a Kassiopeia file. Exiting..." << eom;
-        exit( -1 );
+        aThreads = aFiles.size();
     }
+    if( aThreads > 1 )
+    {
+        ROOT::EnableThreadSafety();
 
-    if( tLabel->GetString().CompareTo( string( "KASSIOPEIA_TREE_DATA" ).c_str() ) != 0 )
+        vector< pthread_t > tThreads( aThreads );
+        for( unsigned int tThread = 0; tThread < aThreads; tThread++ )
+        {
+            pthread_create( &(tThreads[ tThread ]), NULL, &ScanWorker, &tQueue );
+        }
+        for( unsigned int tThread = 0; tThread < aThreads; tThread++ )
+        {
+            pthread_join( tThreads[ tThread ], NULL );
+        }
+        return;
+    }
+#else
+    if( aThreads > 1 )
     {
-        mainmsg( eError ) << "File's <" << tInputRootFile->GetName() << "> LABEL is not 'KASSIOPEIA_TREE_DATA'. Probably not a Kassiopeia File. Exiting..." << eom;
-        exit( -1 );
+        mainmsg( eWarning ) << "Concurrent reading requires ROOT 6.06 or newer, scanning files sequentially" << eom;
     }
-}
+#endif
 
-void GetIndicesBranchAddresses( Trees *tTrees, Indices *tIndices )
-{
-    tTrees->tRunTree->SetBranchAddress( "RUN_INDEX", &(tIndices->tRunIndex) );
-    tTrees->tRunTree->SetBranchAddress( "FIRST_EVENT_INDEX", &(tIndices->tRunFirstEvent) );
-    tTrees->tRunTree->SetBranchAddress( "LAST_EVENT_INDEX", &(tIndices->tRunLastEvent) );
-    tTrees->tRunTree->SetBranchAddress( "FIRST_TRACK_INDEX", &(tIndices->tRunFirstTrack) );
-    tTrees->tRunTree->SetBranchAddress( "LAST_TRACK_INDEX", &(tIndices->tRunLastTrack) );
-    tTrees->tRunTree->SetBranchAddress( "FIRST_STEP_INDEX", &(tIndices->tRunFirstStep) );
-    tTrees->tRunTree->SetBranchAddress( "LAST_STEP_INDEX", &(tIndices->tRunLastStep) );
-
-    tTrees->tEventTree->SetBranchAddress( "EVENT_INDEX", &(tIndices->tEventIndex) );
-    tTrees->tEventTree->SetBranchAddress( "FIRST_TRACK_INDEX", &(tIndices->tEventFirstTrack) );
-    tTrees->tEventTree->SetBranchAddress( "LAST_TRACK_INDEX", &(tIndices->tEventLastTrack) );
-    tTrees->tEventTree->SetBranchAddress( "FIRST_STEP_INDEX", &(tIndices->tEventFirstStep) );
-    tTrees->tEventTree->SetBranchAddress( "LAST_STEP_INDEX", &(tIndices->tEventLastStep) );
-
-    tTrees->tTrackTree->SetBranchAddress( "TRACK_INDEX", &(tIndices->tTrackIndex) );
-    tTrees->tTrackTree->SetBranchAddress( "FIRST_STEP_INDEX", &(tIndices->tTrackFirstStep ) );
-    tTrees->tTrackTree->SetBranchAddress( "LAST_STEP_INDEX", &(tIndices->tTrackLastStep) );
-
-    tTrees->tStepTree->SetBranchAddress( "STEP_INDEX", &(tIndices->tStepIndex) );
+    ScanWorker( &tQueue );
+    return;
 }
 
-void GetDataTrees( KRootFile *tInputFile, TTree *tKeyTree, DataTreeVector *tDataTreeVector, bool first )
+void* ScanWorker( void* aQueue )
 {
-    string tKey;
-    string* tKeyPointer = &tKey;
-    string** tKeyHandle = &tKeyPointer;
-    string tDataTreeName;
-
-    tKeyTree->SetBranchAddress( "KEY", tKeyHandle );
-    for( Long64_t tKeyIndex = 0; tKeyIndex < tKeyTree->GetEntries(); tKeyIndex++ )
+    ScanQueue* tQueue = (ScanQueue*) (aQueue);
+    while( true )
     {
-        tKeyTree->GetEntry( tKeyIndex );
+        tQueue->fMutex.Lock();
+        unsigned int tIndex = tQueue->fNext++;
+        tQueue->fMutex.Unlock();
 
-        tDataTreeName = tKey + string( "_STRUCTURE" );
-        if( first )
-            tDataTreeVector->push_back( make_pair( tDataTreeName, ( TTree * ) tInputFile->File()->Get( tDataTreeName.c_str() ) ) );
-        else
-            tDataTreeVector->at(3*tKeyIndex) = ( make_pair( tDataTreeName, ( TTree * ) tInputFile->File()->Get( tDataTreeName.c_str() ) ) );
-
-        tDataTreeName = tKey + string( "_PRESENCE" );
-        if( first )
-            tDataTreeVector->push_back( make_pair( tDataTreeName, ( TTree * ) tInputFile->File()->Get( tDataTreeName.c_str() ) ) );
-        else
-            tDataTreeVector->at((3*tKeyIndex)+1) = ( make_pair( tDataTreeName, ( TTree * ) tInputFile->File()->Get( tDataTreeName.c_str() ) ) );
-
-        tDataTreeName = tKey + string( "_DATA" );
-        if( first )
-            tDataTreeVector->push_back( make_pair( tDataTreeName, ( TTree * ) tInputFile->File()->Get( tDataTreeName.c_str() ) ) );
-        else
-            tDataTreeVector->at((3*tKeyIndex)+2) = ( make_pair( tDataTreeName, ( TTree * ) tInputFile->File()->Get( tDataTreeName.c_str() ) ) );
+        if( tIndex >= tQueue->fFiles->size() )
+        {
+            break;
+        }
+        ScanFile( tQueue->fFiles->at( tIndex ) );
     }
+    return NULL;
 }
 
-void GetDataBranches( TTree *tStructureTree, TTree *tPresenceTree, TTree *tDataTree, DataMap *tDataMap )
+bool ScanFile( InputFile& aFile )
 {
-    mainmsg( eDebug ) << "StructureTree: " << tStructureTree->GetName() << eom;
-    mainmsg( eDebug ) << "PresenceTree: " << tPresenceTree->GetName() << eom;
-    mainmsg( eDebug ) << "DataTree: " << tDataTree->GetName() << eom;
-    tStructureTree->SetBranchAddress( "LABEL", tDataMap->tStructureLabelHandle );
-    tStructureTree->SetBranchAddress( "TYPE", tDataMap->tStructureTypeHandle );
+    TFile* tFile = TFile::Open( aFile.fName.c_str(), "READ" );
+    if( tFile == NULL || tFile->IsZombie() )
+    {
+        aFile.fError = "could not be opened";
+        delete tFile;
+        return false;
+    }
 
-    for( Long64_t tStructureIndex = 0; tStructureIndex < tStructureTree->GetEntries(); tStructureIndex++ )
+    //check input file for kassiopeia label
+    TObjString* tLabel = (TObjString*) (tFile->Get( "LABEL" ));
+    if( tLabel == NULL || tLabel->GetString().CompareTo( string( "KASSIOPEIA_TREE_DATA" ).c_str() ) != 0 )
     {
-        tStructureTree->GetEntry( tStructureIndex );
-        mainmsg( eDebug ) << "analyzing structure with label <" << tDataMap->tStructureLabel << "> and type <" << tDataMap->tStructureType << ">" << eom;
+        aFile.fError = "has no LABEL 'KASSIOPEIA_TREE_DATA', probably not a Kassiopeia file";
+        delete tFile;
+        return false;
+    }
 
-        if( tDataMap->tStructureType == string( "bool" ) )
-        {
-            Bool_t &tBool = tDataMap->tBoolMap[ tDataMap->tStructureLabel ];
-            tDataTree->SetBranchAddress( tDataMap->tStructureLabel.c_str(), &tBool );
-            continue;
-        }
-        if( tDataMap->tStructureType == string( "unsigned_char" ) )
-        {
-            UChar_t &tUChar = tDataMap->tUCharMap[ tDataMap->tStructureLabel ];
-            tDataTree->SetBranchAddress( tDataMap->tStructureLabel.c_str(), &tUChar );
-            continue;
-        }
-        if( tDataMap->tStructureType == string( "char" ) )
-        {
-            Char_t &tChar = tDataMap->tCharMap[ tDataMap->tStructureLabel ];
-            tDataTree->SetBranchAddress( tDataMap->tStructureLabel.c_str(), &tChar );
-            continue;
-        }
-        if( tDataMap->tStructureType == string( "unsigned_short" ) )
-        {
-            UShort_t &tUShort = tDataMap->tUShortMap[ tDataMap->tStructureLabel ];
-            tDataTree->SetBranchAddress( tDataMap->tStructureLabel.c_str(), &tUShort );
-            continue;
-        }
-        if( tDataMap->tStructureType == string( "short" ) )
-        {
-            Short_t &tShort = tDataMap->tShortMap[ tDataMap->tStructureLabel ];
-            tDataTree->SetBranchAddress( tDataMap->tStructureLabel.c_str(), &tShort );
-            continue;
-        }
-        if( tDataMap->tStructureType == string( "unsigned_int" ) )
-        {
-            UInt_t &tUInt = tDataMap->tUIntMap[ tDataMap->tStructureLabel ];
-            tDataTree->SetBranchAddress( tDataMap->tStructureLabel.c_str(), &tUInt );
-            continue;
-        }
-        if( tDataMap->tStructureType == string( "int" ) )
-        {
-            Int_t &tInt = tDataMap->tIntMap[ tDataMap->tStructureLabel ];
-            tDataTree->SetBranchAddress( tDataMap->tStructureLabel.c_str(), &tInt );
-            continue;
-        }
-        if( tDataMap->tStructureType == string( "unsigned_long" ) )
-        {
-            ULong64_t &tULong = tDataMap->tULongMap[ tDataMap->tStructureLabel ];
-            tDataTree->SetBranchAddress( tDataMap->tStructureLabel.c_str(), &tULong );
-            continue;
-        }
-        if( tDataMap->tStructureType == string( "long" ) )
-        {
-            Long64_t &tLong = tDataMap->tLongMap[ tDataMap->tStructureLabel ];
-            tDataTree->SetBranchAddress( tDataMap->tStructureLabel.c_str(), &tLong );
-            continue;
-        }
-        if( tDataMap->tStructureType == string( "float" ) )
-        {
-            Float_t &tFloat = tDataMap->tFloatMap[ tDataMap->tStructureLabel ];
-            tDataTree->SetBranchAddress( tDataMap->tStructureLabel.c_str(), &tFloat );
-            continue;
-        }
-        if( tDataMap->tStructureType == string( "double" ) )
+    for( unsigned int tLevel = 0; tLevel < eLevels; tLevel++ )
+    {
+        TTree* tIndexTree = (TTree*) (tFile->Get( (sLevelNames[ tLevel ] + string( "_DATA" )).c_str() ));
+        if( tIndexTree == NULL )
         {
-            Double_t &tDouble = tDataMap->tDoubleMap[ tDataMap->tStructureLabel ];
-            tDataTree->SetBranchAddress( tDataMap->tStructureLabel.c_str(), &tDouble );
-            continue;
+            aFile.fError = string( "has no tree " ) + sLevelNames[ tLevel ] + string( "_DATA" );
+            delete tFile;
+            return false;
         }
-        if( tDataMap->tStructureType == string( "string" ) )
+        aFile.fEntries[ tLevel ] = tIndexTree->GetEntries();
+
+        if( ReadStructure( tFile, sLevelNames[ tLevel ], aFile.fStructure[ tLevel ], aFile.fError ) == false )
         {
-            string &tString = tDataMap->tStringMap[ tDataMap->tStructureLabel ];
-            string* &tStringPointer = tDataMap->tStringPointerMap[ tDataMap->tStructureLabel ];
-            tStringPointer = &tString;
-            tDataTree->SetBranchAddress( tDataMap->tStructureLabel.c_str(), &tStringPointer );
-            continue;
+            delete tFile;
+            return false;
         }
-        if( tDataMap->tStructureType == string( "two_vector" ) )
+    }
+
+    tFile->Close();
+    delete tFile;
+    return true;
+}
+
+bool ReadStructure( TFile* aFile, const string& aLevelName, LevelStructure& aStructure, string& anError )
+{
+    TTree* tKeyTree = (TTree*) (aFile->Get( (aLevelName + string( "_KEYS" )).c_str() ));
+    if( tKeyTree == NULL )
+    {
+        anError = string( "has no tree " ) + aLevelName + string( "_KEYS" );
+        return false;
+    }
+
+    string tKey;
+    string* tKeyPointer = &tKey;
+    tKeyTree->SetBranchAddress( "KEY", &tKeyPointer );
+    for( Long64_t tKeyIndex = 0; tKeyIndex < tKeyTree->GetEntries(); tKeyIndex++ )
+    {
+        tKeyTree->GetEntry( tKeyIndex );
+        aStructure.fKeys.push_back( tKey );
+    }
+    tKeyTree->ResetBranchAddresses();
+
+    for( vector< string >::iterator tIt = aStructure.fKeys.begin(); tIt != aStructure.fKeys.end(); tIt++ )
+    {
+        TTree* tStructureTree = (TTree*) (aFile->Get( (*tIt + string( "_STRUCTURE" )).c_str() ));
+        if( tStructureTree == NULL || aFile->Get( (*tIt + string( "_PRESENCE" )).c_str() ) == NULL || aFile->Get( (*tIt + string( "_DATA" )).c_str() ) == NULL )
         {
-            Double_t &tDoubleX = tDataMap->tTwoVectorXMap[ tDataMap->tStructureLabel + string( "_x" ) ];
-            Double_t &tDoubleY = tDataMap->tTwoVectorYMap[ tDataMap->tStructureLabel + string( "_y" ) ];
-            tDataTree->SetBranchAddress( ( tDataMap->tStructureLabel + string( "_x" ) ).c_str(), &tDoubleX );
-            tDataTree->SetBranchAddress( ( tDataMap->tStructureLabel + string( "_y" ) ).c_str(), &tDoubleY );
-            continue;
+            anError = string( "has incomplete trees for output <" ) + *tIt + string( ">" );
+            return false;
         }
-        if( tDataMap->tStructureType == string( "three_vector" ) )
+
+        string tLabel;
+        string* tLabelPointer = &tLabel;
+        tStructureTree->SetBranchAddress( "LABEL", &tLabelPointer );
+
+        string tType;
+        string* tTypePointer = &tType;
+        tStructureTree->SetBranchAddress( "TYPE", &tTypePointer );
+
+        GroupStructure tGroup;
+        for( Long64_t tStructureIndex = 0; tStructureIndex < tStructureTree->GetEntries(); tStructureIndex++ )
         {
-            Double_t &tDoubleX = tDataMap->tThreeVectorXMap[ tDataMap->tStructureLabel + string( "_x" ) ];
-            Double_t &tDoubleY = tDataMap->tThreeVectorYMap[ tDataMap->tStructureLabel + string( "_y" ) ];
-            Double_t &tDoubleZ = tDataMap->tThreeVectorZMap[ tDataMap->tStructureLabel + string( "_z" ) ];
-            tDataTree->SetBranchAddress( ( tDataMap->tStructureLabel + string( "_x" ) ).c_str(), &tDoubleX );
-            tDataTree->SetBranchAddress( ( tDataMap->tStructureLabel + string( "_y" ) ).c_str(), &tDoubleY );
-            tDataTree->SetBranchAddress( ( tDataMap->tStructureLabel + string( "_z" ) ).c_str(), &tDoubleZ );
-            continue;
+            tStructureTree->GetEntry( tStructureIndex );
+            tGroup.push_back( make_pair( tLabel, tType ) );
         }
+        tStructureTree->ResetBranchAddresses();
 
-        mainmsg( eError ) << "could not analyze branch with label <" << tDataMap->tStructureLabel << "> and type <" << tDataMap->tStructureType << ">. Exiting..." << eom;
-        exit( -1 );
+        aStructure.fGroups.push_back( tGroup );
     }
-
-    tPresenceTree->SetBranchAddress( "INDEX", tDataMap->tPresenceIndexPointer );
-    tPresenceTree->SetBranchAddress( "LENGTH", tDataMap->tPresenceLengthPointer );
-    tPresenceTree->GetEntry( 0 );
+    return true;
 }
 
-void WriteIndexTrees( KRootFile *tRootFile, Trees *tTrees, Indices *tIndices, const int tBufferSize, const int tSplitSize )
+void StartPrefetch( Prefetch& aPrefetch, const string& aName )
 {
-    tTrees->tRunTree = new TTree( "RUN_DATA", "RUN_DATA" );
-    tTrees->tRunTree->SetDirectory( tRootFile->File() );
-    tTrees->tRunTree->Branch( "RUN_INDEX", &(tIndices->tRunIndex), tBufferSize, tSplitSize );
-    tTrees->tRunTree->Branch( "FIRST_STEP_INDEX", &(tIndices->tRunFirstStep), tBufferSize, tSplitSize );
-    tTrees->tRunTree->Branch( "LAST_STEP_INDEX", &(tIndices->tRunLastStep), tBufferSize, tSplitSize );
-    tTrees->tRunTree->Branch( "FIRST_TRACK_INDEX", &(tIndices->tRunFirstTrack), tBufferSize, tSplitSize );
-    tTrees->tRunTree->Branch( "LAST_TRACK_INDEX", &(tIndices->tRunLastTrack), tBufferSize, tSplitSize );
-    tTrees->tRunTree->Branch( "FIRST_EVENT_INDEX", &(tIndices->tRunFirstEvent), tBufferSize, tSplitSize );
-    tTrees->tRunTree->Branch( "LAST_EVENT_INDEX", &(tIndices->tRunLastEvent), tBufferSize, tSplitSize );
-
-    tTrees->tEventTree = new TTree( "EVENT_DATA", "EVENT_DATA" );
-    tTrees->tEventTree->SetDirectory( tRootFile->File() );
-    tTrees->tEventTree->Branch( "EVENT_INDEX", &(tIndices->tEventIndex), tBufferSize, tSplitSize );
-    tTrees->tEventTree->Branch( "FIRST_STEP_INDEX", &(tIndices->tEventFirstStep), tBufferSize, tSplitSize );
-    tTrees->tEventTree->Branch( "LAST_STEP_INDEX", &(tIndices->tEventLastStep), tBufferSize, tSplitSize );
-    tTrees->tEventTree->Branch( "FIRST_TRACK_INDEX", &(tIndices->tEventFirstTrack), tBufferSize, tSplitSize );
-    tTrees->tEventTree->Branch( "LAST_TRACK_INDEX", &(tIndices->tEventLastTrack), tBufferSize, tSplitSize );
-
-    tTrees->tTrackTree = new TTree( "TRACK_DATA", "TRACK_DATA" );
-    tTrees->tTrackTree->SetDirectory( tRootFile->File() );
-    tTrees->tTrackTree->Branch( "TRACK_INDEX", &(tIndices->tTrackIndex), tBufferSize, tSplitSize );
-    tTrees->tTrackTree->Branch( "FIRST_STEP_INDEX", &(tIndices->tTrackFirstStep), tBufferSize, tSplitSize );
-    tTrees->tTrackTree->Branch( "LAST_STEP_INDEX", &(tIndices->tTrackLastStep), tBufferSize, tSplitSize );
-
-    tTrees->tStepTree = new TTree( "STEP_DATA", "STEP_DATA" );
-    tTrees->tStepTree->SetDirectory( tRootFile->File() );
-    tTrees->tStepTree->Branch( "STEP_INDEX", &(tIndices->tStepIndex), tBufferSize, tSplitSize );
+    //remote files are read through ROOT's own protocols and are not prefetched
+    if( aName.find( "://" ) != string::npos )
+    {
+        return;
+    }
+    aPrefetch.fName = aName;
+    aPrefetch.fRunning = (pthread_create( &(aPrefetch.fThread), NULL, &PrefetchWorker, &aPrefetch ) == 0);
+    return;
 }
 
-void WriteDataTrees( KRootFile *tRootFile, DataTreeVector *tOutputDataTreeVector, DataTreeVector *tDataTreeVector )
+void FinishPrefetch( Prefetch& aPrefetch )
 {
-    for( DataTreeVector::iterator tIt = tDataTreeVector->begin(); tIt != tDataTreeVector->end(); ++tIt )
+    if( aPrefetch.fRunning == true )
     {
-        tOutputDataTreeVector->push_back( make_pair( (*tIt).first, new TTree( (TString) (*tIt).first, (TString) (*tIt).first ) ) );
-        tOutputDataTreeVector->back().second->SetDirectory( tRootFile->File() );
+        pthread_join( aPrefetch.fThread, NULL );
+        aPrefetch.fRunning = false;
     }
+    return;
 }
 
-void WriteDataBranches( TTree *tStructureTree, TTree *tPresenceTree, TTree *tDataTree, DataMap *tDataMap, const int tBufferSize, const int tSplitSize )
+void* PrefetchWorker( void* aPrefetch )
 {
-    tStructureTree->Branch( "LABEL", tDataMap->tStructureLabelPointer, tBufferSize, tSplitSize );
-    tStructureTree->Branch( "TYPE", tDataMap->tStructureTypePointer, tBufferSize, tSplitSize );
-
-    tPresenceTree->Branch( "INDEX", tDataMap->tPresenceIndexPointer, tBufferSize, tSplitSize );
-    tPresenceTree->Branch( "LENGTH", tDataMap->tPresenceLengthPointer, tBufferSize, tSplitSize );
-
-    for( map< string, Bool_t >::iterator tIt = tDataMap->tBoolMap.begin(); tIt != tDataMap->tBoolMap.end(); ++tIt )
-    {
-        tDataTree->Branch( (TString) (*tIt).first, &((*tIt).second), tBufferSize, tSplitSize );
-    }
-    for( map< string, UChar_t >::iterator tIt = tDataMap->tUCharMap.begin(); tIt != tDataMap->tUCharMap.end(); ++tIt )
-    {
-        tDataTree->Branch( (TString) (*tIt).first, &((*tIt).second), tBufferSize, tSplitSize );
-    }
-    for( map< string, Char_t >::iterator tIt = tDataMap->tCharMap.begin(); tIt != tDataMap->tCharMap.end(); ++tIt )
-    {
-        tDataTree->Branch( (TString) (*tIt).first, &((*tIt).second), tBufferSize, tSplitSize );
-    }
-    for( map< string, UShort_t >::iterator tIt = tDataMap->tUShortMap.begin(); tIt != tDataMap->tUShortMap.end(); ++tIt )
+    //reads the raw file without ROOT, so that the baskets are in the page cache when the file is merged
+    Prefetch* tPrefetch = (Prefetch*) (aPrefetch);
+    int tDescriptor = open( tPrefetch->fName.c_str(), O_RDONLY );
+    if( tDescriptor < 0 )
     {
-        tDataTree->Branch( (TString) (*tIt).first, &((*tIt).second), tBufferSize, tSplitSize );
+        return NULL;
     }
-    for( map< string, Short_t >::iterator tIt = tDataMap->tShortMap.begin(); tIt != tDataMap->tShortMap.end(); ++tIt )
+    vector< char > tBuffer( sPrefetchSize );
+    while( read( tDescriptor, &(tBuffer[ 0 ]), sPrefetchSize ) > 0 )
     {
-        tDataTree->Branch( (TString) (*tIt).first, &((*tIt).second), tBufferSize, tSplitSize );
-    }
-    for( map< string, UInt_t >::iterator tIt = tDataMap->tUIntMap.begin(); tIt != tDataMap->tUIntMap.end(); ++tIt )
-    {
-        tDataTree->Branch( (TString) (*tIt).first, &((*tIt).second), tBufferSize, tSplitSize );
-    }
-    for( map< string, Int_t >::iterator tIt = tDataMap->tIntMap.begin(); tIt != tDataMap->tIntMap.end(); ++tIt )
-    {
-        tDataTree->Branch( (TString) (*tIt).first, &((*tIt).second), tBufferSize, tSplitSize );
-    }
-    for( map< string, ULong64_t >::iterator tIt = tDataMap->tULongMap.begin(); tIt != tDataMap->tULongMap.end(); ++tIt )
-    {
-        tDataTree->Branch( (TString) (*tIt).first, &((*tIt).second), tBufferSize, tSplitSize );
-    }
-    for( map< string, Long64_t >::iterator tIt = tDataMap->tLongMap.begin(); tIt != tDataMap->tLongMap.end(); ++tIt )
-    {
-        tDataTree->Branch( (TString) (*tIt).first, &((*tIt).second), tBufferSize, tSplitSize );
-    }
-    for( map< string, Float_t >::iterator tIt = tDataMap->tFloatMap.begin(); tIt != tDataMap->tFloatMap.end(); ++tIt )
-    {
-        tDataTree->Branch( (TString) (*tIt).first, &((*tIt).second), tBufferSize, tSplitSize );
-    }
-    for( map< string, Double_t >::iterator tIt = tDataMap->tDoubleMap.begin(); tIt != tDataMap->tDoubleMap.end(); ++tIt )
-    {
-        tDataTree->Branch( (TString) (*tIt).first, &((*tIt).second), tBufferSize, tSplitSize );
-    }
-    for( map< string, string * >::iterator tIt = tDataMap->tStringPointerMap.begin(); tIt != tDataMap->tStringPointerMap.end(); ++tIt )
-    {
-        tDataTree->Branch( (TString) (*tIt).first, &((*tIt).second), tBufferSize, tSplitSize );
-    }
-    for( map< string, Double_t >::iterator tIt = tDataMap->tTwoVectorXMap.begin(); tIt != tDataMap->tTwoVectorXMap.end(); ++tIt )
-    {
-        tDataTree->Branch( (TString) (*tIt).first, &((*tIt).second), tBufferSize, tSplitSize );
-    }
-    for( map< string, Double_t >::iterator tIt = tDataMap->tTwoVectorYMap.begin(); tIt != tDataMap->tTwoVectorYMap.end(); ++tIt )
-    {
-        tDataTree->Branch( (TString) (*tIt).first, &((*tIt).second), tBufferSize, tSplitSize );
-    }
-    for( map< string, Double_t >::iterator tIt = tDataMap->tThreeVectorXMap.begin(); tIt != tDataMap->tThreeVectorXMap.end(); ++tIt )
-    {
-        tDataTree->Branch( (TString) (*tIt).first, &((*tIt).second), tBufferSize, tSplitSize );
-    }
-    for( map< string, Double_t >::iterator tIt = tDataMap->tThreeVectorYMap.begin(); tIt != tDataMap->tThreeVectorYMap.end(); ++tIt )
-    {
-        tDataTree->Branch( (TString) (*tIt).first, &((*tIt).second), tBufferSize, tSplitSize );
-    }
-    for( map< string, Double_t >::iterator tIt = tDataMap->tThreeVectorZMap.begin(); tIt != tDataMap->tThreeVectorZMap.end(); ++tIt )
-    {
-        tDataTree->Branch( (TString) (*tIt).first, &((*tIt).second), tBufferSize, tSplitSize );
     }
+    close( tDescriptor );
+    return NULL;
 }
 
-void FillDataStructureBranch( TTree *tOutputStructureTree, TTree *tInputStructureTree )
+void SetIndexBranches( TTree* aTree, const Level& aLevel, Indices* anIndices, bool aWrite )
 {
-    for( Int_t tIndex = 0; tIndex < tInputStructureTree->GetEntries(); tIndex++ )
-    {
-        tInputStructureTree->GetEntry( tIndex );
-        tOutputStructureTree->Fill();
+    vector< pair< string, unsigned int* > > tBranches;
+    switch( aLevel )
+    {
+        case eRun :
+            tBranches.push_back( make_pair( string( "RUN_INDEX" ), &(anIndices->tRunIndex) ) );
+            tBranches.push_back( make_pair( string( "FIRST_EVENT_INDEX" ), &(anIndices->tRunFirstEvent) ) );
+            tBranches.push_back( make_pair( string( "LAST_EVENT_INDEX" ), &(anIndices->tRunLastEvent) ) );
+            tBranches.push_back( make_pair( string( "FIRST_TRACK_INDEX" ), &(anIndices->tRunFirstTrack) ) );
+            tBranches.push_back( make_pair( string( "LAST_TRACK_INDEX" ), &(anIndices->tRunLastTrack) ) );
+            tBranches.push_back( make_pair( string( "FIRST_STEP_INDEX" ), &(anIndices->tRunFirstStep) ) );
+            tBranches.push_back( make_pair( string( "LAST_STEP_INDEX" ), &(anIndices->tRunLastStep) ) );
+            break;
+        case eEvent :
+            tBranches.push_back( make_pair( string( "EVENT_INDEX" ), &(anIndices->tEventIndex) ) );
+            tBranches.push_back( make_pair( string( "FIRST_TRACK_INDEX" ), &(anIndices->tEventFirstTrack) ) );
+            tBranches.push_back( make_pair( string( "LAST_TRACK_INDEX" ), &(anIndices->tEventLastTrack) ) );
+            tBranches.push_back( make_pair( string( "FIRST_STEP_INDEX" ), &(anIndices->tEventFirstStep) ) );
+            tBranches.push_back( make_pair( string( "LAST_STEP_INDEX" ), &(anIndices->tEventLastStep) ) );
+            break;
+        case eTrack :
+            tBranches.push_back( make_pair( string( "TRACK_INDEX" ), &(anIndices->tTrackIndex) ) );
+            tBranches.push_back( make_pair( string( "FIRST_STEP_INDEX" ), &(anIndices->tTrackFirstStep) ) );
+            tBranches.push_back( make_pair( string( "LAST_STEP_INDEX" ), &(anIndices->tTrackLastStep) ) );
+            break;
+        case eStep :
+            tBranches.push_back( make_pair( string( "STEP_INDEX" ), &(anIndices->tStepIndex) ) );
+            break;
+        default :
+            break;
+    }
+
+    for( vector< pair< string, unsigned int* > >::iterator tIt = tBranches.begin(); tIt != tBranches.end(); tIt++ )
+    {
+        if( aWrite == true )
+        {
+            aTree->Branch( tIt->first.c_str(), tIt->second, sBufferSize, sSplitSize );
+        }
+        else
+        {
+            aTree->SetBranchAddress( tIt->first.c_str(), tIt->second );
+        }
     }
+    return;
 }
 
-void GetWriteFillKeyTrees( KRootFile *tRootFile, Trees *tInputTrees, Trees *tOutputTrees, const int tBufferSize, const int tSplitSize )
+void CreateOutputLevel( TFile* aFile, const Level& aLevel, const LevelStructure& aStructure, OutputLevel& anOutput, Indices* anIndices )
 {
-    string tRunKey;
-    string* tRunKeyPointer = &tRunKey;
-    string** tRunKeyHandle = &tRunKeyPointer;
-
-    string tEventKey;
-    string* tEventKeyPointer = &tEventKey;
-    string** tEventKeyHandle = &tEventKeyPointer;
+    const string& tLevelName = sLevelNames[ aLevel ];
 
-    string tTrackKey;
-    string* tTrackKeyPointer = &tTrackKey;
-    string** tTrackKeyHandle = &tTrackKeyPointer;
+    anOutput.fIndices = new TTree( (tLevelName + string( "_DATA" )).c_str(), (tLevelName + string( "_DATA" )).c_str() );
+    anOutput.fIndices->SetDirectory( aFile );
+    SetIndexBranches( anOutput.fIndices, aLevel, anIndices, true );
 
-    string tStepKey;
-    string* tStepKeyPointer = &tStepKey;
-    string** tStepKeyHandle = &tStepKeyPointer;
-
-    tInputTrees->tRunKeysTree->SetBranchAddress( "KEY", tRunKeyHandle );
-    tInputTrees->tEventKeysTree->SetBranchAddress( "KEY", tEventKeyHandle );
-    tInputTrees->tTrackKeysTree->SetBranchAddress( "KEY", tTrackKeyHandle );
-    tInputTrees->tStepKeysTree->SetBranchAddress( "KEY", tStepKeyHandle );
-
-    tOutputTrees->tRunKeysTree = new TTree( "RUN_KEYS", "RUN_KEYS" );
-    tOutputTrees->tRunKeysTree->SetDirectory( tRootFile->File() );
-    tOutputTrees->tRunKeysTree->Branch( "KEY", tRunKeyPointer, tBufferSize, tSplitSize );
+    //key and structure trees are identical in all input files and are written only once
+    string tKey;
+    string* tKeyPointer = &tKey;
+    anOutput.fKeys = new TTree( (tLevelName + string( "_KEYS" )).c_str(), (tLevelName + string( "_KEYS" )).c_str() );
+    anOutput.fKeys->SetDirectory( aFile );
+    anOutput.fKeys->Branch( "KEY", tKeyPointer, sBufferSize, sSplitSize );
+    for( unsigned int tGroup = 0; tGroup < aStructure.fKeys.size(); tGroup++ )
+    {
+        tKey = aStructure.fKeys.at( tGroup );
+        anOutput.fKeys->Fill();
+
+        string tLabel;
+        string* tLabelPointer = &tLabel;
+        string tType;
+        string* tTypePointer = &tType;
+
+        TTree* tStructureTree = new TTree( (tKey + string( "_STRUCTURE" )).c_str(), (tKey + string( "_STRUCTURE" )).c_str() );
+        tStructureTree->SetDirectory( aFile );
+        tStructureTree->Branch( "LABEL", tLabelPointer, sBufferSize, sSplitSize );
+        tStructureTree->Branch( "TYPE", tTypePointer, sBufferSize, sSplitSize );
+        for( GroupStructure::const_iterator tIt = aStructure.fGroups.at( tGroup ).begin(); tIt != aStructure.fGroups.at( tGroup ).end(); tIt++ )
+        {
+            tLabel = tIt->first;
+            tType = tIt->second;
+            tStructureTree->Fill();
+        }
+        tStructureTree->ResetBranchAddresses();
+        anOutput.fStructures.push_back( tStructureTree );
 
-    tOutputTrees->tEventKeysTree = new TTree( "EVENT_KEYS", "EVENT_KEYS" );
-    tOutputTrees->tEventKeysTree->SetDirectory( tRootFile->File() );
-    tOutputTrees->tEventKeysTree->Branch( "KEY", tEventKeyPointer, tBufferSize, tSplitSize );
+        TTree* tPresenceTree = new TTree( (tKey + string( "_PRESENCE" )).c_str(), (tKey + string( "_PRESENCE" )).c_str() );
+        tPresenceTree->SetDirectory( aFile );
+        anOutput.fPresences.push_back( tPresenceTree );
 
-    tOutputTrees->tTrackKeysTree = new TTree( "TRACK_KEYS", "TRACK_KEYS" );
-    tOutputTrees->tTrackKeysTree->SetDirectory( tRootFile->File() );
-    tOutputTrees->tTrackKeysTree->Branch( "KEY", tTrackKeyPointer, tBufferSize, tSplitSize );
+        //data trees are cloned from the first input file
+        anOutput.fData.push_back( NULL );
+    }
+    anOutput.fKeys->ResetBranchAddresses();
+    return;
+}
 
-    tOutputTrees->tStepKeysTree = new TTree( "STEP_KEYS", "STEP_KEYS" );
-    tOutputTrees->tStepKeysTree->SetDirectory( tRootFile->File() );
-    tOutputTrees->tStepKeysTree->Branch( "KEY", tStepKeyPointer, tBufferSize, tSplitSize );
+void FillIndexTree( TTree* anOutputTree, TTree* anInputTree, const Level& aLevel, Indices* anIndices, const Long64_t* anOffsets )
+{
+    SetIndexBranches( anInputTree, aLevel, anIndices, false );
 
-    for( Int_t tIndex = 0; tIndex < tInputTrees->tRunKeysTree->GetEntries(); tIndex++ )
+    for( Long64_t tIndex = 0; tIndex < anInputTree->GetEntries(); tIndex++ )
     {
-        tInputTrees->tRunKeysTree->GetEntry( tIndex );
-        tOutputTrees->tRunKeysTree->Fill();
+        anInputTree->GetEntry( tIndex );
+        switch( aLevel )
+        {
+            case eRun :
+                anIndices->tRunIndex += anOffsets[ eRun ];
+                anIndices->tRunFirstEvent += anOffsets[ eEvent ];
+                anIndices->tRunLastEvent += anOffsets[ eEvent ];
+                anIndices->tRunFirstTrack += anOffsets[ eTrack ];
+                anIndices->tRunLastTrack += anOffsets[ eTrack ];
+                anIndices->tRunFirstStep += anOffsets[ eStep ];
+                anIndices->tRunLastStep += anOffsets[ eStep ];
+                break;
+            case eEvent :
+                anIndices->tEventIndex += anOffsets[ eEvent ];
+                anIndices->tEventFirstTrack += anOffsets[ eTrack ];
+                anIndices->tEventLastTrack += anOffsets[ eTrack ];
+                anIndices->tEventFirstStep += anOffsets[ eStep ];
+                anIndices->tEventLastStep += anOffsets[ eStep ];
+                break;
+            case eTrack :
+                anIndices->tTrackIndex += anOffsets[ eTrack ];
+                anIndices->tTrackFirstStep += anOffsets[ eStep ];
+                anIndices->tTrackLastStep += anOffsets[ eStep ];
+                break;
+            case eStep :
+                anIndices->tStepIndex += anOffsets[ eStep ];
+                break;
+            default :
+                break;
+        }
+        anOutputTree->Fill();
     }
-    for( Int_t tIndex = 0; tIndex < tInputTrees->tEventKeysTree->GetEntries(); tIndex++ )
+
+    anInputTree->ResetBranchAddresses();
+    return;
+}
+
+void FillPresenceTree( TTree* anOutputTree, TTree* anInputTree, const Long64_t& anOffset )
+{
+    //presence indices refer to the run, event, track or step index and are shifted like those
+    unsigned int tIndex = 0;
+    unsigned int tLength = 0;
+    if( anOutputTree->GetNbranches() == 0 )
     {
-        tInputTrees->tEventKeysTree->GetEntry( tIndex );
-        tOutputTrees->tEventKeysTree->Fill();
+        anOutputTree->Branch( "INDEX", &tIndex, sBufferSize, sSplitSize );
+        anOutputTree->Branch( "LENGTH", &tLength, sBufferSize, sSplitSize );
     }
-    for( Int_t tIndex = 0; tIndex < tInputTrees->tTrackKeysTree->GetEntries(); tIndex++ )
+    else
     {
-        tInputTrees->tTrackKeysTree->GetEntry( tIndex );
-        tOutputTrees->tTrackKeysTree->Fill();
+        anOutputTree->SetBranchAddress( "INDEX", &tIndex );
+        anOutputTree->SetBranchAddress( "LENGTH", &tLength );
     }
-    for( Int_t tIndex = 0; tIndex < tInputTrees->tStepKeysTree->GetEntries(); tIndex++ )
+    anInputTree->SetBranchAddress( "INDEX", &tIndex );
+    anInputTree->SetBranchAddress( "LENGTH", &tLength );
+
+    for( Long64_t tEntry = 0; tEntry < anInputTree->GetEntries(); tEntry++ )
     {
-        tInputTrees->tStepKeysTree->GetEntry( tIndex );
-        tOutputTrees->tStepKeysTree->Fill();
+        anInputTree->GetEntry( tEntry );
+        tIndex += anOffset;
+        anOutputTree->Fill();
     }
+
+    anInputTree->ResetBranchAddresses();
+    anOutputTree->ResetBranchAddresses();
+    return;
 }
 
-void FillIndexTrees( Trees *tOutputTrees, Trees *tInputTrees, Indices *tIndices )
+void CopyDataTree( TFile* anOutputFile, TTree*& anOutputTree, TTree* anInputTree )
 {
-    unsigned int tRunEntries = tOutputTrees->tRunTree->GetEntries();
-    unsigned int tEventEntries = tOutputTrees->tEventTree->GetEntries();
-    unsigned int tTrackEntries = tOutputTrees->tTrackTree->GetEntries();
-    unsigned int tStepEntries = tOutputTrees->tStepTree->GetEntries();
-
-    for( Int_t tIndex = 0; tIndex < tInputTrees->tRunTree->GetEntries(); tIndex++ )
+    if( anOutputTree == NULL )
     {
-        tInputTrees->tRunTree->GetEntry( tIndex );
-
-        (tIndices->tRunIndex) += tRunEntries;
-        (tIndices->tRunFirstEvent) += tEventEntries;
-        (tIndices->tRunLastEvent) += tEventEntries;
-        (tIndices->tRunFirstTrack) += tTrackEntries;
-        (tIndices->tRunLastTrack) += tTrackEntries;
-        (tIndices->tRunFirstStep) += tStepEntries;
-        (tIndices->tRunLastStep) += tStepEntries;
-
-        tOutputTrees->tRunTree->Fill();
+        anOutputTree = anInputTree->CloneTree( 0 );
+        anOutputTree->SetDirectory( anOutputFile );
     }
-    for( Int_t tIndex = 0; tIndex < tInputTrees->tEventTree->GetEntries(); tIndex++ )
-    {
-        tInputTrees->tEventTree->GetEntry( tIndex );
 
-        (tIndices->tEventIndex) += tEventEntries;
-        (tIndices->tEventFirstTrack) += tTrackEntries;
-        (tIndices->tEventLastTrack) += tTrackEntries;
-        (tIndices->tEventFirstStep) += tStepEntries;
-        (tIndices->tEventLastStep) += tStepEntries;
-
-        tOutputTrees->tEventTree->Fill();
-    }
-    for( Int_t tIndex = 0; tIndex < tInputTrees->tTrackTree->GetEntries(); tIndex++ )
+    //copy the compressed baskets as they are, without unzipping and refilling the entries
+    //the check is done before copying, so that a failed fast copy never leaves entries behind
+    Long64_t tEntries = anOutputTree->GetEntries();
+    TTreeCloner tCloner( anInputTree, anOutputTree, "fast", TTreeCloner::kNoWarnings );
+    if( tCloner.IsValid() == true )
     {
-        tInputTrees->tTrackTree->GetEntry( tIndex );
-
-        (tIndices->tTrackIndex) += tTrackEntries;
-        (tIndices->tTrackFirstStep) += tStepEntries;
-        (tIndices->tTrackLastStep) += tStepEntries;
-
-        tOutputTrees->tTrackTree->Fill();
+        anOutputTree->CopyEntries( anInputTree, -1, "fast" );
     }
-    for( Int_t tIndex = 0; tIndex < tInputTrees->tStepTree->GetEntries(); tIndex++ )
+    else
     {
-        tInputTrees->tStepTree->GetEntry( tIndex );
-
-        (tIndices->tStepIndex) += tStepEntries;
-
-        tOutputTrees->tStepTree->Fill();
+        mainmsg( eWarning ) << "Could not copy baskets of tree <" << anInputTree->GetName() << "> (" << tCloner.GetWarning() << "), copying entries instead" << eom;
+        anOutputTree->CopyEntries( anInputTree, -1, "" );
     }
-}
 
-void FillDataBranches( TTree *tOutputDataTree, TTree *tInputDataTree )
-{
-    for( Int_t tIndex = 0; tIndex < tInputDataTree->GetEntries(); tIndex++ )
+    if( anOutputTree->GetEntries() - tEntries != anInputTree->GetEntries() )
     {
-        tInputDataTree->GetEntry( tIndex );
-        tOutputDataTree->Fill();
+        mainmsg( eError ) << "Could not copy tree <" << anInputTree->GetName() << ">. Exiting..." << eom;
+        exit( -1 );
     }
-}
-
-void FillDataPresenceBranch( TTree *tOutputDataPresenceTree, TTree *tInputDataPresenceTree, DataMap *tDataMap )
-{
-	mainmsg( eDebug ) << "Filling presence tree"<<eom;
-
-	unsigned int tLastEntry = 0;
-    unsigned int tLastLength = 0;
 
-	//get the last presence index and length in the output tree, if this is not the first presence data
-	if ( tOutputDataPresenceTree->GetEntries() != 0)
-	{
-		tOutputDataPresenceTree->GetEntry( tOutputDataPresenceTree->GetEntries() - 1 );
-	    tLastEntry = (tDataMap->tPresenceIndex);
-	    tLastLength = (tDataMap->tPresenceLength);
-	}
-    mainmsg( eDebug ) <<"last entry is: "<<tLastEntry<<eom;
-    mainmsg( eDebug ) <<"last length is: "<<tLastLength<<eom;
-
-    for( Int_t tIndex = 0; tIndex < tInputDataPresenceTree->GetEntries(); tIndex++ )
-    {
-        tInputDataPresenceTree->GetEntry( tIndex );
-        (tDataMap->tPresenceIndex) += ( tLastEntry + tLastLength);
-        tOutputDataPresenceTree->Fill();
-    }
+    anOutputTree->ResetBranchAddresses();
+    return;
 }
-
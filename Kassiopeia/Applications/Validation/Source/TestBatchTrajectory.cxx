@@ -0,0 +1,298 @@
+#include "KSRootTrajectory.h"
+#include "KSTrajTrajectoryExactTrapped.h"
+#include "KSTrajIntegratorSym4.h"
+#include "KSTrajTermPropagation.h"
+#include "KSTrajControlTime.h"
+#include "KSMagneticField.h"
+#include "KSElectricField.h"
+#include "KSParticleFactory.h"
+#include "KSStep.h"
+#include "KSEvent.h"
+#include "KSMainMessage.h"
+
+#include <vector>
+
+using namespace Kassiopeia;
+using namespace katrin;
+using namespace std;
+
+//magnetic bottle with its minimum at the origin
+class BottleField :
+    public KSComponentTemplate< BottleField, KSMagneticField >
+{
+    public:
+        BottleField() :
+                fStrength( 1. ),
+                fLength( 0.1 )
+        {
+        }
+        BottleField* Clone() const
+        {
+            return new BottleField( *this );
+        }
+        virtual ~BottleField()
+        {
+        }
+
+        void CalculateField( const KThreeVector& aSamplePoint, const double& /*aSampleTime*/, KThreeVector& aField )
+        {
+            double tScale = fStrength / (fLength * fLength);
+            aField.SetComponents( -tScale * aSamplePoint.X() * aSamplePoint.Z(), -tScale * aSamplePoint.Y() * aSamplePoint.Z(), fStrength + tScale * aSamplePoint.Z() * aSamplePoint.Z() );
+            return;
+        }
+        void CalculateGradient( const KThreeVector& aSamplePoint, const double& /*aSampleTime*/, KThreeMatrix& aGradient )
+        {
+            double tScale = fStrength / (fLength * fLength);
+            aGradient.SetComponents( -tScale * aSamplePoint.Z(), 0., -tScale * aSamplePoint.X(), 0., -tScale * aSamplePoint.Z(), -tScale * aSamplePoint.Y(), 0., 0., 2. * tScale * aSamplePoint.Z() );
+            return;
+        }
+
+    private:
+        double fStrength;
+        double fLength;
+};
+
+//electric quadrupole that traps electrons along z
+class QuadrupoleField :
+    public KSComponentTemplate< QuadrupoleField, KSElectricField >
+{
+    public:
+        QuadrupoleField() :
+                fStrength( -50. ),
+                fLength( 0.1 )
+        {
+        }
+        QuadrupoleField* Clone() const
+        {
+            return new QuadrupoleField( *this );
+        }
+        virtual ~QuadrupoleField()
+        {
+        }
+
+        void CalculatePotential( const KThreeVector& aSamplePoint, const double& /*aSampleTime*/, double& aPotential )
+        {
+            aPotential = fStrength * (aSamplePoint.Z() * aSamplePoint.Z() - 0.5 * (aSamplePoint.X() * aSamplePoint.X() + aSamplePoint.Y() * aSamplePoint.Y())) / (fLength * fLength);
+            return;
+        }
+        void CalculateField( const KThreeVector& aSamplePoint, const double& /*aSampleTime*/, KThreeVector& aField )
+        {
+            double tScale = fStrength / (fLength * fLength);
+            aField.SetComponents( tScale * aSamplePoint.X(), tScale * aSamplePoint.Y(), -2. * tScale * aSamplePoint.Z() );
+            return;
+        }
+
+    private:
+        double fStrength;
+        double fLength;
+};
+
+//the parts of a batchable exact trapped trajectory
+class Tracker
+{
+    public:
+        Tracker( const unsigned int& aLaneCount )
+        {
+            fControl.SetTime( 2.e-12 );
+            fTrajectory.SetIntegrator( &fIntegrator );
+            fTrajectory.AddTerm( &fTerm );
+            fTrajectory.AddControl( &fControl );
+
+            fRootTrajectory.SetTrajectory( &fTrajectory );
+            fRootTrajectory.SetStep( &fStep );
+            fRootTrajectory.SetEvent( &fEvent );
+            fRootTrajectory.SetLookahead( aLaneCount, 16 );
+        }
+
+        KSTrajIntegratorSym4 fIntegrator;
+        KSTrajTermPropagation fTerm;
+        KSTrajControlTime fControl;
+        KSTrajTrajectoryExactTrapped fTrajectory;
+        KSRootTrajectory fRootTrajectory;
+        KSStep fStep;
+        KSEvent fEvent;
+};
+
+KSParticle* CreateElectron( const unsigned int& anIndex, KSMagneticField* aMagneticField, KSElectricField* anElectricField )
+{
+    KSParticle* tParticle = KSParticleFactory::GetInstance().Create( 11 );
+    tParticle->SetMagneticFieldCalculator( aMagneticField );
+    tParticle->SetElectricFieldCalculator( anElectricField );
+    tParticle->SetTime( 0. );
+    tParticle->SetLength( 0. );
+    tParticle->SetPosition( 0.001 * anIndex, -0.0005 * anIndex, 0.002 * anIndex - 0.005 );
+    tParticle->SetMomentum( KThreeVector( 1., 0.1 * anIndex, 0.5 - 0.1 * anIndex ) );
+    tParticle->SetKineticEnergy_eV( 100. + 50. * anIndex );
+    return tParticle;
+}
+
+bool SameState( const KSParticle& aFirst, const KSParticle& aSecond )
+{
+    return aFirst.GetTime() == aSecond.GetTime() &&
+           aFirst.GetLength() == aSecond.GetLength() &&
+           aFirst.GetPosition() == aSecond.GetPosition() &&
+           aFirst.GetMomentum() == aSecond.GetMomentum() &&
+           aFirst.IsActive() == aSecond.IsActive();
+}
+
+//tracks the queued particles one after the other like KSRoot, with a navigator asking for an intermediate state
+//and an interaction changing the momentum of one particle on the way
+void TrackEvent( Tracker& aTracker, vector< KSParticle >& aStates, vector< double >& aSteps )
+{
+    const unsigned int tStepCount = 100;
+    unsigned int tTrack = 0;
+    while( aTracker.fEvent.ParticleQueue().empty() == false )
+    {
+        KSParticle* tParticle = aTracker.fEvent.ParticleQueue().front();
+        aTracker.fStep.InitialParticle() = *tParticle;
+        aTracker.fStep.FinalParticle() = *tParticle;
+        delete tParticle;
+        aTracker.fEvent.ParticleQueue().pop_front();
+
+        aTracker.fRootTrajectory.Reset();
+
+        for( unsigned int tStep = 0; tStep < tStepCount; tStep++ )
+        {
+            aTracker.fStep.TerminatorParticle() = aTracker.fStep.InitialParticle();
+            aTracker.fRootTrajectory.CalculateTrajectory();
+            aSteps.push_back( aTracker.fStep.TrajectoryCenter().X() );
+            aSteps.push_back( aTracker.fStep.TrajectoryCenter().Y() );
+            aSteps.push_back( aTracker.fStep.TrajectoryCenter().Z() );
+            aSteps.push_back( aTracker.fStep.TrajectoryRadius() );
+            aSteps.push_back( aTracker.fStep.TrajectoryStep() );
+
+            if( tStep % 25 == 7 )
+            {
+                KSParticle tIntermediateParticle( aTracker.fStep.TerminatorParticle() );
+                aTracker.fRootTrajectory.ExecuteTrajectory( 0.5 * aTracker.fStep.TrajectoryStep(), tIntermediateParticle );
+                aStates.push_back( tIntermediateParticle );
+            }
+
+            aTracker.fRootTrajectory.ExecuteTrajectory();
+
+            if( tTrack == 2 && tStep == 40 )
+            {
+                aTracker.fStep.FinalParticle().SetMomentum( 0.999 * aTracker.fStep.FinalParticle().GetMomentum() );
+            }
+
+            aStates.push_back( aTracker.fStep.FinalParticle() );
+            aTracker.fStep.InitialParticle() = aTracker.fStep.FinalParticle();
+        }
+        tTrack++;
+    }
+    return;
+}
+
+int main( int /*anArgc*/, char** /*anArgv*/ )
+{
+    BottleField tMagneticField;
+    QuadrupoleField tElectricField;
+
+    bool tSuccess = true;
+
+    const unsigned int tParticleCount = 6;
+    const unsigned int tStepCount = 200;
+
+    //lockstep steps of all particles against the steps of one particle at a time
+    {
+        Tracker tScalar( 1 );
+        Tracker tBatch( 1 );
+
+        if( tBatch.fTrajectory.IsBatchable() == false )
+        {
+            mainmsg( eWarning ) << "exact trapped trajectory with sym4 integrator and time control is not batchable" << eom;
+            tSuccess = false;
+        }
+
+        vector< KSParticle > tScalarParticles;
+        vector< KSParticle > tBatchParticles;
+        for( unsigned int tIndex = 0; tIndex < tParticleCount; tIndex++ )
+        {
+            KSParticle* tParticle = CreateElectron( tIndex, &tMagneticField, &tElectricField );
+            tScalarParticles.push_back( *tParticle );
+            tBatchParticles.push_back( *tParticle );
+            delete tParticle;
+        }
+
+        vector< KSParticle > tFinalParticles;
+        vector< KThreeVector > tCenters;
+        vector< double > tRadii;
+        vector< double > tTimeSteps;
+
+        unsigned int tMismatches = 0;
+        for( unsigned int tStep = 0; tStep < tStepCount; tStep++ )
+        {
+            tBatch.fTrajectory.CalculateTrajectories( tBatchParticles, tFinalParticles, tCenters, tRadii, tTimeSteps );
+            for( unsigned int tIndex = 0; tIndex < tParticleCount; tIndex++ )
+            {
+                KSParticle tFinalParticle( tScalarParticles[ tIndex ] );
+                KThreeVector tCenter;
+                double tRadius;
+                double tTimeStep;
+                tScalar.fTrajectory.CalculateTrajectory( tScalarParticles[ tIndex ], tFinalParticle, tCenter, tRadius, tTimeStep );
+
+                if( SameState( tFinalParticle, tFinalParticles[ tIndex ] ) == false || tCenter != tCenters[ tIndex ] || tRadius != tRadii[ tIndex ] || tTimeStep != tTimeSteps[ tIndex ] )
+                {
+                    tMismatches++;
+                }
+
+                tScalarParticles[ tIndex ] = tFinalParticle;
+            }
+            tBatchParticles = tFinalParticles;
+        }
+
+        if( tMismatches != 0 )
+        {
+            mainmsg( eWarning ) << "lockstep orbits differ from the scalar orbits in <" << tMismatches << "> of <" << tParticleCount * tStepCount << "> steps" << eom;
+            tSuccess = false;
+        }
+    }
+
+    //an event tracked with the lookahead of the root trajectory against the same event tracked without it
+    {
+        Tracker tScalar( 1 );
+        Tracker tBatch( 4 );
+        for( unsigned int tIndex = 0; tIndex < tParticleCount; tIndex++ )
+        {
+            tScalar.fEvent.ParticleQueue().push_back( CreateElectron( tIndex, &tMagneticField, &tElectricField ) );
+            tBatch.fEvent.ParticleQueue().push_back( CreateElectron( tIndex, &tMagneticField, &tElectricField ) );
+        }
+
+        vector< KSParticle > tScalarStates;
+        vector< double > tScalarSteps;
+        TrackEvent( tScalar, tScalarStates, tScalarSteps );
+
+        vector< KSParticle > tBatchStates;
+        vector< double > tBatchSteps;
+        TrackEvent( tBatch, tBatchStates, tBatchSteps );
+
+        unsigned int tMismatches = 0;
+        for( unsigned int tIndex = 0; tIndex < tScalarStates.size(); tIndex++ )
+        {
+            if( SameState( tScalarStates[ tIndex ], tBatchStates[ tIndex ] ) == false )
+            {
+                tMismatches++;
+            }
+        }
+        if( tMismatches != 0 || tScalarSteps != tBatchSteps )
+        {
+            mainmsg( eWarning ) << "event tracked with lookahead differs from the scalar event in <" << tMismatches << "> of <" << tScalarStates.size() << "> states" << eom;
+            tSuccess = false;
+        }
+
+        if( tScalar.fRootTrajectory.GetLookaheadCount() != 0 || tBatch.fRootTrajectory.GetLookaheadCount() == 0 )
+        {
+            mainmsg( eWarning ) << "lookahead served <" << tBatch.fRootTrajectory.GetLookaheadCount() << "> steps with lanes and <" << tScalar.fRootTrajectory.GetLookaheadCount() << "> steps without" << eom;
+            tSuccess = false;
+        }
+        mainmsg( eNormal ) << "lookahead served <" << tBatch.fRootTrajectory.GetLookaheadCount() << "> of <" << tBatchSteps.size() / 5 << "> steps" << eom;
+    }
+
+    if( tSuccess == false )
+    {
+        mainmsg( eWarning ) << "batch trajectory test failed" << eom;
+        return -1;
+    }
+    mainmsg( eNormal ) << "lockstep orbits are identical to the scalar orbits" << eom;
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include "KSMagneticKEMField.h"
+#include "KSElectricKEMField.h"
+#include "KSParallelLoop.h"
+#include "KSMainMessage.h"
+
+#include "KMagneticDipoleField.hh"
+#include "KMagneticSuperpositionField.hh"
+#include "KElectricQuadrupoleField.hh"
+
+#include <vector>
+
+using namespace Kassiopeia;
+using namespace KEMField;
+using namespace katrin;
+using namespace std;
+
+//evaluates the field on a z-x grid one row per iteration, like the field painters do
+class FieldMapLoop :
+    public KSParallelLoop
+{
+    public:
+        FieldMapLoop( KSMagneticField* aMagneticField, KSElectricField* anElectricField, vector< vector< double > >& aRows ) :
+                fMagneticField( aMagneticField ),
+                fElectricField( anElectricField ),
+                fRows( aRows )
+        {
+        }
+        virtual ~FieldMapLoop()
+        {
+        }
+
+    protected:
+        virtual void Iteration( const unsigned int& anIndex )
+        {
+            KThreeVector tMagneticField;
+            KThreeMatrix tMagneticGradient;
+            KThreeVector tElectricField;
+            double tPotential;
+
+            double tZ = -0.5 + anIndex * (1. / (fRows.size() - 1));
+            vector< double >& tRow = fRows[ anIndex ];
+            tRow.clear();
+            for( unsigned int tIndex = 0; tIndex < 50; tIndex++ )
+            {
+                KThreeVector tPoint( 0.01 + tIndex * 0.01, 0.003 * tIndex, tZ );
+
+                fMagneticField->CalculateFieldAndGradient( tPoint, 0., tMagneticField, tMagneticGradient );
+                fElectricField->CalculateFieldAndPotential( tPoint, 0., tElectricField, tPotential );
+
+                tRow.push_back( tMagneticField.X() );
+                tRow.push_back( tMagneticField.Y() );
+                tRow.push_back( tMagneticField.Z() );
+                tRow.push_back( tMagneticGradient( 2, 2 ) );
+                tRow.push_back( tElectricField.X() );
+                tRow.push_back( tElectricField.Z() );
+                tRow.push_back( tPotential );
+            }
+            return;
+        }
+
+    private:
+        KSMagneticField* fMagneticField;
+        KSElectricField* fElectricField;
+        vector< vector< double > >& fRows;
+};
+
+int main( int /*anArgc*/, char** /*anArgv*/ )
+{
+    KMagneticDipoleField tDipole;
+    tDipole.SetLocation( KPosition( 0., 0., 0.1 ) );
+    tDipole.SetMoment( KDirection( 0., 0., 10. ) );
+
+    KMagneticDipoleField tOffsetDipole;
+    tOffsetDipole.SetLocation( KPosition( 0.02, 0., -0.2 ) );
+    tOffsetDipole.SetMoment( KDirection( 1., 0., -5. ) );
+
+    KMagneticSuperpositionField tSuperposition;
+    tSuperposition.AddMagneticField( &tDipole, 1. );
+    tSuperposition.AddMagneticField( &tOffsetDipole, 0.5 );
+
+    KElectricQuadrupoleField tQuadrupole;
+    tQuadrupole.SetLocation( KPosition( 0., 0., 0. ) );
+    tQuadrupole.SetStrength( 100. );
+    tQuadrupole.SetLength( 0.5 );
+    tQuadrupole.SetRadius( 0.2 );
+
+    KSMagneticKEMField tMagneticField( &tSuperposition );
+    KSElectricKEMField tElectricField( &tQuadrupole );
+    tMagneticField.Initialize();
+    tElectricField.Initialize();
+
+    bool tSuccess = true;
+
+    if( tMagneticField.IsThreadSafe() == false || tElectricField.IsThreadSafe() == false )
+    {
+        mainmsg( eWarning ) << "analytic fields are not marked thread safe" << eom;
+        tSuccess = false;
+    }
+
+    //the shared caches of a caching superposition must keep it on one thread
+    tSuperposition.SetUseCaching( true );
+    if( tMagneticField.IsThreadSafe() == true )
+    {
+        mainmsg( eWarning ) << "caching superposition field is marked thread safe" << eom;
+        tSuccess = false;
+    }
+    tSuperposition.SetUseCaching( false );
+
+    const unsigned int tRowCount = 200;
+    vector< vector< double > > tSerialRows( tRowCount );
+    FieldMapLoop tSerialLoop( &tMagneticField, &tElectricField, tSerialRows );
+    tSerialLoop.SetNumberOfThreads( 1 );
+    tSerialLoop.Run( tRowCount );
+
+    const unsigned int tThreadCounts[ 3 ] = { 2, 4, 8 };
+    for( unsigned int tThreadIndex = 0; tThreadIndex < 3; tThreadIndex++ )
+    {
+        vector< vector< double > > tThreadedRows( tRowCount );
+        FieldMapLoop tThreadedLoop( &tMagneticField, &tElectricField, tThreadedRows );
+        tThreadedLoop.SetNumberOfThreads( tThreadCounts[ tThreadIndex ] );
+        tThreadedLoop.Run( tRowCount );
+
+        unsigned int tMismatches = 0;
+        for( unsigned int tRow = 0; tRow < tRowCount; tRow++ )
+        {
+            if( tThreadedRows[ tRow ] != tSerialRows[ tRow ] )
+            {
+                tMismatches++;
+            }
+        }
+        if( tMismatches != 0 )
+        {
+            mainmsg( eWarning ) << "map with <" << tThreadCounts[ tThreadIndex ] << "> threads differs from the serial map in <" << tMismatches << "> of <" << tRowCount << "> rows" << eom;
+            tSuccess = false;
+        }
+    }
+
+    if( tSuccess == false )
+    {
+        mainmsg( eWarning ) << "parallel field map test failed" << eom;
+        return -1;
+    }
+    mainmsg( eNormal ) << "threaded field maps are identical to the serial map" << eom;
+    return 0;
+}
@@ -114,6 +114,23 @@ namespace katrin
             aContainer->CopyTo( fObject, &KSGenGeneratorSimulation::SetPIDName );
             return true;
         }
+        // how tracks are drawn per event: all of them, or count tracks in sequential or random order (e.g. mode="random" count="1")
+        if( aContainer->GetName() == "mode" )
+        {
+            aContainer->CopyTo( fObject, &KSGenGeneratorSimulation::SetMode );
+            return true;
+        }
+        if( aContainer->GetName() == "count" )
+        {
+            aContainer->CopyTo( fObject, &KSGenGeneratorSimulation::SetCount );
+            return true;
+        }
+        // keep only track indices in memory and read values on demand, for very large files
+        if( aContainer->GetName() == "streaming" )
+        {
+            aContainer->CopyTo( fObject, &KSGenGeneratorSimulation::SetStreaming );
+            return true;
+        }
         return false;
     }
 
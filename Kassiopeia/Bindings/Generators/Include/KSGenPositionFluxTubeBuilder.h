@@ -45,6 +45,26 @@ namespace katrin
             aContainer->CopyTo( fObject, &KSGenPositionFluxTube::SetOnlySurface );
             return true;
         }
+        if( aContainer->GetName() == "use_radius_table" )
+        {
+            aContainer->CopyTo( fObject, &KSGenPositionFluxTube::SetUseRadiusTable );
+            return true;
+        }
+        if( aContainer->GetName() == "radius_table_z_min" )
+        {
+            aContainer->CopyTo( fObject, &KSGenPositionFluxTube::SetRadiusTableZMin );
+            return true;
+        }
+        if( aContainer->GetName() == "radius_table_z_max" )
+        {
+            aContainer->CopyTo( fObject, &KSGenPositionFluxTube::SetRadiusTableZMax );
+            return true;
+        }
+        if( aContainer->GetName() == "radius_table_n_z" )
+        {
+            aContainer->CopyTo( fObject, &KSGenPositionFluxTube::SetRadiusTableNZ );
+            return true;
+        }
         if( aContainer->GetName() == "magnetic_field_name" )
         {
             fObject->AddMagneticField( getMagneticField( aContainer->AsReference< std::string >() ) );
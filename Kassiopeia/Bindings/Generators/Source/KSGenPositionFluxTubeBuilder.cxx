@@ -29,6 +29,10 @@ namespace katrin
 		KSGenPositionFluxTubeBuilder::Attribute< double >( "flux" ) +
 		KSGenPositionFluxTubeBuilder::Attribute< int >( "n_integration_step" ) +
 		KSGenPositionFluxTubeBuilder::Attribute< bool >( "only_surface" ) +
+		KSGenPositionFluxTubeBuilder::Attribute< bool >( "use_radius_table" ) +
+		KSGenPositionFluxTubeBuilder::Attribute< double >( "radius_table_z_min" ) +
+		KSGenPositionFluxTubeBuilder::Attribute< double >( "radius_table_z_max" ) +
+		KSGenPositionFluxTubeBuilder::Attribute< int >( "radius_table_n_z" ) +
 		KSGenPositionFluxTubeBuilder::Attribute< string >( "magnetic_field_name" ) +
 		KSGenPositionFluxTubeBuilder::ComplexElement< KSGenValueFix >( "phi_fix" ) +
 		KSGenPositionFluxTubeBuilder::ComplexElement< KSGenValueSet >( "phi_set" ) +
@@ -62,6 +62,11 @@ namespace katrin
             aContainer->CopyTo( fObject, &KSNavMeshedSpace::SetNumberOfAllowedElements );
             return true;
         }
+        if( aContainer->GetName() == "n_threads" )
+        {
+            aContainer->CopyTo( fObject, &KSNavMeshedSpace::SetNumberOfThreads );
+            return true;
+        }
         if( aContainer->GetName() == "absolute_tolerance" )
         {
             aContainer->CopyTo( fObject, &KSNavMeshedSpace::SetAbsoluteTolerance );
@@ -35,6 +35,11 @@ namespace katrin
             aContainer->CopyTo( fObject, &KSNavSpace::SetFailCheck );
             return true;
         }
+        if( aContainer->GetName() == "hermite_search" )
+        {
+            aContainer->CopyTo( fObject, &KSNavSpace::SetHermiteSearch );
+            return true;
+        }
         if( aContainer->GetName() == "tolerance" )
         {
         	navmsg( eWarning ) <<"backward compatibility warning: the tolerance attribute is no longer needed in the space navigator, please remove it from your config file!"<<eom;
@@ -22,6 +22,7 @@ namespace katrin
         KSNavMeshedSpaceBuilder::Attribute< unsigned int >( "max_octree_depth" ) +
         KSNavMeshedSpaceBuilder::Attribute< double >( "spatial_resolution" ) +
         KSNavMeshedSpaceBuilder::Attribute< unsigned int >( "n_allowed_elements" ) +
+        KSNavMeshedSpaceBuilder::Attribute< unsigned int >( "n_threads" ) +
         KSNavMeshedSpaceBuilder::Attribute< double >( "absolute_tolerance" ) +
         KSNavMeshedSpaceBuilder::Attribute< double >( "relative_tolerance" ) +
         KSNavMeshedSpaceBuilder::Attribute< string >( "path" );
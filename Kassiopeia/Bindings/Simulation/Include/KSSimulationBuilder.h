@@ -64,6 +64,21 @@ namespace katrin
             aContainer->CopyTo( fObject, &KSSimulation::SetStepReportIteration );
             return true;
         }
+        if( aContainer->GetName() == "profile" )
+        {
+            aContainer->CopyTo( fObject, &KSSimulation::SetProfile );
+            return true;
+        }
+        if( aContainer->GetName() == "lookahead_lanes" )
+        {
+            aContainer->CopyTo( fObject, &KSSimulation::SetLookaheadLanes );
+            return true;
+        }
+        if( aContainer->GetName() == "lookahead_steps" )
+        {
+            aContainer->CopyTo( fObject, &KSSimulation::SetLookaheadSteps );
+            return true;
+        }
         if( aContainer->GetName() == "add_static_run_modifier" )
         {
             fObject->AddStaticRunModifier( KToolbox::GetInstance().Get< KSRunModifier >( aContainer->AsReference< std::string >() ) );
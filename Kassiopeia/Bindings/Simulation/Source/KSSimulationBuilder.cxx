@@ -21,6 +21,9 @@ namespace katrin
         KSSimulationBuilder::Attribute< unsigned int >( "run" ) +
         KSSimulationBuilder::Attribute< unsigned int >( "events" ) +
         KSSimulationBuilder::Attribute< unsigned int >( "step_report_iteration" ) +
+        KSSimulationBuilder::Attribute< bool >( "profile" ) +
+        KSSimulationBuilder::Attribute< unsigned int >( "lookahead_lanes" ) +
+        KSSimulationBuilder::Attribute< unsigned int >( "lookahead_steps" ) +
         KSSimulationBuilder::Attribute< string >( "add_static_run_modifier" ) +
         KSSimulationBuilder::Attribute< string >( "add_static_event_modifier" ) +
         KSSimulationBuilder::Attribute< string >( "add_static_track_modifier" ) +
@@ -33,6 +33,16 @@ namespace katrin
             aContainer->CopyTo( fObject, &KSTrajControlMomentumNumericalError::SetSolverOrder );
             return true;
         }
+        if( aContainer->GetName() == "integral_gain" )
+        {
+            aContainer->CopyTo( fObject, &KSTrajControlMomentumNumericalError::SetIntegralGain );
+            return true;
+        }
+        if( aContainer->GetName() == "proportional_gain" )
+        {
+            aContainer->CopyTo( fObject, &KSTrajControlMomentumNumericalError::SetProportionalGain );
+            return true;
+        }
         return false;
     }
 
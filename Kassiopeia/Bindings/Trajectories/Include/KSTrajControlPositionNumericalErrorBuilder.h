@@ -33,6 +33,16 @@ namespace katrin
             aContainer->CopyTo( fObject, &KSTrajControlPositionNumericalError::SetSolverOrder );
             return true;
         }
+        if( aContainer->GetName() == "integral_gain" )
+        {
+            aContainer->CopyTo( fObject, &KSTrajControlPositionNumericalError::SetIntegralGain );
+            return true;
+        }
+        if( aContainer->GetName() == "proportional_gain" )
+        {
+            aContainer->CopyTo( fObject, &KSTrajControlPositionNumericalError::SetProportionalGain );
+            return true;
+        }
         return false;
     }
 
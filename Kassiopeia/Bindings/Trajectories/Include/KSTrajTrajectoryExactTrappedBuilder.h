@@ -33,12 +33,22 @@ namespace katrin
             aContainer->CopyTo( fObject, &KSTrajTrajectoryExactTrapped::SetAttemptLimit );
             return true;
         }
+        if( aContainer->GetName() == "adiabaticity_limit" )
+        {
+            aContainer->CopyTo( fObject, &KSTrajTrajectoryExactTrapped::SetAdiabaticityLimit );
+            return true;
+        }
         return false;
     }
 
     template< >
     inline bool KSTrajTrajectoryExactTrappedBuilder::AddElement( KContainer* aContainer )
     {
+        if( aContainer->Is< KSTrajTrajectoryAdiabatic >() == true )
+        {
+            aContainer->ReleaseTo( fObject, &KSTrajTrajectoryExactTrapped::SetGuidingCenterTrajectory );
+            return true;
+        }
         if( aContainer->Is< KSTrajExactTrappedIntegrator >() == true )
         {
             aContainer->ReleaseTo( fObject, &KSTrajTrajectoryExactTrapped::SetIntegrator );
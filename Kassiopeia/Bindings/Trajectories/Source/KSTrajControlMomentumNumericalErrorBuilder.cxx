@@ -16,7 +16,9 @@ namespace katrin
         KSTrajControlMomentumNumericalErrorBuilder::Attribute< string >( "name" ) +
         KSTrajControlMomentumNumericalErrorBuilder::Attribute< double >( "absolute_momentum_error" ) +
         KSTrajControlMomentumNumericalErrorBuilder::Attribute< double >( "safety_factor" ) +
-        KSTrajControlMomentumNumericalErrorBuilder::Attribute< double >( "solver_order" );
+        KSTrajControlMomentumNumericalErrorBuilder::Attribute< double >( "solver_order" ) +
+        KSTrajControlMomentumNumericalErrorBuilder::Attribute< double >( "integral_gain" ) +
+        KSTrajControlMomentumNumericalErrorBuilder::Attribute< double >( "proportional_gain" );
 
     STATICINT sToolboxKSTrajControlMomentumNumericalError =
         KSRootBuilder::ComplexElement< KSTrajControlMomentumNumericalError >( "kstraj_control_momentum_numerical_error" );
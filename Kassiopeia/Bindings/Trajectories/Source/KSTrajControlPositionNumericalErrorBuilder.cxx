@@ -16,7 +16,9 @@ namespace katrin
         KSTrajControlPositionNumericalErrorBuilder::Attribute< string >( "name" ) +
         KSTrajControlPositionNumericalErrorBuilder::Attribute< double >( "absolute_position_error" ) +
         KSTrajControlPositionNumericalErrorBuilder::Attribute< double >( "safety_factor" ) +
-        KSTrajControlPositionNumericalErrorBuilder::Attribute< double >( "solver_order" ); 
+        KSTrajControlPositionNumericalErrorBuilder::Attribute< double >( "solver_order" ) +
+        KSTrajControlPositionNumericalErrorBuilder::Attribute< double >( "integral_gain" ) +
+        KSTrajControlPositionNumericalErrorBuilder::Attribute< double >( "proportional_gain" ); 
 
     STATICINT sToolboxKSTrajControlPositionNumericalError =
         KSRootBuilder::ComplexElement< KSTrajControlPositionNumericalError >( "kstraj_control_position_numerical_error" );
@@ -8,6 +8,7 @@
 #include "KSTrajTermSynchrotronBuilder.h"
 #include "KSTrajControlTimeBuilder.h"
 #include "KSTrajControlLengthBuilder.h"
+#include "KSTrajTrajectoryAdiabaticBuilder.h"
 #include "KSRootBuilder.h"
 
 using namespace Kassiopeia;
@@ -24,6 +25,8 @@ namespace katrin
     STATICINT sKSTrajTrajectoryExactTrappedStructure =
         KSTrajTrajectoryExactTrappedBuilder::Attribute< string >( "name" ) +
         KSTrajTrajectoryExactTrappedBuilder::Attribute< unsigned int >( "attempt_limit" ) +
+        KSTrajTrajectoryExactTrappedBuilder::Attribute< double >( "adiabaticity_limit" ) +
+        KSTrajTrajectoryExactTrappedBuilder::ComplexElement< KSTrajTrajectoryAdiabatic >( "guiding_center" ) +
         KSTrajTrajectoryExactTrappedBuilder::ComplexElement< KSTrajIntegratorSym4 >( "integrator_sym4" ) +
         KSTrajTrajectoryExactTrappedBuilder::ComplexElement< KSTrajIntegratorRK8 >( "integrator_rk8" ) +
         //KSTrajTrajectoryExactTrappedBuilder::ComplexElement< KSTrajInterpolatorFast >( "interpolator_fast" ) +
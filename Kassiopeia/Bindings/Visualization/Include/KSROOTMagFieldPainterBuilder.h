@@ -87,6 +87,11 @@ namespace katrin
 			aContainer->CopyTo( fObject, &KSROOTMagFieldPainter::SetAxialSymmetry );
 			return true;
 		}
+        if( aContainer->GetName() == "threads" )
+		{
+			aContainer->CopyTo( fObject, &KSROOTMagFieldPainter::SetThreads );
+			return true;
+		}
 
         return false;
     }
@@ -72,6 +72,11 @@ namespace katrin
             aContainer->CopyTo( fObject, &KSROOTPotentialPainter::SetReferenceFieldName );
             return true;
         }
+        if( aContainer->GetName() == "threads" )
+        {
+            aContainer->CopyTo( fObject, &KSROOTPotentialPainter::SetThreads );
+            return true;
+        }
         return false;
     }
 
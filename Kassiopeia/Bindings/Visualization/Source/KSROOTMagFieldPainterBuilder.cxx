@@ -23,7 +23,8 @@ namespace katrin
 		KSROOTMagFieldPainterBuilder::Attribute< bool >( "magnetic_gradient_numerical" ) +
 		KSROOTMagFieldPainterBuilder::Attribute< string >( "draw" ) +
 		KSROOTMagFieldPainterBuilder::Attribute< bool >( "axial_symmetry" ) +
-		KSROOTMagFieldPainterBuilder::Attribute< double >( "z_fix" );
+		KSROOTMagFieldPainterBuilder::Attribute< double >( "z_fix" ) +
+		KSROOTMagFieldPainterBuilder::Attribute< unsigned int >( "threads" );
 
 
 
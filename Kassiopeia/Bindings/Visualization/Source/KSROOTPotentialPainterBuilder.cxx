@@ -20,7 +20,8 @@ namespace katrin
         KSROOTPotentialPainterBuilder::Attribute< int >( "z_steps" ) +
         KSROOTPotentialPainterBuilder::Attribute< bool >( "calc_pot" ) +
         KSROOTPotentialPainterBuilder::Attribute< bool >( "compare_fields" ) +
-        KSROOTPotentialPainterBuilder::Attribute< string >( "reference_field" );
+        KSROOTPotentialPainterBuilder::Attribute< string >( "reference_field" ) +
+        KSROOTPotentialPainterBuilder::Attribute< unsigned int >( "threads" );
 
 
     STATICINT sKSROOTPotentialPainterWindow =
@@ -31,6 +31,7 @@ public:
 	virtual void CalculatePotential( const KGeoBag::KThreeVector& aSamplePoint, const double& aSampleTime, double& aPotential );
 	virtual void CalculateField( const KGeoBag::KThreeVector& aSamplePoint, const double& aSampleTime, KGeoBag::KThreeVector& aField );
     virtual void CalculateFieldAndPotential( const KGeoBag::KThreeVector& aSamplePoint, const double& aSampleTime, KGeoBag::KThreeVector& aField, double& aPotential);
+    virtual bool IsThreadSafe() const;
 
 private:
     void InitializeComponent();
@@ -30,6 +30,7 @@ public:
     virtual void CalculateField( const KThreeVector& aSamplePoint, const double& aSampleTime, KThreeVector& aField);
     virtual void CalculateGradient( const KThreeVector& aSamplePoint, const double& aSampleTime, KThreeMatrix& aGradient);
     virtual void CalculateFieldAndGradient( const KThreeVector& aSamplePoint, const double& aSampleTime, KThreeVector& aField, KThreeMatrix& aGradient);
+    virtual bool IsThreadSafe() const;
 private:
     void InitializeComponent();
     void DeinitializeComponent();
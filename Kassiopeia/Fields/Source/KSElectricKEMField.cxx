@@ -67,6 +67,11 @@ KSElectricKEMField::CalculateFieldAndPotential( const KGeoBag::KThreeVector& aSa
     aField = potential_field_pair.first;
 }
 
+bool KSElectricKEMField::IsThreadSafe() const
+{
+    return fField != NULL && fField->IsThreadSafe();
+}
+
 
 void KSElectricKEMField::InitializeComponent() {
 	fField->Initialize();
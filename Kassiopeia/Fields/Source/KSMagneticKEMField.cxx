@@ -74,6 +74,11 @@ void KSMagneticKEMField::CalculateFieldAndGradient( const KThreeVector& aSampleP
     aGradient = field_gradient_pair.second;
 }
 
+bool KSMagneticKEMField::IsThreadSafe() const
+{
+    return fField != NULL && fField->IsThreadSafe();
+}
+
 
 void KSMagneticKEMField::InitializeComponent() {
     fField->Initialize();
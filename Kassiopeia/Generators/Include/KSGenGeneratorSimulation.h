@@ -51,16 +51,46 @@ namespace Kassiopeia
             ;K_SET_GET( std::string, KineticEnergyName );
             ;K_SET_GET( std::string, TimeName );
             ;K_SET_GET( std::string, PIDName );
+            ;K_SET_GET( std::string, Mode );
+            ;K_SET_GET( unsigned int, Count );
+            ;K_SET_GET( bool, Streaming );
 
         protected:
             void InitializeComponent();
             void DeinitializeComponent();
 
-            void GenerateParticlesFromFile( KSParticleQueue &aParticleQueue );
+            void ReadCandidatesFromFile();
+            void GenerateParticle( unsigned int aCandidate, KSParticleQueue& aParticleQueue );
 
         private:
+            // a selected track, with all formulas already applied
+            struct Candidate
+            {
+                KThreeVector fPosition;
+                KThreeVector fDirection;
+                double fEnergy;
+                double fTime;
+                int fPID;
+            };
+
+            typedef enum
+            {
+                eAll, eSequential, eRandom
+            } DrawMode;
+
+            Candidate EvaluateCandidate();
+
             KRootFile* fRootFile;
 
+            // opened once at initialization and only kept open when streaming
+            KSReadFileROOT* fReader;
+            KSReadObjectROOT* fTrackGroup;
+
+            DrawMode fDrawMode;
+            vector< Candidate > fCandidates;
+            vector< unsigned int > fCandidateTracks;
+            unsigned int fNextCandidate;
+
             TFormula *fFormulaPositionX;
             TFormula *fFormulaPositionY;
             TFormula *fFormulaPositionZ;
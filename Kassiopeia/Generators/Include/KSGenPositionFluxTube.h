@@ -33,6 +33,11 @@ namespace Kassiopeia
         private:
             void CalculateField( const KThreeVector& aSamplePoint, const double& aSampleTime, KThreeVector& aField );
 
+            //radius enclosing the flux at the given z, integrated outwards along the direction phi
+            double IntegrateRadius( const double& aZ, const double& aPhi );
+
+            //radius interpolated from the table, z values outside of the table range are integrated along phi
+            double LookupRadius( const double& aZ, const double& aPhi );
 
         private:
             KSGenValue* fPhiValue;
@@ -42,6 +47,14 @@ namespace Kassiopeia
             ;K_SET( int, NIntegrationSteps );
             ;K_SET( bool, OnlySurface );
 
+            //radius table, assumes an axially symmetric field
+            ;K_SET( bool, UseRadiusTable );
+            ;K_SET( double, RadiusTableZMin );
+            ;K_SET( double, RadiusTableZMax );
+            ;K_SET( int, RadiusTableNZ );
+            std::vector< double > fRadiusTableSquares;
+            bool fRadiusTableFallbackWarned;
+
         protected:
             void InitializeComponent();
             void DeinitializeComponent();
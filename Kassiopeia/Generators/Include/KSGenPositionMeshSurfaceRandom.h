@@ -10,6 +10,7 @@
 
 #include "KGCore.hh"
 #include "KGMesh.hh"
+#include "KGAliasTable.hh"
 #include "KSGeneratorsMessage.h"
 #include "KSGenCreator.h"
 #include "KSGenValue.h"
@@ -87,6 +88,13 @@ namespace Kassiopeia
          */
         std::vector< KSGenMeshElementSystem > fElementsystems;
 
+        /**
+         * @brief fElements lists every mesh element together with the index of its
+         * Elementsystem, fAreaTable dices an entry of this list proportional to its area
+         */
+        std::vector< std::pair< unsigned int, KGeoBag::KGMeshElement* > > fElements;
+        KGeoBag::KGAliasTable fAreaTable;
+
 
     protected:
         void InitializeComponent();
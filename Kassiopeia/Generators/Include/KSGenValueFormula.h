@@ -5,7 +5,8 @@
 
 #include "KField.h"
 
-#include "TF1.h"
+#include "KMathExpression.h"
+#include "KMathTabulatedDistribution.h"
 
 namespace Kassiopeia
 {
@@ -31,7 +32,8 @@ namespace Kassiopeia
             void DeinitializeComponent();
 
         protected:
-            TF1* fValueFunction;
+            katrin::KMathExpression fValueFunction;
+            katrin::KMathTabulatedDistribution fValueDistribution;
     };
 
 }
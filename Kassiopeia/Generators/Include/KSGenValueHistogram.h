@@ -11,8 +11,10 @@ using katrin::KFile;
 #include "KRootFile.h"
 using katrin::KRootFile;
 
+#include "KMathExpression.h"
+#include "KMathTabulatedDistribution.h"
+
 #include "TH1.h"
-#include "TF1.h"
 
 namespace Kassiopeia
 {
@@ -39,9 +41,8 @@ namespace Kassiopeia
             void DeinitializeComponent();
 
         private:
-            KRootFile* fRootFile;
-            TH1* fValueHistogram;
-            TF1* fValueFunction;
+            katrin::KMathTabulatedDistribution fValueDistribution;
+            katrin::KMathExpression fValueFunction;
     };
 
 }
@@ -2,6 +2,9 @@
 #include "KSGeneratorsMessage.h"
 #include "KSParticleFactory.h"
 
+#include "KRandom.h"
+using katrin::KRandom;
+
 namespace Kassiopeia
 {
 
@@ -26,7 +29,16 @@ namespace Kassiopeia
             fKineticEnergyName( "final_kinetic_energy" ),
             fTimeName( "final_time" ),
             fPIDName( "" ),
+            fMode( "all" ),
+            fCount( 1 ),
+            fStreaming( false ),
             fRootFile( NULL ),
+            fReader( NULL ),
+            fTrackGroup( NULL ),
+            fDrawMode( eAll ),
+            fCandidates(),
+            fCandidateTracks(),
+            fNextCandidate( 0 ),
             fFormulaPositionX( NULL ),
             fFormulaPositionY( NULL ),
             fFormulaPositionZ( NULL ),
@@ -46,7 +58,7 @@ namespace Kassiopeia
             fPositionZ( aCopy.fPositionZ ),
             fDirectionX( aCopy.fDirectionX ),
             fDirectionY( aCopy.fDirectionY ),
-            fDirectionZ( aCopy.fDirectionX ),
+            fDirectionZ( aCopy.fDirectionZ ),
             fEnergy( aCopy.fEnergy ),
             fTime( aCopy.fTime ),
             fTerminator( aCopy.fTerminator),
@@ -59,7 +71,16 @@ namespace Kassiopeia
             fKineticEnergyName( aCopy.fKineticEnergyName ),
             fTimeName( aCopy.fTimeName ),
             fPIDName( aCopy.fPIDName ),
+            fMode( aCopy.fMode ),
+            fCount( aCopy.fCount ),
+            fStreaming( aCopy.fStreaming ),
             fRootFile( NULL ),
+            fReader( NULL ),
+            fTrackGroup( NULL ),
+            fDrawMode( eAll ),
+            fCandidates(),
+            fCandidateTracks(),
+            fNextCandidate( 0 ),
             fFormulaPositionX( NULL ),
             fFormulaPositionY( NULL ),
             fFormulaPositionZ( NULL ),
@@ -81,7 +102,42 @@ namespace Kassiopeia
     void KSGenGeneratorSimulation::ExecuteGeneration( KSParticleQueue& aPrimaries )
     {
         KSParticleQueue tParticleQueue;
-        GenerateParticlesFromFile( tParticleQueue );
+
+        unsigned int tNumberOfCandidates = fCandidateTracks.size();
+        if( fDrawMode == eAll )
+        {
+            for( unsigned int tIndex = 0; tIndex < tNumberOfCandidates; tIndex++ )
+            {
+                GenerateParticle( tIndex, tParticleQueue );
+            }
+        }
+        else
+        {
+            if( tNumberOfCandidates == 0 )
+            {
+                genmsg( eError ) << "simulation generator <" << GetName() << "> has no tracks to draw from" << eom;
+            }
+            for( unsigned int tCount = 0; tCount < fCount; tCount++ )
+            {
+                unsigned int tIndex;
+                if( fDrawMode == eSequential )
+                {
+                    if( fNextCandidate >= tNumberOfCandidates )
+                    {
+                        genmsg( eWarning ) << "simulation generator <" << GetName() << "> used all " << tNumberOfCandidates << " tracks, starting over" << eom;
+                        fNextCandidate = 0;
+                    }
+                    tIndex = fNextCandidate++;
+                }
+                else
+                {
+                    tIndex = KRandom::GetInstance().Uniform< unsigned int >( 0, tNumberOfCandidates - 1 );
+                }
+                GenerateParticle( tIndex, tParticleQueue );
+            }
+        }
+
+        genmsg_debug( "simulation generator <" << GetName() << "> creates " << tParticleQueue.size() << " particles" << eom );
 
         aPrimaries.assign( tParticleQueue.begin(), tParticleQueue.end() );
 
@@ -161,10 +217,34 @@ namespace Kassiopeia
         if ( ! fTime.empty() )
             fFormulaTime = new TFormula( "time", fTime.c_str() );
 
+        if( fMode == "all" )
+            fDrawMode = eAll;
+        else if( fMode == "sequential" )
+            fDrawMode = eSequential;
+        else if( fMode == "random" )
+            fDrawMode = eRandom;
+        else
+            genmsg( eError ) << "simulation generator <" << GetName() << "> has unknown mode <" << fMode << ">, must be <all>, <sequential> or <random>" << eom;
+
+        // select tracks once, instead of scanning the file for every event
+        ReadCandidatesFromFile();
+
         return;
     }
     void KSGenGeneratorSimulation::DeinitializeComponent()
     {
+        if ( fReader != NULL )
+        {
+            fReader->CloseFile();
+            delete fReader;
+        }
+        fReader = NULL;
+        fTrackGroup = NULL;
+
+        fCandidates.clear();
+        fCandidateTracks.clear();
+        fNextCandidate = 0;
+
         if ( fRootFile != NULL )
             delete fRootFile;
         fRootFile = NULL;
@@ -200,16 +280,16 @@ namespace Kassiopeia
         return;
     }
 
-    void KSGenGeneratorSimulation::GenerateParticlesFromFile( KSParticleQueue &aParticleQueue )
+    void KSGenGeneratorSimulation::ReadCandidatesFromFile()
     {
-        KSReadFileROOT tReader;
-        tReader.OpenFile( fRootFile );
+        fReader = new KSReadFileROOT();
+        fReader->OpenFile( fRootFile );
 
-        KSReadRunROOT&      tRunReader   = tReader.GetRun();
-        KSReadEventROOT&    tEventReader = tReader.GetEvent();
-        KSReadTrackROOT&    tTrackReader = tReader.GetTrack();
+        KSReadRunROOT&      tRunReader   = fReader->GetRun();
+        KSReadEventROOT&    tEventReader = fReader->GetEvent();
+        KSReadTrackROOT&    tTrackReader = fReader->GetTrack();
 
-        KSReadObjectROOT&   tTrackGroup = tTrackReader.GetObject( fTrackGroupName );
+        fTrackGroup = &(tTrackReader.GetObject( fTrackGroupName ));
 
         for( tRunReader = 0; tRunReader <= tRunReader.GetLastRunIndex(); tRunReader++ )
         {
@@ -217,82 +297,117 @@ namespace Kassiopeia
             {
                 for( tTrackReader = tEventReader.GetFirstTrackIndex(); tTrackReader <= tEventReader.GetLastTrackIndex(); tTrackReader++ )
                 {
-                    if( ! tTrackGroup.Valid() )
+                    if( ! fTrackGroup->Valid() )
                         continue;
 
                     if ( ! fTerminator.empty() )
                     {
-                        string tTerminator = tTrackGroup.Get< KSString >( fTerminatorName ).Value();
+                        const string& tTerminator = fTrackGroup->Get< KSString >( fTerminatorName ).Value();
                         if ( tTerminator != fTerminator )
                             continue;
                     }
 
                     if ( ! fGenerator.empty() )
                     {
-                        string tGenerator = tTrackGroup.Get< KSString >( fGeneratorName ).Value();
+                        const string& tGenerator = fTrackGroup->Get< KSString >( fGeneratorName ).Value();
                         if ( tGenerator != fGenerator )
                             continue;
                     }
 
-                    KThreeVector tPosition(0, 0, 0);
-                    KThreeVector tDirection(0, 0, 0);
-                    double tEnergy = 0.;
-                    double tTime = 0.;
-                    int tPID = 11;
-
-                    if ( ! fPositionName.empty() )
-                    {
-                        tPosition = tTrackGroup.Get< KSThreeVector >( fPositionName ).Value();
-                    }
-                    if ( ! fMomentumName.empty() )
-                    {
-                        tDirection = tTrackGroup.Get< KSThreeVector >( fMomentumName ).Value().Unit();
-                    }
-                    if ( ! fKineticEnergyName.empty() )
-                    {
-                        tEnergy = tTrackGroup.Get< KSDouble >( fKineticEnergyName ).Value();
-                    }
-                    if ( ! fTimeName.empty() )
+                    // when streaming, only the track index is kept and values are read on demand
+                    fCandidateTracks.push_back( tTrackReader.Index() );
+                    if( ! fStreaming )
                     {
-                        tTime = tTrackGroup.Get< KSDouble >( fTimeName ).Value();
+                        fCandidates.push_back( EvaluateCandidate() );
                     }
-                    if ( ! fPIDName.empty() )
-                    {
-                        tPID = tTrackGroup.Get< KSInt >( fPIDName ).Value();
-                    }
-
-                    if ( fFormulaPositionX != NULL )
-                        tPosition.SetX( fFormulaPositionX->Eval( tPosition.X() ) );
-                    if ( fFormulaPositionY != NULL )
-                        tPosition.SetY( fFormulaPositionY->Eval( tPosition.Y() ) );
-                    if ( fFormulaPositionZ != NULL )
-                        tPosition.SetZ( fFormulaPositionZ->Eval( tPosition.Z() ) );
-                    if ( fFormulaDirectionX != NULL )
-                        tDirection.SetX( fFormulaDirectionX->Eval( tDirection.X() ) );
-                    if ( fFormulaDirectionY != NULL )
-                        tDirection.SetY( fFormulaDirectionY->Eval( tDirection.Y() ) );
-                    if ( fFormulaDirectionZ != NULL )
-                        tDirection.SetZ( fFormulaDirectionZ->Eval( tDirection.Z() ) );
-                    if ( fFormulaEnergy != NULL )
-                        tEnergy = fFormulaEnergy->Eval( tEnergy );
-                    if ( fFormulaTime != NULL )
-                        tTime = fFormulaTime->Eval( tTime );
-
-                    KSParticle* tParticle = KSParticleFactory::GetInstance().Create( tPID );
-                    tParticle->SetPosition( tPosition );
-                    tParticle->SetMomentum( tDirection.Unit() );  // normalize again here to be safe
-                    tParticle->SetKineticEnergy_eV( tEnergy );
-                    tParticle->SetTime( tTime );
-                    tParticle->AddLabel( GetName() );
-
-                    aParticleQueue.push_back( tParticle );
                 }
             }
         }
 
-        genmsg_debug( "simulation generator <" << GetName() << "> creates " << aParticleQueue.size() << " particles" << eom );
+        genmsg( eNormal ) << "simulation generator <" << GetName() << "> selected " << fCandidateTracks.size() << " tracks from file <" << fBase << ">" << eom;
+
+        if( ! fStreaming )
+        {
+            fReader->CloseFile();
+            delete fReader;
+            fReader = NULL;
+            fTrackGroup = NULL;
+        }
+        return;
+    }
+
+    KSGenGeneratorSimulation::Candidate KSGenGeneratorSimulation::EvaluateCandidate()
+    {
+        Candidate tCandidate;
+        tCandidate.fPosition.SetComponents( 0., 0., 0. );
+        tCandidate.fDirection.SetComponents( 0., 0., 0. );
+        tCandidate.fEnergy = 0.;
+        tCandidate.fTime = 0.;
+        tCandidate.fPID = 11;
+
+        if ( ! fPositionName.empty() )
+        {
+            tCandidate.fPosition = fTrackGroup->Get< KSThreeVector >( fPositionName ).Value();
+        }
+        if ( ! fMomentumName.empty() )
+        {
+            tCandidate.fDirection = fTrackGroup->Get< KSThreeVector >( fMomentumName ).Value().Unit();
+        }
+        if ( ! fKineticEnergyName.empty() )
+        {
+            tCandidate.fEnergy = fTrackGroup->Get< KSDouble >( fKineticEnergyName ).Value();
+        }
+        if ( ! fTimeName.empty() )
+        {
+            tCandidate.fTime = fTrackGroup->Get< KSDouble >( fTimeName ).Value();
+        }
+        if ( ! fPIDName.empty() )
+        {
+            tCandidate.fPID = fTrackGroup->Get< KSInt >( fPIDName ).Value();
+        }
+
+        if ( fFormulaPositionX != NULL )
+            tCandidate.fPosition.SetX( fFormulaPositionX->Eval( tCandidate.fPosition.X() ) );
+        if ( fFormulaPositionY != NULL )
+            tCandidate.fPosition.SetY( fFormulaPositionY->Eval( tCandidate.fPosition.Y() ) );
+        if ( fFormulaPositionZ != NULL )
+            tCandidate.fPosition.SetZ( fFormulaPositionZ->Eval( tCandidate.fPosition.Z() ) );
+        if ( fFormulaDirectionX != NULL )
+            tCandidate.fDirection.SetX( fFormulaDirectionX->Eval( tCandidate.fDirection.X() ) );
+        if ( fFormulaDirectionY != NULL )
+            tCandidate.fDirection.SetY( fFormulaDirectionY->Eval( tCandidate.fDirection.Y() ) );
+        if ( fFormulaDirectionZ != NULL )
+            tCandidate.fDirection.SetZ( fFormulaDirectionZ->Eval( tCandidate.fDirection.Z() ) );
+        if ( fFormulaEnergy != NULL )
+            tCandidate.fEnergy = fFormulaEnergy->Eval( tCandidate.fEnergy );
+        if ( fFormulaTime != NULL )
+            tCandidate.fTime = fFormulaTime->Eval( tCandidate.fTime );
+
+        return tCandidate;
+    }
+
+    void KSGenGeneratorSimulation::GenerateParticle( unsigned int aCandidate, KSParticleQueue& aParticleQueue )
+    {
+        Candidate tCandidate;
+        if( fStreaming )
+        {
+            // random access into the track tree, no scan required
+            fReader->GetTrack() = fCandidateTracks[ aCandidate ];
+            tCandidate = EvaluateCandidate();
+        }
+        else
+        {
+            tCandidate = fCandidates[ aCandidate ];
+        }
+
+        KSParticle* tParticle = KSParticleFactory::GetInstance().Create( tCandidate.fPID );
+        tParticle->SetPosition( tCandidate.fPosition );
+        tParticle->SetMomentum( tCandidate.fDirection.Unit() );  // normalize again here to be safe
+        tParticle->SetKineticEnergy_eV( tCandidate.fEnergy );
+        tParticle->SetTime( tCandidate.fTime );
+        tParticle->AddLabel( GetName() );
 
-        tReader.CloseFile();
+        aParticleQueue.push_back( tParticle );
         return;
     }
 
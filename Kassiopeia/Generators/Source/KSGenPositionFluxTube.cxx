@@ -15,7 +15,13 @@ namespace Kassiopeia
             fMagneticFields(),
             fFlux( 0.0191 ),
             fNIntegrationSteps( 1000 ),
-            fOnlySurface( true )
+            fOnlySurface( true ),
+            fUseRadiusTable( false ),
+            fRadiusTableZMin( 0. ),
+            fRadiusTableZMax( 0. ),
+            fRadiusTableNZ( 0 ),
+            fRadiusTableSquares(),
+            fRadiusTableFallbackWarned( false )
     {
     }
 	KSGenPositionFluxTube::KSGenPositionFluxTube( const KSGenPositionFluxTube& aCopy ) :
@@ -25,7 +31,13 @@ namespace Kassiopeia
             fMagneticFields( aCopy.fMagneticFields ),
             fFlux( aCopy.fFlux ),
             fNIntegrationSteps( aCopy.fNIntegrationSteps ),
-            fOnlySurface( aCopy.fOnlySurface )
+            fOnlySurface( aCopy.fOnlySurface ),
+            fUseRadiusTable( aCopy.fUseRadiusTable ),
+            fRadiusTableZMin( aCopy.fRadiusTableZMin ),
+            fRadiusTableZMax( aCopy.fRadiusTableZMax ),
+            fRadiusTableNZ( aCopy.fRadiusTableNZ ),
+            fRadiusTableSquares( aCopy.fRadiusTableSquares ),
+            fRadiusTableFallbackWarned( false )
     {
     }
 	KSGenPositionFluxTube* KSGenPositionFluxTube::Clone() const
@@ -56,12 +68,6 @@ namespace Kassiopeia
         vector< double >::iterator tZValueIt;
 
         double tRValue;
-		double tX;
-		double tY;
-
-		double tFlux;
-		double tArea;
-		double tLastArea;
 
         fPhiValue->DiceValue( tPhiValues );
         fZValue->DiceValue( tZValues );
@@ -74,39 +80,14 @@ namespace Kassiopeia
 			{
 				tPhiValue = (KConst::Pi() / 180.) * (*tPhiValueIt);
 
-				tRValue = 0.0;
-				tFlux = 0.0;
-				tLastArea = 0.0;
-
-				KThreeVector tField;
-				//calculate position at z=0 to get approximation for radius
-				CalculateField( KThreeVector( 0, 0, tZValue ), 0.0, tField );
-				double tRApproximation = sqrt( fFlux / (KConst::Pi() * tField.Magnitude() ) );
-				genmsg_debug( "r approximation is <"<<tRApproximation<<">"<<eom);
-
-				//calculate stepsize from 0 to rApproximation
-				double tStepSize = tRApproximation / fNIntegrationSteps;
-
-				while( tFlux < fFlux )
+				if( fUseRadiusTable == true )
 				{
-					tX = tRValue * cos( tPhiValue );
-					tY = tRValue * sin( tPhiValue );
-					CalculateField( KThreeVector(tX,tY,tZValue), 0.0, tField );
-
-					tArea = KConst::Pi()*tRValue*tRValue;
-					tFlux += tField.Magnitude() * ( tArea - tLastArea);
-
-					genmsg_debug( "r <"<<tRValue<<">"<<eom);
-					genmsg_debug( "field "<<tField<<eom);
-					genmsg_debug( "area <"<<tArea<<">"<<eom);
-					genmsg_debug( "flux <"<<tFlux<<">"<<eom);
-
-					tRValue += tStepSize;
-					tLastArea = tArea;
+					tRValue = LookupRadius( tZValue, tPhiValue );
+				}
+				else
+				{
+					tRValue = IntegrateRadius( tZValue, tPhiValue );
 				}
-
-				//correct the last step, to get a tFlux = fFlux
-				tRValue = sqrt( tRValue * tRValue - ( tFlux - fFlux ) / ( tField.Magnitude()*KConst::Pi() ) );
 
 				//dice r value if volume option is choosen
 				if ( !fOnlySurface )
@@ -140,6 +121,77 @@ namespace Kassiopeia
     }
 
 
+    double KSGenPositionFluxTube::IntegrateRadius( const double& aZ, const double& aPhi )
+    {
+		double tRValue;
+		double tX;
+		double tY;
+
+		double tFlux;
+		double tArea;
+		double tLastArea;
+
+		tRValue = 0.0;
+		tFlux = 0.0;
+		tLastArea = 0.0;
+
+		KThreeVector tField;
+		//calculate position at z=0 to get approximation for radius
+		CalculateField( KThreeVector( 0, 0, aZ ), 0.0, tField );
+		double tRApproximation = sqrt( fFlux / (KConst::Pi() * tField.Magnitude() ) );
+		genmsg_debug( "r approximation is <"<<tRApproximation<<">"<<eom);
+
+		//calculate stepsize from 0 to rApproximation
+		double tStepSize = tRApproximation / fNIntegrationSteps;
+
+		while( tFlux < fFlux )
+		{
+			tX = tRValue * cos( aPhi );
+			tY = tRValue * sin( aPhi );
+			CalculateField( KThreeVector(tX,tY,aZ), 0.0, tField );
+
+			tArea = KConst::Pi()*tRValue*tRValue;
+			tFlux += tField.Magnitude() * ( tArea - tLastArea);
+
+			genmsg_debug( "r <"<<tRValue<<">"<<eom);
+			genmsg_debug( "field "<<tField<<eom);
+			genmsg_debug( "area <"<<tArea<<">"<<eom);
+			genmsg_debug( "flux <"<<tFlux<<">"<<eom);
+
+			tRValue += tStepSize;
+			tLastArea = tArea;
+		}
+
+		//correct the last step, to get a tFlux = fFlux
+		tRValue = sqrt( tRValue * tRValue - ( tFlux - fFlux ) / ( tField.Magnitude()*KConst::Pi() ) );
+
+		return tRValue;
+    }
+
+    double KSGenPositionFluxTube::LookupRadius( const double& aZ, const double& aPhi )
+    {
+        if( fRadiusTableNZ > 1 && aZ >= fRadiusTableZMin && aZ <= fRadiusTableZMax )
+        {
+            //interpolate the enclosed area, i.e. r^2, linearly between the grid points
+            double tPosition = (aZ - fRadiusTableZMin) / (fRadiusTableZMax - fRadiusTableZMin) * (fRadiusTableNZ - 1);
+            int tIndex = (int) floor( tPosition );
+            if( tIndex > fRadiusTableNZ - 2 )
+            {
+                tIndex = fRadiusTableNZ - 2;
+            }
+            double tFraction = tPosition - tIndex;
+            return sqrt( (1. - tFraction) * fRadiusTableSquares[ tIndex ] + tFraction * fRadiusTableSquares[ tIndex + 1 ] );
+        }
+
+        //z values off the grid are integrated as without a table
+        if( fRadiusTableFallbackWarned == false )
+        {
+            genmsg( eWarning ) << "flux tube generator <" << GetName() << "> integrates the radius at z <" << aZ << ">, which is not covered by its radius table from <" << fRadiusTableZMin << "> to <" << fRadiusTableZMax << "> with <" << fRadiusTableNZ << "> points" << eom;
+            fRadiusTableFallbackWarned = true;
+        }
+        return IntegrateRadius( aZ, aPhi );
+    }
+
     void KSGenPositionFluxTube::SetPhiValue( KSGenValue* aPhiValue )
     {
         if( fPhiValue == NULL )
@@ -213,6 +265,46 @@ namespace Kassiopeia
         {
             tIndex->Initialize();
         }
+
+        fRadiusTableSquares.clear();
+        fRadiusTableFallbackWarned = false;
+        if( fUseRadiusTable == true && fRadiusTableNZ > 1 )
+        {
+            if( fRadiusTableZMax <= fRadiusTableZMin )
+            {
+                genmsg( eError ) << "flux tube generator <" << GetName() << "> needs a radius table z range with z_max > z_min" << eom;
+            }
+            for( int tIndex = 0; tIndex < fRadiusTableNZ; tIndex++ )
+            {
+                double tZ = fRadiusTableZMin + tIndex * (fRadiusTableZMax - fRadiusTableZMin) / (fRadiusTableNZ - 1);
+                double tRValue = IntegrateRadius( tZ, 0. );
+                fRadiusTableSquares.push_back( tRValue * tRValue );
+            }
+            genmsg_debug( "flux tube generator <" << GetName() << "> tabulated the radius at <" << fRadiusTableNZ << "> z values" << eom );
+
+            //the table is integrated at phi = 0 only, compare a few other directions at both ends and the center
+            double tDeviation = 0.;
+            int tSampleIndices[ 3 ] = { 0, (fRadiusTableNZ - 1) / 2, fRadiusTableNZ - 1 };
+            for( int tSample = 0; tSample < 3; tSample++ )
+            {
+                int tIndex = tSampleIndices[ tSample ];
+                double tZ = fRadiusTableZMin + tIndex * (fRadiusTableZMax - fRadiusTableZMin) / (fRadiusTableNZ - 1);
+                double tTableRValue = sqrt( fRadiusTableSquares[ tIndex ] );
+                for( int tPhiIndex = 1; tPhiIndex < 4; tPhiIndex++ )
+                {
+                    double tRValue = IntegrateRadius( tZ, tPhiIndex * KConst::Pi() / 2. );
+                    double tRelative = fabs( tRValue - tTableRValue ) / tTableRValue;
+                    if( tRelative > tDeviation )
+                    {
+                        tDeviation = tRelative;
+                    }
+                }
+            }
+            if( tDeviation > 1.e-4 )
+            {
+                genmsg( eWarning ) << "flux tube generator <" << GetName() << "> uses a radius table, but the radius depends on phi by up to <" << 100. * tDeviation << "> percent; the field does not look axially symmetric" << eom;
+            }
+        }
         return;
     }
     void KSGenPositionFluxTube::DeinitializeComponent()
@@ -22,7 +22,9 @@ namespace Kassiopeia
     KSGenPositionMeshSurfaceRandom::KSGenPositionMeshSurfaceRandom(const KSGenPositionMeshSurfaceRandom& aCopy):
             KSComponent(),
             fTotalArea( aCopy.fTotalArea ),
-            fElementsystems( aCopy.fElementsystems )
+            fElementsystems( aCopy.fElementsystems ),
+            fElements( aCopy.fElements ),
+            fAreaTable( aCopy.fAreaTable )
     {}
 
     KSGenPositionMeshSurfaceRandom* KSGenPositionMeshSurfaceRandom::Clone() const
@@ -58,26 +60,13 @@ namespace Kassiopeia
     {
         for(KSParticleIt tParticleIt = aPrimaries->begin(); tParticleIt != aPrimaries->end(); ++tParticleIt)
         {
-            double tDecision = KRandom::GetInstance().Uniform() * fTotalArea;
-            std::vector< KSGenMeshElementSystem >::iterator tSysIt;
-            KGeoBag::KGMeshElementCIt tElementIt;
+            double tFirstUniform = KRandom::GetInstance().Uniform();
+            double tSecondUniform = KRandom::GetInstance().Uniform();
+            const std::pair< unsigned int, KGeoBag::KGMeshElement* >& tEntry = fElements[ fAreaTable.Sample( tFirstUniform, tSecondUniform ) ];
+            std::vector< KSGenMeshElementSystem >::iterator tSysIt = fElementsystems.begin() + tEntry.first;
+            KGeoBag::KGMeshElement* tElement = tEntry.second;
 
-            for( tSysIt = fElementsystems.begin(); tSysIt != fElementsystems.end(); ++tSysIt )
-            {
-                for( tElementIt = tSysIt->second->begin(); tElementIt != tSysIt->second->end(); ++tElementIt )
-                {
-                    tDecision -= (*tElementIt)->Area();
-                    if (tDecision < 0.)
-                    {
-                        break;
-                    }
-                }
-
-                if( tDecision < 0.)
-                    break;
-            }
-
-            if( KGeoBag::KGMeshRectangle* tMeshRectangle = dynamic_cast< KGeoBag::KGMeshRectangle* >( *tElementIt ) )
+            if( KGeoBag::KGMeshRectangle* tMeshRectangle = dynamic_cast< KGeoBag::KGMeshRectangle* >( tElement ) )
             {
                 KThreeVector tInternalRandomPosition = tMeshRectangle->GetP0() + KRandom::GetInstance().Uniform() * tMeshRectangle->GetA() * tMeshRectangle->GetN1()
                                                                                + KRandom::GetInstance().Uniform() * tMeshRectangle->GetB() * tMeshRectangle->GetN2();
@@ -91,7 +80,7 @@ namespace Kassiopeia
                 continue;
             }
 
-            if( KGeoBag::KGMeshTriangle* tMeshTriangle = dynamic_cast< KGeoBag::KGMeshTriangle* >( *tElementIt ) )
+            if( KGeoBag::KGMeshTriangle* tMeshTriangle = dynamic_cast< KGeoBag::KGMeshTriangle* >( tElement ) )
             {
                 //P = (1 - sqrt(r1)) * A + (sqrt(r1) * (1 - r2)) * B + (sqrt(r1) * r2) * C
                 double r1 = KRandom::GetInstance().Uniform();
@@ -111,7 +100,7 @@ namespace Kassiopeia
 
             }
 
-            if( KGeoBag::KGMeshWire* tMeshWire = dynamic_cast< KGeoBag::KGMeshWire* >( *tElementIt ) )
+            if( KGeoBag::KGMeshWire* tMeshWire = dynamic_cast< KGeoBag::KGMeshWire* >( tElement ) )
             {
                 KThreeVector tStart = tMeshWire->GetP1();
                 KThreeVector tEnd = tMeshWire->GetP0();
@@ -141,17 +130,27 @@ namespace Kassiopeia
     void KSGenPositionMeshSurfaceRandom::InitializeComponent()
     {
 
-        for( std::vector< KSGenMeshElementSystem >::iterator tSysIt = fElementsystems.begin();
-                                                              tSysIt != fElementsystems.end();
-                                                              ++tSysIt )
+        //one-time area table, so that dicing an element does not depend on the mesh size
+        fElements.clear();
+        std::vector< double > tAreas;
+        for( unsigned int tSysIndex = 0; tSysIndex < fElementsystems.size(); tSysIndex++ )
         {
-            for( KGeoBag::KGMeshElementCIt tElementIt = tSysIt->second->begin();
-                                          tElementIt != tSysIt->second->end();
+            KGeoBag::KGMeshElementVector* tElements = fElementsystems[ tSysIndex ].second;
+            if( tElements == NULL )
+            {
+                genmsg( eWarning ) << "surface random position generator <" << GetName() << "> ignores a surface without mesh" << eom;
+                continue;
+            }
+            for( KGeoBag::KGMeshElementCIt tElementIt = tElements->begin();
+                                          tElementIt != tElements->end();
                                           ++tElementIt )
             {
-                fTotalArea += (*tElementIt)->Area();
+                fElements.push_back( std::make_pair( tSysIndex, *tElementIt ) );
+                tAreas.push_back( (*tElementIt)->Area() );
             }
         }
+        fAreaTable.Initialize( tAreas );
+        fTotalArea = fAreaTable.GetTotalWeight();
 
         if( fTotalArea <= 0. || fTotalArea != fTotalArea )
             genmsg(eError) << "KSGenPositionRandomSurface fTotalArea is " << fTotalArea << " wrong/corrupt mesh?" << eom;
@@ -24,6 +24,7 @@ namespace Kassiopeia
 
     void KSGenPositionSpaceRandom::AddSpace(KGeoBag::KGSpace* aSpace) {
         fSpaces.push_back(aSpace);
+        random.ResetTables();
     }
 
     bool KSGenPositionSpaceRandom::RemoveSpace(KGeoBag::KGSpace* aSpace) {
@@ -31,6 +32,7 @@ namespace Kassiopeia
                         s != fSpaces.end(); ++s) {
                 if((*s) == aSpace) {
                         fSpaces.erase(s);
+                        random.ResetTables();
                         return true;
                 }
         }
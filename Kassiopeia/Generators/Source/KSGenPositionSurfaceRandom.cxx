@@ -25,6 +25,7 @@ namespace Kassiopeia
     void KSGenPositionSurfaceRandom::AddSurface(KGeoBag::KGSurface* aSurface)
     {
         fSurfaces.push_back(aSurface);
+        random.ResetTables();
     }
 
     bool KSGenPositionSurfaceRandom::RemoveSurface(KGeoBag::KGSurface* aSurface)
@@ -35,6 +36,7 @@ namespace Kassiopeia
             if((*s) == aSurface)
             {
                 fSurfaces.erase(s);
+                random.ResetTables();
                 return true;
             }
         }
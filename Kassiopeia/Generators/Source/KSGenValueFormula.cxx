@@ -1,4 +1,11 @@
 #include "KSGenValueFormula.h"
+#include "KSGeneratorsMessage.h"
+
+#include "KRandom.h"
+using katrin::KRandom;
+
+#include "KException.h"
+using katrin::KException;
 
 namespace Kassiopeia
 {
@@ -7,7 +14,8 @@ namespace Kassiopeia
             fValueMin( 0. ),
             fValueMax( 0. ),
             fValueFormula( "x" ),
-            fValueFunction( NULL )
+            fValueFunction(),
+            fValueDistribution()
     {
     }
     KSGenValueFormula::KSGenValueFormula( const KSGenValueFormula& aCopy ) :
@@ -15,7 +23,8 @@ namespace Kassiopeia
             fValueMin( aCopy.fValueMin ),
             fValueMax( aCopy.fValueMax ),
             fValueFormula( aCopy.fValueFormula ),
-            fValueFunction( NULL )
+            fValueFunction(),
+            fValueDistribution()
     {
     }
     KSGenValueFormula* KSGenValueFormula::Clone() const
@@ -30,7 +39,7 @@ namespace Kassiopeia
     {
         double tValue;
 
-        tValue = fValueFunction->GetRandom( fValueMin, fValueMax );
+        tValue = fValueDistribution.Sample( KRandom::GetInstance().Uniform() );
         aDicedValues.push_back( tValue );
 
         return;
@@ -38,13 +47,21 @@ namespace Kassiopeia
 
     void KSGenValueFormula::InitializeComponent()
     {
-        fValueFunction = new TF1( "function", fValueFormula.c_str(), fValueMin, fValueMax );
+        // the formula is compiled and its inverse CDF tabulated once, dicing is a table lookup
+        try
+        {
+            fValueFunction.Compile( fValueFormula );
+            fValueDistribution.SetFunction( fValueFunction, fValueMin, fValueMax );
+        }
+        catch( KException& tException )
+        {
+            genmsg( eError ) << "formula generator <" << GetName() << "> could not use formula <" << fValueFormula << ">: " << tException.what() << eom;
+        }
         return;
     }
     void KSGenValueFormula::DeinitializeComponent()
     {
-        delete fValueFunction;
-        fValueFunction = NULL;
+        fValueDistribution.Clear();
         return;
     }
 
@@ -2,6 +2,12 @@
 
 #include "KSGeneratorsMessage.h"
 
+#include "KRandom.h"
+using katrin::KRandom;
+
+#include "KException.h"
+using katrin::KException;
+
 namespace Kassiopeia
 {
 
@@ -10,9 +16,8 @@ namespace Kassiopeia
             fPath( "" ),
             fHistogram( "" ),
             fFormula( "" ),
-            fRootFile( NULL ),
-            fValueHistogram( NULL ),
-            fValueFunction( NULL )
+            fValueDistribution(),
+            fValueFunction()
     {
     }
     KSGenValueHistogram::KSGenValueHistogram( const KSGenValueHistogram& aCopy ) :
@@ -21,9 +26,8 @@ namespace Kassiopeia
             fPath( aCopy.fPath ),
             fHistogram( aCopy.fHistogram ),
             fFormula( aCopy.fFormula ),
-            fRootFile( NULL ),
-            fValueHistogram( NULL ),
-            fValueFunction( NULL )
+            fValueDistribution(),
+            fValueFunction()
     {
     }
     KSGenValueHistogram* KSGenValueHistogram::Clone() const
@@ -38,11 +42,11 @@ namespace Kassiopeia
     {
         double tValue;
 
-        tValue = fValueHistogram->GetRandom();
+        tValue = fValueDistribution.Sample( KRandom::GetInstance().Uniform() );
         genmsg_debug( "histogram generator <" << GetName() << "> diced value <" << tValue << "> from histogram <" << fHistogram << ">" << eom);
-        if ( fValueFunction != NULL )
+        if ( fValueFunction.IsCompiled() )
         {
-            tValue = fValueFunction->Eval( tValue );
+            tValue = fValueFunction.Evaluate( tValue );
             genmsg_debug( "histogram generator <" << GetName() << "> modified diced value to <" << tValue << "> via formula <" << fFormula << ">" << eom );
         }
         aDicedValues.push_back( tValue );
@@ -52,48 +56,64 @@ namespace Kassiopeia
 
     void KSGenValueHistogram::InitializeComponent()
     {
-        fRootFile = KRootFile::CreateDataRootFile( fBase );
+        KRootFile* tRootFile = KRootFile::CreateDataRootFile( fBase );
         if( ! fPath.empty() )
         {
-            fRootFile->AddToPaths( fPath );
+            tRootFile->AddToPaths( fPath );
         }
-        if( fRootFile->Open( KFile::eRead ) == false )
+        if( tRootFile->Open( KFile::eRead ) == false )
         {
             genmsg( eError ) << "histogram generator <" << GetName() << "> could not open file <" << fBase << "> at path <" << fPath << ">" << eom;
         }
 
-        fValueHistogram = static_cast< TH1* >( fRootFile->File()->Get( fHistogram.c_str() ) );
-        fValueHistogram->SetDirectory(0);
+        TH1* tValueHistogram = static_cast< TH1* >( tRootFile->File()->Get( fHistogram.c_str() ) );
 
-        if ( fValueHistogram == NULL )
+        if ( tValueHistogram == NULL )
         {
             genmsg( eError ) << "histogram generator <" << GetName() << "> could not find ROOT histogram <" << fHistogram << ">" << eom;
         }
 
+        // the histogram is only needed to fill the inverse CDF table, dicing then works without ROOT
+        int tNBins = tValueHistogram->GetNbinsX();
+        std::vector< double > tEdges( tNBins + 1 );
+        std::vector< double > tContents( tNBins );
+        for( int tBin = 1; tBin <= tNBins; tBin++ )  // 0 is underflow, nbins+1 is overflow
+        {
+            tEdges[ tBin - 1 ] = tValueHistogram->GetXaxis()->GetBinLowEdge( tBin );
+            tContents[ tBin - 1 ] = tValueHistogram->GetBinContent( tBin );
+        }
+        tEdges[ tNBins ] = tValueHistogram->GetXaxis()->GetBinUpEdge( tNBins );
+
+        try
+        {
+            fValueDistribution.SetHistogram( tEdges, tContents );
+        }
+        catch( KException& tException )
+        {
+            genmsg( eError ) << "histogram generator <" << GetName() << "> could not use ROOT histogram <" << fHistogram << ">: " << tException.what() << eom;
+        }
+
         if ( ! fFormula.empty() )
         {
-            double tValueMin = fValueHistogram->GetXaxis()->GetBinCenter( 1 ); // 0 is underflow
-            double tValueMax = fValueHistogram->GetXaxis()->GetBinCenter( fValueHistogram->GetNbinsX() );  // nbins+1 is overflow
-            fValueFunction = new TF1( "function", fFormula.c_str(), tValueMin, tValueMax );
+            try
+            {
+                fValueFunction.Compile( fFormula );
+            }
+            catch( KException& tException )
+            {
+                genmsg( eError ) << "histogram generator <" << GetName() << "> could not compile formula <" << fFormula << ">: " << tException.what() << eom;
+            }
         }
 
-        fRootFile->Close();
+        tRootFile->Close();
+        delete tRootFile;
 
         return;
     }
     void KSGenValueHistogram::DeinitializeComponent()
     {
-        if ( fRootFile != NULL )
-            delete fRootFile;
-        fRootFile = NULL;
-
-        if ( fValueHistogram != NULL )
-            delete fValueHistogram;
-        fValueHistogram = NULL;
-
-        if ( fValueFunction != NULL )
-            delete fValueFunction;
-        fValueFunction = NULL;
+        fValueDistribution.Clear();
+        fValueFunction = katrin::KMathExpression();
 
         return;
     }
@@ -0,0 +1,38 @@
+#ifndef Kassiopeia_KSGeoBoundingBox_h_
+#define Kassiopeia_KSGeoBoundingBox_h_
+
+#include "KGCore.hh"
+#include "KGMesh.hh"
+using namespace KGeoBag;
+
+namespace Kassiopeia
+{
+
+    // accumulates an axis aligned box around the mesh elements of geometry contents.
+    // the box of every element is widened by its longest edge (or wire diameter),
+    // which covers the deviation of curved geometry from its mesh.
+    class KSGeoBoundingBox
+    {
+        public:
+            KSGeoBoundingBox();
+            ~KSGeoBoundingBox();
+
+        public:
+            bool Add( const KGSurface* aSurface );
+            bool Add( const KGSpace* aSpace );
+
+            bool IsEmpty() const;
+            const KThreeVector& GetLower() const;
+            const KThreeVector& GetUpper() const;
+
+        private:
+            bool Add( const KGMeshData* aMesh, const KThreeVector& anOrigin, const KThreeVector& anXAxis, const KThreeVector& aYAxis, const KThreeVector& aZAxis );
+
+            bool fEmpty;
+            KThreeVector fLower;
+            KThreeVector fUpper;
+    };
+
+}
+
+#endif
@@ -29,6 +29,7 @@ namespace Kassiopeia
             bool Outside( const KThreeVector& aPoint ) const;
             KThreeVector Point( const KThreeVector& aPoint ) const;
             KThreeVector Normal( const KThreeVector& aPoint ) const;
+            bool BoundingBox( KThreeVector& aLower, KThreeVector& anUpper ) const;
 
         public:
             void AddContent( KGSpace* aSpace );
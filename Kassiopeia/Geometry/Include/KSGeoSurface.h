@@ -29,6 +29,7 @@ namespace Kassiopeia
 
             KThreeVector Point( const KThreeVector& aPoint ) const;
             KThreeVector Normal( const KThreeVector& aPoint ) const;
+            bool BoundingBox( KThreeVector& aLower, KThreeVector& anUpper ) const;
 
         public:
             void AddContent( KGSurface* aSurface );
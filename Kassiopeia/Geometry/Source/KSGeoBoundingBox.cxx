@@ -0,0 +1,133 @@
+#include "KSGeoBoundingBox.h"
+
+#include "KGMeshWire.hh"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace Kassiopeia
+{
+
+    KSGeoBoundingBox::KSGeoBoundingBox() :
+            fEmpty( true ),
+            fLower( 0., 0., 0. ),
+            fUpper( 0., 0., 0. )
+    {
+    }
+    KSGeoBoundingBox::~KSGeoBoundingBox()
+    {
+    }
+
+    bool KSGeoBoundingBox::Add( const KGSurface* aSurface )
+    {
+        return Add( aSurface->AsExtension< KGMesh >(), aSurface->GetOrigin(), aSurface->GetXAxis(), aSurface->GetYAxis(), aSurface->GetZAxis() );
+    }
+
+    bool KSGeoBoundingBox::Add( const KGSpace* aSpace )
+    {
+        if( Add( aSpace->AsExtension< KGMesh >(), aSpace->GetOrigin(), aSpace->GetXAxis(), aSpace->GetYAxis(), aSpace->GetZAxis() ) == true )
+        {
+            return true;
+        }
+
+        // spaces without a mesh of their own are bounded by the meshes of their boundaries
+        const vector< KGSurface* >* tBoundaries = aSpace->GetBoundaries();
+        if( tBoundaries->empty() == true )
+        {
+            return false;
+        }
+        for( vector< KGSurface* >::const_iterator tBoundaryIt = tBoundaries->begin(); tBoundaryIt != tBoundaries->end(); tBoundaryIt++ )
+        {
+            if( Add( *tBoundaryIt ) == false )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool KSGeoBoundingBox::IsEmpty() const
+    {
+        return fEmpty;
+    }
+    const KThreeVector& KSGeoBoundingBox::GetLower() const
+    {
+        return fLower;
+    }
+    const KThreeVector& KSGeoBoundingBox::GetUpper() const
+    {
+        return fUpper;
+    }
+
+    bool KSGeoBoundingBox::Add( const KGMeshData* aMesh, const KThreeVector& anOrigin, const KThreeVector& anXAxis, const KThreeVector& aYAxis, const KThreeVector& aZAxis )
+    {
+        if( (aMesh == NULL) || (aMesh->HasData() == false) )
+        {
+            return false;
+        }
+
+        KThreeVector tStart;
+        KThreeVector tEnd;
+        KThreeVector tPoint;
+        KThreeVector tElementLower;
+        KThreeVector tElementUpper;
+        double tPadding;
+        const KGMeshWire* tWire;
+
+        for( KGMeshElementCIt tElementIt = aMesh->Elements()->begin(); tElementIt != aMesh->Elements()->end(); tElementIt++ )
+        {
+            tPadding = 0.;
+            tWire = dynamic_cast< const KGMeshWire* >( *tElementIt );
+            if( tWire != NULL )
+            {
+                tPadding = tWire->GetDiameter();
+            }
+
+            for( unsigned int tEdgeIndex = 0; tEdgeIndex < (*tElementIt)->GetNumberOfEdges(); tEdgeIndex++ )
+            {
+                (*tElementIt)->GetEdge( tStart, tEnd, tEdgeIndex );
+                tPadding = max( tPadding, (tEnd - tStart).Magnitude() );
+
+                for( unsigned int tEndIndex = 0; tEndIndex < 2; tEndIndex++ )
+                {
+                    const KThreeVector& tLocal = (tEndIndex == 0) ? tStart : tEnd;
+                    tPoint = anOrigin + tLocal.X() * anXAxis + tLocal.Y() * aYAxis + tLocal.Z() * aZAxis;
+                    if( (tEdgeIndex == 0) && (tEndIndex == 0) )
+                    {
+                        tElementLower = tPoint;
+                        tElementUpper = tPoint;
+                        continue;
+                    }
+                    for( unsigned int tCoordinate = 0; tCoordinate < 3; tCoordinate++ )
+                    {
+                        tElementLower[ tCoordinate ] = min( tElementLower[ tCoordinate ], tPoint[ tCoordinate ] );
+                        tElementUpper[ tCoordinate ] = max( tElementUpper[ tCoordinate ], tPoint[ tCoordinate ] );
+                    }
+                }
+            }
+
+            if( (*tElementIt)->GetNumberOfEdges() == 0 )
+            {
+                continue;
+            }
+
+            for( unsigned int tCoordinate = 0; tCoordinate < 3; tCoordinate++ )
+            {
+                tElementLower[ tCoordinate ] -= tPadding;
+                tElementUpper[ tCoordinate ] += tPadding;
+                if( fEmpty == false )
+                {
+                    tElementLower[ tCoordinate ] = min( tElementLower[ tCoordinate ], fLower[ tCoordinate ] );
+                    tElementUpper[ tCoordinate ] = max( tElementUpper[ tCoordinate ], fUpper[ tCoordinate ] );
+                }
+            }
+            fLower = tElementLower;
+            fUpper = tElementUpper;
+            fEmpty = false;
+        }
+
+        return true;
+    }
+
+}
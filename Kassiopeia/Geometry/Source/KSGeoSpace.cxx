@@ -2,6 +2,7 @@
 #include "KSGeoSurface.h"
 #include "KSGeoSide.h"
 #include "KSGeometryMessage.h"
+#include "KSGeoBoundingBox.h"
 #include <limits>
 
 using namespace std;
@@ -115,6 +116,28 @@ namespace Kassiopeia
         return KThreeVector::sInvalid;
     }
 
+    bool KSGeoSpace::BoundingBox( KThreeVector& aLower, KThreeVector& anUpper ) const
+    {
+        KSGeoBoundingBox tBox;
+        vector< KGSpace* >::const_iterator tContent;
+
+        for( tContent = fContents.begin(); tContent != fContents.end(); tContent++ )
+        {
+            if( tBox.Add( *tContent ) == false )
+            {
+                return false;
+            }
+        }
+        if( tBox.IsEmpty() == true )
+        {
+            return false;
+        }
+
+        aLower = tBox.GetLower();
+        anUpper = tBox.GetUpper();
+        return true;
+    }
+
     void KSGeoSpace::AddContent( KGSpace* aSpace )
     {
         vector< KGSpace* >::iterator tSpace;
@@ -1,6 +1,7 @@
 #include "KSGeoSurface.h"
 #include "KSGeoSpace.h"
 #include "KSGeometryMessage.h"
+#include "KSGeoBoundingBox.h"
 #include <limits>
 
 using namespace std;
@@ -97,6 +98,28 @@ namespace Kassiopeia
         return KThreeVector::sInvalid;
     }
 
+    bool KSGeoSurface::BoundingBox( KThreeVector& aLower, KThreeVector& anUpper ) const
+    {
+        KSGeoBoundingBox tBox;
+        vector< KGSurface* >::const_iterator tContent;
+
+        for( tContent = fContents.begin(); tContent != fContents.end(); tContent++ )
+        {
+            if( tBox.Add( *tContent ) == false )
+            {
+                return false;
+            }
+        }
+        if( tBox.IsEmpty() == true )
+        {
+            return false;
+        }
+
+        aLower = tBox.GetLower();
+        anUpper = tBox.GetUpper();
+        return true;
+    }
+
     void KSGeoSurface::AddContent( KGSurface* aSurface )
     {
         vector< KGSurface* >::iterator tSurface;
@@ -30,6 +30,10 @@ namespace Kassiopeia
             /*******************************************************************/
             virtual void ClearState() {};
 
+            //prepares a repeated step from the initial value of the last step, e.g. after a rejection
+            //integrators that cache derivatives may keep the one at the initial value
+            virtual void RewindState() {ClearState();};
+
             //returns true if information valid
             virtual bool GetInitialDerivative(XDerivativeType& /*derv*/) const {return false;};
 
@@ -50,6 +50,15 @@ namespace Kassiopeia
                 fHaveCachedDerivative = false;
             };
 
+            virtual void RewindState()
+            {
+                //the derivative at the initial value stays valid for a retry from the same value
+                if(fHaveCachedDerivative)
+                {
+                    fDerivatives[KSMATHRK65_STAGE] = fDerivatives[0];
+                }
+            };
+
 
             //returns true if information valid
             virtual bool GetInitialDerivative(DerivativeType& derv) const
@@ -35,6 +35,11 @@ namespace Kassiopeia
                                     const double& aStep,
                                     ValueType& aFinalValue,
                                     ErrorType& anError ) const;
+
+            //stage coefficients of the scheme, shared with lockstep integrators of several particles
+            static const double* GetPositionCoefficients() { return fT; }
+            static const double* GetMomentumCoefficients() { return fV; }
+
         private:
             enum
             {
@@ -0,0 +1,82 @@
+#ifndef Kassiopeia_KSNavBoundingHierarchy_h_
+#define Kassiopeia_KSNavBoundingHierarchy_h_
+
+#include "KThreeVector.hh"
+using KGeoBag::KThreeVector;
+
+#include <vector>
+
+namespace Kassiopeia
+{
+
+    // bounding volume hierarchy over indexed axis aligned boxes.
+    // entries without a known box are kept aside and always reported.
+    class KSNavBoundingHierarchy
+    {
+        public:
+            KSNavBoundingHierarchy();
+            ~KSNavBoundingHierarchy();
+
+        public:
+            void Clear();
+            void AddBounded( const int& anIndex, const KThreeVector& aLower, const KThreeVector& anUpper );
+            void AddUnbounded( const int& anIndex );
+            void Build();
+
+            // fills the indices of all entries whose box intersects the given ball in ascending order,
+            // and returns a lower bound on the distance from the center to all entries that were left out
+            double Collect( const KThreeVector& aCenter, const double& aRadius, std::vector< int >& anIndices ) const;
+
+            unsigned int GetBoundedCount() const;
+            unsigned int GetUnboundedCount() const;
+
+        private:
+            class Entry
+            {
+                public:
+                    int fIndex;
+                    KThreeVector fLower;
+                    KThreeVector fUpper;
+                    KThreeVector fCenter;
+            };
+
+            class EntryCompare
+            {
+                public:
+                    EntryCompare( const unsigned int& aCoordinate ) :
+                            fCoordinate( aCoordinate )
+                    {
+                    }
+                    bool operator()( const Entry& aFirst, const Entry& aSecond ) const
+                    {
+                        return aFirst.fCenter[ fCoordinate ] < aSecond.fCenter[ fCoordinate ];
+                    }
+
+                private:
+                    unsigned int fCoordinate;
+            };
+
+            class Node
+            {
+                public:
+                    KThreeVector fLower;
+                    KThreeVector fUpper;
+                    unsigned int fFirst;
+                    unsigned int fCount;
+                    int fLeft;
+                    int fRight;
+            };
+
+            int BuildNode( const unsigned int& aFirst, const unsigned int& aCount );
+            static double Distance( const KThreeVector& aPoint, const KThreeVector& aLower, const KThreeVector& anUpper );
+
+            std::vector< Entry > fEntries;
+            std::vector< int > fUnbounded;
+            std::vector< Node > fNodes;
+
+            static const unsigned int sLeafSize;
+    };
+
+}
+
+#endif
@@ -18,6 +18,7 @@
 #include "KGNavigableMeshTreeBuilder.hh"
 #include "KGNavigableMeshFirstIntersectionFinder.hh"
 #include "KGNavigableMeshProximityCheck.hh"
+#include "KGNavigableMeshSearchRoot.hh"
 
 
 using namespace KGeoBag;
@@ -83,6 +84,10 @@ namespace Kassiopeia
             void SetNumberOfAllowedElements(unsigned int n){fNAllowedElements = n; fSpecifyAllowedElements = true;};
             unsigned int GetNumberOfAllowedElements() const {return fNAllowedElements;};
 
+            //number of threads used to build the octree, zero selects the number of online processors
+            void SetNumberOfThreads(unsigned int n){fNThreads = n;};
+            unsigned int GetNumberOfThreads() const {return fNThreads;};
+
             void SetAbsoluteTolerance(double abs_tol){fAbsoluteTolerance = abs_tol; fUserSpecifiedAbsoluteTolerance = true;};
             double GetAbsoluteTolerance() const {return fAbsoluteTolerance;};
 
@@ -110,13 +115,21 @@ namespace Kassiopeia
             bool RetrieveTree();
             void SaveTree();
 
+            //hash the mesh element geometry and the octree parameters, these key the tree file
+            void ComputeTreeHashes();
+            std::string GetTreeFile();
+
             std::string fFileName;
             std::string fPath;
-            std::vector< std::string > fLabels;
+            std::string fMeshHash;
+            std::string fParameterHash;
 
             //solve quadratic for intersection time
             double SolveForTime(double distance, double t, double v1, double v2) const;
 
+            //recursively bound groups of trajectory segments, to flag the ones which might hit the mesh
+            void CullSegments(unsigned int first_point, unsigned int last_point);
+
             //navigation parameters
             bool fExitSplit;
             bool fEnterSplit;
@@ -139,6 +152,8 @@ namespace Kassiopeia
             unsigned int fNAllowedElements;
             bool fSpecifyAllowedElements;
 
+            unsigned int fNThreads;
+
             //container to hold all of the mesh elements (with global coordinates)
             KGNavigableMeshElementContainer fElementContainer;
 
@@ -288,6 +303,10 @@ namespace Kassiopeia
 
             //used to determine the time of intersection and exit/entry of spaces
             mutable std::vector<KSParticle> fIntermediateParticleStates;
+            std::vector<bool> fSegmentCandidates;
+
+            //deepest octree node which fully contains the last bounding ball
+            KGNavigableMeshSearchRoot fSearchRoot;
             mutable bool fIsEntry;
 
             //long count of navigation actions
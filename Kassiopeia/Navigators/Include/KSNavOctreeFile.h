@@ -0,0 +1,69 @@
+#ifndef KSNavOctreeFile_HH__
+#define KSNavOctreeFile_HH__
+
+#include <string>
+#include <cstring>
+
+#include "KEMFlatFile.hh"
+
+namespace Kassiopeia
+{
+
+/*
+*
+*@file KSNavOctreeFile.hh
+*@class KSNavOctreeFileHeader
+*@brief flat, memory-mappable binary layout of the mesh navigation octree
+*@details
+* a file consists of a header, followed by one node record per octree node in
+* breadth first order (so the children of a node are contiguous) and a single
+* block holding the mesh element ids of all nodes. records are 8-byte aligned, the
+* header carries the hashes of the mesh and of the parameters the tree was built with
+*
+*/
+
+struct KSNavOctreeFileHeader : public KEMField::KEMFlatFileHeader
+{
+    static const char* Magic() { return "KSOCTRE"; }
+    static unsigned int Version() { return 1; }
+    static std::string Suffix() { return ".kso"; }
+
+    void Initialize()
+    {
+        std::memset(this, 0, sizeof(KSNavOctreeFileHeader));
+        KEMField::KEMFlatFileHeader::Initialize(Magic(), Version());
+    }
+
+    bool IsValid() const
+    {
+        return KEMField::KEMFlatFileHeader::IsValid(Magic(), Version());
+    }
+
+    char fMeshHash[HashLength];
+    char fParameterHash[HashLength];
+    unsigned long long fNodeCount;
+    unsigned long long fNodeOffset;
+    unsigned long long fIdentityCount;
+    unsigned long long fIdentityOffset;
+};
+
+struct KSNavOctreeFileNode
+{
+    enum
+    {
+        eHasCube = 1,
+        eHasIdentitySet = 2
+    };
+
+    double fCenter[3];
+    double fLength;
+    unsigned long long fFirstIdentity;
+    unsigned int fNIdentities;
+    unsigned int fFirstChild;
+    unsigned int fNChildren;
+    unsigned int fFlags;
+};
+
+}
+
+#endif /* KSNavOctreeFile_HH__ */
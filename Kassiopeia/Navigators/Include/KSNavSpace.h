@@ -2,6 +2,9 @@
 #define Kassiopeia_KSNavSpace_h_
 
 #include "KSSpaceNavigator.h"
+#include "KSNavBoundingHierarchy.h"
+
+#include <map>
 
 #include "KMathBracketingSolver.h"
 using namespace katrin;
@@ -28,10 +31,14 @@ namespace Kassiopeia
             void SetFailCheck( const bool& aValue );
             const bool& GetFailCheck() const;
 
+            void SetHermiteSearch( const bool& aValue );
+            const bool& GetHermiteSearch() const;
+
         private:
             bool fEnterSplit;
             bool fExitSplit;
             bool fFailCheck;
+            bool fHermiteSearch;
 
         public:
             void CalculateNavigation( const KSTrajectory& aTrajectory, const KSParticle& aTrajectoryInitialParticle, const KSParticle& aTrajectoryFinalParticle, const KThreeVector& aTrajectoryCenter, const double& aTrajectoryRadius, const double& aTrajectoryStep, KSParticle& aNavigationParticle, double& aNavigationStep, bool& aNavigationFlag );
@@ -70,6 +77,21 @@ namespace Kassiopeia
             double fChildSurfaceDistance;
             bool fChildSurfaceRecalculate;
 
+            // bounding volume hierarchies over the children of every visited space
+            class SpaceHierarchy
+            {
+                public:
+                    KSNavBoundingHierarchy fChildSpaces;
+                    KSNavBoundingHierarchy fParentSides;
+                    KSNavBoundingHierarchy fChildSides;
+                    std::vector< KSSide* > fChildSideList;
+                    KSNavBoundingHierarchy fChildSurfaces;
+                    unsigned int fRevision;
+            };
+            SpaceHierarchy& GetHierarchy( KSSpace* aSpace );
+            std::map< const KSSpace*, SpaceHierarchy > fHierarchies;
+            std::vector< int > fCandidates;
+
             mutable bool fSpaceInsideCheck;
             mutable bool fNavigationFail;
 
@@ -78,6 +100,21 @@ namespace Kassiopeia
             double SideIntersectionFunction( const double& anIntersection );
             KMathBracketingSolver fSolver;
             KSParticle fIntermediateParticle;
+
+            typedef double (KSNavSpace::*IntersectionFunction)( const double& );
+
+            void SolveIntersection( IntersectionFunction aFunction, const double& aLowerTime, const double& anUpperTime, double& aTime );
+            bool RefineIntersection( IntersectionFunction aFunction, const double& aLowerTime, const double& anUpperTime, const double& anUpperValue, const double& anApproximateTime, double& aTime );
+            void PrepareApproximation( const KSParticle& anInitialParticle, const KSParticle& aFinalParticle, const double& aTimeStep );
+            KThreeVector IntermediatePosition( const double& aTime );
+
+            // cubic hermite approximation of the current trajectory step
+            bool fApproximate;
+            double fApproximationStep;
+            KThreeVector fApproximationInitialPoint;
+            KThreeVector fApproximationInitialTangent;
+            KThreeVector fApproximationFinalPoint;
+            KThreeVector fApproximationFinalTangent;
     };
 
 }
@@ -0,0 +1,193 @@
+#include "KSNavBoundingHierarchy.h"
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+using namespace std;
+
+namespace Kassiopeia
+{
+
+    const unsigned int KSNavBoundingHierarchy::sLeafSize = 4;
+
+    KSNavBoundingHierarchy::KSNavBoundingHierarchy() :
+            fEntries(),
+            fUnbounded(),
+            fNodes()
+    {
+    }
+    KSNavBoundingHierarchy::~KSNavBoundingHierarchy()
+    {
+    }
+
+    void KSNavBoundingHierarchy::Clear()
+    {
+        fEntries.clear();
+        fUnbounded.clear();
+        fNodes.clear();
+        return;
+    }
+
+    void KSNavBoundingHierarchy::AddBounded( const int& anIndex, const KThreeVector& aLower, const KThreeVector& anUpper )
+    {
+        Entry tEntry;
+        tEntry.fIndex = anIndex;
+        tEntry.fLower = aLower;
+        tEntry.fUpper = anUpper;
+        tEntry.fCenter = 0.5 * (aLower + anUpper);
+        fEntries.push_back( tEntry );
+        return;
+    }
+    void KSNavBoundingHierarchy::AddUnbounded( const int& anIndex )
+    {
+        fUnbounded.push_back( anIndex );
+        return;
+    }
+
+    void KSNavBoundingHierarchy::Build()
+    {
+        fNodes.clear();
+        if( fEntries.empty() == false )
+        {
+            BuildNode( 0, fEntries.size() );
+        }
+        return;
+    }
+
+    int KSNavBoundingHierarchy::BuildNode( const unsigned int& aFirst, const unsigned int& aCount )
+    {
+        int tNodeIndex = fNodes.size();
+        fNodes.push_back( Node() );
+
+        KThreeVector tLower = fEntries[ aFirst ].fLower;
+        KThreeVector tUpper = fEntries[ aFirst ].fUpper;
+        KThreeVector tCenterLower = fEntries[ aFirst ].fCenter;
+        KThreeVector tCenterUpper = fEntries[ aFirst ].fCenter;
+        for( unsigned int tEntryIndex = aFirst + 1; tEntryIndex < aFirst + aCount; tEntryIndex++ )
+        {
+            const Entry& tEntry = fEntries[ tEntryIndex ];
+            for( unsigned int tCoordinate = 0; tCoordinate < 3; tCoordinate++ )
+            {
+                tLower[ tCoordinate ] = min( tLower[ tCoordinate ], tEntry.fLower[ tCoordinate ] );
+                tUpper[ tCoordinate ] = max( tUpper[ tCoordinate ], tEntry.fUpper[ tCoordinate ] );
+                tCenterLower[ tCoordinate ] = min( tCenterLower[ tCoordinate ], tEntry.fCenter[ tCoordinate ] );
+                tCenterUpper[ tCoordinate ] = max( tCenterUpper[ tCoordinate ], tEntry.fCenter[ tCoordinate ] );
+            }
+        }
+
+        fNodes[ tNodeIndex ].fLower = tLower;
+        fNodes[ tNodeIndex ].fUpper = tUpper;
+        fNodes[ tNodeIndex ].fFirst = aFirst;
+        fNodes[ tNodeIndex ].fCount = aCount;
+        fNodes[ tNodeIndex ].fLeft = -1;
+        fNodes[ tNodeIndex ].fRight = -1;
+
+        if( aCount <= sLeafSize )
+        {
+            return tNodeIndex;
+        }
+
+        // split at the median of the box centers along the longest extent of the centers
+        KThreeVector tExtent = tCenterUpper - tCenterLower;
+        unsigned int tSplitCoordinate = 0;
+        if( tExtent[ 1 ] > tExtent[ tSplitCoordinate ] )
+        {
+            tSplitCoordinate = 1;
+        }
+        if( tExtent[ 2 ] > tExtent[ tSplitCoordinate ] )
+        {
+            tSplitCoordinate = 2;
+        }
+
+        unsigned int tHalf = aCount / 2;
+        nth_element( fEntries.begin() + aFirst, fEntries.begin() + aFirst + tHalf, fEntries.begin() + aFirst + aCount, EntryCompare( tSplitCoordinate ) );
+
+        int tLeft = BuildNode( aFirst, tHalf );
+        int tRight = BuildNode( aFirst + tHalf, aCount - tHalf );
+        fNodes[ tNodeIndex ].fLeft = tLeft;
+        fNodes[ tNodeIndex ].fRight = tRight;
+
+        return tNodeIndex;
+    }
+
+    double KSNavBoundingHierarchy::Collect( const KThreeVector& aCenter, const double& aRadius, vector< int >& anIndices ) const
+    {
+        double tCulledDistance = numeric_limits< double >::max();
+
+        anIndices.clear();
+        anIndices.insert( anIndices.end(), fUnbounded.begin(), fUnbounded.end() );
+
+        if( fNodes.empty() == false )
+        {
+            vector< int > tStack;
+            tStack.push_back( 0 );
+            while( tStack.empty() == false )
+            {
+                const Node& tNode = fNodes[ tStack.back() ];
+                tStack.pop_back();
+
+                double tDistance = Distance( aCenter, tNode.fLower, tNode.fUpper );
+                if( tDistance > aRadius )
+                {
+                    tCulledDistance = min( tCulledDistance, tDistance );
+                    continue;
+                }
+
+                if( tNode.fLeft < 0 )
+                {
+                    for( unsigned int tEntryIndex = tNode.fFirst; tEntryIndex < tNode.fFirst + tNode.fCount; tEntryIndex++ )
+                    {
+                        const Entry& tEntry = fEntries[ tEntryIndex ];
+                        tDistance = Distance( aCenter, tEntry.fLower, tEntry.fUpper );
+                        if( tDistance > aRadius )
+                        {
+                            tCulledDistance = min( tCulledDistance, tDistance );
+                            continue;
+                        }
+                        anIndices.push_back( tEntry.fIndex );
+                    }
+                    continue;
+                }
+
+                tStack.push_back( tNode.fRight );
+                tStack.push_back( tNode.fLeft );
+            }
+        }
+
+        // keep the order of the underlying lists, so that ties are resolved as in a linear scan
+        sort( anIndices.begin(), anIndices.end() );
+
+        return tCulledDistance;
+    }
+
+    unsigned int KSNavBoundingHierarchy::GetBoundedCount() const
+    {
+        return fEntries.size();
+    }
+    unsigned int KSNavBoundingHierarchy::GetUnboundedCount() const
+    {
+        return fUnbounded.size();
+    }
+
+    double KSNavBoundingHierarchy::Distance( const KThreeVector& aPoint, const KThreeVector& aLower, const KThreeVector& anUpper )
+    {
+        double tSquaredDistance = 0.;
+        double tDelta;
+        for( unsigned int tCoordinate = 0; tCoordinate < 3; tCoordinate++ )
+        {
+            tDelta = 0.;
+            if( aPoint[ tCoordinate ] < aLower[ tCoordinate ] )
+            {
+                tDelta = aLower[ tCoordinate ] - aPoint[ tCoordinate ];
+            }
+            else if( aPoint[ tCoordinate ] > anUpper[ tCoordinate ] )
+            {
+                tDelta = aPoint[ tCoordinate ] - anUpper[ tCoordinate ];
+            }
+            tSquaredDistance += tDelta * tDelta;
+        }
+        return sqrt( tSquaredDistance );
+    }
+
+}
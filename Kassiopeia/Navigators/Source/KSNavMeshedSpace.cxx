@@ -2,9 +2,10 @@
 
 #include "KGObjectCollector.hh"
 #include "KGTreeStructureExtractor.hh"
+#include "KGNavigableMeshLeafBlockBuilder.hh"
 
-#include "KSNavOctreeData.h"
-#include "KEMFileInterface.hh"
+#include "KSNavOctreeFile.h"
+#include "KEMMappedFile.hh"
 #include "KMD5HashGenerator.hh"
 
 #include "KFile.h"
@@ -14,6 +15,10 @@
 #include <queue>
 #include <ctime>
 #include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
 
 using std::numeric_limits;
 using namespace KEMField;
@@ -35,7 +40,8 @@ namespace Kassiopeia
         fSpatialResolution(1e-6),
         fSpecifyResolution(false),
         fNAllowedElements(1),
-        fSpecifyAllowedElements(false)
+        fSpecifyAllowedElements(false),
+        fNThreads(0)
     {
     }
 
@@ -53,7 +59,8 @@ namespace Kassiopeia
             fSpatialResolution(aCopy.fSpatialResolution),
             fSpecifyResolution(aCopy.fSpecifyResolution),
             fNAllowedElements(aCopy.fNAllowedElements),
-            fSpecifyAllowedElements(aCopy.fSpecifyAllowedElements)
+            fSpecifyAllowedElements(aCopy.fSpecifyAllowedElements),
+            fNThreads(aCopy.fNThreads)
     {
         //this would be is slow if we copy the navigator a lot
         InitializeComponent();
@@ -199,6 +206,7 @@ namespace Kassiopeia
     void
     KSNavMeshedSpace::ConstructTree()
     {
+        ComputeTreeHashes();
         bool haveTree = RetrieveTree();
 
         if(!haveTree)
@@ -220,6 +228,7 @@ namespace Kassiopeia
                 fTreeBuilder.SetNAllowedElements(fNAllowedElements);
             }
 
+            fTreeBuilder.SetNThreads(fNThreads);
             fTreeBuilder.SetNavigableMeshElementContainer(&fElementContainer);
             fTreeBuilder.SetTree(&fTree);
             fTreeBuilder.ConstructTree();
@@ -235,6 +244,7 @@ namespace Kassiopeia
         }
 
         fWorldCube = KGObjectRetriever<KGMeshNavigationNodeObjects, KGCube<KGMESH_DIM> >::GetNodeObject(fTree.GetRootNode());
+        fSearchRoot.SetTree(&fTree);
 
         //if no user specified tolerance, automatically try to estimate one
         if(!fUserSpecifiedAbsoluteTolerance)
@@ -244,23 +254,30 @@ namespace Kassiopeia
         }
     };
 
-    void KSNavMeshedSpace::SaveTree()
+    void KSNavMeshedSpace::ComputeTreeHashes()
     {
-        KSNavOctreeData data;
-
-        //compute a unique id tag for this tree
-        //based on entity names, tree parameters and number of mesh elements
-
-        std::stringstream se;
-        for(unsigned int i=0; i<fSpaces.size(); i++){se << fSpaces[i]->GetName();}
-        for(unsigned int i=0; i<fSides.size(); i++){se << fSides[i]->GetName();}
-        for(unsigned int i=0; i<fSurfaces.size(); i++){se << fSurfaces[i]->GetName();}
-        se << fElementMap.size();
-        std::string temp = se.str();
+        //hash the geometry of every mesh element, so that a changed mesh never picks up a stale tree
+        MD5 mesh_md5;
+        std::vector<double> element_data;
+        unsigned int n_elements = fElementContainer.GetNElements();
+        for(unsigned int i=0; i<n_elements; i++)
+        {
+            KGNavigableMeshElement* element = fElementContainer.GetElement(i);
+            KGPointCloud<KGMESH_DIM> cloud = element->GetMeshElement()->GetPointCloud();
 
-        //compute a hash for entity data
-        KMD5HashGenerator entity_hasher;
-        std::string entity_hash = entity_hasher.GenerateHashFromString( temp );
+            element_data.clear();
+            element_data.push_back( element->GetMeshElementType() );
+            for(unsigned int j=0; j<cloud.GetNPoints(); j++)
+            {
+                KGPoint<KGMESH_DIM> point = cloud.GetPoint(j);
+                for(unsigned int k=0; k<KGMESH_DIM; k++){ element_data.push_back(point[k]); };
+            }
+            mesh_md5.update( reinterpret_cast<unsigned char*>(&(element_data[0])), element_data.size()*sizeof(double) );
+        }
+        mesh_md5.finalize();
+        char* digest = mesh_md5.hex_digest();
+        fMeshHash = std::string(digest);
+        delete[] digest;
 
         //concatenate the parameters and hash them too
         std::stringstream sp;
@@ -269,221 +286,237 @@ namespace Kassiopeia
         sp << fSpecifyAllowedElements;
 
         if(fSpecifyMaxDepth){ sp << fMaxDepth; };
-        if(fSpecifyResolution){ sp << fSpecifyResolution; };
+        if(fSpecifyResolution){ sp << fSpatialResolution; };
         if(fSpecifyAllowedElements){ sp << fNAllowedElements; };
-        temp = sp.str();
 
         KMD5HashGenerator param_hasher;
-        std::string param_hash = param_hasher.GenerateHashFromString( temp );
-
-        //make and set the unique_id
-        std::stringstream us;
-        us << entity_hash.substr(0,6);
-        us << param_hash.substr(0,6);
-        std::string unique_id = us.str();
-        data.SetTreeID( unique_id );
-
-        //set the tree parameters
-        data.SetMaximumOctreeDepth(fMaxDepth);
-        data.SetSpecifyMaximumOctreeDepth(0);
-        if(fSpecifyMaxDepth){ data.SetSpecifyMaximumOctreeDepth(1);};
-
-        data.SetSpatialResolution(fSpatialResolution);
-        data.SetSpecifySpatialResolution(0);
-        if(fSpecifyResolution){data.SetSpecifySpatialResolution(1);};
-
-        data.SetNumberOfAllowedElements(fNAllowedElements);
-        data.SetSpecifyNumberOfAllowedElements(0);
-        if(fSpecifyAllowedElements){data.SetSpecifyNumberOfAllowedElements(1);};
-
-        //flatten the tree
-        KGTreeStructureExtractor< KGMeshNavigationNodeObjects > flattener;
-        fTree.ApplyRecursiveAction(&flattener);
-
-        //set number of tree nodes
-        data.SetNumberOfTreeNodes( flattener.GetNumberOfNodes() );
-
-        //set the flattend tree data
-        data.SetFlattenedTree( flattener.GetFlattenedTree() );
-
-        //collect the identity sets and the associated node data
-        KGObjectCollector< KGMeshNavigationNodeObjects , KGIdentitySet > id_set_collector;
-        fTree.ApplyCorecursiveAction(&id_set_collector);
-        data.SetIdentitySetNodeIDs( id_set_collector.GetCollectedObjectAssociatedNodeIDs() );
-        data.SetIdentitySets( id_set_collector.GetCollectedObjects() );
-
-        //collect the cubes and associated node data
-        KGObjectCollector< KGMeshNavigationNodeObjects, KGCube<KGMESH_DIM> > cube_collector;
-        fTree.ApplyCorecursiveAction(&cube_collector);
-        data.SetCubeNodeIDs( cube_collector.GetCollectedObjectAssociatedNodeIDs() );
-        data.SetCubes( cube_collector.GetCollectedObjects() );
-
-        //stream the data out to file
-        std::vector< std::string > labels;
-        labels.push_back( entity_hash );
-        labels.push_back( param_hash );
-        labels.push_back( unique_id );
-        labels.push_back( GetName() );
+        fParameterHash = param_hasher.GenerateHashFromString( sp.str() );
+    }
 
-        if(fFileName == "")
+    std::string KSNavMeshedSpace::GetTreeFile()
+    {
+        if ( fPath == "" )
         {
-            time_t t = time(0);
-            struct tm * now = localtime(&t);
-            std::stringstream s;
-            s << "KSOctree_"
-              << (now->tm_year + 1900) << '-'
-              << std::setfill('0') << std::setw(2) << (now->tm_mon + 1) << '-'
-              << std::setfill('0') << std::setw(2) << now->tm_mday << "_"
-              << std::setfill('0') << std::setw(2) << now->tm_hour << "-"
-              << std::setfill('0') << std::setw(2) << now->tm_min << "-"
-              << std::setfill('0') << std::setw(2) << now->tm_sec
-              << ".kbd";
-            fFileName = s.str();
+            fPath = SCRATCH_DEFAULT_DIR;
         }
 
-        //we use the kemfield file interface
-        if ( fPath == "" )
+        //unless the user specified a file, the name is keyed by the mesh and parameter hashes
+        if(fFileName == "")
         {
-            fPath = SCRATCH_DEFAULT_DIR;
+            std::stringstream s;
+            s << "KSOctree_" << fMeshHash.substr(0,16) << "_" << fParameterHash.substr(0,8) << KSNavOctreeFileHeader::Suffix();
+            fFileName = s.str();
         }
-        std::string file = fPath + "/" + fFileName;
 
-        KEMFileInterface::GetInstance()->Write(file, data, "octree", labels );
+        return fPath + "/" + fFileName;
     }
 
-    bool KSNavMeshedSpace::RetrieveTree()
+    void KSNavMeshedSpace::SaveTree()
     {
-        //construct the labels
-        fLabels.clear();
+        //flatten the tree breadth first, so the children of every node are stored contiguously
+        std::vector< KSNavOctreeFileNode > records;
+        std::vector< unsigned int > identities;
+        std::vector< KGMeshNavigationNode* > nodes;
+        nodes.push_back( fTree.GetRootNode() );
 
-        std::stringstream se;
-        for(unsigned int i=0; i<fSpaces.size(); i++){se << fSpaces[i]->GetName();}
-        for(unsigned int i=0; i<fSides.size(); i++){se << fSides[i]->GetName();}
-        for(unsigned int i=0; i<fSurfaces.size(); i++){se << fSurfaces[i]->GetName();}
-        se << fElementMap.size();
-        std::string temp = se.str();
+        for(unsigned int i=0; i<nodes.size(); i++)
+        {
+            KGMeshNavigationNode* node = nodes[i];
 
-        //compute a hash for entity data
-        KMD5HashGenerator entity_hasher;
-        std::string entity_hash = entity_hasher.GenerateHashFromString( temp );
+            KSNavOctreeFileNode record;
+            std::memset(&record, 0, sizeof(KSNavOctreeFileNode));
 
-        //concatenate the parameters and hash them too
-        std::stringstream sp;
-        sp << fSpecifyMaxDepth;
-        sp << fSpecifyResolution;
-        sp << fSpecifyAllowedElements;
+            KGCube<KGMESH_DIM>* cube = KGObjectRetriever<KGMeshNavigationNodeObjects, KGCube<KGMESH_DIM> >::GetNodeObject(node);
+            if(cube != NULL)
+            {
+                record.fFlags |= KSNavOctreeFileNode::eHasCube;
+                cube->GetCenter(record.fCenter);
+                record.fLength = cube->GetLength();
+            }
 
-        if(fSpecifyMaxDepth){ sp << fMaxDepth; };
-        if(fSpecifyResolution){ sp << fSpecifyResolution; };
-        if(fSpecifyAllowedElements){ sp << fNAllowedElements; };
-        temp = sp.str();
+            KGIdentitySet* id_set = KGObjectRetriever<KGMeshNavigationNodeObjects, KGIdentitySet >::GetNodeObject(node);
+            if(id_set != NULL)
+            {
+                record.fFlags |= KSNavOctreeFileNode::eHasIdentitySet;
+                record.fFirstIdentity = identities.size();
+                record.fNIdentities = id_set->GetSize();
+                for(unsigned int j=0; j<id_set->GetSize(); j++)
+                {
+                    identities.push_back( id_set->GetID(j) );
+                }
+            }
 
-        KMD5HashGenerator param_hasher;
-        std::string param_hash = param_hasher.GenerateHashFromString( temp );
+            record.fFirstChild = nodes.size();
+            record.fNChildren = node->GetNChildren();
+            for(unsigned int j=0; j<node->GetNChildren(); j++)
+            {
+                nodes.push_back( node->GetChild(j) );
+            }
 
-        //make and set the unique_id
-        std::stringstream us;
-        us << entity_hash.substr(0,6);
-        us << param_hash.substr(0,6);
-        std::string unique_id = us.str();
+            records.push_back(record);
+        }
 
-        fLabels.push_back(entity_hash);
-        fLabels.push_back(param_hash);
-        fLabels.push_back(unique_id);
-        fLabels.push_back( GetName() );
+        KSNavOctreeFileHeader header;
+        header.Initialize();
+        KSNavOctreeFileHeader::SetHash(header.fMeshHash, fMeshHash);
+        KSNavOctreeFileHeader::SetHash(header.fParameterHash, fParameterHash);
+        header.fNodeCount = records.size();
+        header.fNodeOffset = sizeof(KSNavOctreeFileHeader);
+        header.fIdentityCount = identities.size();
+        header.fIdentityOffset = header.fNodeOffset + records.size()*sizeof(KSNavOctreeFileNode);
+        header.fFileSize = header.fIdentityOffset + identities.size()*sizeof(unsigned int);
+
+        //write under a temporary name and rename into place, so that concurrent jobs never map an incomplete file
+        std::string file_name = GetTreeFile();
+        std::stringstream s;
+        s << file_name << "." << getpid() << ".tmp";
+        std::string temporary_name = s.str();
+
+        std::ofstream file(temporary_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        bool good = file.is_open();
+        if(good)
+        {
+            file.write(reinterpret_cast<const char*>(&header), sizeof(KSNavOctreeFileHeader));
+            file.write(reinterpret_cast<const char*>(&(records[0])), records.size()*sizeof(KSNavOctreeFileNode));
+            if(!identities.empty())
+            {
+                file.write(reinterpret_cast<const char*>(&(identities[0])), identities.size()*sizeof(unsigned int));
+            }
+            good = file.good();
+            file.close();
+        }
 
-        //switch to the scratch directory
-        std::string previousDirectory = KEMFileInterface::GetInstance()->ActiveDirectory();
-        KEMFileInterface::GetInstance()->ActiveDirectory( std::string(SCRATCH_DEFAULT_DIR) );
+        if( !good || std::rename(temporary_name.c_str(), file_name.c_str()) != 0 )
+        {
+            std::remove(temporary_name.c_str());
+            navmsg(eWarning) << "navigation space <" << this->GetName() << "> could not write the octree to <" << file_name << ">" << eom;
+        }
+    }
 
-        //find the file by labels
-        std::set< std::string > file_set = KEMFileInterface::GetInstance()->FileNamesWithLabels(fLabels);
+    bool KSNavMeshedSpace::RetrieveTree()
+    {
+        std::string file_name = GetTreeFile();
 
-        if(file_set.size() != 1)
+        KEMMappedFile file;
+        if( !file.Open(file_name) )
         {
             return false;
         }
-        else
+
+        //validate the layout and the hashes before touching any of the node data
+        const KSNavOctreeFileHeader* header = file.At<KSNavOctreeFileHeader>(0);
+        bool valid = ( header != NULL &&
+                       header->IsValid() &&
+                       header->fFileSize == file.Size() &&
+                       header->fNodeCount > 0 &&
+                       file.At<KSNavOctreeFileNode>(header->fNodeOffset, header->fNodeCount) != NULL &&
+                       file.At<unsigned int>(header->fIdentityOffset, header->fIdentityCount) != NULL &&
+                       KSNavOctreeFileHeader::HashMatches(header->fMeshHash, fMeshHash) &&
+                       KSNavOctreeFileHeader::HashMatches(header->fParameterHash, fParameterHash) );
+
+        if(!valid)
         {
-            //we have tree data, so reconstruct the tree
-            KSNavOctreeData data;
-            fFileName = *(file_set.begin());
-            KEMFileInterface::GetInstance()->ReadLabeled(fFileName, data, fLabels);
-
-            //reset the active directory to its original state
-            KEMFileInterface::GetInstance()->ActiveDirectory( previousDirectory );
-
-            //reconstruct tree from the data;
-            unsigned int n_nodes = data.GetNumberOfTreeNodes();
-
-            //create the tree properties
-            KGSpaceTreeProperties<KGMESH_DIM>* tree_prop = fTree.GetTreeProperties();
-            tree_prop->SetMaxTreeDepth( fMaxDepth );
-            unsigned int dim[KGMESH_DIM];
-            for(unsigned int i=0; i<KGMESH_DIM; i++){ dim[i] = 2;}; //we use an octtree in 3d
-            tree_prop->SetDimensions(dim);
-            tree_prop->SetNeighborOrder(0);
-
-            //now we need to create a vector of N empty nodes, and enumerate them
-            std::vector< KGMeshNavigationNode* > tree_nodes;
-            tree_nodes.resize(n_nodes, NULL);
-            for(unsigned int i=0; i<n_nodes; i++)
-            {
-                tree_nodes[i] = new KGMeshNavigationNode();
-                tree_nodes[i]->SetID(i);
+            navmsg(eNormal) << "navigation space <" << this->GetName() << "> ignores octree file <" << file_name << ">, it does not match the mesh or octree parameters" << eom;
+            return false;
+        }
 
-                //attach the tree properties to these nodes
-                KGObjectRetriever<KGMeshNavigationNodeObjects, KGSpaceTreeProperties<KGMESH_DIM> >::SetNodeObject(tree_prop, tree_nodes[i]);
+        unsigned int n_nodes = header->fNodeCount;
+        unsigned int n_elements = fElementContainer.GetNElements();
+        const KSNavOctreeFileNode* records = file.At<KSNavOctreeFileNode>(header->fNodeOffset, header->fNodeCount);
+        const unsigned int* identities = file.At<unsigned int>(header->fIdentityOffset, header->fIdentityCount);
 
-                //attach the mesh element container
-                KGObjectRetriever<KGMeshNavigationNodeObjects, KGNavigableMeshElementContainer >::SetNodeObject(&fElementContainer, tree_nodes[i]);
+        //check that the children of each node follow in breadth first order and all ids are in range
+        unsigned int next_child = 1;
+        for(unsigned int i=0; i<n_nodes; i++)
+        {
+            const KSNavOctreeFileNode& record = records[i];
+            if( record.fNChildren != 0 && (record.fFirstChild != next_child || record.fNChildren > n_nodes - next_child) )
+            {
+                valid = false;
+                break;
             }
+            next_child += record.fNChildren;
 
-            //now we need to re-link the tree, by connecting child nodes to their parents
-            std::vector<KGNodeData> tree_structure_data;
-            data.GetFlattenedTree(&tree_structure_data);
-
-            for(unsigned int i=0; i<tree_structure_data.size(); i++)
+            if(record.fFlags & KSNavOctreeFileNode::eHasIdentitySet)
             {
-                KGMeshNavigationNode* current_node = tree_nodes[ tree_structure_data[i].GetID() ];
-
-                //link the children of this current node
-                std::vector<unsigned int> child_ids;
-                tree_structure_data[i].GetChildIDs(&child_ids);
-                for(unsigned int j=0; j<child_ids.size(); j++)
+                if(record.fFirstIdentity > header->fIdentityCount || record.fNIdentities > header->fIdentityCount - record.fFirstIdentity)
+                {
+                    valid = false;
+                    break;
+                }
+                for(unsigned int j=0; j<record.fNIdentities; j++)
                 {
-                    current_node->AddChild( tree_nodes[ child_ids[j] ] );
+                    if( identities[record.fFirstIdentity + j] >= n_elements ){ valid = false; };
                 }
             }
+        }
+
+        if( !valid || next_child != n_nodes )
+        {
+            navmsg(eWarning) << "navigation space <" << this->GetName() << "> found a corrupt octree file <" << file_name << ">" << eom;
+            return false;
+        }
+
+        //create the tree properties
+        KGSpaceTreeProperties<KGMESH_DIM>* tree_prop = fTree.GetTreeProperties();
+        tree_prop->SetMaxTreeDepth( fMaxDepth );
+        unsigned int dim[KGMESH_DIM];
+        for(unsigned int i=0; i<KGMESH_DIM; i++){ dim[i] = 2;}; //we use an octtree in 3d
+        tree_prop->SetDimensions(dim);
+        tree_prop->SetNeighborOrder(0);
+
+        //create the nodes and attach their objects
+        std::vector< KGMeshNavigationNode* > tree_nodes;
+        tree_nodes.resize(n_nodes, NULL);
+        std::vector< unsigned int > ids;
+        for(unsigned int i=0; i<n_nodes; i++)
+        {
+            const KSNavOctreeFileNode& record = records[i];
+
+            tree_nodes[i] = new KGMeshNavigationNode();
+            tree_nodes[i]->SetID(i);
 
-            //now we need to re-attach objects to the node which owns them
-            std::vector<int> id_set_node_ids;
-            std::vector< KGIdentitySet* > id_sets;
-            data.GetIdentitySetNodeIDs(&id_set_node_ids);
-            data.GetIdentitySets(&id_sets);
+            //attach the tree properties to these nodes
+            KGObjectRetriever<KGMeshNavigationNodeObjects, KGSpaceTreeProperties<KGMESH_DIM> >::SetNodeObject(tree_prop, tree_nodes[i]);
 
-            for(unsigned int i=0; i<id_set_node_ids.size(); i++)
+            //attach the mesh element container
+            KGObjectRetriever<KGMeshNavigationNodeObjects, KGNavigableMeshElementContainer >::SetNodeObject(&fElementContainer, tree_nodes[i]);
+
+            if(record.fFlags & KSNavOctreeFileNode::eHasCube)
             {
-                KGMeshNavigationNode* node = tree_nodes[ id_set_node_ids[i] ];
-                KGObjectRetriever<KGMeshNavigationNodeObjects, KGIdentitySet>::SetNodeObject(id_sets[i], node);
+                KGCube<KGMESH_DIM>* cube = new KGCube<KGMESH_DIM>(record.fCenter, record.fLength);
+                KGObjectRetriever<KGMeshNavigationNodeObjects, KGCube<KGMESH_DIM> >::SetNodeObject(cube, tree_nodes[i]);
             }
 
-            std::vector<int> cube_node_ids;
-            std::vector< KGCube<KGMESH_DIM>* > cubes;
-            data.GetCubeNodeIDs(&cube_node_ids);
-            data.GetCubes(&cubes);
-
-            for(unsigned int i=0; i<cube_node_ids.size(); i++)
+            if(record.fFlags & KSNavOctreeFileNode::eHasIdentitySet)
             {
-                KGMeshNavigationNode* node = tree_nodes[ cube_node_ids[i] ];
-                KGObjectRetriever<KGMeshNavigationNodeObjects, KGCube<KGMESH_DIM> >::SetNodeObject(cubes[i], node);
+                ids.assign(identities + record.fFirstIdentity, identities + record.fFirstIdentity + record.fNIdentities);
+                KGIdentitySet* id_set = new KGIdentitySet();
+                id_set->SetIDs(&ids);
+                KGObjectRetriever<KGMeshNavigationNodeObjects, KGIdentitySet >::SetNodeObject(id_set, tree_nodes[i]);
             }
+        }
 
-            //now replace the tree's root node with the new one
-            fTree.ReplaceRootNode(tree_nodes[0]);
-            return true;
+        //re-link the tree, by connecting child nodes to their parents
+        for(unsigned int i=0; i<n_nodes; i++)
+        {
+            for(unsigned int j=0; j<records[i].fNChildren; j++)
+            {
+                tree_nodes[i]->AddChild( tree_nodes[ records[i].fFirstChild + j ] );
+            }
         }
-    };
+        tree_nodes[0]->SetIndex(0);
+        tree_nodes[0]->SetParent(NULL);
+
+        //now replace the tree's root node with the new one
+        fTree.ReplaceRootNode(tree_nodes[0]);
+
+        //the packed leaf elements are not stored in the file, rebuild them as the tree builder does
+        KGNavigableMeshLeafBlockBuilder block_builder;
+        block_builder.SetMeshElementContainer(&fElementContainer);
+        fTree.ApplyCorecursiveAction(&block_builder);
+        return true;
+    }
 
     void KSNavMeshedSpace::CalculateNavigation( const KSTrajectory& aTrajectory, const KSParticle& aTrajectoryInitialParticle,
         const KSParticle& aTrajectoryFinalParticle, const KThreeVector& aTrajectoryCenter, const double& aTrajectoryRadius,
@@ -517,8 +550,9 @@ namespace Kassiopeia
 
         //first we check if the bounding ball of the trajectory comes close enough
         //to the mesh that an intersection might occur
+        //the search starts at the deepest octree node which contains the whole bounding ball
         fProximityChecker.SetPointAndRadius(aTrajectoryCenter, aTrajectoryRadius);
-        fProximityChecker.ApplyAction(fTree.GetRootNode()); //TODO: implement some caching on search root node?
+        fProximityChecker.ApplyAction( fSearchRoot.Find(aTrajectoryCenter, aTrajectoryRadius) );
 
         if( fProximityChecker.SphereIntersectsMesh() )
         {
@@ -527,10 +561,14 @@ namespace Kassiopeia
             //now we retrieve the piecewise linear approximation to the trajectory
             aTrajectory.GetPiecewiseLinearApproximation(aTrajectoryInitialParticle, aTrajectoryFinalParticle, &fIntermediateParticleStates);
 
-            //TODO: may want to add a few stages of recursively subdividing and bounding sub-sections
-            //of the intermediate states to possibley reduce the number of false
-            //positive triggers for an intersection search
-            //(since a bounding ball, while simple, is not the best culling volume for a nearly linear trajectory)
+            //recursively subdivide and bound sub-sections of the intermediate states,
+            //since the bounding ball of the whole step is not the best culling volume for a nearly linear trajectory,
+            //segments whose sub-section bounding balls do not touch the mesh are not searched
+            fSegmentCandidates.assign(fIntermediateParticleStates.size(), false);
+            if(fIntermediateParticleStates.size() > 1)
+            {
+                CullSegments(0, fIntermediateParticleStates.size() - 1);
+            }
 
             std::vector< KSParticle >::iterator startIt = fIntermediateParticleStates.begin();
             std::vector< KSParticle >::iterator stopIt = startIt; stopIt++;
@@ -539,14 +577,21 @@ namespace Kassiopeia
             unsigned int seg = 0;
             while( stopIt != fIntermediateParticleStates.end() )
             {
+                if( !fSegmentCandidates[ startIt - fIntermediateParticleStates.begin() ] )
+                {
+                    navmsg_debug( "navigation space <" << this->GetName() << "> skipping segment which is not near mesh elements" << eom );
+                    startIt++;
+                    stopIt++;
+                    repeatCount = 0;
+                    continue;
+                }
+
                 tInitialPoint = startIt->GetPosition();
                 tFinalPoint = stopIt->GetPosition();
                 double length = (tFinalPoint - tInitialPoint).Magnitude();
 
                 fFirstIntersectionFinder.SetLineSegment(tInitialPoint, tFinalPoint);
-
-                //TODO: implement some caching on search root node?
-                fFirstIntersectionFinder.ApplyAction(fTree.GetRootNode());
+                fFirstIntersectionFinder.ApplyAction( fSearchRoot.Find( 0.5*(tInitialPoint + tFinalPoint), 0.5*length ) );
 
                 if( fFirstIntersectionFinder.HasIntersectionWithMesh() )
                 {
@@ -815,6 +860,49 @@ namespace Kassiopeia
         return;
     }
 
+    void
+    KSNavMeshedSpace::CullSegments(unsigned int first_point, unsigned int last_point)
+    {
+        //bounding ball of the points, which also contains the segments between them
+        KThreeVector lower = fIntermediateParticleStates[first_point].GetPosition();
+        KThreeVector upper = lower;
+        for(unsigned int i=first_point+1; i<=last_point; i++)
+        {
+            KThreeVector point = fIntermediateParticleStates[i].GetPosition();
+            for(unsigned int j=0; j<3; j++)
+            {
+                if(point[j] < lower[j]){lower[j] = point[j];};
+                if(point[j] > upper[j]){upper[j] = point[j];};
+            }
+        }
+
+        KThreeVector center = 0.5*(lower + upper);
+        double radius = 0.0;
+        for(unsigned int i=first_point; i<=last_point; i++)
+        {
+            double dist = (fIntermediateParticleStates[i].GetPosition() - center).Magnitude();
+            if(dist > radius){radius = dist;};
+        }
+
+        fProximityChecker.SetPointAndRadius(center, radius);
+        fProximityChecker.ApplyAction( fSearchRoot.Find(center, radius) );
+        if( !fProximityChecker.SphereIntersectsMesh() )
+        {
+            //none of these segments can intersect the mesh
+            return;
+        }
+
+        if(last_point - first_point == 1)
+        {
+            fSegmentCandidates[first_point] = true;
+            return;
+        }
+
+        unsigned int mid_point = (first_point + last_point)/2;
+        CullSegments(first_point, mid_point);
+        CullSegments(mid_point, last_point);
+    }
+
     void KSNavMeshedSpace::ExecuteNavigation( const KSParticle& aNavigationParticle, KSParticle& aFinalParticle, KSParticleQueue& aParticleQueue ) const
     {
         navmsg_debug( "navigation space <" << this->GetName() << "> executing navigation:" << eom );
@@ -2,6 +2,7 @@
 #include "KSNavigatorsMessage.h"
 
 #include <limits>
+#include <cmath>
 
 using namespace std;
 
@@ -12,6 +13,7 @@ namespace Kassiopeia
             fEnterSplit( false ),
             fExitSplit( false ),
             fFailCheck( false ),
+            fHermiteSearch( true ),
             fCurrentTrajectory( NULL ),
             fCurrentSpace( NULL ),
             fParentSpace( NULL ),
@@ -35,10 +37,18 @@ namespace Kassiopeia
             fChildSurfaceAnchor( 0., 0., 0. ),
             fChildSurfaceDistance( 0. ),
             fChildSurfaceRecalculate( true ),
+            fHierarchies(),
+            fCandidates(),
             fSpaceInsideCheck( true ),
             fNavigationFail( false ),
             fSolver(),
-            fIntermediateParticle()
+            fIntermediateParticle(),
+            fApproximate( false ),
+            fApproximationStep( 0. ),
+            fApproximationInitialPoint( 0., 0., 0. ),
+            fApproximationInitialTangent( 0., 0., 0. ),
+            fApproximationFinalPoint( 0., 0., 0. ),
+            fApproximationFinalTangent( 0., 0., 0. )
     {
     }
     KSNavSpace::KSNavSpace( const KSNavSpace& aCopy ) :
@@ -46,6 +56,7 @@ namespace Kassiopeia
             fEnterSplit( aCopy.fEnterSplit ),
             fExitSplit( aCopy.fExitSplit ),
             fFailCheck( aCopy.fFailCheck ),
+            fHermiteSearch( aCopy.fHermiteSearch ),
             fCurrentTrajectory( aCopy.fCurrentTrajectory ),
             fCurrentSpace( aCopy.fCurrentSpace ),
             fParentSpace( aCopy.fParentSpace ),
@@ -69,10 +80,18 @@ namespace Kassiopeia
             fChildSurfaceAnchor( aCopy.fChildSurfaceAnchor ),
             fChildSurfaceDistance( aCopy.fChildSurfaceDistance ),
             fChildSurfaceRecalculate( aCopy.fChildSurfaceRecalculate ),
+            fHierarchies(),
+            fCandidates(),
             fSpaceInsideCheck( aCopy.fSpaceInsideCheck ),
             fNavigationFail( aCopy.fNavigationFail ),
             fSolver(),
-            fIntermediateParticle()
+            fIntermediateParticle(),
+            fApproximate( false ),
+            fApproximationStep( 0. ),
+            fApproximationInitialPoint( 0., 0., 0. ),
+            fApproximationInitialTangent( 0., 0., 0. ),
+            fApproximationFinalPoint( 0., 0., 0. ),
+            fApproximationFinalTangent( 0., 0., 0. )
     {
     }
     KSNavSpace* KSNavSpace::Clone() const
@@ -113,6 +132,16 @@ namespace Kassiopeia
         return fFailCheck;
     }
 
+    void KSNavSpace::SetHermiteSearch( const bool& aValue )
+    {
+        fHermiteSearch = aValue;
+        return;
+    }
+    const bool& KSNavSpace::GetHermiteSearch() const
+    {
+        return fHermiteSearch;
+    }
+
     void KSNavSpace::CalculateNavigation( const KSTrajectory& aTrajectory, const KSParticle& aTrajectoryInitialParticle, const KSParticle& aTrajectoryFinalParticle, const KThreeVector& aTrajectoryCenter, const double& aTrajectoryRadius, const double& aTrajectoryStep, KSParticle& aNavigationParticle, double& aNavigationStep, bool& aNavigationFlag )
     {
         navmsg_debug( "navigation space <" << this->GetName() << "> calculating navigation:" << eom );
@@ -155,7 +184,10 @@ namespace Kassiopeia
             fChildSpaceRecalculate = true;
         }
 
+        SpaceHierarchy& tHierarchy = GetHierarchy( tCurrentSpace );
+
         fCurrentTrajectory = &aTrajectory;
+        PrepareApproximation( aTrajectoryInitialParticle, aTrajectoryFinalParticle, aTrajectoryStep );
 
         //check if particle is inside the space it should be (only if fail check is activated)
         if ( fFailCheck && fSpaceInsideCheck )
@@ -252,7 +284,7 @@ namespace Kassiopeia
                     }
                 	// calculate intersection time
                     fIntermediateParticle.SetCurrentSpace( tSpace );
-                    fSolver.Solve( KMathBracketingSolver::eBrent, this, &KSNavSpace::SpaceIntersectionFunction, 0., tLowerBoundary, aTrajectoryStep, tTime );
+                    SolveIntersection( &KSNavSpace::SpaceIntersectionFunction, tLowerBoundary, aTrajectoryStep, tTime );
                     navmsg_debug( "    time to parent space <" << tSpace->GetName() << "> is <" << tTime << ">" << eom );
                 }
                 else if( tFinalIntersection == 0  )
@@ -298,12 +330,13 @@ namespace Kassiopeia
         if( fChildSpaceRecalculate == true )
         {
             fChildSpaceAnchor = aTrajectoryCenter;
-            fChildSpaceDistance = numeric_limits< double >::max();
             navmsg_debug( "  minimum distance to enter must be recalculated" << eom );
 
-            for( int tSpaceIndex = 0; tSpaceIndex < tCurrentSpace->GetSpaceCount(); tSpaceIndex++ )
+            // child spaces whose bounding boxes are out of reach are not queried, their box distance bounds the cached distance
+            fChildSpaceDistance = tHierarchy.fChildSpaces.Collect( fChildSpaceAnchor, aTrajectoryRadius, fCandidates );
+            for( vector< int >::iterator tCandidateIt = fCandidates.begin(); tCandidateIt != fCandidates.end(); tCandidateIt++ )
             {
-                tSpace = tCurrentSpace->GetSpace( tSpaceIndex );
+                tSpace = tCurrentSpace->GetSpace( *tCandidateIt );
 
                 // calculate the distance between the anchor and the enter space
                 tDistance = (fChildSpaceAnchor - tSpace->Point( fChildSpaceAnchor )).Magnitude();
@@ -346,7 +379,7 @@ namespace Kassiopeia
 
                 	// calculate intersection time
                     fIntermediateParticle.SetCurrentSpace( tSpace );
-                    fSolver.Solve( KMathBracketingSolver::eBrent, this, &KSNavSpace::SpaceIntersectionFunction, 0., tLowerBoundary, aTrajectoryStep, tTime );
+                    SolveIntersection( &KSNavSpace::SpaceIntersectionFunction, tLowerBoundary, aTrajectoryStep, tTime );
                     navmsg_debug( "    time to child space <" << tSpace->GetName() << "> is <" << tTime << ">" << eom );
                 }
                 else
@@ -397,12 +430,12 @@ namespace Kassiopeia
         if( fParentSideRecalculate == true )
         {
             fParentSideAnchor = aTrajectoryCenter;
-            fParentSideDistance = numeric_limits< double >::max();
             navmsg_debug( "  minimum distance to parent sides must be recalculated" << eom );
 
-            for( int tParentSideIndex = 0; tParentSideIndex < tCurrentSpace->GetSideCount(); tParentSideIndex++ )
+            fParentSideDistance = tHierarchy.fParentSides.Collect( fParentSideAnchor, aTrajectoryRadius, fCandidates );
+            for( vector< int >::iterator tCandidateIt = fCandidates.begin(); tCandidateIt != fCandidates.end(); tCandidateIt++ )
             {
-                tSide = tCurrentSpace->GetSide( tParentSideIndex );
+                tSide = tCurrentSpace->GetSide( *tCandidateIt );
 
                 // calculate the distance between the anchor and the parent side
                 tDistance = (fParentSideAnchor - tSide->Point( fParentSideAnchor )).Magnitude();
@@ -450,7 +483,7 @@ namespace Kassiopeia
                     }
                 	// calculate intersection time
                     fIntermediateParticle.SetCurrentSide( tSide );
-                    fSolver.Solve( KMathBracketingSolver::eBrent, this, &KSNavSpace::SideIntersectionFunction, 0., tLowerBoundary, aTrajectoryStep, tTime );
+                    SolveIntersection( &KSNavSpace::SideIntersectionFunction, tLowerBoundary, aTrajectoryStep, tTime );
                     navmsg_debug( "    time to parent side <" << tSide->GetName() << "> is <" << tTime << ">" << eom );
                 }
                 else if( tFinalIntersection == 0  )
@@ -463,7 +496,7 @@ namespace Kassiopeia
 
                 // calculate intersection time
                 fIntermediateParticle.SetCurrentSide( tSide );
-                fSolver.Solve( KMathBracketingSolver::eBrent, this, &KSNavSpace::SideIntersectionFunction, 0., 0., aTrajectoryStep, tTime );
+                SolveIntersection( &KSNavSpace::SideIntersectionFunction, 0., aTrajectoryStep, tTime );
                 navmsg_debug( "    time to parent side <" << tSide->GetName() << "> is <" << tTime << ">" << eom );
 
                 // if the intersection time is not the smallest, skip the parent side
@@ -507,86 +540,82 @@ namespace Kassiopeia
         if( fChildSideRecalculate == true )
         {
             fChildSideAnchor = aTrajectoryCenter;
-            fChildSideDistance = numeric_limits< double >::max();
             navmsg_debug( "  minimum distance to child sides must be recalculated" << eom );
 
-            for( int tSpaceIndex = 0; tSpaceIndex < tCurrentSpace->GetSpaceCount(); tSpaceIndex++ )
+            fChildSideDistance = tHierarchy.fChildSides.Collect( fChildSideAnchor, aTrajectoryRadius, fCandidates );
+            for( vector< int >::iterator tCandidateIt = fCandidates.begin(); tCandidateIt != fCandidates.end(); tCandidateIt++ )
             {
-                tSpace = tCurrentSpace->GetSpace( tSpaceIndex );
-                for( int tInternalSideIndex = 0; tInternalSideIndex < tSpace->GetSideCount(); tInternalSideIndex++ )
-                {
-                    tSide = tSpace->GetSide( tInternalSideIndex );
+                tSide = tHierarchy.fChildSideList[ *tCandidateIt ];
 
-                    // calculate the distance between the anchor and the child side
-                    tDistance = (fChildSideAnchor - tSide->Point( fChildSideAnchor )).Magnitude();
-                    navmsg_debug( "    distance to child side <" << tSide->GetName() << "> is <" << tDistance << ">" << eom );
+                // calculate the distance between the anchor and the child side
+                tDistance = (fChildSideAnchor - tSide->Point( fChildSideAnchor )).Magnitude();
+                navmsg_debug( "    distance to child side <" << tSide->GetName() << "> is <" << tDistance << ">" << eom );
 
-                    // if the current distance is less than the current minimum distance replace the current minimum distance with the current distance
-                    if( tDistance < fChildSideDistance )
-                    {
-                        fChildSideDistance = tDistance;
-                    }
+                // if the current distance is less than the current minimum distance replace the current minimum distance with the current distance
+                if( tDistance < fChildSideDistance )
+                {
+                    fChildSideDistance = tDistance;
+                }
 
-                    // if this distance is greater than the trajectory radius, skip the child side
-                    if( tDistance > aTrajectoryRadius )
-                    {
-                        navmsg_debug( "    skipping child side <" << tSide->GetName() << "> because distance is greater than trajectory radius" << eom );
-                        continue;
-                    }
+                // if this distance is greater than the trajectory radius, skip the child side
+                if( tDistance > aTrajectoryRadius )
+                {
+                    navmsg_debug( "    skipping child side <" << tSide->GetName() << "> because distance is greater than trajectory radius" << eom );
+                    continue;
+                }
 
-                    // calculate initial intersection
-                    tInitialIntersection = ( tInitialPoint - tSide->Point( tInitialPoint )).Dot( tSide->Normal( tInitialPoint ) );
-                    navmsg_debug( "    initial intersection to child side <" << tSide->GetName() << "> is <" << tInitialIntersection << ">" << eom );
+                // calculate initial intersection
+                tInitialIntersection = ( tInitialPoint - tSide->Point( tInitialPoint )).Dot( tSide->Normal( tInitialPoint ) );
+                navmsg_debug( "    initial intersection to child side <" << tSide->GetName() << "> is <" << tInitialIntersection << ">" << eom );
 
-                    // calculate final intersection
-                    tFinalIntersection = ( tFinalPoint - tSide->Point( tFinalPoint )).Dot( tSide->Normal( tFinalPoint ) );
-                    navmsg_debug( "    final intersection to child side <" << tSide->GetName() << "> is <" << tFinalIntersection << ">" << eom );
+                // calculate final intersection
+                tFinalIntersection = ( tFinalPoint - tSide->Point( tFinalPoint )).Dot( tSide->Normal( tFinalPoint ) );
+                navmsg_debug( "    final intersection to child side <" << tSide->GetName() << "> is <" << tFinalIntersection << ">" << eom );
 
 
-                    if( tFinalIntersection <= 0  )
-                    {
-                    	//final state inside, default case for enter
-                    	//including zero intersection function, if final state hits exactly the side of the space to enter (very rare case)
+                if( tFinalIntersection <= 0  )
+                {
+                	//final state inside, default case for enter
+                	//including zero intersection function, if final state hits exactly the side of the space to enter (very rare case)
 
-                    	double tLowerBoundary = 0.0;
-                    	if( tInitialIntersection <= 0  )
-                    	{
-                    		//very rare case where the space was just left and the initial state of the next step is still inside due to numerics
-                    		//increase the lower boundary to make sure not to get two intersections (which would results in gsl error for brent solver)
-                    		tLowerBoundary = aTrajectoryStep / 100.0;
-                    	}
+                	double tLowerBoundary = 0.0;
+                	if( tInitialIntersection <= 0  )
+                	{
+                		//very rare case where the space was just left and the initial state of the next step is still inside due to numerics
+                		//increase the lower boundary to make sure not to get two intersections (which would results in gsl error for brent solver)
+                		tLowerBoundary = aTrajectoryStep / 100.0;
+                	}
 
-                    	// calculate intersection time
-                        fIntermediateParticle.SetCurrentSide( tSide );
-                        fSolver.Solve( KMathBracketingSolver::eBrent, this, &KSNavSpace::SideIntersectionFunction, 0., tLowerBoundary, aTrajectoryStep, tTime );
-                        navmsg_debug( "    time to child side <" << tSide->GetName() << "> is <" << tTime << ">" << eom );
-                    }
-                    else
-                    {
-                    	//final state outside, particle did not enter space/side
-                        navmsg_debug( "    skipping child side <" << tSide->GetName() << "> because final intersection function is positive" << eom );
-                        continue;
-                    }
+                	// calculate intersection time
+                    fIntermediateParticle.SetCurrentSide( tSide );
+                    SolveIntersection( &KSNavSpace::SideIntersectionFunction, tLowerBoundary, aTrajectoryStep, tTime );
+                    navmsg_debug( "    time to child side <" << tSide->GetName() << "> is <" << tTime << ">" << eom );
+                }
+                else
+                {
+                	//final state outside, particle did not enter space/side
+                    navmsg_debug( "    skipping child side <" << tSide->GetName() << "> because final intersection function is positive" << eom );
+                    continue;
+                }
 
-                    // if the intersection time is not the smallest, skip the child side
-                    if( tTime > tSideTime )
-                    {
-                        navmsg_debug( "    skipping child side <" << tSide->GetName() << "> because intersection time is not smallest" << eom );
+                // if the intersection time is not the smallest, skip the child side
+                if( tTime > tSideTime )
+                {
+                    navmsg_debug( "    skipping child side <" << tSide->GetName() << "> because intersection time is not smallest" << eom );
 						continue;
-                    }
+                }
 
 #ifdef Kassiopeia_ENABLE_DEBUG
-                    // calculate intersection distance
-                    aTrajectory.ExecuteTrajectory( tTime, fIntermediateParticle );
-                    tDistance = (fIntermediateParticle.GetPosition() - tSide->Point( fIntermediateParticle.GetPosition() )).Magnitude();
-                    navmsg_debug( "    distance of calculated crossing position to child side <" << tSide->GetName() << "> is <" << tDistance << ">" << eom );
+                // calculate intersection distance
+                aTrajectory.ExecuteTrajectory( tTime, fIntermediateParticle );
+                tDistance = (fIntermediateParticle.GetPosition() - tSide->Point( fIntermediateParticle.GetPosition() )).Magnitude();
+                navmsg_debug( "    distance of calculated crossing position to child side <" << tSide->GetName() << "> is <" << tDistance << ">" << eom );
 #endif
 
-                    tSideFlag = true;
-                    tSideTime = tTime;
-                    fParentSide = NULL;
-                    fChildSide = tSide;
-                }
+                tSideFlag = true;
+                tSideTime = tTime;
+                fParentSide = NULL;
+                fChildSide = tSide;
             }
 
             fChildSideRecalculate = false;
@@ -610,12 +639,12 @@ namespace Kassiopeia
         if( fChildSurfaceRecalculate == true )
         {
             fChildSurfaceAnchor = aTrajectoryCenter;
-            fChildSurfaceDistance = numeric_limits< double >::max();
             navmsg_debug( "  minimum distance to child surfaces must be recalculated" << eom );
 
-            for( int tSurfaceIndex = 0; tSurfaceIndex < tCurrentSpace->GetSurfaceCount(); tSurfaceIndex++ )
+            fChildSurfaceDistance = tHierarchy.fChildSurfaces.Collect( fChildSurfaceAnchor, aTrajectoryRadius, fCandidates );
+            for( vector< int >::iterator tCandidateIt = fCandidates.begin(); tCandidateIt != fCandidates.end(); tCandidateIt++ )
             {
-                tSurface = tCurrentSpace->GetSurface( tSurfaceIndex );
+                tSurface = tCurrentSpace->GetSurface( *tCandidateIt );
 
                 // calculate the distance between the anchor and the child surface
                 tDistance = (fChildSurfaceAnchor - tSurface->Point( fChildSurfaceAnchor )).Magnitude();
@@ -663,7 +692,7 @@ namespace Kassiopeia
                     		//find second crossing point (first one is at the start, increase lower boundary artificially
                     		double tLowerBoundary = aTrajectoryStep / 100.0;
                             fIntermediateParticle.SetCurrentSurface( tSurface );
-                            fSolver.Solve( KMathBracketingSolver::eBrent, this, &KSNavSpace::SurfaceIntersectionFunction, 0., tLowerBoundary, aTrajectoryStep, tTime );
+                            SolveIntersection( &KSNavSpace::SurfaceIntersectionFunction, tLowerBoundary, aTrajectoryStep, tTime );
                             navmsg_debug( "    time to cross child surface <" << tSurface->GetName() << "> again is <" << tTime << ">" << eom );
                     	}
                     	else
@@ -681,7 +710,7 @@ namespace Kassiopeia
                     		//find second crossing point (first one is at the start, increase lower boundary artificially
                     		double tLowerBoundary = aTrajectoryStep / 100.0;
                             fIntermediateParticle.SetCurrentSurface( tSurface );
-                            fSolver.Solve( KMathBracketingSolver::eBrent, this, &KSNavSpace::SurfaceIntersectionFunction, 0., tLowerBoundary, aTrajectoryStep, tTime );
+                            SolveIntersection( &KSNavSpace::SurfaceIntersectionFunction, tLowerBoundary, aTrajectoryStep, tTime );
                             navmsg_debug( "    time to cross child surface <" << tSurface->GetName() << "> again is <" << tTime << ">" << eom );
                     	}
                     	else
@@ -705,7 +734,7 @@ namespace Kassiopeia
 
                     // calculate intersection time
                     fIntermediateParticle.SetCurrentSurface( tSurface );
-                    fSolver.Solve( KMathBracketingSolver::eBrent, this, &KSNavSpace::SurfaceIntersectionFunction, 0., 0., aTrajectoryStep, tTime );
+                    SolveIntersection( &KSNavSpace::SurfaceIntersectionFunction, 0., aTrajectoryStep, tTime );
                     navmsg_debug( "    time to cross child surface <" << tSurface->GetName() << "> is <" << tTime << ">" << eom );
                 }
                 else
@@ -1109,27 +1138,301 @@ namespace Kassiopeia
 
     double KSNavSpace::SpaceIntersectionFunction( const double& aTime )
     {
-        fCurrentTrajectory->ExecuteTrajectory( aTime, fIntermediateParticle );
-        KThreeVector tParticlePoint = fIntermediateParticle.GetPosition();
+        KThreeVector tParticlePoint = IntermediatePosition( aTime );
         KThreeVector tSpacePoint = fIntermediateParticle.GetCurrentSpace()->Point( tParticlePoint );
         KThreeVector tSpaceNormal = fIntermediateParticle.GetCurrentSpace()->Normal( tParticlePoint );
         return (tParticlePoint - tSpacePoint).Dot( tSpaceNormal );
     }
     double KSNavSpace::SurfaceIntersectionFunction( const double& aTime )
     {
-        fCurrentTrajectory->ExecuteTrajectory( aTime, fIntermediateParticle );
-        KThreeVector tParticlePoint = fIntermediateParticle.GetPosition();
+        KThreeVector tParticlePoint = IntermediatePosition( aTime );
         KThreeVector tSurfacePoint = fIntermediateParticle.GetCurrentSurface()->Point( tParticlePoint );
         KThreeVector tSurfaceNormal = fIntermediateParticle.GetCurrentSurface()->Normal( tParticlePoint );
         return (tParticlePoint - tSurfacePoint).Dot( tSurfaceNormal );
     }
     double KSNavSpace::SideIntersectionFunction( const double& aTime )
     {
-        fCurrentTrajectory->ExecuteTrajectory( aTime, fIntermediateParticle );
-        KThreeVector tParticlePoint = fIntermediateParticle.GetPosition();
+        KThreeVector tParticlePoint = IntermediatePosition( aTime );
         KThreeVector tSidePoint = fIntermediateParticle.GetCurrentSide()->Point( tParticlePoint );
         KThreeVector tSideNormal = fIntermediateParticle.GetCurrentSide()->Normal( tParticlePoint );
         return (tParticlePoint - tSidePoint).Dot( tSideNormal );
     }
 
+
+    KSNavSpace::SpaceHierarchy& KSNavSpace::GetHierarchy( KSSpace* aSpace )
+    {
+        map< const KSSpace*, SpaceHierarchy >::iterator tIt = fHierarchies.find( aSpace );
+        if( tIt != fHierarchies.end() )
+        {
+            if( tIt->second.fRevision == aSpace->GetRevision() )
+            {
+                return tIt->second;
+            }
+
+            // children were added or removed by commands, the indices and the cached distances are stale
+            navmsg_debug( "navigation space <" << GetName() << "> rebuilding bounding hierarchy for modified space <" << aSpace->GetName() << ">" << eom );
+            fHierarchies.erase( tIt );
+            fParentSideRecalculate = true;
+            fChildSideRecalculate = true;
+            fChildSurfaceRecalculate = true;
+            fParentSpaceRecalculate = true;
+            fChildSpaceRecalculate = true;
+        }
+
+        SpaceHierarchy& tHierarchy = fHierarchies[ aSpace ];
+        tHierarchy.fRevision = aSpace->GetRevision();
+        KThreeVector tLower;
+        KThreeVector tUpper;
+
+        for( int tSpaceIndex = 0; tSpaceIndex < aSpace->GetSpaceCount(); tSpaceIndex++ )
+        {
+            KSSpace* tSpace = aSpace->GetSpace( tSpaceIndex );
+            if( tSpace->BoundingBox( tLower, tUpper ) == true )
+            {
+                tHierarchy.fChildSpaces.AddBounded( tSpaceIndex, tLower, tUpper );
+            }
+            else
+            {
+                tHierarchy.fChildSpaces.AddUnbounded( tSpaceIndex );
+            }
+
+            for( int tSideIndex = 0; tSideIndex < tSpace->GetSideCount(); tSideIndex++ )
+            {
+                KSSide* tSide = tSpace->GetSide( tSideIndex );
+                int tIndex = tHierarchy.fChildSideList.size();
+                tHierarchy.fChildSideList.push_back( tSide );
+                if( tSide->BoundingBox( tLower, tUpper ) == true )
+                {
+                    tHierarchy.fChildSides.AddBounded( tIndex, tLower, tUpper );
+                }
+                else
+                {
+                    tHierarchy.fChildSides.AddUnbounded( tIndex );
+                }
+            }
+        }
+
+        for( int tSideIndex = 0; tSideIndex < aSpace->GetSideCount(); tSideIndex++ )
+        {
+            if( aSpace->GetSide( tSideIndex )->BoundingBox( tLower, tUpper ) == true )
+            {
+                tHierarchy.fParentSides.AddBounded( tSideIndex, tLower, tUpper );
+            }
+            else
+            {
+                tHierarchy.fParentSides.AddUnbounded( tSideIndex );
+            }
+        }
+
+        for( int tSurfaceIndex = 0; tSurfaceIndex < aSpace->GetSurfaceCount(); tSurfaceIndex++ )
+        {
+            if( aSpace->GetSurface( tSurfaceIndex )->BoundingBox( tLower, tUpper ) == true )
+            {
+                tHierarchy.fChildSurfaces.AddBounded( tSurfaceIndex, tLower, tUpper );
+            }
+            else
+            {
+                tHierarchy.fChildSurfaces.AddUnbounded( tSurfaceIndex );
+            }
+        }
+
+        tHierarchy.fChildSpaces.Build();
+        tHierarchy.fChildSides.Build();
+        tHierarchy.fParentSides.Build();
+        tHierarchy.fChildSurfaces.Build();
+
+        navmsg_debug( "navigation space <" << GetName() << "> built bounding hierarchy for space <" << aSpace->GetName() << "> with <" << tHierarchy.fChildSpaces.GetBoundedCount() << "/" << aSpace->GetSpaceCount() << "> child spaces, <" << tHierarchy.fParentSides.GetBoundedCount() << "/" << aSpace->GetSideCount() << "> parent sides, <" << tHierarchy.fChildSides.GetBoundedCount() << "/" << tHierarchy.fChildSideList.size() << "> child sides and <" << tHierarchy.fChildSurfaces.GetBoundedCount() << "/" << aSpace->GetSurfaceCount() << "> child surfaces bounded" << eom );
+
+        return tHierarchy;
+    }
+
+    KThreeVector KSNavSpace::IntermediatePosition( const double& aTime )
+    {
+        if( fApproximate == true )
+        {
+            double tFraction = aTime / fApproximationStep;
+            double tFraction2 = tFraction * tFraction;
+            double tFraction3 = tFraction2 * tFraction;
+            return (2. * tFraction3 - 3. * tFraction2 + 1.) * fApproximationInitialPoint
+                 + (tFraction3 - 2. * tFraction2 + tFraction) * fApproximationInitialTangent
+                 + (-2. * tFraction3 + 3. * tFraction2) * fApproximationFinalPoint
+                 + (tFraction3 - tFraction2) * fApproximationFinalTangent;
+        }
+
+        fCurrentTrajectory->ExecuteTrajectory( aTime, fIntermediateParticle );
+        return fIntermediateParticle.GetPosition();
+    }
+
+    void KSNavSpace::PrepareApproximation( const KSParticle& anInitialParticle, const KSParticle& aFinalParticle, const double& aTimeStep )
+    {
+        fApproximate = false;
+        fApproximationStep = aTimeStep;
+        fApproximationInitialPoint = anInitialParticle.GetPosition();
+        fApproximationFinalPoint = aFinalParticle.GetPosition();
+
+        if( fHermiteSearch == false || aTimeStep <= 0. )
+        {
+            return;
+        }
+
+        fApproximationInitialTangent = aTimeStep * anInitialParticle.GetVelocity();
+        fApproximationFinalTangent = aTimeStep * aFinalParticle.GetVelocity();
+
+        KThreeVector tChord = fApproximationFinalPoint - fApproximationInitialPoint;
+        double tChordLength = tChord.Magnitude();
+        if( tChordLength > 0. )
+        {
+            // backwards propagation runs against the particle velocity
+            if( fApproximationInitialTangent.Dot( tChord ) < 0. && fApproximationFinalTangent.Dot( tChord ) < 0. )
+            {
+                fApproximationInitialTangent = -1. * fApproximationInitialTangent;
+                fApproximationFinalTangent = -1. * fApproximationFinalTangent;
+            }
+
+            // trajectories that are not parametrized by the particle's time (e.g. magnetic field lines) fall back to a linear approximation
+            double tInitialRatio = fApproximationInitialTangent.Magnitude() / tChordLength;
+            double tFinalRatio = fApproximationFinalTangent.Magnitude() / tChordLength;
+            if( tInitialRatio < 0.1 || tInitialRatio > 10. || tFinalRatio < 0.1 || tFinalRatio > 10. )
+            {
+                fApproximationInitialTangent = tChord;
+                fApproximationFinalTangent = tChord;
+            }
+        }
+        return;
+    }
+
+    void KSNavSpace::SolveIntersection( IntersectionFunction aFunction, const double& aLowerTime, const double& anUpperTime, double& aTime )
+    {
+        if( fHermiteSearch == true && fApproximationStep > 0. )
+        {
+            // bracket the crossing on the approximated step first, which requires no trajectory integrations
+            fApproximate = true;
+            double tLowerValue = (this->*aFunction)( aLowerTime );
+            double tUpperValue = (this->*aFunction)( anUpperTime );
+            if( tLowerValue * tUpperValue < 0. )
+            {
+                double tApproximateTime;
+                fSolver.Solve( KMathBracketingSolver::eBrent, this, aFunction, 0., aLowerTime, anUpperTime, tApproximateTime );
+                fApproximate = false;
+
+                if( RefineIntersection( aFunction, aLowerTime, anUpperTime, tUpperValue, tApproximateTime, aTime ) == true )
+                {
+                    return;
+                }
+                navmsg_debug( "    approximate crossing could not be refined, solving on full trajectory" << eom );
+            }
+            fApproximate = false;
+        }
+
+        fSolver.Solve( KMathBracketingSolver::eBrent, this, aFunction, 0., aLowerTime, anUpperTime, aTime );
+        return;
+    }
+
+    bool KSNavSpace::RefineIntersection( IntersectionFunction aFunction, const double& aLowerTime, const double& anUpperTime, const double& anUpperValue, const double& anApproximateTime, double& aTime )
+    {
+        double tTime = anApproximateTime;
+        double tValue = (this->*aFunction)( tTime );
+        if( tValue == 0. )
+        {
+            aTime = tTime;
+            return true;
+        }
+
+        // estimate the distance to the exact crossing from the slope of the approximation
+        double tDelta = 1.e-6 * (anUpperTime - aLowerTime);
+        fApproximate = true;
+        double tSlope = ((this->*aFunction)( tTime + tDelta ) - (this->*aFunction)( tTime - tDelta )) / (2. * tDelta);
+        fApproximate = false;
+
+        double tWidth = tDelta;
+        if( tSlope != 0. && 2. * fabs( tValue / tSlope ) > tWidth )
+        {
+            tWidth = 2. * fabs( tValue / tSlope );
+        }
+
+        // the value at the upper boundary is exact, so the crossing lies above if the signs differ
+        double tDirection = (tValue * anUpperValue < 0.) ? 1. : -1.;
+
+        // step away from the approximate crossing with growing width until the exact crossing is bracketed
+        double tOtherTime;
+        double tOtherValue;
+        while( true )
+        {
+            tOtherTime = tTime + tDirection * tWidth;
+            if( tOtherTime >= anUpperTime )
+            {
+                tOtherTime = anUpperTime;
+                tOtherValue = anUpperValue;
+            }
+            else if( tOtherTime <= aLowerTime )
+            {
+                tOtherTime = aLowerTime;
+                tOtherValue = (this->*aFunction)( tOtherTime );
+            }
+            else
+            {
+                tOtherValue = (this->*aFunction)( tOtherTime );
+            }
+
+            if( tOtherValue == 0. )
+            {
+                aTime = tOtherTime;
+                return true;
+            }
+            if( tOtherValue * tValue < 0. )
+            {
+                break;
+            }
+            if( tOtherTime == aLowerTime || tOtherTime == anUpperTime )
+            {
+                return false;
+            }
+
+            tTime = tOtherTime;
+            tValue = tOtherValue;
+            tWidth *= 16.;
+        }
+
+        // polish the bracketed crossing with the illinois variant of regula falsi
+        double tFixedTime = tTime;
+        double tFixedValue = tValue;
+        double tMovingTime = tOtherTime;
+        double tMovingValue = tOtherValue;
+        for( unsigned int tIteration = 0; tIteration < 100; tIteration++ )
+        {
+            if( fabs( tMovingTime - tFixedTime ) < 1.e-15 )
+            {
+                break;
+            }
+
+            double tNewTime = (tFixedTime * tMovingValue - tMovingTime * tFixedValue) / (tMovingValue - tFixedValue);
+            if( (tNewTime - tFixedTime) * (tNewTime - tMovingTime) >= 0. )
+            {
+                tNewTime = 0.5 * (tFixedTime + tMovingTime);
+            }
+
+            double tNewValue = (this->*aFunction)( tNewTime );
+            if( tNewValue == 0. )
+            {
+                tMovingTime = tNewTime;
+                break;
+            }
+
+            if( tNewValue * tMovingValue < 0. )
+            {
+                tFixedTime = tMovingTime;
+                tFixedValue = tMovingValue;
+            }
+            else
+            {
+                tFixedValue = 0.5 * tFixedValue;
+            }
+            tMovingTime = tNewTime;
+            tMovingValue = tNewValue;
+        }
+
+        aTime = tMovingTime;
+        return true;
+    }
+
 }
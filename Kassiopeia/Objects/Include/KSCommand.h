@@ -31,6 +31,9 @@ namespace Kassiopeia
             void Activate();
             void Deactivate();
 
+            //changes whenever a command is activated or deactivated, and returns to the same value for the same set of active commands
+            static const unsigned long& GetActiveSignature();
+
         protected:
             StateType fState;
 
@@ -47,6 +50,11 @@ namespace Kassiopeia
         protected:
             KSComponent* fParentComponent;
             KSComponent* fChildComponent;
+
+        private:
+            void ToggleSignature() const;
+
+            static unsigned long sActiveSignature;
     };
 
     template< >
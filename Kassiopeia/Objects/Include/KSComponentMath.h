@@ -3,7 +3,9 @@
 
 #include "KSDictionary.h"
 #include "KSNumerical.h"
-#include "TF1.h"
+
+#include "KMathExpression.h"
+#include "KException.h"
 
 namespace Kassiopeia
 {
@@ -26,34 +28,27 @@ namespace Kassiopeia
                     aParentComponents.at( tIndex )->AddChild( this );
                 }
 
+                //variables are named x0,x1,etc., one for each component
+                std::vector< std::string > tVariables;
                 for( size_t tIndex = 0; tIndex < fParents.size(); tIndex++ )
                 {
-                    //create std::string for variable name x0,x1,etc.
-                    std::string tVariable( "x" );
-                    std::stringstream tIndexConverter;
-                    tIndexConverter << tIndex;
-                    tVariable += tIndexConverter.str();
-
-                    std::stringstream tParameterConverter;
-                    tParameterConverter << "[" << tIndexConverter.str() << "]";
-
-                    //replace x with [index], this denotes a parameter for TF1
-                    while( aTerm.find( tVariable ) != std::string::npos )
-                    {
-                        aTerm.replace( aTerm.find( tVariable ), tVariable.length(), tParameterConverter.str() );
-                    }
+                    std::stringstream tVariableConverter;
+                    tVariableConverter << "x" << tIndex;
+                    tVariables.push_back( tVariableConverter.str() );
                 }
 
                 fTerm = aTerm;
+                fValues.resize( fParents.size(), 0. );
 
-                //check if all x are replaced in formula
-                if( fTerm.find( std::string( "x" ) ) != std::string::npos || fTerm.find( std::string( "X" ) ) != std::string::npos )
+                // compile the term once, only the values are updated every PushUpdate call
+                try
                 {
-                    objctmsg( eError ) << "Error in KSComponentMath: could not replace all variables in term! Use only x0,x1,etc., one for each component" << eom;
+                    fFunction.Compile( fTerm, tVariables );
+                }
+                catch( katrin::KException& tException )
+                {
+                    objctmsg( eError ) << "Error in KSComponentMath: could not compile term <" << fTerm << ">: " << tException.what() << ". Use only x0,x1,etc., one for each component" << eom;
                 }
-
-                // initialize function once, parameters are updated every PushUpdate call
-                fFunction = new TF1( "(anonymous)", fTerm.c_str(), -1., 1. );
             }
             KSComponentMath( const KSComponentMath< XValueType >& aCopy ) :
                     KSComponent( aCopy ),
@@ -61,7 +56,8 @@ namespace Kassiopeia
                     fParents( aCopy.fParents ),
                     fResult( aCopy.fResult ),
                     fTerm( aCopy.fTerm ),
-                    fFunction( aCopy.fFunction )
+                    fFunction( aCopy.fFunction ),
+                    fValues( aCopy.fValues )
             {
                 Set( &fResult );
                 this->SetParent( aCopy.fParentComponent );
@@ -72,7 +68,6 @@ namespace Kassiopeia
             }
             virtual ~KSComponentMath()
             {
-                delete fFunction;
             }
 
             //***********
@@ -111,10 +106,10 @@ namespace Kassiopeia
                 for( size_t tIndex = 0; tIndex < fParents.size(); tIndex++ )
                 {
                     fParentComponents.at( tIndex )->PullUpdate();
-                    fFunction->SetParameter(tIndex, *(fParents.at(tIndex)));
+                    fValues[ tIndex ] = *(fParents.at( tIndex ));
                 }
 
-                fResult = fFunction->Eval( 0 );
+                fResult = fFunction.Evaluate( fValues );
                 return;
             }
 
@@ -143,7 +138,8 @@ namespace Kassiopeia
             std::vector< XValueType* > fParents;
             XValueType fResult;
             std::string fTerm;
-            TF1* fFunction;
+            katrin::KMathExpression fFunction;
+            std::vector< double > fValues;
     };
 
 }
@@ -3,6 +3,8 @@
 namespace Kassiopeia
 {
 
+    unsigned long KSCommand::sActiveSignature = 0;
+
     KSCommand::KSCommand() :
             KSObject(),
             fState( eIdle ),
@@ -33,6 +35,7 @@ namespace Kassiopeia
             objctmsg_debug( "command <" << this->GetName() << "> activating" << eom );
             ActivateCommand();
             fState = eActivated;
+            ToggleSignature();
 
             return;
         }
@@ -51,6 +54,7 @@ namespace Kassiopeia
             objctmsg_debug( "command <" << this->GetName() << "> deactivating" << eom );
             DeactivateCommand();
             fState = eIdle;
+            ToggleSignature();
 
             return;
         }
@@ -63,6 +67,22 @@ namespace Kassiopeia
         return;
     }
 
+    const unsigned long& KSCommand::GetActiveSignature()
+    {
+        return sActiveSignature;
+    }
+    void KSCommand::ToggleSignature() const
+    {
+        //each command contributes a mixed hash of its address, so toggling it twice cancels out
+        unsigned long long tHash = (unsigned long long) (size_t) ( this );
+        tHash += 0x9e3779b97f4a7c15ULL;
+        tHash = (tHash ^ (tHash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        tHash = (tHash ^ (tHash >> 27)) * 0x94d049bb133111ebULL;
+        tHash = tHash ^ (tHash >> 31);
+        sActiveSignature ^= (unsigned long) ( tHash );
+        return;
+    }
+
     void KSCommand::ActivateCommand()
     {
         return;
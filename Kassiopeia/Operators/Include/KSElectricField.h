@@ -9,6 +9,8 @@ using KGeoBag::KThreeVector;
 #include "KThreeMatrix.hh"
 using KGeoBag::KThreeMatrix;
 
+#include <vector>
+
 namespace Kassiopeia
 {
 
@@ -27,6 +29,17 @@ namespace Kassiopeia
             {
                 CalculateField(aSamplePoint,aSampleTime,aField); CalculatePotential(aSamplePoint,aSampleTime,aPotential);
             };
+            virtual void CalculateFieldAndGradient( const KThreeVector& aSamplePoint, const double& aSampleTime, KThreeVector& aField, KThreeMatrix& aGradient )
+            {
+                CalculateField(aSamplePoint,aSampleTime,aField); CalculateGradient(aSamplePoint,aSampleTime,aGradient);
+            };
+
+            //evaluates the field at a batch of sample points, the default calls CalculateField for every point
+            virtual void CalculateFields( const std::vector< KThreeVector >& aSamplePoints, const std::vector< double >& aSampleTimes, std::vector< KThreeVector >& aFields );
+
+            //true if the field may be evaluated from several threads at once. fields that keep solver
+            //scratch state or select their sub-fields per call are not, which is the default
+            virtual bool IsThreadSafe() const { return false; }
     };
 
 }
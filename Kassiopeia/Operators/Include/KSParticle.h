@@ -195,6 +195,18 @@ namespace Kassiopeia
 
             void RecalculateMomentum() const;
 
+            //time, length, position and momentum at once, the dependent quantities are invalidated only once
+
+            void SetPhaseSpace( const double& t, const double& l, const KThreeVector& position, const KThreeVector& momentum );
+
+            //stamp of the trajectory particle whose state was pushed here, every setter clears it again
+            //a trajectory particle that finds its own stamp on a particle can use its state as is, without comparing or copying it
+
+            void SetStateStamp( const unsigned long& aStamp );
+            const unsigned long& GetStateStamp() const;
+
+            static unsigned long NewStateStamp();
+
             //velocity (units are m/s)
 
             const KThreeVector& GetVelocity() const;
@@ -294,6 +306,8 @@ namespace Kassiopeia
             mutable double fKineticEnergy_eV;
             mutable double fPolarAngleToZ;
             mutable double fAzimuthalAngleToX;
+            unsigned long fStateStamp;
+            static unsigned long sStateStampCount;
 
         protected:
             mutable void (KSParticle::*fGetPositionAction)() const;
@@ -345,6 +359,13 @@ namespace Kassiopeia
 
             void RecalculateElectricPotential() const;
 
+            //true if the value is cached for the current time and position and can be taken over without a field calculation
+
+            bool HasMagneticField() const;
+            bool HasElectricField() const;
+            bool HasMagneticGradient() const;
+            bool HasElectricPotential() const;
+
         protected:
             mutable KThreeVector fMagneticField;
             mutable KThreeVector fElectricField;
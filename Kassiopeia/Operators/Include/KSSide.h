@@ -28,6 +28,9 @@ namespace Kassiopeia
             virtual KThreeVector Point( const KThreeVector& aPoint ) const = 0;
             virtual KThreeVector Normal( const KThreeVector& aPoint ) const = 0;
 
+            // axis aligned box enclosing the geometry, returns false if no such box is known
+            virtual bool BoundingBox( KThreeVector& aLower, KThreeVector& anUpper ) const;
+
             const KSSpace* GetOutsideParent() const;
             KSSpace* GetOutsideParent();
             const KSSpace* GetInsideParent() const;
@@ -34,6 +34,9 @@ namespace Kassiopeia
             virtual KThreeVector Point( const KThreeVector& aPoint ) const = 0;
             virtual KThreeVector Normal( const KThreeVector& aPoint ) const = 0;
 
+            // axis aligned box enclosing the geometry, returns false if no such box is known
+            virtual bool BoundingBox( KThreeVector& aLower, KThreeVector& anUpper ) const;
+
             const KSSpace* GetParent() const;
             KSSpace* GetParent();
             void SetParent( KSSpace* aParent );
@@ -56,11 +59,17 @@ namespace Kassiopeia
             const KSSide* GetSide( int anIndex ) const;
             void RemoveSide( KSSide* aSide );
 
+            // changes whenever the children or sides of this space or the sides of its child spaces change
+            const unsigned int& GetRevision() const;
+
         protected:
+            void Touch();
+
             KSSpace* fParent;
             std::vector< KSSpace* > fSpaces;
             std::vector< KSSurface* > fSurfaces;
             std::vector< KSSide* > fSides;
+            unsigned int fRevision;
     };
 
 }
@@ -40,6 +40,18 @@ namespace Kassiopeia
                 std::vector< KSParticle >* intermediateParticleStates
             ) const = 0;
 
+            //lockstep interface, a trajectory that can advance several particles together returns true and overrides
+            //CalculateTrajectories. the default calculates the particles one by one with CalculateTrajectory.
+            virtual bool IsBatchable() const;
+
+            virtual void CalculateTrajectories(
+                const std::vector< KSParticle >& anInitialParticles,
+                std::vector< KSParticle >& aFinalParticles,
+                std::vector< KThreeVector >& aCenters,
+                std::vector< double >& aRadii,
+                std::vector< double >& aTimeSteps
+            );
+
             //we are forced to use a static function because this is accessed
             //as a callback from a c-function  (gsl error handler)
             //this callback is not thread safe. However, that being said,
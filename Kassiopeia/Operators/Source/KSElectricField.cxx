@@ -55,5 +55,14 @@ namespace Kassiopeia
         return;
     }
 
+    void KSElectricField::CalculateFields( const std::vector< KThreeVector >& aSamplePoints, const std::vector< double >& aSampleTimes, std::vector< KThreeVector >& aFields )
+    {
+        aFields.resize( aSamplePoints.size() );
+        for( unsigned int tIndex = 0; tIndex < aSamplePoints.size(); tIndex++ )
+        {
+            CalculateField( aSamplePoints[ tIndex ], aSampleTimes[ tIndex ], aFields[ tIndex ] );
+        }
+        return;
+    }
 
 }
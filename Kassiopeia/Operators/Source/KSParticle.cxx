@@ -13,6 +13,7 @@ namespace Kassiopeia
 {
 
     const string KSParticle::sSeparator = string( ":" );
+    unsigned long KSParticle::sStateStampCount = 0;
 
     //**********
     //assignment
@@ -57,6 +58,7 @@ namespace Kassiopeia
             fKineticEnergy_eV( 0. ),
             fPolarAngleToZ( 0. ),
             fAzimuthalAngleToX( 0. ),
+            fStateStamp( 0 ),
 
             fGetPositionAction( &KSParticle::DoNothing ),
             fGetMomentumAction( &KSParticle::DoNothing ),
@@ -139,6 +141,7 @@ namespace Kassiopeia
             fKineticEnergy_eV( aParticle.fKineticEnergy_eV ),
             fPolarAngleToZ( aParticle.fPolarAngleToZ ),
             fAzimuthalAngleToX( aParticle.fAzimuthalAngleToX ),
+            fStateStamp( aParticle.fStateStamp ),
 
             fGetPositionAction( aParticle.fGetPositionAction ),
             fGetMomentumAction( aParticle.fGetMomentumAction ),
@@ -221,6 +224,7 @@ namespace Kassiopeia
         fKineticEnergy = aParticle.fKineticEnergy;
         fPolarAngleToZ = aParticle.fPolarAngleToZ;
         fAzimuthalAngleToX = aParticle.fAzimuthalAngleToX;
+        fStateStamp = aParticle.fStateStamp;
 
         fGetPositionAction = aParticle.fGetPositionAction;
         fGetMomentumAction = aParticle.fGetMomentumAction;
@@ -490,6 +494,7 @@ namespace Kassiopeia
 
     void KSParticle::SetMagneticFieldCalculator( KSMagneticField* aMagFieldCalculator )
     {
+        fStateStamp = 0;
         fMagneticFieldCalculator = aMagFieldCalculator;
         //RecalculateSpinBody();
         return;
@@ -501,6 +506,7 @@ namespace Kassiopeia
 
     void KSParticle::SetElectricFieldCalculator( KSElectricField* const anElFieldCalculator )
     {
+        fStateStamp = 0;
         fElectricFieldCalculator = anElFieldCalculator;
         return;
     }
@@ -511,6 +517,7 @@ namespace Kassiopeia
 
     void KSParticle::ResetFieldCaching()
     {
+        fStateStamp = 0;
         fGetMagneticFieldAction = &KSParticle::RecalculateMagneticField;
         fGetElectricFieldAction = &KSParticle::RecalculateElectricField;
         fGetMagneticGradientAction = &KSParticle::RecalculateMagneticGradient;
@@ -557,6 +564,7 @@ namespace Kassiopeia
 //***************
     void KSParticle::SetMainQuantumNumber(const int &t)
     {
+        fStateStamp = 0;
         fMainQuantumNumber = t;
     }
     const int& KSParticle::GetMainQuantumNumber() const
@@ -565,6 +573,7 @@ namespace Kassiopeia
     }
     void KSParticle::SetSecondQuantumNumber(const int &t)
     {
+        fStateStamp = 0;
         fSecondQuantumNumber = t;
     }
     const int& KSParticle::GetSecondQuantumNumber() const
@@ -578,6 +587,7 @@ namespace Kassiopeia
 
     void KSParticle::SetTime( const double& t )
     {
+        fStateStamp = 0;
         fTime = t;
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fTime" << ret );
@@ -611,6 +621,7 @@ namespace Kassiopeia
 
     void KSParticle::SetLength( const double& l )
     {
+        fStateStamp = 0;
         fLength = l;
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fLength" << ret );
@@ -650,6 +661,7 @@ namespace Kassiopeia
 
     void KSParticle::SetPosition( const KThreeVector& aPosition )
     {
+        fStateStamp = 0;
         fPosition = aPosition;
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fPosition" << ret );
@@ -673,6 +685,7 @@ namespace Kassiopeia
     }
     void KSParticle::SetPosition( const double& anX, const double& aY, const double& aZ )
     {
+        fStateStamp = 0;
         fPosition.SetComponents( anX, aY, aZ );
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fPosition" << ret );
@@ -696,6 +709,7 @@ namespace Kassiopeia
     }
     void KSParticle::SetX( const double& anX )
     {
+        fStateStamp = 0;
         fPosition[ 0 ] = anX;
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fPosition" << ret );
@@ -719,6 +733,7 @@ namespace Kassiopeia
     }
     void KSParticle::SetY( const double& aY )
     {
+        fStateStamp = 0;
         fPosition[ 1 ] = aY;
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fPosition" << ret );
@@ -742,6 +757,7 @@ namespace Kassiopeia
     }
     void KSParticle::SetZ( const double& aZ )
     {
+        fStateStamp = 0;
         fPosition[ 2 ] = aZ;
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fPosition" << ret );
@@ -800,6 +816,7 @@ namespace Kassiopeia
 
     void KSParticle::SetMomentum( const KThreeVector& aMomentum )
     {
+        fStateStamp = 0;
         fMomentum = aMomentum;
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fMomentum" << ret );
@@ -825,6 +842,7 @@ namespace Kassiopeia
     }
     void KSParticle::SetMomentum( const double& anX, const double& aY, const double& aZ )
     {
+        fStateStamp = 0;
         fMomentum.SetComponents( anX, aY, aZ );
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fMomentum" << ret );
@@ -848,8 +866,43 @@ namespace Kassiopeia
 
         return;
     }
+
+    void KSParticle::SetPhaseSpace( const double& t, const double& l, const KThreeVector& aPosition, const KThreeVector& aMomentum )
+    {
+        fStateStamp = 0;
+        fTime = t;
+        fLength = l;
+        fPosition = aPosition;
+        fMomentum = aMomentum;
+
+        oprmsg_debug( "KSParticle: [" << this << "] setting fTime, fLength, fPosition and fMomentum" << eom );
+
+        fGetVelocityAction = &KSParticle::RecalculateVelocity;
+        fGetLorentzFactorAction = &KSParticle::RecalculateLorentzFactor;
+        fGetSpeedAction = &KSParticle::RecalculateSpeed;
+        fGetKineticEnergyAction = &KSParticle::RecalculateKineticEnergy;
+        fGetPolarAngleToZAction = &KSParticle::RecalculatePolarAngleToZ;
+        fGetAzimuthalAngleToXAction = &KSParticle::RecalculateAzimuthalAngleToX;
+
+        fGetMagneticFieldAction = &KSParticle::RecalculateMagneticField;
+        fGetElectricFieldAction = &KSParticle::RecalculateElectricField;
+        fGetMagneticGradientAction = &KSParticle::RecalculateMagneticGradient;
+        fGetElectricPotentialAction = &KSParticle::RecalculateElectricPotential;
+
+        fGetLongMomentumAction = &KSParticle::RecalculateLongMomentum;
+        fGetTransMomentumAction = &KSParticle::RecalculateTransMomentum;
+        fGetLongVelocityAction = &KSParticle::RecalculateLongVelocity;
+        fGetTransVelocityAction = &KSParticle::RecalculateTransVelocity;
+        fGetPolarAngleToBAction = &KSParticle::RecalculatePolarAngleToB;
+        fGetCyclotronFrequencyAction = &KSParticle::RecalculateCyclotronFrequency;
+        fGetOrbitalMagneticMomentAction = &KSParticle::RecalculateOrbitalMagneticMoment;
+        fGetGuidingCenterPositionAction = &KSParticle::RecalculateGuidingCenterPosition;
+
+        return;
+    }
     void KSParticle::SetPX( const double& anX )
     {
+        fStateStamp = 0;
         fMomentum[ 0 ] = anX;
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fMomentum" << ret );
@@ -875,6 +928,7 @@ namespace Kassiopeia
     }
     void KSParticle::SetPY( const double& aY )
     {
+        fStateStamp = 0;
         fMomentum[ 1 ] = aY;
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fMomentum" << ret );
@@ -900,6 +954,7 @@ namespace Kassiopeia
     }
     void KSParticle::SetPZ( const double& aZ )
     {
+        fStateStamp = 0;
         fMomentum[ 2 ] = aZ;
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fMomentum" << ret );
@@ -942,6 +997,7 @@ namespace Kassiopeia
 
     void KSParticle::SetVelocity( const KThreeVector& NewVelocity )
     {
+        fStateStamp = 0;
         double Speed = NewVelocity.Magnitude();
         double Beta = Speed/KConst::C();
         double LorentzFactor = 1.0 / sqrt( (1.0-Beta)*(1+Beta) );
@@ -1004,6 +1060,7 @@ namespace Kassiopeia
 
     void KSParticle::SetSpin0( const double& aSpin0 )
     {
+        fStateStamp = 0;
         fSpin0 = aSpin0;
 
         oprmsg_debug( "KSParticle: [" << this << "] getting fSpin0" << ret );
@@ -1067,6 +1124,7 @@ namespace Kassiopeia
 
     void KSParticle::SetSpin( const KThreeVector& aSpin )
     {
+        fStateStamp = 0;
         fSpin = aSpin;
 
         NormalizeSpin();
@@ -1094,6 +1152,7 @@ namespace Kassiopeia
     }
     void KSParticle::SetSpin( const double& anX, const double& aY, const double& aZ )
     {
+        fStateStamp = 0;
         fSpin.SetComponents( anX, aY, aZ );
 
         NormalizeSpin();
@@ -1121,6 +1180,7 @@ namespace Kassiopeia
     }
     void KSParticle::SetSpinX( const double& anX )
     {
+        fStateStamp = 0;
         fSpin[ 0 ] = anX;
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fSpin" << ret );
@@ -1146,6 +1206,7 @@ namespace Kassiopeia
     }
     void KSParticle::SetSpinY( const double& aY )
     {
+        fStateStamp = 0;
         fSpin[ 1 ] = aY;
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fSpin" << ret );
@@ -1171,6 +1232,7 @@ namespace Kassiopeia
     }
     void KSParticle::SetSpinZ( const double& aZ )
     {
+        fStateStamp = 0;
         fSpin[ 2 ] = aZ;
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fSpin" << ret );
@@ -1197,6 +1259,7 @@ namespace Kassiopeia
 
     void KSParticle::SetInitialSpin( const KThreeVector& aSpin )
     {
+        fStateStamp = 0;
         fSpin = aSpin;
         fSpin0 = fVelocity.Dot(aSpin) / KConst::C();
 
@@ -1266,6 +1329,7 @@ namespace Kassiopeia
 
     void KSParticle::SetSpeed( const double& NewSpeed )
     {
+        fStateStamp = 0;
         double Beta = NewSpeed / KConst::C();
         double LorentzFactor = 1.0 / sqrt( (1.0-Beta)*(1+Beta) );
         double MomentumMagnitude = GetMass() * KConst::C() * sqrt( (LorentzFactor - 1.0) * (LorentzFactor + 1.0) );
@@ -1324,6 +1388,7 @@ namespace Kassiopeia
 
     void KSParticle::SetLorentzFactor( const double& NewLorentzFactor )
     {
+        fStateStamp = 0;
         double MomentumMagnitude = GetMass() * KConst::C() * sqrt( (NewLorentzFactor - 1.0)*(NewLorentzFactor + 1.0) );
 
         fMomentum.SetMagnitude( MomentumMagnitude );
@@ -1377,6 +1442,7 @@ namespace Kassiopeia
 
     void KSParticle::SetKineticEnergy( const double& NewKineticEnergy )
     {
+        fStateStamp = 0;
         double MomentumMagnitude = (NewKineticEnergy / KConst::C()) * sqrt( 1.0 + (2.0 * GetMass() * KConst::C() * KConst::C()) / NewKineticEnergy );
         fMomentum.SetMagnitude( MomentumMagnitude );
         fKineticEnergy = NewKineticEnergy;
@@ -1424,6 +1490,7 @@ namespace Kassiopeia
 
     void KSParticle::SetKineticEnergy_eV( const double& NewKineticEnergy )
     {
+        fStateStamp = 0;
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fKineticEnergy in eV" << ret );
         oprmsg_debug( "[" << NewKineticEnergy << "]" << eom );
@@ -1455,6 +1522,7 @@ namespace Kassiopeia
 
     void KSParticle::SetPolarAngleToZ( const double& NewPolarAngleToZ )
     {
+        fStateStamp = 0;
         if( (NewPolarAngleToZ < 0.0) || (NewPolarAngleToZ > 180.0) )
         {
             oprmsg( eWarning ) <<"KSParticle: [" << this << "] setting fPolarAngleToZ" << ret;
@@ -1514,6 +1582,7 @@ namespace Kassiopeia
 
     void KSParticle::SetAzimuthalAngleToX( const double& NewAzimuthalAngleToX )
     {
+        fStateStamp = 0;
         fAzimuthalAngleToX = NewAzimuthalAngleToX;
         if( fAzimuthalAngleToX < 0.0 )
         {
@@ -1605,6 +1674,7 @@ namespace Kassiopeia
 
     void KSParticle::SetMagneticField( const KThreeVector& aMagneticField )
     {
+        fStateStamp = 0;
         fMagneticField = aMagneticField;
 
         //RecalculateSpinBody();
@@ -1649,6 +1719,7 @@ namespace Kassiopeia
 
     void KSParticle::SetElectricField( const KThreeVector& aElectricField )
     {
+        fStateStamp = 0;
         fElectricField = aElectricField;
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fElectricField" << ret );
@@ -1678,6 +1749,7 @@ namespace Kassiopeia
 
     void KSParticle::SetMagneticGradient( const KThreeMatrix& aMagneticGradient )
     {
+        fStateStamp = 0;
         fMagneticGradient = aMagneticGradient;
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fMagneticGradient" << eom );
@@ -1707,6 +1779,7 @@ namespace Kassiopeia
 
     void KSParticle::SetElectricPotential( const double& anElectricPotential )
     {
+        fStateStamp = 0;
         fElectricPotential = anElectricPotential;
 
         oprmsg_debug( "KSParticle: [" << this << "] setting fElectricPotential" << ret );
@@ -1724,12 +1797,48 @@ namespace Kassiopeia
         return;
     }
 
+//*************
+//cached fields
+//*************
+
+    void KSParticle::SetStateStamp( const unsigned long& aStamp )
+    {
+        fStateStamp = aStamp;
+        return;
+    }
+    const unsigned long& KSParticle::GetStateStamp() const
+    {
+        return fStateStamp;
+    }
+    unsigned long KSParticle::NewStateStamp()
+    {
+        return ++sStateStampCount;
+    }
+
+    bool KSParticle::HasMagneticField() const
+    {
+        return fGetMagneticFieldAction == &KSParticle::DoNothing;
+    }
+    bool KSParticle::HasElectricField() const
+    {
+        return fGetElectricFieldAction == &KSParticle::DoNothing;
+    }
+    bool KSParticle::HasMagneticGradient() const
+    {
+        return fGetMagneticGradientAction == &KSParticle::DoNothing;
+    }
+    bool KSParticle::HasElectricPotential() const
+    {
+        return fGetElectricPotentialAction == &KSParticle::DoNothing;
+    }
+
 //*********************
 //longitudinal momentum
 //*********************
 
     void KSParticle::SetLongMomentum( const double& aNewLongMomentum )
     {
+        fStateStamp = 0;
         KThreeVector LongMomentumVector = GetMagneticField();
         LongMomentumVector.SetMagnitude( aNewLongMomentum - GetLongMomentum() );
 
@@ -1782,6 +1891,7 @@ namespace Kassiopeia
 
     void KSParticle::SetTransMomentum( const double& NewTransMomentum )
     {
+        fStateStamp = 0;
         KThreeVector LongMomentumVector = GetLongMomentum() * GetMagneticField().Unit();
         KThreeVector TransMomentumVector = fMomentum - LongMomentumVector;
         TransMomentumVector.SetMagnitude( NewTransMomentum );
@@ -1837,6 +1947,7 @@ namespace Kassiopeia
 
     void KSParticle::SetLongVelocity( const double& NewLongVelocity )
     {
+        fStateStamp = 0;
         KThreeVector LongVelocityVector = GetMagneticField();
         LongVelocityVector.SetMagnitude( NewLongVelocity - GetLongVelocity() );
 
@@ -1897,6 +2008,7 @@ namespace Kassiopeia
 
     void KSParticle::SetTransVelocity( const double& NewTransVelocity )
     {
+        fStateStamp = 0;
         KThreeVector TransVelocityVector = GetVelocity() - GetLongVelocity() * GetMagneticField().Unit();
         TransVelocityVector.SetMagnitude( NewTransVelocity - GetTransVelocity() );
 
@@ -1957,6 +2069,7 @@ namespace Kassiopeia
 
     void KSParticle::SetPolarAngleToB( const double& NewPolarAngleToB )
     {
+        fStateStamp = 0;
         if( (NewPolarAngleToB < 0.0) || (NewPolarAngleToB > 180.0) )
         {
             oprmsg( eWarning ) <<"KSParticle: [" << this << "] setting fPolarAngleToB" << ret;
@@ -2015,6 +2128,7 @@ namespace Kassiopeia
 
     void KSParticle::SetCyclotronFrequency( const double& NewCyclotronFrequency )
     {
+        fStateStamp = 0;
         double LorentzFactor = (GetCharge() * GetMagneticField().Magnitude()) / (2.0 * KConst::Pi() * GetMass() * NewCyclotronFrequency);
         double MomentumMagnitude = GetMass() * KConst::C() * sqrt( (LorentzFactor + 1.0)*( LorentzFactor - 1.0) );
 
@@ -2079,6 +2193,7 @@ namespace Kassiopeia
     }
     void KSParticle::SetOrbitalMagneticMoment( const double& NewOrbitalMagneticMoment )
     {
+        fStateStamp = 0;
         double TransMomentumMagnitude = sqrt( 2.0 * GetMass() * GetMagneticField().Magnitude() * NewOrbitalMagneticMoment );
         KThreeVector TransMomentumVector = fMomentum - GetLongMomentum() * GetMagneticField().Unit();
         TransMomentumVector.SetMagnitude( TransMomentumMagnitude - GetTransMomentum() );
@@ -2137,6 +2252,7 @@ namespace Kassiopeia
 
     void KSParticle::SetGuidingCenterPosition( const KThreeVector& NewGuidingCenterPosition )
     {
+        fStateStamp = 0;
         fGuidingCenterPosition = NewGuidingCenterPosition;
         oprmsg( eWarning ) <<"If this function is called, the correct position calculation needs to be implemented!"<<eom;
     }
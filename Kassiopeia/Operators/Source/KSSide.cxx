@@ -13,6 +13,11 @@ namespace Kassiopeia
     {
     }
 
+    bool KSSide::BoundingBox( KThreeVector&, KThreeVector& ) const
+    {
+        return false;
+    }
+
     const KSSpace* KSSide::GetOutsideParent() const
     {
         return fOutsideParent;
@@ -46,6 +51,8 @@ namespace Kassiopeia
 
         this->fOutsideParent = aParent->fParent;
 
+        aParent->Touch();
+
         return;
     }
 
@@ -11,13 +11,19 @@ namespace Kassiopeia
             fParent( NULL ),
             fSpaces(),
             fSurfaces(),
-            fSides()
+            fSides(),
+            fRevision( 0 )
     {
     }
     KSSpace::~KSSpace()
     {
     }
 
+    bool KSSpace::BoundingBox( KThreeVector&, KThreeVector& ) const
+    {
+        return false;
+    }
+
     const KSSpace* KSSpace::GetParent() const
     {
         return fParent;
@@ -41,6 +47,9 @@ namespace Kassiopeia
 
         this->fParent = aParent;
 
+        aParent->Touch();
+        this->Touch();
+
         for( vector< KSSide* >::iterator tSideIt = this->fSides.begin(); tSideIt != this->fSides.end(); tSideIt++ )
         {
             (*tSideIt)->fOutsideParent = aParent;
@@ -76,6 +85,8 @@ namespace Kassiopeia
 
         aChild->fParent = this;
 
+        this->Touch();
+
         //set outsideparent pointer of sides inside child spaces correctly
         for( int tChildSideIndex = 0; tChildSideIndex < aChild->GetSideCount(); tChildSideIndex++ )
         {
@@ -98,6 +109,8 @@ namespace Kassiopeia
 
         aChild->fParent = NULL;
 
+        this->Touch();
+
         return;
     }
 
@@ -128,6 +141,8 @@ namespace Kassiopeia
 
         aChild->fParent = this;
 
+        this->Touch();
+
         return;
     }
     void KSSpace::RemoveSurface( KSSurface* aChild )
@@ -141,6 +156,7 @@ namespace Kassiopeia
             }
         }
         aChild->fParent = NULL;
+        this->Touch();
         return;
     }
 
@@ -173,6 +189,8 @@ namespace Kassiopeia
 
         aChild->fOutsideParent = this->fParent;
 
+        this->Touch();
+
         return;
     }
     void KSSpace::RemoveSide( KSSide* aChild )
@@ -190,6 +208,23 @@ namespace Kassiopeia
 
         aChild->fOutsideParent = NULL;
 
+        this->Touch();
+
+        return;
+    }
+
+    const unsigned int& KSSpace::GetRevision() const
+    {
+        return fRevision;
+    }
+    void KSSpace::Touch()
+    {
+        // the sides of a space are also children of the navigation data of its parent
+        fRevision++;
+        if( fParent != NULL )
+        {
+            fParent->fRevision++;
+        }
         return;
     }
 
@@ -14,6 +14,11 @@ namespace Kassiopeia
     {
     }
 
+    bool KSSurface::BoundingBox( KThreeVector&, KThreeVector& ) const
+    {
+        return false;
+    }
+
     const KSSpace* KSSurface::GetParent() const
     {
         return fParent;
@@ -37,6 +42,8 @@ namespace Kassiopeia
 
         this->fParent = aParent;
 
+        aParent->Touch();
+
         return;
     }
 
@@ -12,4 +12,23 @@ namespace Kassiopeia
     {
     }
 
+    bool KSTrajectory::IsBatchable() const
+    {
+        return false;
+    }
+
+    void KSTrajectory::CalculateTrajectories( const std::vector< KSParticle >& anInitialParticles, std::vector< KSParticle >& aFinalParticles, std::vector< KThreeVector >& aCenters, std::vector< double >& aRadii, std::vector< double >& aTimeSteps )
+    {
+        unsigned int tCount = anInitialParticles.size();
+        aFinalParticles = anInitialParticles;
+        aCenters.resize( tCount );
+        aRadii.resize( tCount );
+        aTimeSteps.resize( tCount );
+        for( unsigned int tIndex = 0; tIndex < tCount; tIndex++ )
+        {
+            CalculateTrajectory( anInitialParticles[ tIndex ], aFinalParticles[ tIndex ], aCenters[ tIndex ], aRadii[ tIndex ], aTimeSteps[ tIndex ] );
+        }
+        return;
+    }
+
 }
@@ -36,6 +36,10 @@ namespace Kassiopeia
 
             template< class XType >
             bool Exists( const std::string& aVariable ) const;
+
+        protected:
+            // called whenever a variable is accessed, so that readers can load data on demand
+            virtual void Activate( const std::string& aVariable ) const;
     };
 
     template< class XType >
@@ -49,6 +53,7 @@ namespace Kassiopeia
     XType& KSReadIterator::Get( const std::string& aVariable ) const
     {
         const KSReadSet< XType >& tSet = dynamic_cast< const KSReadSet< XType >& >( *this );
+        Activate( aVariable );
         return tSet.Get( aVariable );
     }
 
@@ -5,6 +5,10 @@
 
 #include "TFile.h"
 #include "TTree.h"
+#include "TBranch.h"
+
+#include <set>
+#include <vector>
 
 namespace Kassiopeia
 {
@@ -49,6 +53,27 @@ namespace Kassiopeia
             bool operator==( const unsigned int& aValue ) const;
             bool operator!=( const unsigned int& aValue ) const;
 
+        public:
+            // read all values of a component for the indices [aFirstIndex, aLastIndex] in one go,
+            // e.g. for the steps of a track with Read< double >( "time", tTrack.GetFirstStepIndex(), tTrack.GetLastStepIndex(), tTimes )
+            template< class XType >
+            unsigned int Read( const std::string& aLabel, const unsigned int& aFirstIndex, const unsigned int& aLastIndex, std::vector< XType >& aValues );
+
+        protected:
+            void Activate( const std::string& aLabel ) const;
+
+        private:
+            typedef std::map< std::string, std::vector< TBranch* > > BranchMap;
+            typedef BranchMap::iterator BranchIt;
+            typedef BranchMap::const_iterator BranchCIt;
+
+            void Bind( const std::string& aLabel, const std::string& aBranchName, void* anAddress );
+            void Load( const Long64_t& anEntry );
+
+            BranchMap fBranches;
+            mutable std::set< std::string > fActiveLabels;
+            Long64_t fEntry;
+
         private:
             class Presence
             {
@@ -73,6 +98,50 @@ namespace Kassiopeia
             TTree* fData;
     };
 
+    template< class XType >
+    unsigned int KSReadObjectROOT::Read( const std::string& aLabel, const unsigned int& aFirstIndex, const unsigned int& aLastIndex, std::vector< XType >& aValues )
+    {
+        // accessing the value activates its branches and gives the address they are read into
+        const XType& tValue = Get< KSReadValue< XType > >( aLabel ).Value();
+        const std::vector< TBranch* >& tBranches = fBranches.find( aLabel )->second;
+
+        aValues.clear();
+        for( std::vector< Presence >::iterator tIt = fPresences.begin(); tIt != fPresences.end(); tIt++ )
+        {
+            if( tIt->fIndex > aLastIndex )
+            {
+                break;
+            }
+            if( tIt->fIndex + tIt->fLength <= aFirstIndex )
+            {
+                continue;
+            }
+
+            unsigned int tFirst = (tIt->fIndex > aFirstIndex) ? tIt->fIndex : aFirstIndex;
+            unsigned int tLast = (tIt->fIndex + tIt->fLength - 1 < aLastIndex) ? tIt->fIndex + tIt->fLength - 1 : aLastIndex;
+            for( unsigned int tIndex = tFirst; tIndex <= tLast; tIndex++ )
+            {
+                Long64_t tEntry = tIt->fEntry + (tIndex - tIt->fIndex);
+                for( std::vector< TBranch* >::const_iterator tBranchIt = tBranches.begin(); tBranchIt != tBranches.end(); tBranchIt++ )
+                {
+                    (*tBranchIt)->GetEntry( tEntry );
+                }
+                aValues.push_back( tValue );
+            }
+        }
+
+        // restore the value of the current entry
+        if( fValid == true )
+        {
+            for( std::vector< TBranch* >::const_iterator tBranchIt = tBranches.begin(); tBranchIt != tBranches.end(); tBranchIt++ )
+            {
+                (*tBranchIt)->GetEntry( fEntry );
+            }
+        }
+
+        return aValues.size();
+    }
+
 }
 
 #endif
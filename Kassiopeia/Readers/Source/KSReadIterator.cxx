@@ -53,4 +53,9 @@ namespace Kassiopeia
     {
     }
 
+    void KSReadIterator::Activate( const std::string& ) const
+    {
+        return;
+    }
+
 }
@@ -11,8 +11,14 @@ namespace Kassiopeia
             fIndex( 0 ),
             fStructure( aStructureTree ),
             fPresence( aPresenceTree ),
-            fData( aDataTree )
+            fData( aDataTree ),
+            fBranches(),
+            fActiveLabels(),
+            fEntry( -1 )
     {
+        // branches are only read once their values are accessed
+        fData->SetBranchStatus( "*", 0 );
+
         string tLabel;
         string* tLabelPointer = &tLabel;
         string** tLabelHandle = &tLabelPointer;
@@ -31,84 +37,84 @@ namespace Kassiopeia
 
             if( tType == string( "bool" ) )
             {
-                fData->SetBranchAddress( tLabel.c_str(), Add< KSBool >( tLabel ).Pointer() );
+                Bind( tLabel, tLabel, Add< KSBool >( tLabel ).Pointer() );
                 continue;
             }
 
             if( tType == string( "unsigned_char" ) )
             {
-                fData->SetBranchAddress( tLabel.c_str(), Add< KSUChar >( tLabel ).Pointer() );
+                Bind( tLabel, tLabel, Add< KSUChar >( tLabel ).Pointer() );
                 continue;
             }
             if( tType == string( "char" ) )
             {
-                fData->SetBranchAddress( tLabel.c_str(), Add< KSChar >( tLabel ).Pointer() );
+                Bind( tLabel, tLabel, Add< KSChar >( tLabel ).Pointer() );
                 continue;
             }
 
             if( tType == string( "unsigned_short" ) )
             {
-                fData->SetBranchAddress( tLabel.c_str(), Add< KSUShort >( tLabel ).Pointer() );
+                Bind( tLabel, tLabel, Add< KSUShort >( tLabel ).Pointer() );
                 continue;
             }
             if( tType == string( "short" ) )
             {
-                fData->SetBranchAddress( tLabel.c_str(), Add< KSShort >( tLabel ).Pointer() );
+                Bind( tLabel, tLabel, Add< KSShort >( tLabel ).Pointer() );
                 continue;
             }
 
             if( tType == string( "unsigned_int" ) )
             {
-                fData->SetBranchAddress( tLabel.c_str(), Add< KSUInt >( tLabel ).Pointer() );
+                Bind( tLabel, tLabel, Add< KSUInt >( tLabel ).Pointer() );
                 continue;
             }
             if( tType == string( "int" ) )
             {
-                fData->SetBranchAddress( tLabel.c_str(), Add< KSInt >( tLabel ).Pointer() );
+                Bind( tLabel, tLabel, Add< KSInt >( tLabel ).Pointer() );
                 continue;
             }
 
             if( tType == string( "unsigned_long" ) )
             {
-                fData->SetBranchAddress( tLabel.c_str(), Add< KSULong >( tLabel ).Pointer() );
+                Bind( tLabel, tLabel, Add< KSULong >( tLabel ).Pointer() );
                 continue;
             }
             if( tType == string( "long" ) )
             {
-                fData->SetBranchAddress( tLabel.c_str(), Add< KSLong >( tLabel ).Pointer() );
+                Bind( tLabel, tLabel, Add< KSLong >( tLabel ).Pointer() );
                 continue;
             }
 
             if( tType == string( "float" ) )
             {
-                fData->SetBranchAddress( tLabel.c_str(), Add< KSFloat >( tLabel ).Pointer() );
+                Bind( tLabel, tLabel, Add< KSFloat >( tLabel ).Pointer() );
                 continue;
             }
             if( tType == string( "double" ) )
             {
-                fData->SetBranchAddress( tLabel.c_str(), Add< KSDouble >( tLabel ).Pointer() );
+                Bind( tLabel, tLabel, Add< KSDouble >( tLabel ).Pointer() );
                 continue;
             }
 
             if( tType == string( "string" ) )
             {
-                fData->SetBranchAddress( tLabel.c_str(), Add< KSString >( tLabel ).Handle() );
+                Bind( tLabel, tLabel, Add< KSString >( tLabel ).Handle() );
                 continue;
             }
 
             if( tType == string( "two_vector" ) )
             {
                 KSTwoVector& tTwoVector = Add< KSTwoVector >( tLabel );
-                fData->SetBranchAddress( (tLabel + string( "_x" )).c_str(), &(tTwoVector.Value().X()) );
-                fData->SetBranchAddress( (tLabel + string( "_y" )).c_str(), &(tTwoVector.Value().Y()) );
+                Bind( tLabel, tLabel + string( "_x" ), &(tTwoVector.Value().X()) );
+                Bind( tLabel, tLabel + string( "_y" ), &(tTwoVector.Value().Y()) );
                 continue;
             }
             if( tType == string( "three_vector" ) )
             {
                 KSThreeVector& tTwoVector = Add< KSThreeVector >( tLabel );
-                fData->SetBranchAddress( (tLabel + string( "_x" )).c_str(), &(tTwoVector.Value().X()) );
-                fData->SetBranchAddress( (tLabel + string( "_y" )).c_str(), &(tTwoVector.Value().Y()) );
-                fData->SetBranchAddress( (tLabel + string( "_z" )).c_str(), &(tTwoVector.Value().Z()) );
+                Bind( tLabel, tLabel + string( "_x" ), &(tTwoVector.Value().X()) );
+                Bind( tLabel, tLabel + string( "_y" ), &(tTwoVector.Value().Y()) );
+                Bind( tLabel, tLabel + string( "_z" ), &(tTwoVector.Value().Z()) );
                 continue;
             }
 
@@ -190,7 +196,7 @@ namespace Kassiopeia
             if( tIt->fIndex + tIt->fLength > fIndex )
             {
                 fValid = true;
-                fData->GetEntry( tIt->fEntry + (fIndex - tIt->fIndex) );
+                Load( tIt->fEntry + (fIndex - tIt->fIndex) );
                 return;
             }
         }
@@ -210,7 +216,7 @@ namespace Kassiopeia
             if( tIt->fIndex + tIt->fLength > fIndex )
             {
                 fValid = true;
-                fData->GetEntry( tIt->fEntry + (fIndex - tIt->fIndex) );
+                Load( tIt->fEntry + (fIndex - tIt->fIndex) );
                 return;
             }
         }
@@ -230,7 +236,7 @@ namespace Kassiopeia
             if( tIt->fIndex + tIt->fLength > fIndex )
             {
                 fValid = true;
-                fData->GetEntry( tIt->fEntry + (fIndex - tIt->fIndex) );
+                Load( tIt->fEntry + (fIndex - tIt->fIndex) );
                 return;
             }
         }
@@ -238,6 +244,55 @@ namespace Kassiopeia
         return;
     }
 
+    void KSReadObjectROOT::Bind( const string& aLabel, const string& aBranchName, void* anAddress )
+    {
+        TBranch* tBranch = fData->GetBranch( aBranchName.c_str() );
+        if( tBranch == NULL )
+        {
+            readermsg( eError ) << "could not find branch <" << aBranchName << "> for label <" << aLabel << ">" << eom;
+            return;
+        }
+        fData->SetBranchAddress( aBranchName.c_str(), anAddress );
+        fBranches[ aLabel ].push_back( tBranch );
+        return;
+    }
+
+    void KSReadObjectROOT::Load( const Long64_t& anEntry )
+    {
+        fEntry = anEntry;
+        fData->GetEntry( fEntry );
+        return;
+    }
+
+    void KSReadObjectROOT::Activate( const string& aLabel ) const
+    {
+        if( fActiveLabels.find( aLabel ) != fActiveLabels.end() )
+        {
+            return;
+        }
+
+        BranchCIt tIt = fBranches.find( aLabel );
+        if( tIt == fBranches.end() )
+        {
+            return;
+        }
+
+        readermsg_debug( "activating branches for label <" << aLabel << ">" << eom );
+
+        for( vector< TBranch* >::const_iterator tBranchIt = tIt->second.begin(); tBranchIt != tIt->second.end(); tBranchIt++ )
+        {
+            fData->SetBranchStatus( (*tBranchIt)->GetName(), 1 );
+
+            // the current entry was loaded without this branch
+            if( fValid == true )
+            {
+                (*tBranchIt)->GetEntry( fEntry );
+            }
+        }
+        fActiveLabels.insert( aLabel );
+        return;
+    }
+
     bool KSReadObjectROOT::Valid() const
     {
         return fValid;
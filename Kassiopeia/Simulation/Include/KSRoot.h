@@ -57,6 +57,10 @@ namespace Kassiopeia
             void InitializeComponent();
             void DeinitializeComponent();
 
+        private:
+            void RegisterSections();
+            void ReportSections();
+
         private:
             static void SignalHandler(int aSignal);
             static void GSLErrorHandler(const char* aReason, const char* aFile, int aLine, int aErrNo);
@@ -88,6 +92,22 @@ namespace Kassiopeia
 
             bool fOnce;
 
+            //profiler sections of the stages of a run
+            unsigned int fRunSection;
+            unsigned int fGenerationSection;
+            unsigned int fTrackNavigationSection;
+            unsigned int fStepModificationSection;
+            unsigned int fTerminationSection;
+            unsigned int fTrajectoryCalculationSection;
+            unsigned int fTrajectoryExecutionSection;
+            unsigned int fSpaceInteractionCalculationSection;
+            unsigned int fSpaceInteractionExecutionSection;
+            unsigned int fSpaceNavigationCalculationSection;
+            unsigned int fSpaceNavigationExecutionSection;
+            unsigned int fSurfaceInteractionSection;
+            unsigned int fSurfaceNavigationSection;
+            unsigned int fNavigationFinalizationSection;
+            unsigned int fWritingSection;
 
             unsigned int fRunIndex;
             unsigned int fEventIndex;
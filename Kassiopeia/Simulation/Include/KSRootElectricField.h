@@ -22,6 +22,8 @@ namespace Kassiopeia
             virtual void CalculateField( const KThreeVector& aSamplePoint, const double& aSampleTime, KThreeVector& aField );
             virtual void CalculateGradient( const KThreeVector& aSamplePoint, const double& aSampleTime, KThreeMatrix& aGradient );
             virtual void CalculateFieldAndPotential( const KThreeVector& aSamplePoint, const double& aSampleTime, KThreeVector& aField, double& aPotentia );
+            virtual void CalculateFieldAndGradient( const KThreeVector& aSamplePoint, const double& aSampleTime, KThreeVector& aField, KThreeMatrix& aGradient );
+            virtual void CalculateFields( const std::vector< KThreeVector >& aSamplePoints, const std::vector< double >& aSampleTimes, std::vector< KThreeVector >& aFields );
 
         public:
             void AddElectricField( KSElectricField* anElectricField );
@@ -31,6 +33,7 @@ namespace Kassiopeia
             double fCurrentPotential;
             KThreeVector fCurrentField;
             KThreeMatrix fCurrentGradient;
+            std::vector< KThreeVector > fCurrentFields;
 
             KSList< KSElectricField > fElectricFields;
     };
@@ -21,6 +21,7 @@ namespace Kassiopeia
             void CalculateField( const KThreeVector& aSamplePoint, const double& aSampleTime, KThreeVector& aField );
             void CalculateGradient( const KThreeVector& aSamplePoint, const double& aSampleTime, KThreeMatrix& aGradient );
             void CalculateFieldAndGradient( const KThreeVector& aSamplePoint, const double& aSampleTime, KThreeVector& aField, KThreeMatrix& aGradient );
+            void CalculateFields( const std::vector< KThreeVector >& aSamplePoints, const std::vector< double >& aSampleTimes, std::vector< KThreeVector >& aFields );
 
         public:
             void AddMagneticField( KSMagneticField* aMagneticField );
@@ -29,6 +30,7 @@ namespace Kassiopeia
         private:
             KThreeVector fCurrentField;
             KThreeMatrix fCurrentGradient;
+            std::vector< KThreeVector > fCurrentFields;
 
             KSList< KSMagneticField > fMagneticFields;
     };
@@ -3,11 +3,15 @@
 
 #include "KSTrajectory.h"
 #include "KSStep.h"
+#include "KSEvent.h"
+
+#include <deque>
 
 namespace Kassiopeia
 {
 
     class KSStep;
+    class KSEvent;
 
     class KSRootTrajectory :
         public KSComponentTemplate< KSRootTrajectory, KSTrajectory >
@@ -28,6 +32,7 @@ namespace Kassiopeia
             {
                 if(fTrajectory != NULL){ fTrajectory->Reset(); }
                 fFailureFlag = false;
+                fLookaheadServed = false;
             };
             void CalculateTrajectory( const KSParticle& anInitialParticle, KSParticle& aFinalParticle, KThreeVector& aCenter, double& aRadius, double& aTimeStep );
 
@@ -62,6 +67,66 @@ namespace Kassiopeia
             KSParticle* fTrajectoryParticle;
             KSParticle* fFinalParticle;
             bool fFailureFlag;
+
+            //*********
+            //lookahead
+            //*********
+
+        public:
+            //with more than one lane and a batchable trajectory, the steps of the current particle and of the particles
+            //waiting in the event queue are calculated ahead in lockstep, up to the given number of steps per lane.
+            //a step is taken from the lookahead only if the particle arrives in exactly the state the lane predicted,
+            //so a particle changed by a terminator, interaction, navigation or modifier drops out to the scalar path.
+            void SetEvent( KSEvent* anEvent );
+            void SetLookahead( const unsigned int& aLaneCount, const unsigned int& aStepCount );
+
+            //drops every precalculated step, to be called whenever the trajectory configuration may have changed
+            void ClearLookahead();
+
+            //number of steps that were taken from the lookahead
+            const unsigned long& GetLookaheadCount() const;
+
+        private:
+            bool ServeLookahead();
+            int FindLane( const KSParticle& aParticle ) const;
+            void DropLane( const int& aLane );
+            void FillLookahead();
+            void RecalculateServedStep() const;
+
+            class LookaheadStep
+            {
+                public:
+                    KSParticle fInitialParticle;
+                    KSParticle fFinalParticle;
+                    KThreeVector fCenter;
+                    double fRadius;
+                    double fTimeStep;
+            };
+
+            class LookaheadLane
+            {
+                public:
+                    const KSParticle* fQueuedParticle;
+                    KSParticle fSeedParticle;
+                    bool fEnded;
+                    std::deque< LookaheadStep > fSteps;
+            };
+
+            KSEvent* fEvent;
+            unsigned int fLookaheadLanes;
+            unsigned int fLookaheadSteps;
+            unsigned long fLookaheadSignature;
+            std::vector< LookaheadLane > fLanes;
+            int fServingLane;
+            mutable bool fLookaheadServed;
+            unsigned long fLookaheadCount;
+
+            std::vector< KSParticle > fBatchInitialParticles;
+            std::vector< KSParticle > fBatchFinalParticles;
+            std::vector< KThreeVector > fBatchCenters;
+            std::vector< double > fBatchRadii;
+            std::vector< double > fBatchTimeSteps;
+            std::vector< unsigned int > fBatchLanes;
     };
 
 }
@@ -35,6 +35,16 @@ namespace Kassiopeia
             void SetStepReportIteration( const unsigned int& anIteration );
             const unsigned int& GetStepReportIteration() const;
 
+            void SetProfile( const bool& aFlag );
+            const bool& GetProfile() const;
+
+            //particles of an event that are integrated together by a batchable trajectory, and steps calculated ahead per particle
+            void SetLookaheadLanes( const unsigned int& aCount );
+            const unsigned int& GetLookaheadLanes() const;
+
+            void SetLookaheadSteps( const unsigned int& aCount );
+            const unsigned int& GetLookaheadSteps() const;
+
             void AddCommand( KSCommand* aCommand );
             void RemoveCommand( KSCommand* aCommand );
 
@@ -59,6 +69,9 @@ namespace Kassiopeia
             unsigned int fRun;
             unsigned int fEvents;
             unsigned int fStepReportIteration;
+            bool fProfile;
+            unsigned int fLookaheadLanes;
+            unsigned int fLookaheadSteps;
             std::vector< KSCommand* > fCommands;
             std::vector< KSRunModifier* > fStaticRunModifiers;
             std::vector< KSEventModifier* > fStaticEventModifiers;
@@ -6,6 +6,7 @@
 
 #include "KToolbox.h"
 #include "KSNumerical.h"
+#include "KSProfiler.h"
 
 #include "KSRootMagneticField.h"
 #include "KSRootElectricField.h"
@@ -35,6 +36,7 @@
 #include "KRandom.h"
 
 #include <limits>
+#include <iomanip>
 #include <signal.h>
 
 using namespace std;
@@ -81,6 +83,8 @@ namespace Kassiopeia
 
         fOnce = false;
 
+        RegisterSections();
+
         fRun->SetName( "run" );
         fToolbox.Add<KSRun>(fRun, "run");
 
@@ -110,6 +114,7 @@ namespace Kassiopeia
 
         fRootTrajectory->SetName( "root_trajectory" );
         fRootTrajectory->SetStep( fStep );
+        fRootTrajectory->SetEvent( fEvent );
         fToolbox.Add(fRootTrajectory);
 
         fRootSpaceInteraction->SetName( "root_space_interaction" );
@@ -187,6 +192,8 @@ namespace Kassiopeia
 
         fOnce = false;
 
+        RegisterSections();
+
         fRun->SetName( "run" );
         fToolbox.Add(fRun);
 
@@ -216,6 +223,7 @@ namespace Kassiopeia
 
         fRootTrajectory->SetName( "root_trajectory" );
         fRootTrajectory->SetStep( fStep );
+        fRootTrajectory->SetEvent( fEvent );
         fToolbox.Add(fRootTrajectory);
 
         fRootSpaceInteraction->SetName( "root_space_interaction" );
@@ -325,8 +333,21 @@ namespace Kassiopeia
         mainmsg( eWarning ) << "Kassiopeia is running in debug mode - compile without debug flags to speed up simulations" << eom;
 #endif
 
+        //profiling
+        KSProfiler::GetInstance().Reset();
+        KSProfiler::GetInstance().SetEnabled( fSimulation->GetProfile() );
+
+        //lockstep trajectory lookahead over the particles of an event
+        fRootTrajectory->SetLookahead( fSimulation->GetLookaheadLanes(), fSimulation->GetLookaheadSteps() );
+
         ExecuteRun();
 
+        KSProfiler::GetInstance().SetEnabled( false );
+        if( fSimulation->GetProfile() == true )
+        {
+            ReportSections();
+        }
+
         mainmsg( eNormal ) << "finished!" << eom;
 
         //reset GSL error handling
@@ -381,6 +402,8 @@ namespace Kassiopeia
 
     void KSRoot::ExecuteRun()
     {
+        KSProfiler::Scope tRunScope( fRunSection );
+
         // set random seed
         KRandom::GetInstance().SetSeed( fSimulation->GetSeed() );
 
@@ -444,7 +467,10 @@ namespace Kassiopeia
         fRun->PushUpdate();
         fRootRunModifier->PushUpdate();
 
-        fRootWriter->ExecuteRun();
+        {
+            KSProfiler::Scope tScope( fWritingSection );
+            fRootWriter->ExecuteRun();
+        }
 
         fRun->PushDeupdate();
         fRootRunModifier->PushDeupdate();
@@ -473,11 +499,15 @@ namespace Kassiopeia
 
         //clear any internal trajectory state
         fRootTrajectory->Reset();
+        fRootTrajectory->ClearLookahead();
 
         fRootEventModifier->ExecutePreEventModification();
 
         // generate primaries
-        fRootGenerator->ExecuteGeneration();
+        {
+            KSProfiler::Scope tScope( fGenerationSection );
+            fRootGenerator->ExecuteGeneration();
+        }
 
         // send report
         eventmsg( eNormal ) << "processing event " << fEvent->GetEventId() << " <" << fEvent->GetGeneratorName() << ">..." << eom;
@@ -537,7 +567,10 @@ namespace Kassiopeia
         fEvent->PushUpdate();
         fRootEventModifier->PushUpdate();
 
-        fRootWriter->ExecuteEvent();
+        {
+            KSProfiler::Scope tScope( fWritingSection );
+            fRootWriter->ExecuteEvent();
+        }
 
         fEvent->PushDeupdate();
         fRootEventModifier->PushDeupdate();
@@ -567,10 +600,16 @@ namespace Kassiopeia
         // send report
         trackmsg( eNormal ) << "processing track " << fTrack->GetTrackId() << " <" << fTrack->GetCreatorName() << ">..." << eom;
 
-        fRootTrackModifier->ExecutePreTrackModification();
+        if( fRootTrackModifier->ExecutePreTrackModification() == true )
+        {
+            fRootTrajectory->ClearLookahead();
+        }
 
         // start navigation
-        fRootSpaceNavigator->StartNavigation( fTrack->InitialParticle(), fRootSpace );
+        {
+            KSProfiler::Scope tScope( fTrackNavigationSection );
+            fRootSpaceNavigator->StartNavigation( fTrack->InitialParticle(), fRootSpace );
+        }
 
         // initialize step objects
         fStep->InitialParticle() = fTrack->InitialParticle();
@@ -635,7 +674,10 @@ namespace Kassiopeia
         fTrack->PushUpdate();
         fRootTrackModifier->PushUpdate();
 
-        fRootWriter->ExecuteTrack();
+        {
+            KSProfiler::Scope tScope( fWritingSection );
+            fRootWriter->ExecuteTrack();
+        }
 
         fTrack->PushDeupdate();
         fRootTrackModifier->PushDeupdate();
@@ -643,7 +685,10 @@ namespace Kassiopeia
         fTrackIndex++;
 
         // stop navigation
-        fRootSpaceNavigator->StopNavigation( fTrack->FinalParticle(), fRootSpace );
+        {
+            KSProfiler::Scope tScope( fTrackNavigationSection );
+            fRootSpaceNavigator->StopNavigation( fTrack->FinalParticle(), fRootSpace );
+        }
 
         // send report
         trackmsg( eNormal ) << "...completed track " << fTrack->GetTrackId() << " <" << fTrack->GetTerminatorName() << "> after " << fTrack->GetTotalSteps() << " steps at " << fTrack->GetFinalParticle().GetPosition() << eom;
@@ -656,8 +701,12 @@ namespace Kassiopeia
     void KSRoot::ExecuteStep()
     {
         // run pre-step modification
-        bool hasPreModified = fRootStepModifier->ExecutePreStepModification();
-        if(hasPreModified){fRootTrajectory->Reset();};
+        bool hasPreModified;
+        {
+            KSProfiler::Scope tScope( fStepModificationSection );
+            hasPreModified = fRootStepModifier->ExecutePreStepModification();
+        }
+        if(hasPreModified){fRootTrajectory->Reset(); fRootTrajectory->ClearLookahead();};
 
         // reset step
         fStep->StepId() = fStepIndex;
@@ -722,7 +771,10 @@ namespace Kassiopeia
         KSTrajectory::ClearAbort();
 
         // run terminators
-        fRootTerminator->CalculateTermination();
+        {
+            KSProfiler::Scope tScope( fTerminationSection );
+            fRootTerminator->CalculateTermination();
+        }
 
         // if terminators did not kill the particle, continue with calculations
         if( fStep->TerminatorFlag() == false )
@@ -731,7 +783,10 @@ namespace Kassiopeia
             if( (fStep->InitialParticle().GetCurrentSurface() == NULL) && (fStep->InitialParticle().GetCurrentSide() == NULL) )
             {
                 // integrate the trajectory
-                fRootTrajectory->CalculateTrajectory();
+                {
+                    KSProfiler::Scope tScope( fTrajectoryCalculationSection );
+                    fRootTrajectory->CalculateTrajectory();
+                }
 
                 //need to check if an error handler event or stop signal
                 //was triggered during the trajectory calculation
@@ -752,10 +807,16 @@ namespace Kassiopeia
                 else
                 {
                     // calculate if a space interaction occurred
-                    fRootSpaceInteraction->CalculateInteraction();
+                    {
+                        KSProfiler::Scope tScope( fSpaceInteractionCalculationSection );
+                        fRootSpaceInteraction->CalculateInteraction();
+                    }
 
                     // calculate if a space navigation occurred
-                    fRootSpaceNavigator->CalculateNavigation();
+                    {
+                        KSProfiler::Scope tScope( fSpaceNavigationCalculationSection );
+                        fRootSpaceNavigator->CalculateNavigation();
+                    }
 
                     // if both a space interaction and space navigation occurred, differentiate between them based on which occurred first
                     if( (fStep->GetSpaceInteractionFlag() == true) && (fStep->GetSpaceNavigationFlag() == true) )
@@ -764,7 +825,10 @@ namespace Kassiopeia
                         // if space interaction was first, execute it and clear space navigation data
                         if( fStep->GetSpaceInteractionStep() < fStep->GetSpaceNavigationStep() )
                         {
-                            fRootSpaceInteraction->ExecuteInteraction();
+                            {
+                                KSProfiler::Scope tScope( fSpaceInteractionExecutionSection );
+                                fRootSpaceInteraction->ExecuteInteraction();
+                            }
                             fStep->SpaceNavigationName().clear();
                             fStep->SpaceNavigationStep() = numeric_limits< double >::max();
                             fStep->SpaceNavigationFlag() = false;
@@ -778,7 +842,10 @@ namespace Kassiopeia
                         // if space navigation was first, execute it and clear space interaction data
                         else
                         {
-                            fRootSpaceNavigator->ExecuteNavigation();
+                            {
+                                KSProfiler::Scope tScope( fSpaceNavigationExecutionSection );
+                                fRootSpaceNavigator->ExecuteNavigation();
+                            }
                             fStep->SpaceInteractionName().clear();
                             fStep->SpaceInteractionStep() = numeric_limits< double >::max();
                             fStep->SpaceInteractionFlag() = false;
@@ -793,6 +860,7 @@ namespace Kassiopeia
                     // if only a space interaction occurred, execute it
                     else if( fStep->GetSpaceInteractionFlag() == true )
                     {
+                        KSProfiler::Scope tScope( fSpaceInteractionExecutionSection );
                         fRootSpaceInteraction->ExecuteInteraction();
 
                         // if space interaction killed a particle, the terminator name is the space interaction name
@@ -804,6 +872,7 @@ namespace Kassiopeia
                     // if only a space navigation occurred, execute it
                     else if( fStep->GetSpaceNavigationFlag() == true )
                     {
+                        KSProfiler::Scope tScope( fSpaceNavigationExecutionSection );
                         fRootSpaceNavigator->ExecuteNavigation();
 
                         // if space navigation killed a particle, the terminator name is the space navigation name
@@ -815,11 +884,17 @@ namespace Kassiopeia
                     // if neither occurred, execute the trajectory
                     else
                     {
+                        KSProfiler::Scope tScope( fTrajectoryExecutionSection );
                         fRootTrajectory->ExecuteTrajectory();
                     }
 
                     // execute post-step modification
-                    fRootStepModifier->ExecutePostStepModification();
+                    bool hasSpacePostModified;
+                    {
+                        KSProfiler::Scope tScope( fStepModificationSection );
+                        hasSpacePostModified = fRootStepModifier->ExecutePostStepModification();
+                    }
+                    if(hasSpacePostModified){fRootTrajectory->ClearLookahead();};
 
                     // push update
                     fStep->PushUpdate();
@@ -830,7 +905,10 @@ namespace Kassiopeia
                     fRootStepModifier->PushUpdate();
 
                     // write the step
-                    fRootWriter->ExecuteStep();
+                    {
+                        KSProfiler::Scope tScope( fWritingSection );
+                        fRootWriter->ExecuteStep();
+                    }
 
                     // push deupdate
                     fStep->PushDeupdate();
@@ -844,7 +922,10 @@ namespace Kassiopeia
             // if the particle is on a surface or side, continue with surface calculations
             else
             {
-                fRootSurfaceInteraction->ExecuteInteraction();
+                {
+                    KSProfiler::Scope tScope( fSurfaceInteractionSection );
+                    fRootSurfaceInteraction->ExecuteInteraction();
+                }
 
                 // if surface interaction killed a particle, the terminator name is the surface interaction name
                 if( fStep->InteractionParticle().IsActive() == false )
@@ -852,7 +933,10 @@ namespace Kassiopeia
                     fStep->TerminatorName() = fStep->SurfaceInteractionName();
                 }
 
-                fRootSurfaceNavigator->ExecuteNavigation();
+                {
+                    KSProfiler::Scope tScope( fSurfaceNavigationSection );
+                    fRootSurfaceNavigator->ExecuteNavigation();
+                }
 
                 // if surface navigation killed a particle, the terminator name is the surface navigation name
                 if( fStep->FinalParticle().IsActive() == false )
@@ -861,8 +945,12 @@ namespace Kassiopeia
                 }
 
                 // execute post-step modification
-                bool hasPostModified = fRootStepModifier->ExecutePostStepModification();
-                if(hasPostModified){fRootTrajectory->Reset();};
+                bool hasPostModified;
+                {
+                    KSProfiler::Scope tScope( fStepModificationSection );
+                    hasPostModified = fRootStepModifier->ExecutePostStepModification();
+                }
+                if(hasPostModified){fRootTrajectory->Reset(); fRootTrajectory->ClearLookahead();};
 
                 // push update
                 fStep->PushUpdate();
@@ -872,7 +960,10 @@ namespace Kassiopeia
                 fRootStepModifier->PushUpdate();
 
                 // write the step
-                fRootWriter->ExecuteStep();
+                {
+                    KSProfiler::Scope tScope( fWritingSection );
+                    fRootWriter->ExecuteStep();
+                }
 
                 // push deupdate
                 fStep->PushDeupdate();
@@ -887,6 +978,7 @@ namespace Kassiopeia
         // if the terminators killed the particle, execute them
         else
         {
+            KSProfiler::Scope tScope( fTerminationSection );
             fRootTerminator->ExecuteTermination();
         }
 
@@ -923,6 +1015,7 @@ namespace Kassiopeia
         //now that the step is completely done, finalize either the space or the surface navigation for the next step
         if ( fStep->FinalParticle().IsActive() == true )
         {
+            KSProfiler::Scope tScope( fNavigationFinalizationSection );
             if ( fStep->GetSpaceNavigationFlag() == true )
             {
                 fRootSpaceNavigator->FinalizeNavigation();
@@ -1040,6 +1133,57 @@ namespace Kassiopeia
         return;
     }
 
+    void KSRoot::RegisterSections()
+    {
+        KSProfiler& tProfiler = KSProfiler::GetInstance();
+        fRunSection = tProfiler.Section( "run" );
+        fGenerationSection = tProfiler.Section( "generation" );
+        fTrackNavigationSection = tProfiler.Section( "track navigation" );
+        fStepModificationSection = tProfiler.Section( "step modification" );
+        fTerminationSection = tProfiler.Section( "termination" );
+        fTrajectoryCalculationSection = tProfiler.Section( "trajectory calculation" );
+        fTrajectoryExecutionSection = tProfiler.Section( "trajectory execution" );
+        fSpaceInteractionCalculationSection = tProfiler.Section( "space interaction calculation" );
+        fSpaceInteractionExecutionSection = tProfiler.Section( "space interaction execution" );
+        fSpaceNavigationCalculationSection = tProfiler.Section( "space navigation calculation" );
+        fSpaceNavigationExecutionSection = tProfiler.Section( "space navigation execution" );
+        fSurfaceInteractionSection = tProfiler.Section( "surface interaction" );
+        fSurfaceNavigationSection = tProfiler.Section( "surface navigation" );
+        fNavigationFinalizationSection = tProfiler.Section( "navigation finalization" );
+        fWritingSection = tProfiler.Section( "writing" );
+        return;
+    }
+
+    void KSRoot::ReportSections()
+    {
+        const vector< KSProfiler::Entry >& tEntries = KSProfiler::GetInstance().GetEntries();
+        const double tRunTime = tEntries[ fRunSection ].fTime;
+
+        //component sections are nested in the stages that call them, so the shares do not add up
+        mainmsg( eNormal );
+        mainmsg << "profile of run " << fRun->GetRunId() << " (times include nested sections):" << ret;
+        stringstream tHeader;
+        tHeader << "  " << left << setw( 48 ) << "section" << right << setw( 14 ) << "calls" << setw( 14 ) << "total [s]" << setw( 14 ) << "mean [us]" << setw( 10 ) << "share";
+        mainmsg << tHeader.str() << ret;
+        for( vector< KSProfiler::Entry >::const_iterator tIt = tEntries.begin(); tIt != tEntries.end(); tIt++ )
+        {
+            if( tIt->fCalls == 0 )
+            {
+                continue;
+            }
+
+            stringstream tLine;
+            tLine << "  " << left << setw( 48 ) << tIt->fName << right;
+            tLine << setw( 14 ) << tIt->fCalls;
+            tLine << fixed << setprecision( 3 ) << setw( 14 ) << tIt->fTime;
+            tLine << setw( 14 ) << 1.e6 * tIt->fTime / tIt->fCalls;
+            tLine << setprecision( 1 ) << setw( 9 ) << (tRunTime > 0. ? 100. * tIt->fTime / tRunTime : 0.) << "%";
+            mainmsg << tLine.str() << ret;
+        }
+        mainmsg << eom;
+        return;
+    }
+
     void KSRoot::SignalHandler(int aSignal)
     {
         mainmsg( eWarning ) << "stop requested by signal <" << aSignal << ">. stopping simulation..." << eom;
@@ -1,5 +1,6 @@
 #include "KSRootElectricField.h"
 #include "KSFieldsMessage.h"
+#include "KSProfiler.h"
 
 namespace Kassiopeia
 {
@@ -8,6 +9,7 @@ namespace Kassiopeia
         fCurrentPotential(),
         fCurrentField(),
         fCurrentGradient(),
+        fCurrentFields(),
         fElectricFields( 128 )
     {
     }
@@ -16,6 +18,7 @@ namespace Kassiopeia
             fCurrentPotential( aCopy.fCurrentPotential ),
             fCurrentField( aCopy.fCurrentField ),
             fCurrentGradient( aCopy.fCurrentGradient ),
+            fCurrentFields(),
             fElectricFields( aCopy.fElectricFields )
     {
     }
@@ -32,7 +35,9 @@ namespace Kassiopeia
         aPotential = 0.;
         for( int tIndex = 0; tIndex < fElectricFields.End(); tIndex++ )
         {
-            fElectricFields.ElementAt( tIndex )->CalculatePotential( aSamplePoint, aSampleTime, fCurrentPotential );
+            KSElectricField* tElectricField = fElectricFields.ElementAt( tIndex );
+            KSProfiler::Scope tScope( tElectricField, "electric field", tElectricField->GetName() );
+            tElectricField->CalculatePotential( aSamplePoint, aSampleTime, fCurrentPotential );
             aPotential += fCurrentPotential;
         }
         return;
@@ -42,7 +47,9 @@ namespace Kassiopeia
         aField = KThreeVector::sZero;
         for( int tIndex = 0; tIndex < fElectricFields.End(); tIndex++ )
         {
-            fElectricFields.ElementAt( tIndex )->CalculateField( aSamplePoint, aSampleTime, fCurrentField );
+            KSElectricField* tElectricField = fElectricFields.ElementAt( tIndex );
+            KSProfiler::Scope tScope( tElectricField, "electric field", tElectricField->GetName() );
+            tElectricField->CalculateField( aSamplePoint, aSampleTime, fCurrentField );
             aField += fCurrentField;
         }
         return;
@@ -52,7 +59,9 @@ namespace Kassiopeia
         aGradient = KThreeMatrix::sZero;
         for( int tIndex = 0; tIndex < fElectricFields.End(); tIndex++ )
         {
-            fElectricFields.ElementAt( tIndex )->CalculateGradient( aSamplePoint, aSampleTime, fCurrentGradient );
+            KSElectricField* tElectricField = fElectricFields.ElementAt( tIndex );
+            KSProfiler::Scope tScope( tElectricField, "electric field", tElectricField->GetName() );
+            tElectricField->CalculateGradient( aSamplePoint, aSampleTime, fCurrentGradient );
             aGradient += fCurrentGradient;
         }
         return;
@@ -63,13 +72,46 @@ namespace Kassiopeia
         aPotential = 0.;
         for( int tIndex = 0; tIndex < fElectricFields.End(); tIndex++ )
         {
-            fElectricFields.ElementAt( tIndex )->CalculateFieldAndPotential( aSamplePoint, aSampleTime, fCurrentField, fCurrentPotential );
+            KSElectricField* tElectricField = fElectricFields.ElementAt( tIndex );
+            KSProfiler::Scope tScope( tElectricField, "electric field", tElectricField->GetName() );
+            tElectricField->CalculateFieldAndPotential( aSamplePoint, aSampleTime, fCurrentField, fCurrentPotential );
             aField += fCurrentField;
             aPotential += fCurrentPotential;
         }
         return;
     }
 
+    void KSRootElectricField::CalculateFieldAndGradient( const KThreeVector& aSamplePoint, const double& aSampleTime, KThreeVector& aField, KThreeMatrix& aGradient )
+    {
+        aField = KThreeVector::sZero;
+        aGradient = KThreeMatrix::sZero;
+        for( int tIndex = 0; tIndex < fElectricFields.End(); tIndex++ )
+        {
+            KSElectricField* tElectricField = fElectricFields.ElementAt( tIndex );
+            KSProfiler::Scope tScope( tElectricField, "electric field", tElectricField->GetName() );
+            tElectricField->CalculateFieldAndGradient( aSamplePoint, aSampleTime, fCurrentField, fCurrentGradient );
+            aField += fCurrentField;
+            aGradient += fCurrentGradient;
+        }
+        return;
+    }
+
+    void KSRootElectricField::CalculateFields( const std::vector< KThreeVector >& aSamplePoints, const std::vector< double >& aSampleTimes, std::vector< KThreeVector >& aFields )
+    {
+        aFields.assign( aSamplePoints.size(), KThreeVector::sZero );
+        for( int tIndex = 0; tIndex < fElectricFields.End(); tIndex++ )
+        {
+            KSElectricField* tElectricField = fElectricFields.ElementAt( tIndex );
+            KSProfiler::Scope tScope( tElectricField, "electric field", tElectricField->GetName() );
+            tElectricField->CalculateFields( aSamplePoints, aSampleTimes, fCurrentFields );
+            for( unsigned int tPoint = 0; tPoint < aFields.size(); tPoint++ )
+            {
+                aFields[ tPoint ] += fCurrentFields[ tPoint ];
+            }
+        }
+        return;
+    }
+
     void KSRootElectricField::AddElectricField( KSElectricField* anElectricField )
     {
         //check that field is not already present
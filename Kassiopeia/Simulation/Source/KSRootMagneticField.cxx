@@ -1,5 +1,6 @@
 #include "KSRootMagneticField.h"
 #include "KSFieldsMessage.h"
+#include "KSProfiler.h"
 
 namespace Kassiopeia
 {
@@ -7,6 +8,7 @@ namespace Kassiopeia
     KSRootMagneticField::KSRootMagneticField() :
             fCurrentField(),
             fCurrentGradient(),
+            fCurrentFields(),
             fMagneticFields( 128 )
     {
     }
@@ -14,6 +16,7 @@ namespace Kassiopeia
             KSComponent(),
             fCurrentField( aCopy.fCurrentField ),
             fCurrentGradient( aCopy.fCurrentGradient ),
+            fCurrentFields(),
             fMagneticFields( aCopy.fMagneticFields )
     {
     }
@@ -30,7 +33,9 @@ namespace Kassiopeia
         aField = KThreeVector::sZero;
         for( int tIndex = 0; tIndex < fMagneticFields.End(); tIndex++ )
         {
-            fMagneticFields.ElementAt( tIndex )->CalculateField( aSamplePoint, aSampleTime, fCurrentField );
+            KSMagneticField* tMagneticField = fMagneticFields.ElementAt( tIndex );
+            KSProfiler::Scope tScope( tMagneticField, "magnetic field", tMagneticField->GetName() );
+            tMagneticField->CalculateField( aSamplePoint, aSampleTime, fCurrentField );
             aField += fCurrentField;
         }
         return;
@@ -40,7 +45,9 @@ namespace Kassiopeia
         aGradient = KThreeMatrix::sZero;
         for( int tIndex = 0; tIndex < fMagneticFields.End(); tIndex++ )
         {
-            fMagneticFields.ElementAt( tIndex )->CalculateGradient( aSamplePoint, aSampleTime, fCurrentGradient );
+            KSMagneticField* tMagneticField = fMagneticFields.ElementAt( tIndex );
+            KSProfiler::Scope tScope( tMagneticField, "magnetic field", tMagneticField->GetName() );
+            tMagneticField->CalculateGradient( aSamplePoint, aSampleTime, fCurrentGradient );
             aGradient += fCurrentGradient;
         }
         return;
@@ -52,13 +59,31 @@ namespace Kassiopeia
         aGradient = KThreeMatrix::sZero;
         for( int tIndex = 0; tIndex < fMagneticFields.End(); tIndex++ )
         {
-            fMagneticFields.ElementAt( tIndex )->CalculateFieldAndGradient( aSamplePoint, aSampleTime, fCurrentField, fCurrentGradient );
+            KSMagneticField* tMagneticField = fMagneticFields.ElementAt( tIndex );
+            KSProfiler::Scope tScope( tMagneticField, "magnetic field", tMagneticField->GetName() );
+            tMagneticField->CalculateFieldAndGradient( aSamplePoint, aSampleTime, fCurrentField, fCurrentGradient );
             aField += fCurrentField;
             aGradient += fCurrentGradient;
         }
         return;
     }
 
+    void KSRootMagneticField::CalculateFields( const std::vector< KThreeVector >& aSamplePoints, const std::vector< double >& aSampleTimes, std::vector< KThreeVector >& aFields )
+    {
+        aFields.assign( aSamplePoints.size(), KThreeVector::sZero );
+        for( int tIndex = 0; tIndex < fMagneticFields.End(); tIndex++ )
+        {
+            KSMagneticField* tMagneticField = fMagneticFields.ElementAt( tIndex );
+            KSProfiler::Scope tScope( tMagneticField, "magnetic field", tMagneticField->GetName() );
+            tMagneticField->CalculateFields( aSamplePoints, aSampleTimes, fCurrentFields );
+            for( unsigned int tPoint = 0; tPoint < aFields.size(); tPoint++ )
+            {
+                aFields[ tPoint ] += fCurrentFields[ tPoint ];
+            }
+        }
+        return;
+    }
+
     void KSRootMagneticField::AddMagneticField( KSMagneticField* aMagneticField )
     {
         //check that field is not already present
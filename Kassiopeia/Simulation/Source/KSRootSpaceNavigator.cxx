@@ -1,6 +1,7 @@
 #include "KSRootSpaceNavigator.h"
 
 #include "KSNavigatorsMessage.h"
+#include "KSProfiler.h"
 
 #include <limits>
 using std::numeric_limits;
@@ -45,6 +46,7 @@ namespace Kassiopeia
         {
             navmsg( eError ) << "<" << GetName() << "> cannot calculate navigation with no space navigator set" << eom;
         }
+        KSProfiler::Scope tScope( fSpaceNavigator, "space navigator", fSpaceNavigator->GetName() );
         fSpaceNavigator->CalculateNavigation( aTrajectory, aTrajectoryInitialParticle, aTrajectoryFinalParticle, aTrajectoryCenter, aTrajectoryRadius, aTrajectoryStep, aNavigationParticle, aNavigationStep, aNavigationFlag );
         return;
     }
@@ -54,6 +56,7 @@ namespace Kassiopeia
         {
             navmsg( eError ) << "<" << GetName() << "> cannot execute navigation with no space navigator set" << eom;
         }
+        KSProfiler::Scope tScope( fSpaceNavigator, "space navigator", fSpaceNavigator->GetName() );
         fSpaceNavigator->ExecuteNavigation( aNavigationParticle, aFinalParticle, aSecondaries );
         return;
     }
@@ -1,6 +1,7 @@
 #include "KSRootSurfaceNavigator.h"
 
 #include "KSNavigatorsMessage.h"
+#include "KSProfiler.h"
 
 #include <limits>
 using std::numeric_limits;
@@ -41,6 +42,7 @@ namespace Kassiopeia
         {
             navmsg( eError ) << "<" << GetName() << "> cannot execute navigation with no surface navigation set" << eom;
         }
+        KSProfiler::Scope tScope( fSurfaceNavigator, "surface navigator", fSurfaceNavigator->GetName() );
         fSurfaceNavigator->ExecuteNavigation( anInitialParticle, aNavigationParticle, aFinalParticle, aSecondaries );
         return;
     }
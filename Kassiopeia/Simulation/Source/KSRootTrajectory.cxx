@@ -1,5 +1,6 @@
 #include "KSRootTrajectory.h"
 #include "KSTrajectoriesMessage.h"
+#include "KSCommand.h"
 
 namespace Kassiopeia
 {
@@ -10,7 +11,21 @@ namespace Kassiopeia
             fTerminatorParticle( NULL ),
             fTrajectoryParticle( NULL ),
             fFinalParticle( NULL ),
-            fFailureFlag(false)
+            fFailureFlag(false),
+            fEvent( NULL ),
+            fLookaheadLanes( 1 ),
+            fLookaheadSteps( 0 ),
+            fLookaheadSignature( 0 ),
+            fLanes(),
+            fServingLane( -1 ),
+            fLookaheadServed( false ),
+            fLookaheadCount( 0 ),
+            fBatchInitialParticles(),
+            fBatchFinalParticles(),
+            fBatchCenters(),
+            fBatchRadii(),
+            fBatchTimeSteps(),
+            fBatchLanes()
     {
     }
     KSRootTrajectory::KSRootTrajectory( const KSRootTrajectory& aCopy ) :
@@ -20,7 +35,21 @@ namespace Kassiopeia
             fTerminatorParticle( aCopy.fTerminatorParticle ),
             fTrajectoryParticle( aCopy.fTrajectoryParticle ),
             fFinalParticle( aCopy.fFinalParticle ),
-            fFailureFlag( aCopy.fFailureFlag)
+            fFailureFlag( aCopy.fFailureFlag),
+            fEvent( aCopy.fEvent ),
+            fLookaheadLanes( aCopy.fLookaheadLanes ),
+            fLookaheadSteps( aCopy.fLookaheadSteps ),
+            fLookaheadSignature( 0 ),
+            fLanes(),
+            fServingLane( -1 ),
+            fLookaheadServed( false ),
+            fLookaheadCount( 0 ),
+            fBatchInitialParticles(),
+            fBatchFinalParticles(),
+            fBatchCenters(),
+            fBatchRadii(),
+            fBatchTimeSteps(),
+            fBatchLanes()
     {
     }
     KSRootTrajectory* KSRootTrajectory::Clone() const
@@ -37,6 +66,7 @@ namespace Kassiopeia
         {
             trajmsg( eError ) << "<" << GetName() << "> cannot calculate trajectory with no trajectory set" << eom;
         }
+        fLookaheadServed = false;
         fTrajectory->CalculateTrajectory( anInitialParticle, aFinalParticle, aCenter, aRadius, aTimeStep );
         return;
     }
@@ -46,6 +76,7 @@ namespace Kassiopeia
         {
             trajmsg( eError ) << "<" << GetName() << "> cannot execute trajectory with no trajectory set" << eom;
         }
+        RecalculateServedStep();
         fTrajectory->ExecuteTrajectory( aTimeStep, anIntermediateParticle );
         return;
     }
@@ -56,6 +87,7 @@ namespace Kassiopeia
         {
             trajmsg( eError ) << "<" << GetName() << "> cannot compute piecewise linear approximation with no trajectory set" << eom;
         }
+        RecalculateServedStep();
         fTrajectory->GetPiecewiseLinearApproximation(anInitialParticle, aFinalParticle, intermediateParticleStates );
         return;
     }
@@ -69,6 +101,7 @@ namespace Kassiopeia
         }
         trajmsg_debug( "<" << GetName() << "> setting trajectory <" << aTrajectory->GetName() << ">" << eom );
         fTrajectory = aTrajectory;
+        ClearLookahead();
         return;
     }
     void KSRootTrajectory::ClearTrajectory( KSTrajectory* aTrajectory )
@@ -80,6 +113,7 @@ namespace Kassiopeia
         }
         trajmsg_debug( "<" << GetName() << "> clearing trajectory <" << aTrajectory->GetName() << ">" << eom );
         fTrajectory = NULL;
+        ClearLookahead();
         return;
     }
 
@@ -98,7 +132,10 @@ namespace Kassiopeia
 
         *fTrajectoryParticle = *fTerminatorParticle;
 
-        CalculateTrajectory( *fTerminatorParticle, *fTrajectoryParticle, fStep->TrajectoryCenter(), fStep->TrajectoryRadius(), fStep->TrajectoryStep() );
+        if( ServeLookahead() == false )
+        {
+            CalculateTrajectory( *fTerminatorParticle, *fTrajectoryParticle, fStep->TrajectoryCenter(), fStep->TrajectoryRadius(), fStep->TrajectoryStep() );
+        }
         fFinalParticle->ReleaseLabel( fStep->TrajectoryName() );
 
         trajmsg_debug( "trajectory calculation:" << eom );
@@ -179,6 +216,285 @@ namespace Kassiopeia
         return;
     }
 
+    void KSRootTrajectory::SetEvent( KSEvent* anEvent )
+    {
+        fEvent = anEvent;
+        return;
+    }
+
+    void KSRootTrajectory::SetLookahead( const unsigned int& aLaneCount, const unsigned int& aStepCount )
+    {
+        fLookaheadLanes = aLaneCount;
+        fLookaheadSteps = aStepCount;
+        ClearLookahead();
+        return;
+    }
+
+    void KSRootTrajectory::ClearLookahead()
+    {
+        fLanes.clear();
+        fServingLane = -1;
+        fLookaheadSignature = KSCommand::GetActiveSignature();
+        return;
+    }
+
+    const unsigned long& KSRootTrajectory::GetLookaheadCount() const
+    {
+        return fLookaheadCount;
+    }
+
+    namespace
+    {
+        //two particles arrive at the same step if the integrated state and everything the trajectory takes over as constant agree
+        bool SameTrajectoryState( const KSParticle& aFirst, const KSParticle& aSecond )
+        {
+            return aFirst.GetTime() == aSecond.GetTime() &&
+                   aFirst.GetLength() == aSecond.GetLength() &&
+                   aFirst.GetPosition() == aSecond.GetPosition() &&
+                   aFirst.GetMomentum() == aSecond.GetMomentum() &&
+                   aFirst.GetMass() == aSecond.GetMass() &&
+                   aFirst.GetCharge() == aSecond.GetCharge() &&
+                   aFirst.GetMagneticFieldCalculator() == aSecond.GetMagneticFieldCalculator() &&
+                   aFirst.GetElectricFieldCalculator() == aSecond.GetElectricFieldCalculator();
+        }
+    }
+
+    bool KSRootTrajectory::ServeLookahead()
+    {
+        if( fLookaheadLanes < 2 || fLookaheadSteps == 0 || fTrajectory == NULL || fTrajectory->IsBatchable() == false )
+        {
+            return false;
+        }
+
+        //a command changed fields, spaces or the trajectory since the lanes were calculated
+        if( fLookaheadSignature != KSCommand::GetActiveSignature() )
+        {
+            ClearLookahead();
+        }
+
+        int tLane = FindLane( *fTerminatorParticle );
+        if( tLane == -1 )
+        {
+            //the particle left its lane or never had one, so a new round is calculated with it as the first lane
+            if( fServingLane != -1 )
+            {
+                DropLane( fServingLane );
+            }
+            FillLookahead();
+            tLane = FindLane( *fTerminatorParticle );
+            if( tLane == -1 )
+            {
+                return false;
+            }
+        }
+        else if( fServingLane != -1 && tLane != fServingLane )
+        {
+            //tracks are processed one after the other, so the previous particle is done
+            if( fServingLane < tLane )
+            {
+                tLane--;
+            }
+            DropLane( fServingLane );
+        }
+
+        fServingLane = tLane;
+        LookaheadLane& tCurrentLane = fLanes[ tLane ];
+        tCurrentLane.fQueuedParticle = NULL;
+
+        //the same assignments as the push of the trajectory particle at the end of a scalar step
+        const LookaheadStep& tStep = tCurrentLane.fSteps.front();
+        const KSParticle& tFinalParticle = tStep.fFinalParticle;
+        fTrajectoryParticle->SetPhaseSpace( tFinalParticle.GetTime(), tFinalParticle.GetLength(), tFinalParticle.GetPosition(), tFinalParticle.GetMomentum() );
+        if( tFinalParticle.HasMagneticField() == true )
+        {
+            fTrajectoryParticle->SetMagneticField( tFinalParticle.GetMagneticField() );
+        }
+        if( tFinalParticle.HasElectricField() == true )
+        {
+            fTrajectoryParticle->SetElectricField( tFinalParticle.GetElectricField() );
+        }
+        if( tFinalParticle.HasMagneticGradient() == true )
+        {
+            fTrajectoryParticle->SetMagneticGradient( tFinalParticle.GetMagneticGradient() );
+        }
+        if( tFinalParticle.HasElectricPotential() == true )
+        {
+            fTrajectoryParticle->SetElectricPotential( tFinalParticle.GetElectricPotential() );
+        }
+        fTrajectoryParticle->SetLabel( fTrajectory->GetName() );
+
+        fStep->TrajectoryCenter() = tStep.fCenter;
+        fStep->TrajectoryRadius() = tStep.fRadius;
+        fStep->TrajectoryStep() = tStep.fTimeStep;
+
+        tCurrentLane.fSteps.pop_front();
+        fLookaheadServed = true;
+        fLookaheadCount++;
+
+        trajmsg_debug( "<" << GetName() << "> took step from lookahead lane <" << tLane << ">, <" << tCurrentLane.fSteps.size() << "> steps left" << eom );
+
+        return true;
+    }
+
+    int KSRootTrajectory::FindLane( const KSParticle& aParticle ) const
+    {
+        if( fServingLane != -1 && fLanes[ fServingLane ].fSteps.empty() == false && SameTrajectoryState( fLanes[ fServingLane ].fSteps.front().fInitialParticle, aParticle ) == true )
+        {
+            return fServingLane;
+        }
+        for( unsigned int tLane = 0; tLane < fLanes.size(); tLane++ )
+        {
+            if( fLanes[ tLane ].fSteps.empty() == false && SameTrajectoryState( fLanes[ tLane ].fSteps.front().fInitialParticle, aParticle ) == true )
+            {
+                return tLane;
+            }
+        }
+        return -1;
+    }
+
+    void KSRootTrajectory::DropLane( const int& aLane )
+    {
+        fLanes.erase( fLanes.begin() + aLane );
+        if( fServingLane == aLane )
+        {
+            fServingLane = -1;
+        }
+        else if( fServingLane > aLane )
+        {
+            fServingLane--;
+        }
+        return;
+    }
+
+    void KSRootTrajectory::FillLookahead()
+    {
+        //lanes of particles that are not waiting in the event queue anymore will not be asked for again
+        for( int tLane = fLanes.size() - 1; tLane >= 0; tLane-- )
+        {
+            bool tQueued = false;
+            if( fEvent != NULL && fLanes[ tLane ].fQueuedParticle != NULL )
+            {
+                for( KSParticleCIt tIt = fEvent->ParticleQueue().begin(); tIt != fEvent->ParticleQueue().end(); tIt++ )
+                {
+                    if( *tIt == fLanes[ tLane ].fQueuedParticle && SameTrajectoryState( **tIt, fLanes[ tLane ].fSeedParticle ) == true )
+                    {
+                        tQueued = true;
+                        break;
+                    }
+                }
+            }
+            if( tQueued == false )
+            {
+                DropLane( tLane );
+            }
+        }
+
+        LookaheadLane tLane;
+        tLane.fQueuedParticle = NULL;
+        tLane.fSeedParticle = *fTerminatorParticle;
+        tLane.fEnded = false;
+        fLanes.push_back( tLane );
+
+        //waiting particles share the lanes if the trajectory can take them in the same batch
+        if( fEvent != NULL )
+        {
+            for( KSParticleCIt tIt = fEvent->ParticleQueue().begin(); tIt != fEvent->ParticleQueue().end() && fLanes.size() < fLookaheadLanes; tIt++ )
+            {
+                const KSParticle* tParticle = *tIt;
+                if( tParticle->IsActive() == false || tParticle->GetCurrentSurface() != NULL || tParticle->GetCurrentSide() != NULL ||
+                    tParticle->GetMass() != fTerminatorParticle->GetMass() || tParticle->GetCharge() != fTerminatorParticle->GetCharge() ||
+                    tParticle->GetMagneticFieldCalculator() != fTerminatorParticle->GetMagneticFieldCalculator() ||
+                    tParticle->GetElectricFieldCalculator() != fTerminatorParticle->GetElectricFieldCalculator() )
+                {
+                    continue;
+                }
+                bool tLaned = false;
+                for( unsigned int tIndex = 0; tIndex < fLanes.size(); tIndex++ )
+                {
+                    if( fLanes[ tIndex ].fQueuedParticle == tParticle )
+                    {
+                        tLaned = true;
+                        break;
+                    }
+                }
+                if( tLaned == true )
+                {
+                    continue;
+                }
+                tLane.fQueuedParticle = tParticle;
+                tLane.fSeedParticle = *tParticle;
+                fLanes.push_back( tLane );
+            }
+        }
+
+        //advance all lanes that are short of steps together, one step per batch
+        while( true )
+        {
+            fBatchLanes.clear();
+            fBatchInitialParticles.clear();
+            for( unsigned int tIndex = 0; tIndex < fLanes.size(); tIndex++ )
+            {
+                LookaheadLane& tCurrentLane = fLanes[ tIndex ];
+                if( tCurrentLane.fEnded == true || tCurrentLane.fSteps.size() >= fLookaheadSteps )
+                {
+                    continue;
+                }
+                fBatchLanes.push_back( tIndex );
+                fBatchInitialParticles.push_back( tCurrentLane.fSteps.empty() ? tCurrentLane.fSeedParticle : tCurrentLane.fSteps.back().fFinalParticle );
+            }
+            if( fBatchLanes.empty() == true )
+            {
+                break;
+            }
+
+            fTrajectory->CalculateTrajectories( fBatchInitialParticles, fBatchFinalParticles, fBatchCenters, fBatchRadii, fBatchTimeSteps );
+
+            for( unsigned int tIndex = 0; tIndex < fBatchLanes.size(); tIndex++ )
+            {
+                LookaheadLane& tCurrentLane = fLanes[ fBatchLanes[ tIndex ] ];
+
+                //a failed step is left to the scalar path, which reports it
+                if( fBatchFinalParticles[ tIndex ].IsActive() == false )
+                {
+                    tCurrentLane.fEnded = true;
+                    continue;
+                }
+
+                tCurrentLane.fSteps.push_back( LookaheadStep() );
+                LookaheadStep& tStep = tCurrentLane.fSteps.back();
+                tStep.fInitialParticle = fBatchInitialParticles[ tIndex ];
+                tStep.fFinalParticle = fBatchFinalParticles[ tIndex ];
+                tStep.fCenter = fBatchCenters[ tIndex ];
+                tStep.fRadius = fBatchRadii[ tIndex ];
+                tStep.fTimeStep = fBatchTimeSteps[ tIndex ];
+            }
+        }
+
+        fLookaheadSignature = KSCommand::GetActiveSignature();
+
+        trajmsg_debug( "<" << GetName() << "> calculated lookahead for <" << fLanes.size() << "> lanes" << eom );
+
+        return;
+    }
+
+    void KSRootTrajectory::RecalculateServedStep() const
+    {
+        if( fLookaheadServed == false )
+        {
+            return;
+        }
+
+        //the trajectory holds the state of the lane it calculated last, so the served step is calculated once more
+        //for interpolation. the result is the one taken from the lookahead.
+        KSParticle tFinalParticle( *fTerminatorParticle );
+        KThreeVector tCenter;
+        double tRadius;
+        double tTimeStep;
+        fTrajectory->CalculateTrajectory( *fTerminatorParticle, tFinalParticle, tCenter, tRadius, tTimeStep );
+        fLookaheadServed = false;
+        return;
+    }
+
     STATICINT sKSRootTrajectoryDict =
         KSDictionary< KSRootTrajectory >::AddCommand( &KSRootTrajectory::SetTrajectory, &KSRootTrajectory::ClearTrajectory, "set_trajectory", "clear_trajectory" );
 
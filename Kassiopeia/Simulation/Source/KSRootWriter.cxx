@@ -1,5 +1,6 @@
 #include "KSRootWriter.h"
 #include "KSWritersMessage.h"
+#include "KSProfiler.h"
 
 namespace Kassiopeia
 {
@@ -46,7 +47,9 @@ namespace Kassiopeia
     {
         for( int tIndex = 0; tIndex < fWriters.End(); tIndex++ )
         {
-            fWriters.ElementAt( tIndex )->ExecuteRun();
+            KSWriter* tWriter = fWriters.ElementAt( tIndex );
+            KSProfiler::Scope tScope( tWriter, "writer", tWriter->GetName() );
+            tWriter->ExecuteRun();
         }
         return;
     }
@@ -54,7 +57,9 @@ namespace Kassiopeia
     {
         for( int tIndex = 0; tIndex < fWriters.End(); tIndex++ )
         {
-            fWriters.ElementAt( tIndex )->ExecuteEvent();
+            KSWriter* tWriter = fWriters.ElementAt( tIndex );
+            KSProfiler::Scope tScope( tWriter, "writer", tWriter->GetName() );
+            tWriter->ExecuteEvent();
         }
         return;
     }
@@ -62,7 +67,9 @@ namespace Kassiopeia
     {
         for( int tIndex = 0; tIndex < fWriters.End(); tIndex++ )
         {
-            fWriters.ElementAt( tIndex )->ExecuteTrack();
+            KSWriter* tWriter = fWriters.ElementAt( tIndex );
+            KSProfiler::Scope tScope( tWriter, "writer", tWriter->GetName() );
+            tWriter->ExecuteTrack();
         }
         return;
     }
@@ -70,7 +77,9 @@ namespace Kassiopeia
     {
         for( int tIndex = 0; tIndex < fWriters.End(); tIndex++ )
         {
-            fWriters.ElementAt( tIndex )->ExecuteStep();
+            KSWriter* tWriter = fWriters.ElementAt( tIndex );
+            KSProfiler::Scope tScope( tWriter, "writer", tWriter->GetName() );
+            tWriter->ExecuteStep();
         }
         return;
     }
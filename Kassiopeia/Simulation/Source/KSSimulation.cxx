@@ -10,6 +10,9 @@ namespace Kassiopeia
             fRun( 0 ),
             fEvents( 0 ),
             fStepReportIteration( 1000 ),
+            fProfile( false ),
+            fLookaheadLanes( 1 ),
+            fLookaheadSteps( 16 ),
             fCommands()
     {
     }
@@ -19,6 +22,9 @@ namespace Kassiopeia
             fRun( aCopy.fRun ),
             fEvents( aCopy.fEvents ),
             fStepReportIteration( aCopy.fStepReportIteration ),
+            fProfile( aCopy.fProfile ),
+            fLookaheadLanes( aCopy.fLookaheadLanes ),
+            fLookaheadSteps( aCopy.fLookaheadSteps ),
             fCommands()
     {
     }
@@ -70,6 +76,36 @@ namespace Kassiopeia
         return fStepReportIteration;
     }
 
+    void KSSimulation::SetProfile( const bool& aFlag )
+    {
+        fProfile = aFlag;
+        return;
+    }
+    const bool& KSSimulation::GetProfile() const
+    {
+        return fProfile;
+    }
+
+    void KSSimulation::SetLookaheadLanes( const unsigned int& aCount )
+    {
+        fLookaheadLanes = aCount;
+        return;
+    }
+    const unsigned int& KSSimulation::GetLookaheadLanes() const
+    {
+        return fLookaheadLanes;
+    }
+
+    void KSSimulation::SetLookaheadSteps( const unsigned int& aCount )
+    {
+        fLookaheadSteps = aCount;
+        return;
+    }
+    const unsigned int& KSSimulation::GetLookaheadSteps() const
+    {
+        return fLookaheadSteps;
+    }
+
     void KSSimulation::AddCommand( KSCommand* aCommand )
     {
         std::vector< KSCommand* >::iterator tCommandIt;
@@ -45,6 +45,8 @@ namespace Kassiopeia
             void SetAbsolutePositionError(double error ){fAbsoluteError = error;};
             void SetSafetyFactor(double safety){fSafetyFactor = safety;};
             void SetSolverOrder(double order){fSolverOrder = order;};
+            void SetIntegralGain(double gain){fIntegralGain = gain;};
+            void SetProportionalGain(double gain){fProportionalGain = gain;};
 
         private:
 
@@ -55,9 +57,13 @@ namespace Kassiopeia
             double fAbsoluteError; //max allowable error on position magnitude per step
             double fSafetyFactor; //safety factor for increasing/decreasing step size
             double fSolverOrder; //order of the associated runge-kutta stepper
+            double fIntegralGain; //exponent of the current error ratio, in units of 1/order
+            double fProportionalGain; //exponent of the previous error ratio, in units of 1/order (0 disables PI control)
 
             double fTimeStep;
             bool fFirstStep;
+            double fPreviousError;
+            bool fLastStepRejected;
     };
 
 }
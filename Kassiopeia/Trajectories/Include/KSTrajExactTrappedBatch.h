@@ -0,0 +1,57 @@
+#ifndef Kassiopeia_KSTrajExactTrappedBatch_h_
+#define Kassiopeia_KSTrajExactTrappedBatch_h_
+
+#include "KSTrajExactTrappedParticle.h"
+
+#include <vector>
+
+namespace Kassiopeia
+{
+
+    //state of a group of exact trapped particles stored as one array per coordinate, so that
+    //all lanes are advanced together by the symplectic scheme of KSMathSym4. the propagation
+    //term is evaluated directly on the arrays and the fields are requested with one batched
+    //call per momentum stage. mass, charge and field calculators are the static ones of
+    //KSTrajExactTrappedParticle and therefore shared by all lanes.
+
+    class KSTrajExactTrappedBatch
+    {
+        public:
+            KSTrajExactTrappedBatch();
+            ~KSTrajExactTrappedBatch();
+
+        public:
+            void SetNumberOfLanes( const unsigned int& aNumber );
+            unsigned int GetNumberOfLanes() const;
+
+            void PullFrom( const unsigned int& aLane, const KSTrajExactTrappedParticle& aParticle );
+            void PushTo( const unsigned int& aLane, KSTrajExactTrappedParticle& aParticle ) const;
+
+            //advances every lane by its own time step, lane by lane this reproduces
+            //KSMathSym4 with KSTrajTermPropagation as the only term
+            void IntegrateSym4( const std::vector< double >& aTimeSteps );
+
+        private:
+            void PositionStage( const double& aCoefficient, const std::vector< double >& aTimeSteps );
+            void MomentumStage( const double& aCoefficient, const std::vector< double >& aTimeSteps );
+
+            unsigned int fNLanes;
+
+            std::vector< double > fTime;
+            std::vector< double > fLength;
+            std::vector< double > fX;
+            std::vector< double > fY;
+            std::vector< double > fZ;
+            std::vector< double > fPX;
+            std::vector< double > fPY;
+            std::vector< double > fPZ;
+
+            std::vector< KThreeVector > fSamplePoints;
+            std::vector< double > fSampleTimes;
+            std::vector< KThreeVector > fMagneticFields;
+            std::vector< KThreeVector > fElectricFields;
+    };
+
+}
+
+#endif
@@ -72,6 +72,10 @@ namespace Kassiopeia
             const KThreeMatrix& GetElectricGradient() const;
             const KThreeMatrix& GetMagneticGradient() const;
 
+            //fetch several quantities with a single query at points where none of them is cached yet
+            const std::pair< const KThreeVector&, const KThreeMatrix& > GetMagneticFieldAndGradient() const;
+            const std::pair< const KThreeVector&, const KThreeMatrix& > GetElectricFieldAndGradient() const;
+
             const KThreeVector& GetGuidingCenter() const;
             const double& GetLongMomentum() const;
             const double& GetTransMomentum() const;
@@ -120,12 +124,17 @@ namespace Kassiopeia
             void RecalculateElectricField() const;
             void RecalculateElectricPotential() const;
             void RecalculateElectricGradient() const;
+            void RecalculateMagneticFieldAndGradient() const;
+            void RecalculateElectricFieldAndGradient() const;
 
             mutable void (KSTrajExactTrappedParticle::*fGetMagneticFieldPtr)() const;
             mutable void (KSTrajExactTrappedParticle::*fGetElectricFieldPtr)() const;
             mutable void (KSTrajExactTrappedParticle::*fGetMagneticGradientPtr)() const;
             mutable void (KSTrajExactTrappedParticle::*fGetElectricPotentialPtr)() const;
             mutable void (KSTrajExactTrappedParticle::*fGetElectricGradientPtr)() const;
+
+            //stamp shared with the particle this state was last pushed to, zero once the state changes
+            mutable unsigned long fStateStamp;
     };
 
     inline KSTrajExactTrappedParticle& KSTrajExactTrappedParticle::operator=( const double& anOperand )
@@ -136,6 +145,7 @@ namespace Kassiopeia
         fGetMagneticGradientPtr = &KSTrajExactTrappedParticle::RecalculateMagneticGradient;
         fGetElectricPotentialPtr = &KSTrajExactTrappedParticle::RecalculateElectricPotential;
         fGetElectricGradientPtr = &KSTrajExactTrappedParticle::RecalculateElectricGradient;
+        fStateStamp = 0;
         return *this;
     }
 
@@ -147,6 +157,7 @@ namespace Kassiopeia
         fGetMagneticGradientPtr = &KSTrajExactTrappedParticle::RecalculateMagneticGradient;
         fGetElectricPotentialPtr = &KSTrajExactTrappedParticle::RecalculateElectricPotential;
         fGetElectricGradientPtr = &KSTrajExactTrappedParticle::RecalculateElectricGradient;
+        fStateStamp = 0;
         return *this;
     }
 
@@ -159,6 +170,7 @@ namespace Kassiopeia
         fGetMagneticGradientPtr = &KSTrajExactTrappedParticle::RecalculateMagneticGradient;
         fGetElectricPotentialPtr = &KSTrajExactTrappedParticle::RecalculateElectricPotential;
         fGetElectricGradientPtr = &KSTrajExactTrappedParticle::RecalculateElectricGradient;
+        fStateStamp = 0;
         return *this;
     }
 
@@ -194,6 +206,8 @@ namespace Kassiopeia
         fGetElectricPotentialPtr = aParticle.fGetElectricPotentialPtr;
         fGetElectricGradientPtr = aParticle.fGetElectricGradientPtr;
 
+        fStateStamp = aParticle.fStateStamp;
+
         return *this;
     }
 
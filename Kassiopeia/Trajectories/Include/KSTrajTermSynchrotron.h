@@ -26,6 +26,10 @@ namespace Kassiopeia
             virtual void Differentiate(double /*aTime*/, const KSTrajAdiabaticParticle& aParticle, KSTrajAdiabaticDerivative& aDerivative ) const;
             virtual void Differentiate(double aTime, const KSTrajExactTrappedParticle& aParticle, KSTrajExactTrappedDerivative& aDerivative) const;
 
+            //true if the corresponding Differentiate reads the field gradients at this stage
+            bool UsesFieldGradients( double aTime, const KSTrajExactParticle& aParticle ) const;
+            bool UsesFieldGradients( double aTime, const KSTrajExactTrappedParticle& aParticle ) const;
+
         public:
             void SetEnhancement( const double& anEnhancement );
             void SetOldMethode( const bool& aBool );
@@ -5,6 +5,7 @@
 #include "KSTrajExactTypes.h"
 
 #include "KSList.h"
+#include "KField.h"
 
 #include "KGBall.hh"
 #include "KGBallSupportSet.hh"
@@ -12,6 +13,8 @@
 namespace Kassiopeia
 {
 
+    class KSTrajTermSynchrotron;
+
     class KSTrajTrajectoryExact :
         public KSComponentTemplate< KSTrajTrajectoryExact, KSTrajectory >,
         public KSTrajExactDifferentiator
@@ -65,6 +68,14 @@ namespace Kassiopeia
         public:
             virtual void Differentiate(double aTime, const KSTrajExactParticle& aValue, KSTrajExactDerivative& aDerivative ) const;
 
+        protected:
+            virtual void PullDeupdateComponent();
+            virtual void PushDeupdateComponent();
+
+            //variables for output
+            K_REFS( int, StepNRejections )
+            K_REFS( int, StepNIntegrations )
+
         private:
 
             KSTrajExactParticle fInitialParticle;
@@ -85,6 +96,9 @@ namespace Kassiopeia
 
             unsigned int fMaxAttempts;
 
+            //terms that may need field gradients, see Differentiate
+            KSList< KSTrajTermSynchrotron > fSynchrotronTerms;
+
     };
 
 }
@@ -5,6 +5,7 @@
 #include "KSTrajExactSpinTypes.h"
 
 #include "KSList.h"
+#include "KField.h"
 
 #include "KGBall.hh"
 #include "KGBallSupportSet.hh"
@@ -65,6 +66,14 @@ namespace Kassiopeia
         public:
             virtual void Differentiate(double aTime, const KSTrajExactSpinParticle& aValue, KSTrajExactSpinDerivative& aDerivative ) const;
 
+        protected:
+            virtual void PullDeupdateComponent();
+            virtual void PushDeupdateComponent();
+
+            //variables for output
+            K_REFS( int, StepNRejections )
+            K_REFS( int, StepNIntegrations )
+
         private:
 
             KSTrajExactSpinParticle fInitialParticle;
@@ -3,8 +3,11 @@
 
 #include "KSTrajectory.h"
 #include "KSTrajExactTrappedTypes.h"
+#include "KSTrajExactTrappedBatch.h"
+#include "KSTrajTrajectoryAdiabatic.h"
 
 #include "KSList.h"
+#include "KField.h"
 
 #include "KGBall.hh"
 #include "KGBallSupportSet.hh"
@@ -12,6 +15,8 @@
 namespace Kassiopeia
 {
 
+    class KSTrajTermSynchrotron;
+
     class KSTrajTrajectoryExactTrapped :
         public KSComponentTemplate< KSTrajTrajectoryExactTrapped, KSTrajectory >,
         public KSTrajExactTrappedDifferentiator
@@ -35,6 +40,13 @@ namespace Kassiopeia
             void AddControl( KSTrajExactTrappedControl* aControl );
             void RemoveControl( KSTrajExactTrappedControl* aControlSize );
 
+            //guiding center trajectory used while the motion is adiabatic, see GetAdiabaticity
+            void SetGuidingCenterTrajectory( KSTrajTrajectoryAdiabatic* aTrajectory );
+            void ClearGuidingCenterTrajectory( KSTrajTrajectoryAdiabatic* aTrajectory );
+
+            void SetAdiabaticityLimit( double aLimit ){fAdiabaticityLimit = aLimit;};
+            double GetAdiabaticityLimit() const {return fAdiabaticityLimit;};
+
             void SetAttemptLimit(unsigned int n)
             {
                 if(n > 1 ){fMaxAttempts = n;}
@@ -58,6 +70,22 @@ namespace Kassiopeia
             void ExecuteTrajectory( const double& aTimeStep, KSParticle& anIntermediateParticle ) const;
             void GetPiecewiseLinearApproximation(const KSParticle& anInitialParticle, const KSParticle& /*aFinalParticle*/, std::vector< KSParticle >* intermediateParticleStates) const;
 
+            //*****************
+            //lockstep batching
+            //*****************
+
+        public:
+            //true if the integrator is sym4, no interpolator or guiding center trajectory is set, propagation is the only term
+            //and the step size comes from time and length controls only, which keep no state between particles
+            bool IsBatchable() const;
+
+            //calculates one step for each of the given particles. particles sharing mass, charge and field calculators
+            //with the first one are advanced together, the others, steps rejected by a control and all particles of a
+            //trajectory which is not batchable go through CalculateTrajectory one by one. afterwards the internal state
+            //refers to the last particle handled by CalculateTrajectory, so a particle which needs ExecuteTrajectory
+            //or GetPiecewiseLinearApproximation has to be recalculated with CalculateTrajectory first.
+            void CalculateTrajectories( const std::vector< KSParticle >& anInitialParticles, std::vector< KSParticle >& aFinalParticles, std::vector< KThreeVector >& aCenters, std::vector< double >& aRadii, std::vector< double >& aTimeSteps );
+
             //********************
             //ExactTrapped term interface
             //********************
@@ -65,6 +93,23 @@ namespace Kassiopeia
         public:
             virtual void Differentiate(double aTime, const KSTrajExactTrappedParticle& aValue, KSTrajExactTrappedDerivative& aDerivative ) const;
 
+            //*************
+            //guiding center
+            //*************
+
+        public:
+            //cyclotron radius times the largest magnetic field gradient component over the field magnitude,
+            //the same gradient scale KSTrajControlBChange bounds the adiabatic step with
+            static double GetAdiabaticity( const KSTrajExactTrappedParticle& aParticle );
+
+        protected:
+            virtual void PullDeupdateComponent();
+            virtual void PushDeupdateComponent();
+
+            //variables for output
+            K_REFS( int, StepNRejections )
+            K_REFS( int, StepNIntegrations )
+
         private:
 
             KSTrajExactTrappedParticle fInitialParticle;
@@ -85,6 +130,20 @@ namespace Kassiopeia
 
             unsigned int fMaxAttempts;
 
+            //terms that may need field gradients, see Differentiate
+            KSList< KSTrajTermSynchrotron > fSynchrotronTerms;
+
+            //guiding center
+            KSTrajTrajectoryAdiabatic* fGuidingCenterTrajectory;
+            double fAdiabaticityLimit;
+            bool fGuidingCenterActive;
+
+            //lockstep batching
+            KSTrajExactTrappedBatch fBatch;
+            KSTrajExactTrappedParticle fBatchParticle;
+            std::vector< KSTrajExactTrappedParticle > fBatchParticles;
+            std::vector< unsigned int > fBatchIndices;
+            std::vector< double > fBatchSteps;
     };
 
 }
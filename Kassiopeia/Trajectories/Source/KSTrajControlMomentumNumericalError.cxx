@@ -9,8 +9,12 @@ namespace Kassiopeia
         fAbsoluteError(1e-12),
         fSafetyFactor(0.5),
         fSolverOrder(5),
+        fIntegralGain(1.),
+        fProportionalGain(0.),
         fTimeStep(1),
-        fFirstStep(true)
+        fFirstStep(true),
+        fPreviousError(1e-12),
+        fLastStepRejected(false)
     {
     }
 
@@ -19,8 +23,12 @@ namespace Kassiopeia
             fAbsoluteError(aCopy.fAbsoluteError),
             fSafetyFactor(aCopy.fSafetyFactor),
             fSolverOrder(aCopy.fSolverOrder),
+            fIntegralGain(aCopy.fIntegralGain),
+            fProportionalGain(aCopy.fProportionalGain),
             fTimeStep(aCopy.fTimeStep),
-            fFirstStep(aCopy.fFirstStep)
+            fFirstStep(aCopy.fFirstStep),
+            fPreviousError(aCopy.fPreviousError),
+            fLastStepRejected(aCopy.fLastStepRejected)
     {
         if(fSafetyFactor > 1.0){fSafetyFactor = 1.0/fSafetyFactor;};
     }
@@ -38,6 +46,8 @@ namespace Kassiopeia
     {
         if(fSafetyFactor > 1.0){fSafetyFactor = 1.0/fSafetyFactor;};
         fFirstStep = true;
+        fPreviousError = fAbsoluteError;
+        fLastStepRejected = false;
         trajmsg_debug( "stepsize momentum numerical error resetting, safety factor is <" <<fSafetyFactor <<"> " << eom );
         return;
     }
@@ -157,14 +167,23 @@ namespace Kassiopeia
                 //so we double the stepsize because the normal calculation
                 //for estimating the new stepsize may fail
                 fTimeStep *= 2;
+                fPreviousError = fEpsilon*fAbsoluteError;
+                fLastStepRejected = false;
 //                trajmsg_debug( "stepsize position numerical error increasing stepsize from <"<<fTimeStep<<"> to <"<<2*fTimeStep<<"> at position error <" << position_error_mag << ">" << eom) ;
                 return true; //aFlag, step succeeded
             }
 
             //time step is ok, local error does not exceed bounds
-            //estimate the next time step
-            double beta = error/std::pow(fTimeStep, fSolverOrder);
-            double updatedTimeStep = fSafetyFactor*std::pow( fAbsoluteError/beta , 1.0/fSolverOrder);
+            //estimate the next time step, with a non-zero proportional gain the
+            //error of the previous accepted step enters as well (PI control)
+            double updatedTimeStep = fSafetyFactor*fTimeStep*std::pow( fAbsoluteError/error, fIntegralGain/fSolverOrder )*std::pow( fPreviousError/fAbsoluteError, fProportionalGain/fSolverOrder );
+            if( fProportionalGain > 0. && fLastStepRejected == true && updatedTimeStep > fTimeStep )
+            {
+                //do not grow the step right after a rejection
+                updatedTimeStep = fTimeStep;
+            }
+            fPreviousError = error;
+            fLastStepRejected = false;
 //            trajmsg_debug( "stepsize position numerical error increasing stepsize from <"<<fTimeStep<<"> to <"<<updatedTimeStep<<"> at position error <" << position_error_mag << ">" << eom) ;
             fTimeStep = updatedTimeStep;
             return true; //aFlag, step succeeded
@@ -177,6 +196,7 @@ namespace Kassiopeia
             double updatedTimeStep = fSafetyFactor*std::pow( fAbsoluteError/beta , 1.0/fSolverOrder);
 //            trajmsg_debug( "stepsize position numerical error decreasing stepsize from <"<<fTimeStep<<"> to <"<<updatedTimeStep<<"> at position error <" << position_error_mag << ">" << eom) ;
             fTimeStep = updatedTimeStep;
+            fLastStepRejected = true;
             return false; //aFlag, step failed
         }
 
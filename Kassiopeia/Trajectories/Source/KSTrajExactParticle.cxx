@@ -50,7 +50,9 @@ namespace Kassiopeia
             fGetElectricFieldPtr( &KSTrajExactParticle::RecalculateElectricField ),
             fGetMagneticGradientPtr( &KSTrajExactParticle::RecalculateMagneticGradient ),
             fGetElectricPotentialPtr( &KSTrajExactParticle::RecalculateElectricPotential ),
-            fGetElectricGradientPtr( &KSTrajExactParticle::RecalculateElectricGradient )
+            fGetElectricGradientPtr( &KSTrajExactParticle::RecalculateElectricGradient ),
+
+            fStateStamp( 0 )
     {
     }
     KSTrajExactParticle::~KSTrajExactParticle()
@@ -65,10 +67,15 @@ namespace Kassiopeia
     {
         //trajmsg_debug( "exact particle pulling from particle:" << ret )
 
+        //fields cached by the particle can only be taken over if they come from the same calculators
+        bool tSameMagneticFieldCalculator = true;
+        bool tSameElectricFieldCalculator = true;
+
         if( fMagneticFieldCalculator != aParticle.GetMagneticFieldCalculator() )
         {
             //trajmsg_debug( "  magnetic calculator differs" << ret )
             fMagneticFieldCalculator = aParticle.GetMagneticFieldCalculator();
+            tSameMagneticFieldCalculator = false;
 
             fGetMagneticFieldPtr = &KSTrajExactParticle::RecalculateMagneticField;
             fGetMagneticGradientPtr = &KSTrajExactParticle::RecalculateMagneticGradient;
@@ -78,6 +85,7 @@ namespace Kassiopeia
         {
             //trajmsg_debug( "  electric calculator differs" << ret )
             fElectricFieldCalculator = aParticle.GetElectricFieldCalculator();
+            tSameElectricFieldCalculator = false;
 
             fGetElectricFieldPtr = &KSTrajExactParticle::RecalculateElectricField;
             fGetElectricPotentialPtr = &KSTrajExactParticle::RecalculateElectricPotential;
@@ -96,6 +104,13 @@ namespace Kassiopeia
             fCharge = aParticle.GetCharge();
         }
 
+        //the particle still carries the state this particle pushed to it, so it is already in sync
+        if( fStateStamp != 0 && fStateStamp == aParticle.GetStateStamp() && tSameMagneticFieldCalculator == true && tSameElectricFieldCalculator == true )
+        {
+            return;
+        }
+        fStateStamp = 0;
+
         if( GetTime() != aParticle.GetTime() || GetPosition() != aParticle.GetPosition() )
         {
             //trajmsg_debug( "  time or position differs" << ret )
@@ -110,10 +125,43 @@ namespace Kassiopeia
             fData[ 3 ] = fPosition.Y();
             fData[ 4 ] = fPosition.Z();
 
-            fGetMagneticFieldPtr = &KSTrajExactParticle::RecalculateMagneticField;
-            fGetElectricFieldPtr = &KSTrajExactParticle::RecalculateElectricField;
-            fGetMagneticGradientPtr = &KSTrajExactParticle::RecalculateMagneticGradient;
-            fGetElectricPotentialPtr = &KSTrajExactParticle::RecalculateElectricPotential;
+            //take over what the particle already carries for the new point instead of recalculating it
+            if( tSameMagneticFieldCalculator == true && aParticle.HasMagneticField() == true )
+            {
+                fMagneticField = aParticle.GetMagneticField();
+                fGetMagneticFieldPtr = &KSTrajExactParticle::DoNothing;
+            }
+            else
+            {
+                fGetMagneticFieldPtr = &KSTrajExactParticle::RecalculateMagneticField;
+            }
+            if( tSameMagneticFieldCalculator == true && aParticle.HasMagneticGradient() == true )
+            {
+                fMagneticGradient = aParticle.GetMagneticGradient();
+                fGetMagneticGradientPtr = &KSTrajExactParticle::DoNothing;
+            }
+            else
+            {
+                fGetMagneticGradientPtr = &KSTrajExactParticle::RecalculateMagneticGradient;
+            }
+            if( tSameElectricFieldCalculator == true && aParticle.HasElectricField() == true )
+            {
+                fElectricField = aParticle.GetElectricField();
+                fGetElectricFieldPtr = &KSTrajExactParticle::DoNothing;
+            }
+            else
+            {
+                fGetElectricFieldPtr = &KSTrajExactParticle::RecalculateElectricField;
+            }
+            if( tSameElectricFieldCalculator == true && aParticle.HasElectricPotential() == true )
+            {
+                fElectricPotential = aParticle.GetElectricPotential();
+                fGetElectricPotentialPtr = &KSTrajExactParticle::DoNothing;
+            }
+            else
+            {
+                fGetElectricPotentialPtr = &KSTrajExactParticle::RecalculateElectricPotential;
+            }
             fGetElectricGradientPtr = &KSTrajExactParticle::RecalculateElectricGradient;
         }
 
@@ -139,10 +187,7 @@ namespace Kassiopeia
         //trajmsg_debug( "exact particle pushing to particle:" << eom )
 
 
-        aParticle.SetLength( GetLength() );
-        aParticle.SetPosition( GetPosition() );
-        aParticle.SetMomentum( GetMomentum() );
-        aParticle.SetTime( GetTime() );
+        aParticle.SetPhaseSpace( GetTime(), GetLength(), GetPosition(), GetMomentum() );
 
         if( fGetMagneticFieldPtr == &KSTrajExactParticle::DoNothing )
         {
@@ -161,6 +206,13 @@ namespace Kassiopeia
             aParticle.SetElectricPotential( GetElectricPotential() );
         }
 
+        //the stamp goes last, the setters above clear it
+        if( fStateStamp == 0 )
+        {
+            fStateStamp = KSParticle::NewStateStamp();
+        }
+        aParticle.SetStateStamp( fStateStamp );
+
         //trajmsg_debug( "  time: <" << GetTime() << ">" << eom )
         //trajmsg_debug( "  length: <" << GetLength() << ">" << eom )
         //trajmsg_debug( "  position: <" << GetPosition().X() << ", " << GetPosition().Y() << ", " << GetPosition().Z() << ">" << eom )
@@ -283,6 +335,33 @@ namespace Kassiopeia
         return fElectricPotential;
     }
 
+    const std::pair< const KThreeVector&, const KThreeMatrix& > KSTrajExactParticle::GetMagneticFieldAndGradient() const
+    {
+        if( fGetMagneticFieldPtr != &KSTrajExactParticle::DoNothing && fGetMagneticGradientPtr != &KSTrajExactParticle::DoNothing )
+        {
+            RecalculateMagneticFieldAndGradient();
+        }
+        else
+        {
+            (this->*fGetMagneticFieldPtr)();
+            (this->*fGetMagneticGradientPtr)();
+        }
+        return std::pair< const KThreeVector&, const KThreeMatrix& >( fMagneticField, fMagneticGradient );
+    }
+    const std::pair< const KThreeVector&, const KThreeMatrix& > KSTrajExactParticle::GetElectricFieldAndGradient() const
+    {
+        if( fGetElectricFieldPtr != &KSTrajExactParticle::DoNothing && fGetElectricGradientPtr != &KSTrajExactParticle::DoNothing )
+        {
+            RecalculateElectricFieldAndGradient();
+        }
+        else
+        {
+            (this->*fGetElectricFieldPtr)();
+            (this->*fGetElectricGradientPtr)();
+        }
+        return std::pair< const KThreeVector&, const KThreeMatrix& >( fElectricField, fElectricGradient );
+    }
+
     const KThreeVector& KSTrajExactParticle::GetGuidingCenter() const
     {
         fGuidingCenter = GetPosition() + (1. / (GetCharge() * GetMagneticField().MagnitudeSquared())) * (GetMomentum().Cross( GetMagneticField() ));
@@ -357,5 +436,19 @@ namespace Kassiopeia
         fGetElectricPotentialPtr = &KSTrajExactParticle::DoNothing;
         return;
     }
+    void KSTrajExactParticle::RecalculateMagneticFieldAndGradient() const
+    {
+        fMagneticFieldCalculator->CalculateFieldAndGradient( GetPosition(), GetTime(), fMagneticField, fMagneticGradient );
+        fGetMagneticFieldPtr = &KSTrajExactParticle::DoNothing;
+        fGetMagneticGradientPtr = &KSTrajExactParticle::DoNothing;
+        return;
+    }
+    void KSTrajExactParticle::RecalculateElectricFieldAndGradient() const
+    {
+        fElectricFieldCalculator->CalculateFieldAndGradient( GetPosition(), GetTime(), fElectricField, fElectricGradient );
+        fGetElectricFieldPtr = &KSTrajExactParticle::DoNothing;
+        fGetElectricGradientPtr = &KSTrajExactParticle::DoNothing;
+        return;
+    }
 
 }
@@ -0,0 +1,220 @@
+#include "KSTrajExactTrappedBatch.h"
+#include "KSTrajExactTrappedTypes.h"
+#include "KSMathSym4.h"
+
+#include "KConst.h"
+using katrin::KConst;
+
+#include <cmath>
+
+namespace Kassiopeia
+{
+
+    KSTrajExactTrappedBatch::KSTrajExactTrappedBatch() :
+            fNLanes( 0 ),
+            fTime(),
+            fLength(),
+            fX(),
+            fY(),
+            fZ(),
+            fPX(),
+            fPY(),
+            fPZ(),
+            fSamplePoints(),
+            fSampleTimes(),
+            fMagneticFields(),
+            fElectricFields()
+    {
+    }
+    KSTrajExactTrappedBatch::~KSTrajExactTrappedBatch()
+    {
+    }
+
+    void KSTrajExactTrappedBatch::SetNumberOfLanes( const unsigned int& aNumber )
+    {
+        fNLanes = aNumber;
+        fTime.resize( fNLanes );
+        fLength.resize( fNLanes );
+        fX.resize( fNLanes );
+        fY.resize( fNLanes );
+        fZ.resize( fNLanes );
+        fPX.resize( fNLanes );
+        fPY.resize( fNLanes );
+        fPZ.resize( fNLanes );
+        fSamplePoints.resize( fNLanes );
+        fSampleTimes.resize( fNLanes );
+        return;
+    }
+    unsigned int KSTrajExactTrappedBatch::GetNumberOfLanes() const
+    {
+        return fNLanes;
+    }
+
+    void KSTrajExactTrappedBatch::PullFrom( const unsigned int& aLane, const KSTrajExactTrappedParticle& aParticle )
+    {
+        fTime[ aLane ] = aParticle[ 0 ];
+        fLength[ aLane ] = aParticle[ 1 ];
+        fX[ aLane ] = aParticle[ 2 ];
+        fY[ aLane ] = aParticle[ 3 ];
+        fZ[ aLane ] = aParticle[ 4 ];
+        fPX[ aLane ] = aParticle[ 5 ];
+        fPY[ aLane ] = aParticle[ 6 ];
+        fPZ[ aLane ] = aParticle[ 7 ];
+        return;
+    }
+    void KSTrajExactTrappedBatch::PushTo( const unsigned int& aLane, KSTrajExactTrappedParticle& aParticle ) const
+    {
+        //assigning a whole array invalidates the cached fields of the particle
+        KSMathArray< 8 > tValue;
+        tValue[ 0 ] = fTime[ aLane ];
+        tValue[ 1 ] = fLength[ aLane ];
+        tValue[ 2 ] = fX[ aLane ];
+        tValue[ 3 ] = fY[ aLane ];
+        tValue[ 4 ] = fZ[ aLane ];
+        tValue[ 5 ] = fPX[ aLane ];
+        tValue[ 6 ] = fPY[ aLane ];
+        tValue[ 7 ] = fPZ[ aLane ];
+        aParticle = tValue;
+        return;
+    }
+
+    void KSTrajExactTrappedBatch::IntegrateSym4( const std::vector< double >& aTimeSteps )
+    {
+        const double* tT = KSMathSym4< KSTrajExactTrappedSystem >::GetPositionCoefficients();
+        const double* tV = KSMathSym4< KSTrajExactTrappedSystem >::GetMomentumCoefficients();
+
+        //same stage sequence as KSMathSym4::Integrate
+        PositionStage( tT[ 2 ], aTimeSteps );
+        MomentumStage( tV[ 2 ], aTimeSteps );
+        PositionStage( tT[ 1 ], aTimeSteps );
+        MomentumStage( tV[ 1 ], aTimeSteps );
+        PositionStage( tT[ 0 ], aTimeSteps );
+        MomentumStage( tV[ 1 ], aTimeSteps );
+        PositionStage( tT[ 1 ], aTimeSteps );
+        MomentumStage( tV[ 2 ], aTimeSteps );
+        PositionStage( tT[ 2 ], aTimeSteps );
+
+        return;
+    }
+
+    void KSTrajExactTrappedBatch::PositionStage( const double& aCoefficient, const std::vector< double >& aTimeSteps )
+    {
+        const double tMass = KSTrajExactTrappedParticle::GetMass();
+        const double tMassFactor = tMass * tMass * KConst::C() * KConst::C();
+
+        for( unsigned int tLane = 0; tLane < fNLanes; tLane++ )
+        {
+            double tStep = aCoefficient * aTimeSteps[ tLane ];
+
+            double tMomentum2 = fPX[ tLane ] * fPX[ tLane ] + fPY[ tLane ] * fPY[ tLane ] + fPZ[ tLane ] * fPZ[ tLane ];
+            double tLorentzFactor = sqrt( 1. + tMomentum2 / tMassFactor );
+            double tInverse = 1. / (tMass * tLorentzFactor);
+            double tVX = tInverse * fPX[ tLane ];
+            double tVY = tInverse * fPY[ tLane ];
+            double tVZ = tInverse * fPZ[ tLane ];
+            double tSpeed = sqrt( tVX * tVX + tVY * tVY + tVZ * tVZ );
+
+            fTime[ tLane ] += tStep * 1.;
+            fLength[ tLane ] += tStep * tSpeed;
+            fX[ tLane ] += tStep * tVX;
+            fY[ tLane ] += tStep * tVY;
+            fZ[ tLane ] += tStep * tVZ;
+        }
+        return;
+    }
+
+    void KSTrajExactTrappedBatch::MomentumStage( const double& aCoefficient, const std::vector< double >& aTimeSteps )
+    {
+        for( unsigned int tLane = 0; tLane < fNLanes; tLane++ )
+        {
+            fSamplePoints[ tLane ].SetComponents( fX[ tLane ], fY[ tLane ], fZ[ tLane ] );
+            fSampleTimes[ tLane ] = fTime[ tLane ];
+        }
+        KSTrajExactTrappedParticle::GetMagneticFieldCalculator()->CalculateFields( fSamplePoints, fSampleTimes, fMagneticFields );
+        KSTrajExactTrappedParticle::GetElectricFieldCalculator()->CalculateFields( fSamplePoints, fSampleTimes, fElectricFields );
+
+        const double tMass = KSTrajExactTrappedParticle::GetMass();
+        const double tCharge = KSTrajExactTrappedParticle::GetCharge();
+        const double tMassFactor = tMass * tMass * KConst::C() * KConst::C();
+
+        for( unsigned int tLane = 0; tLane < fNLanes; tLane++ )
+        {
+            double tStep = aCoefficient * aTimeSteps[ tLane ];
+
+            double tPX = fPX[ tLane ];
+            double tPY = fPY[ tLane ];
+            double tPZ = fPZ[ tLane ];
+            double tMomentum2 = tPX * tPX + tPY * tPY + tPZ * tPZ;
+            double tLorentzFactor = sqrt( 1. + tMomentum2 / tMassFactor );
+            double tInverse = 1. / (tMass * tLorentzFactor);
+            double tVX = tInverse * tPX;
+            double tVY = tInverse * tPY;
+            double tVZ = tInverse * tPZ;
+            double tSpeed = sqrt( tVX * tVX + tVY * tVY + tVZ * tVZ );
+
+            fTime[ tLane ] += tStep * 1.;
+            fLength[ tLane ] += tStep * tSpeed;
+
+            if( tStep == 0. )
+            {
+                //a vanishing stage degenerates to a position update, as in KSTrajTermPropagation
+                fX[ tLane ] += tStep * tVX;
+                fY[ tLane ] += tStep * tVY;
+                fZ[ tLane ] += tStep * tVZ;
+                continue;
+            }
+
+            //exact rotation about the magnetic field plus the electric kick, see KSTrajTermPropagation
+            const KThreeVector& tMagneticField = fMagneticFields[ tLane ];
+            const KThreeVector& tElectricField = fElectricFields[ tLane ];
+            double tBX = tMagneticField[ 0 ];
+            double tBY = tMagneticField[ 1 ];
+            double tBZ = tMagneticField[ 2 ];
+            double tB = sqrt( tBX * tBX + tBY * tBY + tBZ * tBZ );
+            if( tB > 0. )
+            {
+                tBX = tBX / tB;
+                tBY = tBY / tB;
+                tBZ = tBZ / tB;
+            }
+
+            double tTheta = tCharge * tB * tStep / (tLorentzFactor * tMass);
+            double tSin = sin( tTheta );
+            double tCos = cos( tTheta );
+
+            double tCX = tBY * tPZ - tBZ * tPY;
+            double tCY = tBZ * tPX - tBX * tPZ;
+            double tCZ = tBX * tPY - tBY * tPX;
+            double tCCX = tBY * tCZ - tBZ * tCY;
+            double tCCY = tBZ * tCX - tBX * tCZ;
+            double tCCZ = tBX * tCY - tBY * tCX;
+            double tMX = -tSin * tCX + (1.0 - tCos) * tCCX;
+            double tMY = -tSin * tCY + (1.0 - tCos) * tCCY;
+            double tMZ = -tSin * tCZ + (1.0 - tCos) * tCCZ;
+
+            double tEX = tElectricField[ 0 ] * tCharge * tStep * tLorentzFactor;
+            double tEY = tElectricField[ 1 ] * tCharge * tStep * tLorentzFactor;
+            double tEZ = tElectricField[ 2 ] * tCharge * tStep * tLorentzFactor;
+            if( tTheta != 0 )
+            {
+                double tA = -(1.0 - tCos) / tTheta;
+                double tC = 1.0 - tSin / tTheta;
+                double tDX = tBY * tEZ - tBZ * tEY;
+                double tDY = tBZ * tEX - tBX * tEZ;
+                double tDZ = tBX * tEY - tBY * tEX;
+                double tDDX = tBY * tDZ - tBZ * tDY;
+                double tDDY = tBZ * tDX - tBX * tDZ;
+                double tDDZ = tBX * tDY - tBY * tDX;
+                tEX += tA * tDX + tC * tDDX;
+                tEY += tA * tDY + tC * tDDY;
+                tEZ += tA * tDZ + tC * tDDZ;
+            }
+
+            fPX[ tLane ] += tStep * ((tMX + tEX) / tStep);
+            fPY[ tLane ] += tStep * ((tMY + tEY) / tStep);
+            fPZ[ tLane ] += tStep * ((tMZ + tEZ) / tStep);
+        }
+        return;
+    }
+
+}
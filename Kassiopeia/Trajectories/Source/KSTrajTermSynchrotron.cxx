@@ -151,6 +151,16 @@ namespace Kassiopeia
         return;
     }
 
+    bool KSTrajTermSynchrotron::UsesFieldGradients( double /*aTime*/, const KSTrajExactParticle& /*aParticle*/ ) const
+    {
+        return !fOldMethode;
+    }
+    bool KSTrajTermSynchrotron::UsesFieldGradients( double aTime, const KSTrajExactTrappedParticle& /*aParticle*/ ) const
+    {
+        //the exact trapped differentiation skips the stages at zero time
+        return (aTime != 0.) && !fOldMethode;
+    }
+
     void KSTrajTermSynchrotron::SetEnhancement( const double& anEnhancement )
     {
         fEnhancement = anEnhancement;
@@ -164,7 +164,7 @@ namespace Kassiopeia
 
             trajmsg_debug( "  time step: <" << tSmallestStep << ">" << eom );
 
-            if(!tFlag){fIntegrator->ClearState();};
+            if(!tFlag){fIntegrator->RewindState();};
             fIntegrator->Integrate( currentTime, *this, fInitialParticle, tSmallestStep, fFinalParticle, fError );
 
             if(fAbortSignal)
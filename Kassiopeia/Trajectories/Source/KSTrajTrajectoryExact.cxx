@@ -1,5 +1,6 @@
 #include "KSTrajTrajectoryExact.h"
 #include "KSTrajectoriesMessage.h"
+#include "KSTrajTermSynchrotron.h"
 
 #include "KConst.h"
 
@@ -12,6 +13,8 @@ namespace Kassiopeia
 {
 
     KSTrajTrajectoryExact::KSTrajTrajectoryExact() :
+            fStepNRejections( 0 ),
+            fStepNIntegrations( 0 ),
             fInitialParticle(),
             fIntermediateParticle(),
             fFinalParticle(),
@@ -22,11 +25,14 @@ namespace Kassiopeia
             fControls(),
             fPiecewiseTolerance(1e-9),
             fNMaxSegments(1),
-            fMaxAttempts(32)
+            fMaxAttempts(32),
+            fSynchrotronTerms()
     {
     }
     KSTrajTrajectoryExact::KSTrajTrajectoryExact( const KSTrajTrajectoryExact& aCopy ) :
             KSComponent(),
+            fStepNRejections( 0 ),
+            fStepNIntegrations( 0 ),
             fInitialParticle( aCopy.fInitialParticle ),
             fIntermediateParticle( aCopy.fIntermediateParticle ),
             fFinalParticle( aCopy.fFinalParticle ),
@@ -37,7 +43,8 @@ namespace Kassiopeia
             fControls( aCopy.fControls ),
             fPiecewiseTolerance( aCopy.fPiecewiseTolerance ),
             fNMaxSegments( aCopy.fNMaxSegments ),
-            fMaxAttempts( aCopy.fMaxAttempts )
+            fMaxAttempts( aCopy.fMaxAttempts ),
+            fSynchrotronTerms( aCopy.fSynchrotronTerms )
     {
     }
     KSTrajTrajectoryExact* KSTrajTrajectoryExact::Clone() const
@@ -95,6 +102,11 @@ namespace Kassiopeia
     {
         if( fTerms.AddElement( aTerm ) != -1 )
         {
+            KSTrajTermSynchrotron* tSynchrotron = dynamic_cast< KSTrajTermSynchrotron* >( aTerm );
+            if( tSynchrotron != NULL )
+            {
+                fSynchrotronTerms.AddElement( tSynchrotron );
+            }
             return;
         }
         trajmsg( eError ) << "cannot add term <" << aTerm << "> to <" << this->GetName() << ">" << eom;
@@ -104,6 +116,11 @@ namespace Kassiopeia
     {
         if( fTerms.RemoveElement( aTerm ) != -1 )
         {
+            KSTrajTermSynchrotron* tSynchrotron = dynamic_cast< KSTrajTermSynchrotron* >( aTerm );
+            if( tSynchrotron != NULL )
+            {
+                fSynchrotronTerms.RemoveElement( tSynchrotron );
+            }
             return;
         }
         trajmsg( eError ) << "cannot remove term <" << aTerm << "> from <" << this->GetName() << ">" << eom;
@@ -144,6 +161,9 @@ namespace Kassiopeia
         fInitialParticle.PullFrom( anInitialParticle );
         double currentTime = fInitialParticle.GetTime();
 
+        fStepNRejections = 0;
+        fStepNIntegrations = 0;
+
         trajmsg_debug( "exact trajectory integrating:" << eom );
 
         bool tFlag = true;
@@ -164,8 +184,10 @@ namespace Kassiopeia
 
             trajmsg_debug( "  time step: <" << tSmallestStep << ">" << eom );
 
-            if(!tFlag){fIntegrator->ClearState();};
+            //a retry starts from the same initial value, so the integrator may keep its derivative there
+            if(!tFlag){fIntegrator->RewindState();};
             fIntegrator->Integrate( currentTime, *this, fInitialParticle, tSmallestStep, fFinalParticle, fError );
+            fStepNIntegrations++;
 
             if(fAbortSignal)
             {
@@ -183,6 +205,7 @@ namespace Kassiopeia
                 fControls.ElementAt( tIndex )->Check( fInitialParticle, fFinalParticle, fError, tFlag );
                 if( tFlag == false )
                 {
+                    fStepNRejections++;
                     double tCurrentStep = tSmallestStep;
                     fControls.ElementAt( tIndex )->Calculate( fInitialParticle, tSmallestStep );
                     if ( fabs( tCurrentStep - tSmallestStep ) < sMinimalStep )
@@ -295,6 +318,18 @@ namespace Kassiopeia
 
     void KSTrajTrajectoryExact::Differentiate(double aTime, const KSTrajExactParticle& aValue, KSTrajExactDerivative& aDerivative ) const
     {
+        for( int tIndex = 0; tIndex < fSynchrotronTerms.End(); tIndex++ )
+        {
+            if( fSynchrotronTerms.ElementAt( tIndex )->UsesFieldGradients( aTime, aValue ) == true )
+            {
+                //force the cached calculation of the fields together with their gradients
+                //(otherwise the propagation term calculates the fields single and the synchrotron term the gradients later)
+                aValue.GetMagneticFieldAndGradient();
+                aValue.GetElectricFieldAndGradient();
+                break;
+            }
+        }
+
         KThreeVector tVelocity = aValue.GetVelocity();
 
         aDerivative = 0.;
@@ -309,10 +344,24 @@ namespace Kassiopeia
         return;
     }
 
+    void KSTrajTrajectoryExact::PullDeupdateComponent()
+    {
+        fStepNRejections = 0;
+        fStepNIntegrations = 0;
+    }
+
+    void KSTrajTrajectoryExact::PushDeupdateComponent()
+    {
+        fStepNRejections = 0;
+        fStepNIntegrations = 0;
+    }
+
     STATICINT sKSTrajTrajectoryExactDict =
         KSDictionary< KSTrajTrajectoryExact >::AddCommand( &KSTrajTrajectoryExact::SetIntegrator, &KSTrajTrajectoryExact::ClearIntegrator, "set_integrator", "clear_integrator" ) +
         KSDictionary< KSTrajTrajectoryExact >::AddCommand( &KSTrajTrajectoryExact::SetInterpolator, &KSTrajTrajectoryExact::ClearInterpolator, "set_interpolator", "clear_interpolator" ) +
         KSDictionary< KSTrajTrajectoryExact >::AddCommand( &KSTrajTrajectoryExact::AddTerm, &KSTrajTrajectoryExact::RemoveTerm, "add_term", "remove_term" ) +
-        KSDictionary< KSTrajTrajectoryExact >::AddCommand( &KSTrajTrajectoryExact::AddControl, &KSTrajTrajectoryExact::RemoveControl, "add_control", "remove_control" );
+        KSDictionary< KSTrajTrajectoryExact >::AddCommand( &KSTrajTrajectoryExact::AddControl, &KSTrajTrajectoryExact::RemoveControl, "add_control", "remove_control" ) +
+        KSDictionary< KSTrajTrajectoryExact >::AddComponent( &KSTrajTrajectoryExact::GetStepNRejections, "step_number_of_rejections" ) +
+        KSDictionary< KSTrajTrajectoryExact >::AddComponent( &KSTrajTrajectoryExact::GetStepNIntegrations, "step_number_of_integrations" );
 
 }
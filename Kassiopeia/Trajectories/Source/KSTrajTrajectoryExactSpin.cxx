@@ -12,6 +12,8 @@ namespace Kassiopeia
 {
 
     KSTrajTrajectoryExactSpin::KSTrajTrajectoryExactSpin() :
+            fStepNRejections( 0 ),
+            fStepNIntegrations( 0 ),
             fInitialParticle(),
             fIntermediateParticle(),
             fFinalParticle(),
@@ -27,6 +29,8 @@ namespace Kassiopeia
     }
     KSTrajTrajectoryExactSpin::KSTrajTrajectoryExactSpin( const KSTrajTrajectoryExactSpin& aCopy ) :
             KSComponent(),
+            fStepNRejections( 0 ),
+            fStepNIntegrations( 0 ),
             fInitialParticle( aCopy.fInitialParticle ),
             fIntermediateParticle( aCopy.fIntermediateParticle ),
             fFinalParticle( aCopy.fFinalParticle ),
@@ -147,6 +151,9 @@ namespace Kassiopeia
         fInitialParticle.PullFrom( anInitialParticle );
         double currentTime = fInitialParticle.GetTime();
 
+        fStepNRejections = 0;
+        fStepNIntegrations = 0;
+
         trajmsg_debug( "ExactSpin trajectory integrating:" << eom );
 
         bool tFlag = true;
@@ -167,8 +174,10 @@ namespace Kassiopeia
 
             trajmsg_debug( "  time step: <" << tSmallestStep << ">" << eom );
 
-            if(!tFlag){fIntegrator->ClearState();};
+            //a retry starts from the same initial value, so the integrator may keep its derivative there
+            if(!tFlag){fIntegrator->RewindState();};
             fIntegrator->Integrate( currentTime, *this, fInitialParticle, tSmallestStep, fFinalParticle, fError );
+            fStepNIntegrations++;
 
             if(fAbortSignal)
             {
@@ -186,6 +195,7 @@ namespace Kassiopeia
                 fControls.ElementAt( tIndex )->Check( fInitialParticle, fFinalParticle, fError, tFlag );
                 if( tFlag == false )
                 {
+                    fStepNRejections++;
                     double tCurrentStep = tSmallestStep;
                     fControls.ElementAt( tIndex )->Calculate( fInitialParticle, tSmallestStep );
                     if ( fabs( tCurrentStep - tSmallestStep ) < sMinimalStep )
@@ -319,10 +329,24 @@ namespace Kassiopeia
         return;
     }
 
+    void KSTrajTrajectoryExactSpin::PullDeupdateComponent()
+    {
+        fStepNRejections = 0;
+        fStepNIntegrations = 0;
+    }
+
+    void KSTrajTrajectoryExactSpin::PushDeupdateComponent()
+    {
+        fStepNRejections = 0;
+        fStepNIntegrations = 0;
+    }
+
     STATICINT sKSTrajTrajectoryExactSpinDict =
         KSDictionary< KSTrajTrajectoryExactSpin >::AddCommand( &KSTrajTrajectoryExactSpin::SetIntegrator, &KSTrajTrajectoryExactSpin::ClearIntegrator, "set_integrator", "clear_integrator" ) +
         KSDictionary< KSTrajTrajectoryExactSpin >::AddCommand( &KSTrajTrajectoryExactSpin::SetInterpolator, &KSTrajTrajectoryExactSpin::ClearInterpolator, "set_interpolator", "clear_interpolator" ) +
         KSDictionary< KSTrajTrajectoryExactSpin >::AddCommand( &KSTrajTrajectoryExactSpin::AddTerm, &KSTrajTrajectoryExactSpin::RemoveTerm, "add_term", "remove_term" ) +
-        KSDictionary< KSTrajTrajectoryExactSpin >::AddCommand( &KSTrajTrajectoryExactSpin::AddControl, &KSTrajTrajectoryExactSpin::RemoveControl, "add_control", "remove_control" );
+        KSDictionary< KSTrajTrajectoryExactSpin >::AddCommand( &KSTrajTrajectoryExactSpin::AddControl, &KSTrajTrajectoryExactSpin::RemoveControl, "add_control", "remove_control" ) +
+        KSDictionary< KSTrajTrajectoryExactSpin >::AddComponent( &KSTrajTrajectoryExactSpin::GetStepNRejections, "step_number_of_rejections" ) +
+        KSDictionary< KSTrajTrajectoryExactSpin >::AddComponent( &KSTrajTrajectoryExactSpin::GetStepNIntegrations, "step_number_of_integrations" );
 
 }
@@ -1,5 +1,10 @@
 #include "KSTrajTrajectoryExactTrapped.h"
 #include "KSTrajectoriesMessage.h"
+#include "KSTrajTermSynchrotron.h"
+#include "KSTrajIntegratorSym4.h"
+#include "KSTrajTermPropagation.h"
+#include "KSTrajControlTime.h"
+#include "KSTrajControlLength.h"
 
 #include "KConst.h"
 
@@ -12,6 +17,8 @@ namespace Kassiopeia
 {
 
     KSTrajTrajectoryExactTrapped::KSTrajTrajectoryExactTrapped() :
+            fStepNRejections( 0 ),
+            fStepNIntegrations( 0 ),
             fInitialParticle(),
             fIntermediateParticle(),
             fFinalParticle(),
@@ -22,11 +29,22 @@ namespace Kassiopeia
             fControls(),
             fPiecewiseTolerance(1e-9),
             fNMaxSegments(1),
-            fMaxAttempts(32)
+            fMaxAttempts(32),
+            fSynchrotronTerms(),
+            fGuidingCenterTrajectory( NULL ),
+            fAdiabaticityLimit( 1.e-3 ),
+            fGuidingCenterActive( false ),
+            fBatch(),
+            fBatchParticle(),
+            fBatchParticles(),
+            fBatchIndices(),
+            fBatchSteps()
     {
     }
     KSTrajTrajectoryExactTrapped::KSTrajTrajectoryExactTrapped( const KSTrajTrajectoryExactTrapped& aCopy ) :
             KSComponent(),
+            fStepNRejections( 0 ),
+            fStepNIntegrations( 0 ),
             fInitialParticle( aCopy.fInitialParticle ),
             fIntermediateParticle( aCopy.fIntermediateParticle ),
             fFinalParticle( aCopy.fFinalParticle ),
@@ -37,7 +55,16 @@ namespace Kassiopeia
             fControls( aCopy.fControls ),
             fPiecewiseTolerance( aCopy.fPiecewiseTolerance ),
             fNMaxSegments( aCopy.fNMaxSegments ),
-            fMaxAttempts( aCopy.fMaxAttempts )
+            fMaxAttempts( aCopy.fMaxAttempts ),
+            fSynchrotronTerms( aCopy.fSynchrotronTerms ),
+            fGuidingCenterTrajectory( aCopy.fGuidingCenterTrajectory ),
+            fAdiabaticityLimit( aCopy.fAdiabaticityLimit ),
+            fGuidingCenterActive( false ),
+            fBatch(),
+            fBatchParticle(),
+            fBatchParticles(),
+            fBatchIndices(),
+            fBatchSteps()
     {
     }
     KSTrajTrajectoryExactTrapped* KSTrajTrajectoryExactTrapped::Clone() const
@@ -95,6 +122,11 @@ namespace Kassiopeia
     {
         if( fTerms.AddElement( aTerm ) != -1 )
         {
+            KSTrajTermSynchrotron* tSynchrotron = dynamic_cast< KSTrajTermSynchrotron* >( aTerm );
+            if( tSynchrotron != NULL )
+            {
+                fSynchrotronTerms.AddElement( tSynchrotron );
+            }
             return;
         }
         trajmsg( eError ) << "cannot add term <" << aTerm << "> to <" << this->GetName() << ">" << eom;
@@ -104,6 +136,11 @@ namespace Kassiopeia
     {
         if( fTerms.RemoveElement( aTerm ) != -1 )
         {
+            KSTrajTermSynchrotron* tSynchrotron = dynamic_cast< KSTrajTermSynchrotron* >( aTerm );
+            if( tSynchrotron != NULL )
+            {
+                fSynchrotronTerms.RemoveElement( tSynchrotron );
+            }
             return;
         }
         trajmsg( eError ) << "cannot remove term <" << aTerm << "> from <" << this->GetName() << ">" << eom;
@@ -129,9 +166,33 @@ namespace Kassiopeia
         return;
     }
 
+    void KSTrajTrajectoryExactTrapped::SetGuidingCenterTrajectory( KSTrajTrajectoryAdiabatic* aTrajectory )
+    {
+        if( fGuidingCenterTrajectory == NULL )
+        {
+            fGuidingCenterTrajectory = aTrajectory;
+            return;
+        }
+        trajmsg( eError ) << "cannot set guiding center trajectory in <" << this->GetName() << "> with <" << aTrajectory << ">" << eom;
+        return;
+    }
+    void KSTrajTrajectoryExactTrapped::ClearGuidingCenterTrajectory( KSTrajTrajectoryAdiabatic* aTrajectory )
+    {
+        if( fGuidingCenterTrajectory == aTrajectory )
+        {
+            fGuidingCenterTrajectory = NULL;
+            fGuidingCenterActive = false;
+            return;
+        }
+        trajmsg( eError ) << "cannot clear guiding center trajectory in <" << this->GetName() << "> with <" << aTrajectory << ">" << eom;
+        return;
+    }
+
     void KSTrajTrajectoryExactTrapped::Reset()
     {
         if(fIntegrator != NULL){ fIntegrator->ClearState(); }
+        if(fGuidingCenterTrajectory != NULL){ fGuidingCenterTrajectory->Reset(); }
+        fGuidingCenterActive = false;
         fInitialParticle = 0.0;
         fFinalParticle = 0.0;
     };
@@ -144,6 +205,33 @@ namespace Kassiopeia
         fInitialParticle.PullFrom( anInitialParticle );
         double currentTime = fInitialParticle.GetTime();
 
+        fStepNRejections = 0;
+        fStepNIntegrations = 0;
+
+        if( fGuidingCenterTrajectory != NULL )
+        {
+            //hand over to the guiding center trajectory while the field is slowly varying over a gyration,
+            //come back to the resolved gyration as soon as the adiabaticity limit is exceeded
+            double tAdiabaticity = GetAdiabaticity( fInitialParticle );
+            if( tAdiabaticity < fAdiabaticityLimit )
+            {
+                if( fGuidingCenterActive == false )
+                {
+                    trajmsg_debug( "ExactTrapped trajectory switching to guiding center at adiabaticity <" << tAdiabaticity << ">" << eom );
+                    fGuidingCenterTrajectory->Reset();
+                    fGuidingCenterActive = true;
+                }
+                fGuidingCenterTrajectory->CalculateTrajectory( anInitialParticle, aFinalParticle, aCenter, aRadius, aTimeStep );
+                return;
+            }
+            if( fGuidingCenterActive == true )
+            {
+                trajmsg_debug( "ExactTrapped trajectory switching to exact tracking at adiabaticity <" << tAdiabaticity << ">" << eom );
+                fIntegrator->ClearState();
+                fGuidingCenterActive = false;
+            }
+        }
+
         trajmsg_debug( "ExactTrapped trajectory integrating:" << eom );
 
         bool tFlag = true;
@@ -164,8 +252,10 @@ namespace Kassiopeia
 
             trajmsg_debug( "  time step: <" << tSmallestStep << ">" << eom );
 
-            if(!tFlag){fIntegrator->ClearState();};
+            //a retry starts from the same initial value, so the integrator may keep its derivative there
+            if(!tFlag){fIntegrator->RewindState();};
             fIntegrator->Integrate( currentTime, *this, fInitialParticle, tSmallestStep, fFinalParticle, fError );
+            fStepNIntegrations++;
 
             if(fAbortSignal)
             {
@@ -183,6 +273,7 @@ namespace Kassiopeia
                 fControls.ElementAt( tIndex )->Check( fInitialParticle, fFinalParticle, fError, tFlag );
                 if( tFlag == false )
                 {
+                    fStepNRejections++;
                     double tCurrentStep = tSmallestStep;
                     fControls.ElementAt( tIndex )->Calculate( fInitialParticle, tSmallestStep );
                     if ( fabs( tCurrentStep - tSmallestStep ) < sMinimalStep )
@@ -267,6 +358,12 @@ namespace Kassiopeia
 
     void KSTrajTrajectoryExactTrapped::ExecuteTrajectory( const double& aTimeStep, KSParticle& anIntermediateParticle ) const
     {
+        if( fGuidingCenterActive == true )
+        {
+            fGuidingCenterTrajectory->ExecuteTrajectory( aTimeStep, anIntermediateParticle );
+            return;
+        }
+
         double currentTime = anIntermediateParticle.GetTime();
         if( fInterpolator != NULL )
         {
@@ -282,8 +379,14 @@ namespace Kassiopeia
         }
     }
 
-    void KSTrajTrajectoryExactTrapped::GetPiecewiseLinearApproximation(const KSParticle& anInitialParticle, const KSParticle& /*aFinalParticle*/, std::vector< KSParticle >* intermediateParticleStates) const
+    void KSTrajTrajectoryExactTrapped::GetPiecewiseLinearApproximation(const KSParticle& anInitialParticle, const KSParticle& aFinalParticle, std::vector< KSParticle >* intermediateParticleStates) const
     {
+        if( fGuidingCenterActive == true )
+        {
+            fGuidingCenterTrajectory->GetPiecewiseLinearApproximation( anInitialParticle, aFinalParticle, intermediateParticleStates );
+            return;
+        }
+
         intermediateParticleStates->clear();
         for(unsigned int i=0; i<fIntermediateParticleStates.size(); i++)
         {
@@ -293,8 +396,151 @@ namespace Kassiopeia
         }
     }
 
+    bool KSTrajTrajectoryExactTrapped::IsBatchable() const
+    {
+        if( fInterpolator != NULL || fGuidingCenterTrajectory != NULL || dynamic_cast< KSTrajIntegratorSym4* >( fIntegrator ) == NULL )
+        {
+            return false;
+        }
+        for( int tIndex = 0; tIndex < fTerms.End(); tIndex++ )
+        {
+            if( dynamic_cast< KSTrajTermPropagation* >( fTerms.ElementAt( tIndex ) ) == NULL )
+            {
+                return false;
+            }
+        }
+        for( int tIndex = 0; tIndex < fControls.End(); tIndex++ )
+        {
+            if( dynamic_cast< KSTrajControlTime* >( fControls.ElementAt( tIndex ) ) == NULL && dynamic_cast< KSTrajControlLength* >( fControls.ElementAt( tIndex ) ) == NULL )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void KSTrajTrajectoryExactTrapped::CalculateTrajectories( const std::vector< KSParticle >& anInitialParticles, std::vector< KSParticle >& aFinalParticles, std::vector< KThreeVector >& aCenters, std::vector< double >& aRadii, std::vector< double >& aTimeSteps )
+    {
+        unsigned int tCount = anInitialParticles.size();
+        aFinalParticles = anInitialParticles;
+        aCenters.resize( tCount );
+        aRadii.resize( tCount );
+        aTimeSteps.resize( tCount );
+
+        std::vector< bool > tDone( tCount, false );
+
+        fBatchParticles.clear();
+        fBatchIndices.clear();
+        fBatchSteps.clear();
+
+        if( IsBatchable() == true )
+        {
+            //mass, charge and field calculators are static in the exact trapped particle, so they must agree across the batch
+            const KSParticle* tReference = NULL;
+            for( unsigned int tIndex = 0; tIndex < tCount; tIndex++ )
+            {
+                const KSParticle& tParticle = anInitialParticles[ tIndex ];
+                if( tReference == NULL )
+                {
+                    tReference = &tParticle;
+                }
+                else if( tParticle.GetMass() != tReference->GetMass() ||
+                         tParticle.GetCharge() != tReference->GetCharge() ||
+                         tParticle.GetMagneticFieldCalculator() != tReference->GetMagneticFieldCalculator() ||
+                         tParticle.GetElectricFieldCalculator() != tReference->GetElectricFieldCalculator() )
+                {
+                    continue;
+                }
+
+                fBatchParticle.PullFrom( tParticle );
+
+                double tStep;
+                double tSmallestStep = numeric_limits< double >::max();
+                for( int tControl = 0; tControl < fControls.End(); tControl++ )
+                {
+                    fControls.ElementAt( tControl )->Calculate( fBatchParticle, tStep );
+                    if( tStep < tSmallestStep )
+                    {
+                        tSmallestStep = tStep;
+                    }
+                }
+
+                fBatchIndices.push_back( tIndex );
+                fBatchParticles.push_back( fBatchParticle );
+                fBatchSteps.push_back( tSmallestStep );
+            }
+
+            trajmsg_debug( "ExactTrapped trajectory integrating <" << fBatchIndices.size() << "> of <" << tCount << "> particles in lockstep" << eom );
+
+            fBatch.SetNumberOfLanes( fBatchIndices.size() );
+            for( unsigned int tLane = 0; tLane < fBatchIndices.size(); tLane++ )
+            {
+                fBatch.PullFrom( tLane, fBatchParticles[ tLane ] );
+            }
+            fBatch.IntegrateSym4( fBatchSteps );
+
+            for( unsigned int tLane = 0; tLane < fBatchIndices.size(); tLane++ )
+            {
+                //an abort signal or a rejected step is left to the scalar path
+                if( fAbortSignal )
+                {
+                    break;
+                }
+
+                fBatch.PushTo( tLane, fFinalParticle );
+
+                bool tFlag = true;
+                for( int tControl = 0; tControl < fControls.End(); tControl++ )
+                {
+                    fControls.ElementAt( tControl )->Check( fBatchParticles[ tLane ], fFinalParticle, fError, tFlag );
+                    if( tFlag == false )
+                    {
+                        break;
+                    }
+                }
+                if( tFlag == false )
+                {
+                    continue;
+                }
+
+                unsigned int tIndex = fBatchIndices[ tLane ];
+                fFinalParticle.PushTo( aFinalParticles[ tIndex ] );
+                aFinalParticles[ tIndex ].SetLabel( GetName() );
+
+                KThreeVector tInitialFinalLine = fFinalParticle.GetPosition() - fBatchParticles[ tLane ].GetPosition();
+                aCenters[ tIndex ] = fBatchParticles[ tLane ].GetPosition() + .5 * tInitialFinalLine;
+                aRadii[ tIndex ] = .5 * tInitialFinalLine.Magnitude();
+                aTimeSteps[ tIndex ] = fBatchSteps[ tLane ];
+
+                tDone[ tIndex ] = true;
+            }
+        }
+
+        for( unsigned int tIndex = 0; tIndex < tCount; tIndex++ )
+        {
+            if( tDone[ tIndex ] == false )
+            {
+                CalculateTrajectory( anInitialParticles[ tIndex ], aFinalParticles[ tIndex ], aCenters[ tIndex ], aRadii[ tIndex ], aTimeSteps[ tIndex ] );
+            }
+        }
+
+        return;
+    }
+
     void KSTrajTrajectoryExactTrapped::Differentiate(double aTime, const KSTrajExactTrappedParticle& aValue, KSTrajExactTrappedDerivative& aDerivative ) const
     {
+        for( int tIndex = 0; tIndex < fSynchrotronTerms.End(); tIndex++ )
+        {
+            if( fSynchrotronTerms.ElementAt( tIndex )->UsesFieldGradients( aTime, aValue ) == true )
+            {
+                //force the cached calculation of the fields together with their gradients
+                //(otherwise the propagation term calculates the fields single and the synchrotron term the gradients later)
+                aValue.GetMagneticFieldAndGradient();
+                aValue.GetElectricFieldAndGradient();
+                break;
+            }
+        }
+
         KThreeVector tVelocity = aValue.GetVelocity();
 
         aDerivative = 0.;
@@ -309,10 +555,49 @@ namespace Kassiopeia
         return;
     }
 
+    double KSTrajTrajectoryExactTrapped::GetAdiabaticity( const KSTrajExactTrappedParticle& aParticle )
+    {
+        const KThreeVector& tMagneticField = aParticle.GetMagneticField();
+        const KThreeMatrix& tMagneticGradient = aParticle.GetMagneticGradient();
+
+        double tMagneticFieldMagnitude = tMagneticField.Magnitude();
+        if( tMagneticFieldMagnitude <= 0. )
+        {
+            return numeric_limits< double >::max();
+        }
+
+        double tMaxGradient = 0.;
+        for( int tIndex = 0; tIndex < 9; tIndex++ )
+        {
+            if( fabs( tMagneticGradient[ tIndex ] ) > tMaxGradient )
+            {
+                tMaxGradient = fabs( tMagneticGradient[ tIndex ] );
+            }
+        }
+
+        double tCyclotronRadius = aParticle.GetTransMomentum() / (fabs( aParticle.GetCharge() ) * tMagneticFieldMagnitude);
+        return tCyclotronRadius * tMaxGradient / tMagneticFieldMagnitude;
+    }
+
+    void KSTrajTrajectoryExactTrapped::PullDeupdateComponent()
+    {
+        fStepNRejections = 0;
+        fStepNIntegrations = 0;
+    }
+
+    void KSTrajTrajectoryExactTrapped::PushDeupdateComponent()
+    {
+        fStepNRejections = 0;
+        fStepNIntegrations = 0;
+    }
+
     STATICINT sKSTrajTrajectoryExactTrappedDict =
         KSDictionary< KSTrajTrajectoryExactTrapped >::AddCommand( &KSTrajTrajectoryExactTrapped::SetIntegrator, &KSTrajTrajectoryExactTrapped::ClearIntegrator, "set_integrator", "clear_integrator" ) +
         KSDictionary< KSTrajTrajectoryExactTrapped >::AddCommand( &KSTrajTrajectoryExactTrapped::SetInterpolator, &KSTrajTrajectoryExactTrapped::ClearInterpolator, "set_interpolator", "clear_interpolator" ) +
+        KSDictionary< KSTrajTrajectoryExactTrapped >::AddCommand( &KSTrajTrajectoryExactTrapped::SetGuidingCenterTrajectory, &KSTrajTrajectoryExactTrapped::ClearGuidingCenterTrajectory, "set_guiding_center", "clear_guiding_center" ) +
         KSDictionary< KSTrajTrajectoryExactTrapped >::AddCommand( &KSTrajTrajectoryExactTrapped::AddTerm, &KSTrajTrajectoryExactTrapped::RemoveTerm, "add_term", "remove_term" ) +
-        KSDictionary< KSTrajTrajectoryExactTrapped >::AddCommand( &KSTrajTrajectoryExactTrapped::AddControl, &KSTrajTrajectoryExactTrapped::RemoveControl, "add_control", "remove_control" );
+        KSDictionary< KSTrajTrajectoryExactTrapped >::AddCommand( &KSTrajTrajectoryExactTrapped::AddControl, &KSTrajTrajectoryExactTrapped::RemoveControl, "add_control", "remove_control" ) +
+        KSDictionary< KSTrajTrajectoryExactTrapped >::AddComponent( &KSTrajTrajectoryExactTrapped::GetStepNRejections, "step_number_of_rejections" ) +
+        KSDictionary< KSTrajTrajectoryExactTrapped >::AddComponent( &KSTrajTrajectoryExactTrapped::GetStepNIntegrations, "step_number_of_integrations" );
 
 }
@@ -0,0 +1,44 @@
+#ifndef KSPARALLELLOOP_H_
+#define KSPARALLELLOOP_H_
+
+#include "KSMutex.h"
+
+#include <pthread.h>
+
+namespace Kassiopeia
+{
+
+    //runs the iterations of a loop on a number of threads, which take the next open iteration whenever they are done.
+    //the calling thread works along, so a single thread runs the loop in order without starting any other thread.
+    class KSParallelLoop
+    {
+        public:
+            KSParallelLoop();
+            virtual ~KSParallelLoop();
+
+            //zero means one thread per processor
+            void SetNumberOfThreads( const unsigned int& aNumber );
+            unsigned int GetNumberOfThreads() const;
+
+            void Run( const unsigned int& aCount );
+
+        protected:
+            //called concurrently for different indices
+            virtual void Iteration( const unsigned int& anIndex ) = 0;
+
+            //called after each finished iteration, one call at a time
+            virtual void Progress( const unsigned int& aFinished, const unsigned int& aCount );
+
+        private:
+            static void* Thread( void* aLoop );
+
+            unsigned int fNThreads;
+            unsigned int fCount;
+            unsigned int fNext;
+            unsigned int fFinished;
+            KSMutex fMutex;
+    };
+
+}
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef KSPROFILER_H_
+#define KSPROFILER_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include <time.h>
+
+namespace Kassiopeia
+{
+
+    //counts calls and accumulates wall time for named sections of the simulation.
+    //while disabled, a scope costs a single flag test. the profiler is not synchronized and
+    //is meant to be enabled only around the tracking loop, which runs on a single thread.
+    class KSProfiler
+    {
+        public:
+            class Entry
+            {
+                public:
+                    std::string fName;
+                    unsigned long fCalls;
+                    double fTime;
+            };
+
+            //times the enclosing block and counts it as one call of a section
+            class Scope
+            {
+                public:
+                    Scope( const unsigned int& aSection );
+                    Scope( const void* aKey, const char* aCategory, const std::string& aName );
+                    ~Scope();
+
+                private:
+                    int fSection;
+                    timespec fStart;
+            };
+
+        public:
+            static KSProfiler& GetInstance();
+
+            void SetEnabled( const bool& aFlag );
+            const bool& IsEnabled() const;
+
+            //returns the section with the given name, adding it if it does not exist
+            unsigned int Section( const std::string& aName );
+
+            //returns the section registered for an object, adding it as "category <name>" on first use
+            unsigned int Section( const void* aKey, const char* aCategory, const std::string& aName );
+
+            const std::vector< Entry >& GetEntries() const;
+
+            //zeroes all counters, keeps the sections
+            void Reset();
+
+        private:
+            KSProfiler();
+            ~KSProfiler();
+
+            void Add( const unsigned int& aSection, const timespec& aStart );
+
+            bool fEnabled;
+            std::vector< Entry > fEntries;
+            std::map< std::string, unsigned int > fNamedSections;
+            std::map< const void*, unsigned int > fKeyedSections;
+    };
+
+    inline KSProfiler::Scope::Scope( const unsigned int& aSection ) :
+        fSection( -1 )
+    {
+        if( KSProfiler::GetInstance().IsEnabled() == true )
+        {
+            fSection = aSection;
+            clock_gettime( CLOCK_MONOTONIC, &fStart );
+        }
+    }
+    inline KSProfiler::Scope::Scope( const void* aKey, const char* aCategory, const std::string& aName ) :
+        fSection( -1 )
+    {
+        KSProfiler& tProfiler = KSProfiler::GetInstance();
+        if( tProfiler.IsEnabled() == true )
+        {
+            fSection = tProfiler.Section( aKey, aCategory, aName );
+            clock_gettime( CLOCK_MONOTONIC, &fStart );
+        }
+    }
+    inline KSProfiler::Scope::~Scope()
+    {
+        if( fSection >= 0 )
+        {
+            KSProfiler::GetInstance().Add( fSection, fStart );
+        }
+    }
+
+    inline const bool& KSProfiler::IsEnabled() const
+    {
+        return fEnabled;
+    }
+
+    inline void KSProfiler::Add( const unsigned int& aSection, const timespec& aStart )
+    {
+        timespec tStop;
+        clock_gettime( CLOCK_MONOTONIC, &tStop );
+
+        Entry& tEntry = fEntries[ aSection ];
+        tEntry.fCalls++;
+        tEntry.fTime += (double) (tStop.tv_sec - aStart.tv_sec) + 1.e-9 * (double) (tStop.tv_nsec - aStart.tv_nsec);
+        return;
+    }
+
+}
+
+#endif
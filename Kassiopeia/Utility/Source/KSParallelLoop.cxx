@@ -0,0 +1,95 @@
+#include "KSParallelLoop.h"
+
+#include <unistd.h>
+#include <vector>
+
+namespace Kassiopeia
+{
+
+    KSParallelLoop::KSParallelLoop() :
+        fNThreads( 1 ),
+        fCount( 0 ),
+        fNext( 0 ),
+        fFinished( 0 ),
+        fMutex()
+    {
+    }
+    KSParallelLoop::~KSParallelLoop()
+    {
+    }
+
+    void KSParallelLoop::SetNumberOfThreads( const unsigned int& aNumber )
+    {
+        fNThreads = aNumber;
+        return;
+    }
+    unsigned int KSParallelLoop::GetNumberOfThreads() const
+    {
+        if( fNThreads == 0 )
+        {
+            long tProcessors = sysconf( _SC_NPROCESSORS_ONLN );
+            return (tProcessors > 0) ? tProcessors : 1;
+        }
+        return fNThreads;
+    }
+
+    void KSParallelLoop::Run( const unsigned int& aCount )
+    {
+        fCount = aCount;
+        fNext = 0;
+        fFinished = 0;
+
+        unsigned int tThreads = GetNumberOfThreads();
+        if( tThreads > fCount )
+        {
+            tThreads = fCount;
+        }
+
+        std::vector< pthread_t > tWorkers;
+        for( unsigned int tIndex = 1; tIndex < tThreads; tIndex++ )
+        {
+            pthread_t tWorker;
+            if( pthread_create( &tWorker, NULL, &KSParallelLoop::Thread, this ) == 0 )
+            {
+                tWorkers.push_back( tWorker );
+            }
+        }
+        Thread( this );
+        for( unsigned int tIndex = 0; tIndex < tWorkers.size(); tIndex++ )
+        {
+            pthread_join( tWorkers[ tIndex ], NULL );
+        }
+        return;
+    }
+
+    void KSParallelLoop::Progress( const unsigned int& /*aFinished*/, const unsigned int& /*aCount*/ )
+    {
+        return;
+    }
+
+    void* KSParallelLoop::Thread( void* aLoop )
+    {
+        KSParallelLoop* tLoop = static_cast< KSParallelLoop* >( aLoop );
+        while( true )
+        {
+            tLoop->fMutex.Lock();
+            if( tLoop->fNext >= tLoop->fCount )
+            {
+                tLoop->fMutex.Unlock();
+                break;
+            }
+            unsigned int tIndex = tLoop->fNext;
+            tLoop->fNext++;
+            tLoop->fMutex.Unlock();
+
+            tLoop->Iteration( tIndex );
+
+            tLoop->fMutex.Lock();
+            tLoop->fFinished++;
+            tLoop->Progress( tLoop->fFinished, tLoop->fCount );
+            tLoop->fMutex.Unlock();
+        }
+        return NULL;
+    }
+
+}
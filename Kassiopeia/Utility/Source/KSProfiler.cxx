@@ -0,0 +1,76 @@
+#include "KSProfiler.h"
+
+namespace Kassiopeia
+{
+
+    KSProfiler::KSProfiler() :
+        fEnabled( false ),
+        fEntries(),
+        fNamedSections(),
+        fKeyedSections()
+    {
+    }
+    KSProfiler::~KSProfiler()
+    {
+    }
+
+    KSProfiler& KSProfiler::GetInstance()
+    {
+        static KSProfiler sInstance;
+        return sInstance;
+    }
+
+    void KSProfiler::SetEnabled( const bool& aFlag )
+    {
+        fEnabled = aFlag;
+        return;
+    }
+
+    unsigned int KSProfiler::Section( const std::string& aName )
+    {
+        std::map< std::string, unsigned int >::iterator tIt = fNamedSections.find( aName );
+        if( tIt != fNamedSections.end() )
+        {
+            return tIt->second;
+        }
+
+        Entry tEntry;
+        tEntry.fName = aName;
+        tEntry.fCalls = 0;
+        tEntry.fTime = 0.;
+
+        unsigned int tSection = fEntries.size();
+        fEntries.push_back( tEntry );
+        fNamedSections[ aName ] = tSection;
+        return tSection;
+    }
+
+    unsigned int KSProfiler::Section( const void* aKey, const char* aCategory, const std::string& aName )
+    {
+        std::map< const void*, unsigned int >::iterator tIt = fKeyedSections.find( aKey );
+        if( tIt != fKeyedSections.end() )
+        {
+            return tIt->second;
+        }
+
+        unsigned int tSection = Section( std::string( aCategory ) + " <" + aName + ">" );
+        fKeyedSections[ aKey ] = tSection;
+        return tSection;
+    }
+
+    const std::vector< KSProfiler::Entry >& KSProfiler::GetEntries() const
+    {
+        return fEntries;
+    }
+
+    void KSProfiler::Reset()
+    {
+        for( std::vector< Entry >::iterator tIt = fEntries.begin(); tIt != fEntries.end(); tIt++ )
+        {
+            tIt->fCalls = 0;
+            tIt->fTime = 0.;
+        }
+        return;
+    }
+
+}
@@ -9,6 +9,9 @@ using katrin::KROOTPainter;
 
 #include "KField.h"
 #include "KSMagneticField.h"
+#include "KSParallelLoop.h"
+
+#include <vector>
 
 namespace Kassiopeia
 {
@@ -23,8 +26,8 @@ namespace Kassiopeia
             virtual void Render();
             virtual void Display();
             virtual void Write();
-            virtual void FieldMapX(KSMagneticField* tMagField, double tDeltaZ, double tDeltaR);
-            virtual void FieldMapZ(KSMagneticField* tMagField, double tDeltaZ, double tDeltaR);
+            virtual void FieldMapX(KSMagneticField* tMagField, double tDeltaZ, double tDeltaR, unsigned int tThreads = 1);
+            virtual void FieldMapZ(KSMagneticField* tMagField, double tDeltaZ, double tDeltaR, unsigned int tThreads = 1);
 
             virtual double GetXMin();
             virtual double GetXMax();
@@ -34,6 +37,41 @@ namespace Kassiopeia
             virtual std::string GetXAxisLabel();
             virtual std::string GetYAxisLabel();
 
+        private:
+            class MapBin
+            {
+                public:
+                    int fBinX;
+                    int fBinY;
+                    double fValue;
+            };
+
+            //evaluates one row of the map, rows are processed concurrently when more than one thread is used
+            class RowLoop :
+                public KSParallelLoop
+            {
+                public:
+                    RowLoop( KSROOTMagFieldPainter* aPainter, KSMagneticField* aField, bool aZMap, double aDeltaZ, double aDeltaR, std::vector< std::vector< MapBin > >& aRows );
+                    virtual ~RowLoop();
+
+                protected:
+                    virtual void Iteration( const unsigned int& anIndex );
+                    virtual void Progress( const unsigned int& aFinished, const unsigned int& aCount );
+
+                private:
+                    KSROOTMagFieldPainter* fPainter;
+                    KSMagneticField* fField;
+                    bool fZMap;
+                    double fDeltaZ;
+                    double fDeltaR;
+                    std::vector< std::vector< MapBin > >& fRows;
+            };
+
+            void FieldMapZRow( KSMagneticField* tMagField, int i, double tDeltaZ, double tDeltaR, std::vector< MapBin >& aBins );
+            void FieldMapXRow( KSMagneticField* tMagField, int i, double tDeltaZ, double tDeltaR, std::vector< MapBin >& aBins );
+            static void Fill( std::vector< MapBin >& aBins, int aBinX, int aBinY, double aValue );
+            static void FillMap( TH2D* aMap, const std::vector< std::vector< MapBin > >& aRows );
+
         private:
             ;K_SET( std::string, XAxis );
             ;K_SET( std::string, YAxis );
@@ -49,6 +87,9 @@ namespace Kassiopeia
             ;K_SET( bool, UseLogZ );
             ;K_SET( bool, GradNumerical);
             ;K_SET( std::string, Draw);
+            //the field is evaluated concurrently by this many threads, zero means one per processor.
+            //fields that are not marked thread safe are always evaluated by one thread
+            ;K_SET( unsigned int, Threads );
             TH2D* fMap;
 
     };
@@ -11,6 +11,9 @@ using katrin::KROOTPainter;
 
 #include "KField.h"
 #include "KSElectricField.h"
+#include "KSParallelLoop.h"
+
+#include <vector>
 
 namespace Kassiopeia
 {
@@ -37,6 +40,39 @@ namespace Kassiopeia
         public:
             bool CheckPosition( const KThreeVector& aPosition ) const;
 
+        private:
+            class MapBin
+            {
+                public:
+                    int fBinX;
+                    int fBinY;
+                    double fValue;
+            };
+
+            //evaluates one row of the map, rows are processed concurrently when more than one thread is used
+            class RowLoop :
+                public KSParallelLoop
+            {
+                public:
+                    RowLoop( KSROOTPotentialPainter* aPainter, KSElectricField* aField, KSElectricField* aReferenceField, double aDeltaZ, double aDeltaR, std::vector< std::vector< MapBin > >& aRows );
+                    virtual ~RowLoop();
+
+                protected:
+                    virtual void Iteration( const unsigned int& anIndex );
+                    virtual void Progress( const unsigned int& aFinished, const unsigned int& aCount );
+
+                private:
+                    KSROOTPotentialPainter* fPainter;
+                    KSElectricField* fField;
+                    KSElectricField* fReferenceField;
+                    double fDeltaZ;
+                    double fDeltaR;
+                    std::vector< std::vector< MapBin > >& fRows;
+            };
+
+            void MapRow( KSElectricField* tElField, KSElectricField* tRefField, int i, double tDeltaZ, double tDeltaR, std::vector< MapBin >& aBins );
+            static void Fill( std::vector< MapBin >& aBins, int aBinX, int aBinY, double aValue );
+
         private:
             ;K_SET( std::string, XAxis );
             ;K_SET( std::string, YAxis );
@@ -50,6 +86,9 @@ namespace Kassiopeia
             TH2D* fMap;
             ;K_SET( bool, Comparison );
             ;K_SET( std::string, ReferenceFieldName );
+            //the field is evaluated concurrently by this many threads, zero means one per processor.
+            //fields that are not marked thread safe are always evaluated by one thread
+            ;K_SET( unsigned int, Threads );
     };
 
 }
@@ -22,6 +22,7 @@ namespace Kassiopeia
 			fUseLogZ(false),
 			fGradNumerical(true),
 			fDraw( "COLZ"),
+			fThreads( 1 ),
             fMap()
     {
     }
@@ -29,347 +30,226 @@ namespace Kassiopeia
     {
     }
 
-    void KSROOTMagFieldPainter::FieldMapZ( KSMagneticField* tMagField , double tDeltaZ, double tDeltaR){
-		double tZ,tR;
+    void KSROOTMagFieldPainter::FieldMapZ( KSMagneticField* tMagField , double tDeltaZ, double tDeltaR, unsigned int tThreads){
 		TH2D* Map = new TH2D("Map", "Map", fZsteps,fZmin,fZmax,2*fRsteps,-fRmax,fRmax);
-    	KThreeVector tPosition;
-		KThreeVector tPosition_i, tPosition_j;
 
-		KThreeVector tMagneticField;
-		KThreeVector tPotential;
-		KThreeMatrix tGradient;
-
-		if( fAxialSymmetry==true ){
+		if( fAxialSymmetry==true )
 			vismsg(eNormal) << "start calculating <"<<fPlot<<"> map, (assuming axial symmetry!!)" << eom;
-			for( int i=0; i<fZsteps; i++){
-				tZ = fZmin + i* tDeltaZ;
-				vismsg( eNormal ) << "map: Z Position: " << i <<"/" << fZsteps << reom;
-
-				for ( int j=fRsteps; j>=0;j--){
-					tR = j * tDeltaR;
-
-					if(fYAxis=="y"){
-						tPosition.SetComponents(0.,tR,tZ);
-						tPosition_i.SetComponents(0., tR, tZ+tDeltaZ);
-						tPosition_j.SetComponents(0., tR+tDeltaR, tZ);
-					}
-					else if(fYAxis=="x"){
-						tPosition.SetComponents(tR,0.,tZ);
-						tPosition_i.SetComponents(tR, 0., tZ+tDeltaZ);
-						tPosition_j.SetComponents(tR+tDeltaR, 0., tZ);
-					}
-					else vismsg(eError) << "Please use x or y for the Y-Axis and z for the X-Axis. All other combinations are not yet included" << eom;
-//					calculate magnetic field at tPosition, requested by any further calculation
-					tMagField->CalculateField(tPosition,0.0,tMagneticField);
-					if( fPlot=="magnetic_field_abs" ){
-						Map->SetBinContent(i+1,fRsteps-j+1,tMagneticField.Magnitude());
-						Map->SetBinContent(i+1,fRsteps+j+1,tMagneticField.Magnitude());
-					}
-					else if( fPlot=="magnetic_field_z" ){
-						Map->SetBinContent(i+1,fRsteps-j+1,tMagneticField.Z());
-						Map->SetBinContent(i+1,fRsteps+j+1,tMagneticField.Z());
-					}
-					else if( fPlot=="magnetic_field_z_abs" ){
-						Map->SetBinContent(i+1,fRsteps-j+1,fabs(tMagneticField.Z()) );
-						Map->SetBinContent(i+1,fRsteps+j+1,fabs(tMagneticField.Z()) );
-					}
-					else if( fPlot=="magnetic_field_x" || fPlot=="magnetic_field_y" ){
-						Map->SetBinContent(i+1,fRsteps-j+1,tMagneticField.X());
-						Map->SetBinContent(i+1,fRsteps+j+1,tMagneticField.X());
-					}
-					else if( fPlot=="magnetic_field_x_abs" || fPlot=="magnetic_field_y_abs" ){
-						Map->SetBinContent(i+1,fRsteps-j+1,fabs(tMagneticField.X()) );
-						Map->SetBinContent(i+1,fRsteps+j+1,fabs(tMagneticField.X()) );
-					}
-					else if( fPlot=="magnetic_potential_abs" )
-					{
-						tMagField->CalculatePotential(tPosition,0.0,tPotential);
-						Map->SetBinContent(i+1,fRsteps-j+1,tPotential.Magnitude());
-						Map->SetBinContent(i+1,fRsteps+j+1,tPotential.Magnitude());
-					}
-					else if ( fPlot.compare(9, 8, "gradient") == 0 ){
-						if( fGradNumerical==true) {
-							KThreeVector tMagneticField_i, tMagneticField_j;
-							if( fPlot=="magnetic_gradient_z" ){
-								tMagField->CalculateField(tPosition_i,0.0,tMagneticField_i);
-								Double_t tGradient = (tMagneticField_i.Magnitude()-tMagneticField.Magnitude())/tDeltaZ;
-								Map->SetBinContent(i+1,fRsteps-j+1, tGradient );
-								Map->SetBinContent(i+1,fRsteps+j+1, tGradient );
-							}
-							else if( fPlot=="magnetic_gradient_z_abs" ){
-								tMagField->CalculateField(tPosition_i,0.0,tMagneticField_i);
-								Double_t tGradient = fabs((tMagneticField_i.Magnitude()-tMagneticField.Magnitude())/tDeltaZ);
-								Map->SetBinContent(i+1,fRsteps-j+1, tGradient );
-								Map->SetBinContent(i+1,fRsteps+j+1, tGradient );
-							}
-							else if( fPlot=="magnetic_gradient_x" || fPlot=="magnetic_gradient_y" ){
-								tMagField->CalculateField(tPosition_j,0.0,tMagneticField_j);
-								Double_t tGradient = (tMagneticField_j.Magnitude()-tMagneticField.Magnitude())/tDeltaR;
-								Map->SetBinContent(i+1,fRsteps-j+1, tGradient );
-								Map->SetBinContent(i+1,fRsteps+j+1, tGradient );
-							}
-							else if( fPlot=="magnetic_gradient_x_abs" || fPlot=="magnetic_gradient_y_abs" ){
-								tMagField->CalculateField(tPosition_j,0.0,tMagneticField_j);
-								Double_t tGradient = fabs((tMagneticField_j.Magnitude()-tMagneticField.Magnitude())/tDeltaR);
-								Map->SetBinContent(i+1,fRsteps-j+1, tGradient );
-								Map->SetBinContent(i+1,fRsteps+j+1, tGradient );
-							}
-						}
-						else if( fGradNumerical==false){
-//							calculate gradient matrix
-							tMagField->CalculateGradient(tPosition,0.0,tGradient);
-							KThreeVector tGradB;
-							tGradB.SetX(tMagneticField.X()*tGradient[0]+tMagneticField.Y()*tGradient[1]+tMagneticField.Z()*tGradient[2]);
-							tGradB.SetY(tMagneticField.X()*tGradient[3]+tMagneticField.Y()*tGradient[4]+tMagneticField.Z()*tGradient[5]);
-							tGradB.SetZ(tMagneticField.X()*tGradient[6]+tMagneticField.Y()*tGradient[7]+tMagneticField.Z()*tGradient[8]);
-							tGradB *= tMagneticField.Magnitude();
-							if( fPlot=="magnetic_gradient_abs" ){
-								Map->SetBinContent(i+1,fRsteps-j+1, tGradB.Magnitude() );
-								Map->SetBinContent(i+1,fRsteps+j+1, tGradB.Magnitude() );
-							}
-							else if( fPlot=="magnetic_gradient_z" ){
-								Map->SetBinContent(i+1,fRsteps-j+1, tGradB.Z() );
-								Map->SetBinContent(i+1,fRsteps+j+1, tGradB.Z() );
-							}
-							else if( fPlot=="magnetic_gradient_z_abs" ){
-								Map->SetBinContent(i+1,fRsteps-j+1, fabs(tGradB.Z()) );
-								Map->SetBinContent(i+1,fRsteps+j+1, fabs(tGradB.Z()) );
-							}
-							else if( fPlot=="magnetic_gradient_x" || fPlot=="magnetic_gradient_y" ){
-								Map->SetBinContent(i+1,fRsteps-j+1, tGradB.X() );
-								Map->SetBinContent(i+1,fRsteps+j+1, tGradB.X() );
-							}
-							else if( fPlot=="magnetic_gradient_x_abs" || fPlot=="magnetic_gradient_y_abs" ){
-								Map->SetBinContent(i+1,fRsteps-j+1, fabs(tGradB.X()) );
-								Map->SetBinContent(i+1,fRsteps+j+1, fabs(tGradB.X()) );
-							}
-						}
-					}
-					else{
-						vismsg ( eError ) << "do not know what to plot" << eom;
-					}
-				}
-			}
-		}
-		else if ( fAxialSymmetry==false ){
+		else
 			vismsg(eNormal) << "start calculating <"<<fPlot<<"> map" << eom;
-			KThreeVector tPosition_x, tPosition_y;
-			for( int i=0; i<fZsteps; i++){
-				tZ = fZmin + i* tDeltaZ;
-				vismsg( eNormal ) << "map: Z Position: " << i <<"/" << fZsteps << reom;
-
-				for ( int j=fRsteps; j>=-fRsteps;j--){
-					tR = j * tDeltaR;
-
-					tPosition_x.SetComponents(tR+tDeltaR, 0., tZ);
-					tPosition_y.SetComponents(0., tR+tDeltaR, tZ);
-					if(fYAxis=="y"){
-						tPosition.SetComponents(0.,tR,tZ);
-						tPosition_i.SetComponents(0., tR, tZ+tDeltaZ);
-						tPosition_j.SetComponents(0., tR+tDeltaR, tZ);
-					}
-					else if(fYAxis=="x"){
-						tPosition.SetComponents(tR,0.,tZ);
-						tPosition_i.SetComponents(tR, 0., tZ+tDeltaZ);
-						tPosition_j.SetComponents(tR+tDeltaR, 0., tZ);
-					}
-					else vismsg(eError) << "Please use x or y for the Y-Axis and z for the X-Axis. All other combinations are not yet included" << eom;
-//					calculate magnetic field at tPosition, requested by any further calculation
-					tMagField->CalculateField(tPosition,0.0,tMagneticField);
-					if( fPlot=="magnetic_field_abs" ){
-						Map->SetBinContent(i+1,fRsteps+j+1,tMagneticField.Magnitude());
-					}
-					else if( fPlot=="magnetic_field_z" ){
-						tMagField->CalculateField(tPosition,0.0,tMagneticField);
-						Map->SetBinContent(i+1,fRsteps+j+1,tMagneticField.Z());
-					}
-					else if( fPlot=="magnetic_field_z_abs" ){
-						Map->SetBinContent(i+1,fRsteps+j+1,fabs(tMagneticField.Z()) );
-					}
-					else if( fPlot=="magnetic_field_x" ){
-						Map->SetBinContent(i+1,fRsteps+j+1,tMagneticField.X());
-					}
-					else if( fPlot=="magnetic_field_x_abs" ){
-						Map->SetBinContent(i+1,fRsteps+j+1,fabs(tMagneticField.X()) );
-					}
-					else if( fPlot=="magnetic_field_y" ){
-						Map->SetBinContent(i+1,fRsteps+j+1,tMagneticField.Y());
-					}
-					else if( fPlot=="magnetic_field_y_abs" ){
-						Map->SetBinContent(i+1,fRsteps+j+1,fabs(tMagneticField.Y()) );
-					}
-					else if( fPlot=="magnetic_potential_abs" )
-					{
-						tMagField->CalculatePotential(tPosition,0.0,tPotential);
-						Map->SetBinContent(i+1,fRsteps+j+1,tPotential.Magnitude());
-					}
-					else if ( fPlot.compare(9, 8, "gradient") == 0 ){
-						KThreeVector tMagneticField_i, tMagneticField_j;
-						if( fGradNumerical==true) {
-							KThreeVector tMagneticField_x, tMagneticField_y;
-							if( fPlot=="magnetic_gradient_z" ){
-								tMagField->CalculateField(tPosition_i,0.0,tMagneticField_i);
-								Double_t tGradient = (tMagneticField_i.Magnitude()-tMagneticField.Magnitude())/tDeltaZ;
-								Map->SetBinContent(i+1,fRsteps+j+1, tGradient );
-							}
-							else if( fPlot=="magnetic_gradient_z_abs" ){
-								tMagField->CalculateField(tPosition_i,0.0,tMagneticField_i);
-								Double_t tGradient = fabs((tMagneticField_i.Magnitude()-tMagneticField.Magnitude())/tDeltaZ);
-								Map->SetBinContent(i+1,fRsteps+j+1, tGradient );
-							}
-							else if( fPlot=="magnetic_gradient_x" ){
-								tMagField->CalculateField(tPosition_x,0.0,tMagneticField_x);
-								Double_t tGradient = (tMagneticField_x.Magnitude()-tMagneticField.Magnitude())/tDeltaR;
-								Map->SetBinContent(i+1,fRsteps+j+1, tGradient );
-							}
-							else if( fPlot=="magnetic_gradient_x_abs" ){
-								tMagField->CalculateField(tPosition_j,0.0,tMagneticField_x);
-								Double_t tGradient = fabs((tMagneticField_x.Magnitude()-tMagneticField.Magnitude())/tDeltaR);
-								Map->SetBinContent(i+1,fRsteps+j+1, tGradient );
-							}
-							else if( fPlot=="magnetic_gradient_y" ){
-								tMagField->CalculateField(tPosition_y,0.0,tMagneticField_y);
-								Double_t tGradient = (tMagneticField_y.Magnitude()-tMagneticField.Magnitude())/tDeltaR;
-								Map->SetBinContent(i+1,fRsteps+j+1, tGradient );
-							}
-							else if( fPlot=="magnetic_gradient_y_abs" ){
-								tMagField->CalculateField(tPosition_j,0.0,tMagneticField_y);
-								Double_t tGradient = fabs((tMagneticField_y.Magnitude()-tMagneticField.Magnitude())/tDeltaR);
-								Map->SetBinContent(i+1,fRsteps+j+1, tGradient );
-							}
-						}
-						else if( fGradNumerical==false){
-//							calculate gradient matrix
-							tMagField->CalculateGradient(tPosition,0.0,tGradient);
-							KThreeVector tGradB;
-							tGradB.SetX(tMagneticField.X()*tGradient[0]+tMagneticField.Y()*tGradient[1]+tMagneticField.Z()*tGradient[2]);
-							tGradB.SetY(tMagneticField.X()*tGradient[3]+tMagneticField.Y()*tGradient[4]+tMagneticField.Z()*tGradient[5]);
-							tGradB.SetZ(tMagneticField.X()*tGradient[6]+tMagneticField.Y()*tGradient[7]+tMagneticField.Z()*tGradient[8]);
-							tGradB *= tMagneticField.Magnitude();
-							if( fPlot=="magnetic_gradient_abs" ){
-								Map->SetBinContent(i+1,fRsteps+j+1, tGradB.Magnitude() );
-							}
-							else if( fPlot=="magnetic_gradient_z" ){
-								Map->SetBinContent(i+1,fRsteps+j+1, tGradB.Z() );
-							}
-							else if( fPlot=="magnetic_gradient_z_abs" ){
-								Map->SetBinContent(i+1,fRsteps+j+1, fabs(tGradB.Z()) );
-							}
-							else if( fPlot=="magnetic_gradient_x"){
-								Map->SetBinContent(i+1,fRsteps+j+1, tGradB.X() );
-							}
-							else if( fPlot=="magnetic_gradient_x_abs" ){
-								Map->SetBinContent(i+1,fRsteps+j+1, fabs(tGradB.X()) );
-							}
-							else if( fPlot=="magnetic_gradient_y"){
-								Map->SetBinContent(i+1,fRsteps+j+1, tGradB.Y() );
-							}
-							else if( fPlot=="magnetic_gradient_y_abs" ){
-								Map->SetBinContent(i+1,fRsteps+j+1, fabs(tGradB.Y()) );
-							}
-						}
-					}
-					else{
-						vismsg ( eError ) << "do not know what to plot" << eom;
-					}
-				}
-			}
-		}
-		else {
-			vismsg( eError ) << "axial symmetry must be either true or false!" << eom;
-		}
+
+		std::vector< std::vector< MapBin > > tRows( fZsteps );
+		RowLoop tLoop( this, tMagField, true, tDeltaZ, tDeltaR, tRows );
+		tLoop.SetNumberOfThreads( tThreads );
+		tLoop.Run( fZsteps );
+		FillMap( Map, tRows );
 
 		fMap=Map;
 
 		return;
     }
 
-    void KSROOTMagFieldPainter::FieldMapX( KSMagneticField* tMagField, double tDeltaZ, double tDeltaR){
-		double tR_i, tR_j;
+    void KSROOTMagFieldPainter::FieldMapX( KSMagneticField* tMagField, double tDeltaZ, double tDeltaR, unsigned int tThreads){
 		TH2D* Map = new TH2D("Map", "Map", 2*fRsteps,-fRmax,fRmax,2*fRsteps,-fRmax,fRmax);
-		KThreeVector tPosition;
-		KThreeVector tPosition_i, tPosition_j, tPosition_z;
 
-		KThreeVector tMagneticField;
+    	vismsg(eNormal) << "start calculating <"<<fPlot<<"> map" << eom;
+
+		std::vector< std::vector< MapBin > > tRows( 2*fRsteps+1 );
+		RowLoop tLoop( this, tMagField, false, tDeltaZ, tDeltaR, tRows );
+		tLoop.SetNumberOfThreads( tThreads );
+		tLoop.Run( 2*fRsteps+1 );
+		FillMap( Map, tRows );
+
+		fMap=Map;
+
+		return;
+    }
+
+    void KSROOTMagFieldPainter::FieldMapZRow( KSMagneticField* tMagField, int i, double tDeltaZ, double tDeltaR, std::vector< MapBin >& aBins ){
+		double tZ = fZmin + i* tDeltaZ;
+		double tR;
+		int tLowest = ( fAxialSymmetry==true ) ? 0 : -fRsteps;
+
+//		calculate magnetic field at all positions of the row in one batch, requested by any further calculation
+		std::vector< KThreeVector > tPositions;
+		for ( int j=fRsteps; j>=tLowest;j--){
+			tR = j * tDeltaR;
+			if(fYAxis=="y") tPositions.push_back( KThreeVector(0.,tR,tZ) );
+			else tPositions.push_back( KThreeVector(tR,0.,tZ) );
+		}
+		std::vector< double > tTimes( tPositions.size(), 0.0 );
+		std::vector< KThreeVector > tMagneticFields;
+		tMagField->CalculateFields( tPositions, tTimes, tMagneticFields );
+
+		KThreeVector tPosition_i, tPosition_j, tPosition_x, tPosition_y;
 		KThreeVector tPotential;
 		KThreeMatrix tGradient;
-    	vismsg(eNormal) << "start calculating <"<<fPlot<<"> map" << eom;
-		for( int i=fRsteps; i>=-fRsteps;i--){
-			vismsg( eNormal ) << "map: R Position: " << -(i-fRsteps) <<"/" << 2*fRsteps << reom;
-			tR_i = i * tDeltaR;
-			for ( int j=fRsteps; j>=-fRsteps;j--){
-				tR_j = j * tDeltaR;
-				tPosition_z.SetComponents(tR_i, tR_j, fZfix+tDeltaZ);
-				if(fYAxis=="y"){
-					tPosition.SetComponents(tR_i, tR_j, fZfix);
-					tPosition_i.SetComponents(tR_i+tDeltaR, tR_j, fZfix);
-					tPosition_j.SetComponents(tR_i, tR_j+tDeltaR, fZfix);
+		for ( int j=fRsteps; j>=tLowest;j--){
+			tR = j * tDeltaR;
+			const KThreeVector& tPosition = tPositions[ fRsteps-j ];
+			const KThreeVector& tMagneticField = tMagneticFields[ fRsteps-j ];
+
+			if(fYAxis=="y"){
+				tPosition_i.SetComponents(0., tR, tZ+tDeltaZ);
+				tPosition_j.SetComponents(0., tR+tDeltaR, tZ);
+			}
+			else{
+				tPosition_i.SetComponents(tR, 0., tZ+tDeltaZ);
+				tPosition_j.SetComponents(tR+tDeltaR, 0., tZ);
+			}
+
+			if( fAxialSymmetry==true ){
+				if( fPlot=="magnetic_field_abs" ){
+					Fill( aBins, i+1,fRsteps-j+1,tMagneticField.Magnitude());
+					Fill( aBins, i+1,fRsteps+j+1,tMagneticField.Magnitude());
 				}
-				else vismsg(eError) << "Please use x for the X-Axis and y for the Y-Axis. All other combinations are not yet included for the xy FieldMap" << eom;
-//				calculate magnetic field at tPosition, requested by any further calculation
-				tMagField->CalculateField(tPosition,0.0,tMagneticField);
+				else if( fPlot=="magnetic_field_z" ){
+					Fill( aBins, i+1,fRsteps-j+1,tMagneticField.Z());
+					Fill( aBins, i+1,fRsteps+j+1,tMagneticField.Z());
+				}
+				else if( fPlot=="magnetic_field_z_abs" ){
+					Fill( aBins, i+1,fRsteps-j+1,fabs(tMagneticField.Z()) );
+					Fill( aBins, i+1,fRsteps+j+1,fabs(tMagneticField.Z()) );
+				}
+				else if( fPlot=="magnetic_field_x" || fPlot=="magnetic_field_y" ){
+					Fill( aBins, i+1,fRsteps-j+1,tMagneticField.X());
+					Fill( aBins, i+1,fRsteps+j+1,tMagneticField.X());
+				}
+				else if( fPlot=="magnetic_field_x_abs" || fPlot=="magnetic_field_y_abs" ){
+					Fill( aBins, i+1,fRsteps-j+1,fabs(tMagneticField.X()) );
+					Fill( aBins, i+1,fRsteps+j+1,fabs(tMagneticField.X()) );
+				}
+				else if( fPlot=="magnetic_potential_abs" )
+				{
+					tMagField->CalculatePotential(tPosition,0.0,tPotential);
+					Fill( aBins, i+1,fRsteps-j+1,tPotential.Magnitude());
+					Fill( aBins, i+1,fRsteps+j+1,tPotential.Magnitude());
+				}
+				else if ( fPlot.compare(9, 8, "gradient") == 0 ){
+					if( fGradNumerical==true) {
+						KThreeVector tMagneticField_i, tMagneticField_j;
+						if( fPlot=="magnetic_gradient_z" ){
+							tMagField->CalculateField(tPosition_i,0.0,tMagneticField_i);
+							Double_t tGradient = (tMagneticField_i.Magnitude()-tMagneticField.Magnitude())/tDeltaZ;
+							Fill( aBins, i+1,fRsteps-j+1, tGradient );
+							Fill( aBins, i+1,fRsteps+j+1, tGradient );
+						}
+						else if( fPlot=="magnetic_gradient_z_abs" ){
+							tMagField->CalculateField(tPosition_i,0.0,tMagneticField_i);
+							Double_t tGradient = fabs((tMagneticField_i.Magnitude()-tMagneticField.Magnitude())/tDeltaZ);
+							Fill( aBins, i+1,fRsteps-j+1, tGradient );
+							Fill( aBins, i+1,fRsteps+j+1, tGradient );
+						}
+						else if( fPlot=="magnetic_gradient_x" || fPlot=="magnetic_gradient_y" ){
+							tMagField->CalculateField(tPosition_j,0.0,tMagneticField_j);
+							Double_t tGradient = (tMagneticField_j.Magnitude()-tMagneticField.Magnitude())/tDeltaR;
+							Fill( aBins, i+1,fRsteps-j+1, tGradient );
+							Fill( aBins, i+1,fRsteps+j+1, tGradient );
+						}
+						else if( fPlot=="magnetic_gradient_x_abs" || fPlot=="magnetic_gradient_y_abs" ){
+							tMagField->CalculateField(tPosition_j,0.0,tMagneticField_j);
+							Double_t tGradient = fabs((tMagneticField_j.Magnitude()-tMagneticField.Magnitude())/tDeltaR);
+							Fill( aBins, i+1,fRsteps-j+1, tGradient );
+							Fill( aBins, i+1,fRsteps+j+1, tGradient );
+						}
+					}
+					else if( fGradNumerical==false){
+//							calculate gradient matrix
+						tMagField->CalculateGradient(tPosition,0.0,tGradient);
+						KThreeVector tGradB;
+						tGradB.SetX(tMagneticField.X()*tGradient[0]+tMagneticField.Y()*tGradient[1]+tMagneticField.Z()*tGradient[2]);
+						tGradB.SetY(tMagneticField.X()*tGradient[3]+tMagneticField.Y()*tGradient[4]+tMagneticField.Z()*tGradient[5]);
+						tGradB.SetZ(tMagneticField.X()*tGradient[6]+tMagneticField.Y()*tGradient[7]+tMagneticField.Z()*tGradient[8]);
+						tGradB *= tMagneticField.Magnitude();
+						if( fPlot=="magnetic_gradient_abs" ){
+							Fill( aBins, i+1,fRsteps-j+1, tGradB.Magnitude() );
+							Fill( aBins, i+1,fRsteps+j+1, tGradB.Magnitude() );
+						}
+						else if( fPlot=="magnetic_gradient_z" ){
+							Fill( aBins, i+1,fRsteps-j+1, tGradB.Z() );
+							Fill( aBins, i+1,fRsteps+j+1, tGradB.Z() );
+						}
+						else if( fPlot=="magnetic_gradient_z_abs" ){
+							Fill( aBins, i+1,fRsteps-j+1, fabs(tGradB.Z()) );
+							Fill( aBins, i+1,fRsteps+j+1, fabs(tGradB.Z()) );
+						}
+						else if( fPlot=="magnetic_gradient_x" || fPlot=="magnetic_gradient_y" ){
+							Fill( aBins, i+1,fRsteps-j+1, tGradB.X() );
+							Fill( aBins, i+1,fRsteps+j+1, tGradB.X() );
+						}
+						else if( fPlot=="magnetic_gradient_x_abs" || fPlot=="magnetic_gradient_y_abs" ){
+							Fill( aBins, i+1,fRsteps-j+1, fabs(tGradB.X()) );
+							Fill( aBins, i+1,fRsteps+j+1, fabs(tGradB.X()) );
+						}
+					}
+				}
+			}
+			else{
+				tPosition_x.SetComponents(tR+tDeltaR, 0., tZ);
+				tPosition_y.SetComponents(0., tR+tDeltaR, tZ);
 				if( fPlot=="magnetic_field_abs" ){
-					Map->SetBinContent(fRsteps+i+1,fRsteps+j+1,tMagneticField.Magnitude());
+					Fill( aBins, i+1,fRsteps+j+1,tMagneticField.Magnitude());
 				}
 				else if( fPlot=="magnetic_field_z" ){
-					Map->SetBinContent(fRsteps+i+1,fRsteps+j+1,tMagneticField.Z());
+					Fill( aBins, i+1,fRsteps+j+1,tMagneticField.Z());
 				}
 				else if( fPlot=="magnetic_field_z_abs" ){
-					Map->SetBinContent(fRsteps+i+1,fRsteps+j+1,fabs(tMagneticField.Z()) );
+					Fill( aBins, i+1,fRsteps+j+1,fabs(tMagneticField.Z()) );
 				}
 				else if( fPlot=="magnetic_field_x" ){
-					Map->SetBinContent(i+1,fRsteps+j+1,tMagneticField.X());
+					Fill( aBins, i+1,fRsteps+j+1,tMagneticField.X());
 				}
 				else if( fPlot=="magnetic_field_x_abs" ){
-					Map->SetBinContent(i+1,fRsteps+j+1,fabs(tMagneticField.X()) );
+					Fill( aBins, i+1,fRsteps+j+1,fabs(tMagneticField.X()) );
 				}
 				else if( fPlot=="magnetic_field_y" ){
-					Map->SetBinContent(i+1,fRsteps+j+1,tMagneticField.Y());
+					Fill( aBins, i+1,fRsteps+j+1,tMagneticField.Y());
 				}
 				else if( fPlot=="magnetic_field_y_abs" ){
-					Map->SetBinContent(i+1,fRsteps+j+1,fabs(tMagneticField.Y()) );
+					Fill( aBins, i+1,fRsteps+j+1,fabs(tMagneticField.Y()) );
 				}
 				else if( fPlot=="magnetic_potential_abs" )
 				{
 					tMagField->CalculatePotential(tPosition,0.0,tPotential);
-					Map->SetBinContent(i+1,fRsteps+j+1,tPotential.Magnitude());
+					Fill( aBins, i+1,fRsteps+j+1,tPotential.Magnitude());
 				}
 				else if ( fPlot.compare(9, 8, "gradient") == 0 ){
+					KThreeVector tMagneticField_i, tMagneticField_j;
 					if( fGradNumerical==true) {
-						KThreeVector tMagneticField_z, tMagneticField_i, tMagneticField_j;
+						KThreeVector tMagneticField_x, tMagneticField_y;
 						if( fPlot=="magnetic_gradient_z" ){
-							tMagField->CalculateField(tPosition_z,0.0,tMagneticField_z);
-							Double_t tGradient = (tMagneticField_z.Magnitude()-tMagneticField.Magnitude())/tDeltaZ;
-							Map->SetBinContent(i+1,fRsteps+j+1, tGradient );
+							tMagField->CalculateField(tPosition_i,0.0,tMagneticField_i);
+							Double_t tGradient = (tMagneticField_i.Magnitude()-tMagneticField.Magnitude())/tDeltaZ;
+							Fill( aBins, i+1,fRsteps+j+1, tGradient );
 						}
 						else if( fPlot=="magnetic_gradient_z_abs" ){
-							tMagField->CalculateField(tPosition_z,0.0,tMagneticField_z);
-							Double_t tGradient = fabs((tMagneticField_z.Magnitude()-tMagneticField.Magnitude())/tDeltaZ);
-							Map->SetBinContent(i+1,fRsteps+j+1, tGradient );
+							tMagField->CalculateField(tPosition_i,0.0,tMagneticField_i);
+							Double_t tGradient = fabs((tMagneticField_i.Magnitude()-tMagneticField.Magnitude())/tDeltaZ);
+							Fill( aBins, i+1,fRsteps+j+1, tGradient );
 						}
 						else if( fPlot=="magnetic_gradient_x" ){
-							tMagField->CalculateField(tPosition_i,0.0,tMagneticField_i);
-							Double_t tGradient = (tMagneticField_i.Magnitude()-tMagneticField.Magnitude())/tDeltaR;
-							Map->SetBinContent(i+1,fRsteps+j+1, tGradient );
+							tMagField->CalculateField(tPosition_x,0.0,tMagneticField_x);
+							Double_t tGradient = (tMagneticField_x.Magnitude()-tMagneticField.Magnitude())/tDeltaR;
+							Fill( aBins, i+1,fRsteps+j+1, tGradient );
 						}
 						else if( fPlot=="magnetic_gradient_x_abs" ){
-							tMagField->CalculateField(tPosition_i,0.0,tMagneticField_i);
-							Double_t tGradient = fabs((tMagneticField_i.Magnitude()-tMagneticField.Magnitude())/tDeltaR);
-							Map->SetBinContent(i+1,fRsteps+j+1, tGradient );
+							tMagField->CalculateField(tPosition_j,0.0,tMagneticField_x);
+							Double_t tGradient = fabs((tMagneticField_x.Magnitude()-tMagneticField.Magnitude())/tDeltaR);
+							Fill( aBins, i+1,fRsteps+j+1, tGradient );
 						}
 						else if( fPlot=="magnetic_gradient_y" ){
-							tMagField->CalculateField(tPosition_j,0.0,tMagneticField_j);
-							Double_t tGradient = (tMagneticField_j.Magnitude()-tMagneticField.Magnitude())/tDeltaR;
-							Map->SetBinContent(i+1,fRsteps+j+1, tGradient );
+							tMagField->CalculateField(tPosition_y,0.0,tMagneticField_y);
+							Double_t tGradient = (tMagneticField_y.Magnitude()-tMagneticField.Magnitude())/tDeltaR;
+							Fill( aBins, i+1,fRsteps+j+1, tGradient );
 						}
 						else if( fPlot=="magnetic_gradient_y_abs" ){
-							tMagField->CalculateField(tPosition_j,0.0,tMagneticField_j);
-							Double_t tGradient = fabs((tMagneticField_j.Magnitude()-tMagneticField.Magnitude())/tDeltaR);
-							Map->SetBinContent(i+1,fRsteps+j+1, tGradient );
+							tMagField->CalculateField(tPosition_j,0.0,tMagneticField_y);
+							Double_t tGradient = fabs((tMagneticField_y.Magnitude()-tMagneticField.Magnitude())/tDeltaR);
+							Fill( aBins, i+1,fRsteps+j+1, tGradient );
 						}
 					}
 					else if( fGradNumerical==false){
-//						calculate gradient matrix
+//							calculate gradient matrix
 						tMagField->CalculateGradient(tPosition,0.0,tGradient);
 						KThreeVector tGradB;
 						tGradB.SetX(tMagneticField.X()*tGradient[0]+tMagneticField.Y()*tGradient[1]+tMagneticField.Z()*tGradient[2]);
@@ -377,45 +257,231 @@ namespace Kassiopeia
 						tGradB.SetZ(tMagneticField.X()*tGradient[6]+tMagneticField.Y()*tGradient[7]+tMagneticField.Z()*tGradient[8]);
 						tGradB *= tMagneticField.Magnitude();
 						if( fPlot=="magnetic_gradient_abs" ){
-							Map->SetBinContent(i+1,fRsteps+j+1, tGradB.Magnitude() );
+							Fill( aBins, i+1,fRsteps+j+1, tGradB.Magnitude() );
 						}
 						else if( fPlot=="magnetic_gradient_z" ){
-							Map->SetBinContent(i+1,fRsteps+j+1, tGradB.Z() );
+							Fill( aBins, i+1,fRsteps+j+1, tGradB.Z() );
 						}
 						else if( fPlot=="magnetic_gradient_z_abs" ){
-							Map->SetBinContent(i+1,fRsteps+j+1, fabs(tGradB.Z()) );
+							Fill( aBins, i+1,fRsteps+j+1, fabs(tGradB.Z()) );
 						}
-						else if( fPlot=="magnetic_gradient_x" ){
-							Map->SetBinContent(i+1,fRsteps+j+1, tGradB.X() );
+						else if( fPlot=="magnetic_gradient_x"){
+							Fill( aBins, i+1,fRsteps+j+1, tGradB.X() );
 						}
 						else if( fPlot=="magnetic_gradient_x_abs" ){
-							Map->SetBinContent(i+1,fRsteps+j+1, fabs(tGradB.X()) );
+							Fill( aBins, i+1,fRsteps+j+1, fabs(tGradB.X()) );
 						}
-						else if( fPlot=="magnetic_gradient_y" ){
-							Map->SetBinContent(i+1,fRsteps+j+1, tGradB.Y() );
+						else if( fPlot=="magnetic_gradient_y"){
+							Fill( aBins, i+1,fRsteps+j+1, tGradB.Y() );
 						}
 						else if( fPlot=="magnetic_gradient_y_abs" ){
-							Map->SetBinContent(i+1,fRsteps+j+1, fabs(tGradB.Y()) );
+							Fill( aBins, i+1,fRsteps+j+1, fabs(tGradB.Y()) );
 						}
 					}
 				}
-				else {
-					vismsg( eError ) << "do not know what to plot" << eom;
+			}
+		}
+
+		return;
+    }
+
+    void KSROOTMagFieldPainter::FieldMapXRow( KSMagneticField* tMagField, int i, double tDeltaZ, double tDeltaR, std::vector< MapBin >& aBins ){
+		double tR_i = i * tDeltaR;
+		double tR_j;
+
+//		calculate magnetic field at all positions of the row in one batch, requested by any further calculation
+		std::vector< KThreeVector > tPositions;
+		for ( int j=fRsteps; j>=-fRsteps;j--){
+			tR_j = j * tDeltaR;
+			tPositions.push_back( KThreeVector(tR_i, tR_j, fZfix) );
+		}
+		std::vector< double > tTimes( tPositions.size(), 0.0 );
+		std::vector< KThreeVector > tMagneticFields;
+		tMagField->CalculateFields( tPositions, tTimes, tMagneticFields );
+
+		KThreeVector tPosition_i, tPosition_j, tPosition_z;
+		KThreeVector tPotential;
+		KThreeMatrix tGradient;
+		for ( int j=fRsteps; j>=-fRsteps;j--){
+			tR_j = j * tDeltaR;
+			const KThreeVector& tPosition = tPositions[ fRsteps-j ];
+			const KThreeVector& tMagneticField = tMagneticFields[ fRsteps-j ];
+
+			tPosition_z.SetComponents(tR_i, tR_j, fZfix+tDeltaZ);
+			tPosition_i.SetComponents(tR_i+tDeltaR, tR_j, fZfix);
+			tPosition_j.SetComponents(tR_i, tR_j+tDeltaR, fZfix);
+			if( fPlot=="magnetic_field_abs" ){
+				Fill( aBins, fRsteps+i+1,fRsteps+j+1,tMagneticField.Magnitude());
+			}
+			else if( fPlot=="magnetic_field_z" ){
+				Fill( aBins, fRsteps+i+1,fRsteps+j+1,tMagneticField.Z());
+			}
+			else if( fPlot=="magnetic_field_z_abs" ){
+				Fill( aBins, fRsteps+i+1,fRsteps+j+1,fabs(tMagneticField.Z()) );
+			}
+			else if( fPlot=="magnetic_field_x" ){
+				Fill( aBins, i+1,fRsteps+j+1,tMagneticField.X());
+			}
+			else if( fPlot=="magnetic_field_x_abs" ){
+				Fill( aBins, i+1,fRsteps+j+1,fabs(tMagneticField.X()) );
+			}
+			else if( fPlot=="magnetic_field_y" ){
+				Fill( aBins, i+1,fRsteps+j+1,tMagneticField.Y());
+			}
+			else if( fPlot=="magnetic_field_y_abs" ){
+				Fill( aBins, i+1,fRsteps+j+1,fabs(tMagneticField.Y()) );
+			}
+			else if( fPlot=="magnetic_potential_abs" )
+			{
+				tMagField->CalculatePotential(tPosition,0.0,tPotential);
+				Fill( aBins, i+1,fRsteps+j+1,tPotential.Magnitude());
+			}
+			else if ( fPlot.compare(9, 8, "gradient") == 0 ){
+				if( fGradNumerical==true) {
+					KThreeVector tMagneticField_z, tMagneticField_i, tMagneticField_j;
+					if( fPlot=="magnetic_gradient_z" ){
+						tMagField->CalculateField(tPosition_z,0.0,tMagneticField_z);
+						Double_t tGradient = (tMagneticField_z.Magnitude()-tMagneticField.Magnitude())/tDeltaZ;
+						Fill( aBins, i+1,fRsteps+j+1, tGradient );
+					}
+					else if( fPlot=="magnetic_gradient_z_abs" ){
+						tMagField->CalculateField(tPosition_z,0.0,tMagneticField_z);
+						Double_t tGradient = fabs((tMagneticField_z.Magnitude()-tMagneticField.Magnitude())/tDeltaZ);
+						Fill( aBins, i+1,fRsteps+j+1, tGradient );
+					}
+					else if( fPlot=="magnetic_gradient_x" ){
+						tMagField->CalculateField(tPosition_i,0.0,tMagneticField_i);
+						Double_t tGradient = (tMagneticField_i.Magnitude()-tMagneticField.Magnitude())/tDeltaR;
+						Fill( aBins, i+1,fRsteps+j+1, tGradient );
+					}
+					else if( fPlot=="magnetic_gradient_x_abs" ){
+						tMagField->CalculateField(tPosition_i,0.0,tMagneticField_i);
+						Double_t tGradient = fabs((tMagneticField_i.Magnitude()-tMagneticField.Magnitude())/tDeltaR);
+						Fill( aBins, i+1,fRsteps+j+1, tGradient );
+					}
+					else if( fPlot=="magnetic_gradient_y" ){
+						tMagField->CalculateField(tPosition_j,0.0,tMagneticField_j);
+						Double_t tGradient = (tMagneticField_j.Magnitude()-tMagneticField.Magnitude())/tDeltaR;
+						Fill( aBins, i+1,fRsteps+j+1, tGradient );
+					}
+					else if( fPlot=="magnetic_gradient_y_abs" ){
+						tMagField->CalculateField(tPosition_j,0.0,tMagneticField_j);
+						Double_t tGradient = fabs((tMagneticField_j.Magnitude()-tMagneticField.Magnitude())/tDeltaR);
+						Fill( aBins, i+1,fRsteps+j+1, tGradient );
+					}
+				}
+				else if( fGradNumerical==false){
+//						calculate gradient matrix
+					tMagField->CalculateGradient(tPosition,0.0,tGradient);
+					KThreeVector tGradB;
+					tGradB.SetX(tMagneticField.X()*tGradient[0]+tMagneticField.Y()*tGradient[1]+tMagneticField.Z()*tGradient[2]);
+					tGradB.SetY(tMagneticField.X()*tGradient[3]+tMagneticField.Y()*tGradient[4]+tMagneticField.Z()*tGradient[5]);
+					tGradB.SetZ(tMagneticField.X()*tGradient[6]+tMagneticField.Y()*tGradient[7]+tMagneticField.Z()*tGradient[8]);
+					tGradB *= tMagneticField.Magnitude();
+					if( fPlot=="magnetic_gradient_abs" ){
+						Fill( aBins, i+1,fRsteps+j+1, tGradB.Magnitude() );
+					}
+					else if( fPlot=="magnetic_gradient_z" ){
+						Fill( aBins, i+1,fRsteps+j+1, tGradB.Z() );
+					}
+					else if( fPlot=="magnetic_gradient_z_abs" ){
+						Fill( aBins, i+1,fRsteps+j+1, fabs(tGradB.Z()) );
+					}
+					else if( fPlot=="magnetic_gradient_x" ){
+						Fill( aBins, i+1,fRsteps+j+1, tGradB.X() );
+					}
+					else if( fPlot=="magnetic_gradient_x_abs" ){
+						Fill( aBins, i+1,fRsteps+j+1, fabs(tGradB.X()) );
+					}
+					else if( fPlot=="magnetic_gradient_y" ){
+						Fill( aBins, i+1,fRsteps+j+1, tGradB.Y() );
+					}
+					else if( fPlot=="magnetic_gradient_y_abs" ){
+						Fill( aBins, i+1,fRsteps+j+1, fabs(tGradB.Y()) );
+					}
 				}
 			}
 		}
-		fMap=Map;
 
 		return;
     }
 
+    void KSROOTMagFieldPainter::Fill( std::vector< MapBin >& aBins, int aBinX, int aBinY, double aValue ){
+		MapBin tBin;
+		tBin.fBinX = aBinX;
+		tBin.fBinY = aBinY;
+		tBin.fValue = aValue;
+		aBins.push_back( tBin );
+		return;
+    }
+
+    void KSROOTMagFieldPainter::FillMap( TH2D* aMap, const std::vector< std::vector< MapBin > >& aRows ){
+//		fill in the order of the serial calculation, so bins written by several rows get the same content
+		for( unsigned int tRow = 0; tRow < aRows.size(); tRow++ ){
+			for( unsigned int tBin = 0; tBin < aRows[ tRow ].size(); tBin++ ){
+				const MapBin& tMapBin = aRows[ tRow ][ tBin ];
+				aMap->SetBinContent( tMapBin.fBinX, tMapBin.fBinY, tMapBin.fValue );
+			}
+		}
+		return;
+    }
+
+    KSROOTMagFieldPainter::RowLoop::RowLoop( KSROOTMagFieldPainter* aPainter, KSMagneticField* aField, bool aZMap, double aDeltaZ, double aDeltaR, std::vector< std::vector< MapBin > >& aRows ) :
+            KSParallelLoop(),
+            fPainter( aPainter ),
+            fField( aField ),
+            fZMap( aZMap ),
+            fDeltaZ( aDeltaZ ),
+            fDeltaR( aDeltaR ),
+            fRows( aRows )
+    {
+    }
+    KSROOTMagFieldPainter::RowLoop::~RowLoop()
+    {
+    }
+
+    void KSROOTMagFieldPainter::RowLoop::Iteration( const unsigned int& anIndex )
+    {
+        if( fZMap == true )
+        {
+            fPainter->FieldMapZRow( fField, anIndex, fDeltaZ, fDeltaR, fRows[ anIndex ] );
+        }
+        else
+        {
+            fPainter->FieldMapXRow( fField, fPainter->fRsteps - anIndex, fDeltaZ, fDeltaR, fRows[ anIndex ] );
+        }
+        return;
+    }
+    void KSROOTMagFieldPainter::RowLoop::Progress( const unsigned int& aFinished, const unsigned int& aCount )
+    {
+        if( fZMap == true )
+        {
+            vismsg( eNormal ) << "map: Z Position: " << aFinished <<"/" << aCount << reom;
+        }
+        else
+        {
+            vismsg( eNormal ) << "map: R Position: " << aFinished <<"/" << aCount << reom;
+        }
+        return;
+    }
+
     void KSROOTMagFieldPainter::Render(){
 		vismsg(eNormal) << "Getting magnetic field <" << fMagneticFieldName << "> from the toolbox" << eom;
 		KSMagneticField* tMagField = getMagneticField( fMagneticFieldName );
 		if ( tMagField == NULL)
 			vismsg(eError) << "No magnetic Field!" << eom;
+		unsigned int tThreads = fThreads;
+		if ( tThreads != 1 && tMagField->IsThreadSafe() == false ) {
+			vismsg(eWarning) << "magnetic field <" << fMagneticFieldName << "> is not marked thread safe, calculating the map with one thread instead of " << fThreads << eom;
+			tThreads = 1;
+		}
+//		the rows rely on this check and do not report unknown plots from the worker threads
 		if ( fPlot!="magnetic_field_abs" && fPlot!="magnetic_field_x" && fPlot!="magnetic_field_x_abs"&& fPlot!="magnetic_field_y" && fPlot!="magnetic_field_y_abs" && fPlot!="magnetic_field_z" && fPlot!="magnetic_field_z_abs" && fPlot!="magnetic_potential_abs" && fPlot!="magnetic_gradient_z" && fPlot!="magnetic_gradient_z_abs" && fPlot!="magnetic_gradient_x" && fPlot!="magnetic_gradient_x_abs" && fPlot!="magnetic_gradient_y" && fPlot!="magnetic_gradient_y_abs" )
 			vismsg ( eError ) << "do not know what to plot, plot=<"<<fPlot<<"> is not defined in KSROOTMagFieldPainter" << eom;
+		if ( fXAxis=="z" && fYAxis!="y" && fYAxis!="x" )
+			vismsg(eError) << "Please use x or y for the Y-Axis and z for the X-Axis. All other combinations are not yet included" << eom;
+		if ( fXAxis=="x" && fYAxis!="y" )
+			vismsg(eError) << "Please use x for the X-Axis and y for the Y-Axis. All other combinations are not yet included for the xy FieldMap" << eom;
 		vismsg(eNormal) << "Initialize magnetic field (again)" << eom;
 		tMagField->Initialize();
 
@@ -424,11 +490,11 @@ namespace Kassiopeia
 
 		if ( fXAxis=="z" ) {
 			vismsg( eNormal ) << "initializing z field map with root_window_x=" << fXAxis << " and root_window_y=" << fYAxis << eom;
-			FieldMapZ( tMagField, tDeltaZ, tDeltaR );
+			FieldMapZ( tMagField, tDeltaZ, tDeltaR, tThreads );
 		}
 		else if ( fXAxis=="x" ) {
 			vismsg( eNormal ) << "initializing xy field map with root_window_x=" << fXAxis << " and root_window_y=" << fYAxis << eom;
-			FieldMapX( tMagField, tDeltaZ, tDeltaR );
+			FieldMapX( tMagField, tDeltaZ, tDeltaR, tThreads );
 		}
 		else vismsg ( eError ) << "accept only x or z for x_axis " << eom;
 
@@ -17,7 +17,8 @@ namespace Kassiopeia
             fYAxis( "y" ),
             fCalcPot(1),
             fMap(),
-            fComparison( false )
+            fComparison( false ),
+            fThreads( 1 )
     {
     }
     KSROOTPotentialPainter::~KSROOTPotentialPainter()
@@ -47,116 +48,146 @@ namespace Kassiopeia
             tRefField->Initialize();
         }
 
+        if( fYAxis!="y" && fYAxis!="x" )
+            vismsg(eError) << "Please use x or y for the Y-Axis and z for the X-Axis. All other combinations are not yet included" << eom;
+
+        unsigned int tThreads = fThreads;
+        if( tThreads != 1 && ( tElField->IsThreadSafe() == false || ( tRefField != NULL && tRefField->IsThreadSafe() == false ) ) )
+        {
+            vismsg(eWarning) << "electric field <" << (tElField->IsThreadSafe() ? fReferenceFieldName : fElectricFieldName) << "> is not marked thread safe, calculating the map with one thread instead of " << fThreads << eom;
+            tThreads = 1;
+        }
+
         double tDeltaZ = fabs(fZmax-fZmin)/fZsteps;
         double tDeltaR = fabs(fRmax)/fRsteps;
-        double tZ,tR;
         TH2D* Map = new TH2D("Map", "Map", fZsteps,fZmin,fZmax,2*fRsteps,-fRmax,fRmax);
-        KThreeVector tPosition;
 
-        KThreeVector ElectricField;
-        Double_t tPotential;
+        vismsg(eNormal) << "start calculating potential map" << eom;
+
+        std::vector< std::vector< MapBin > > tRows( fZsteps );
+        RowLoop tLoop( this, tElField, tRefField, tDeltaZ, tDeltaR, tRows );
+        tLoop.SetNumberOfThreads( tThreads );
+        tLoop.Run( fZsteps );
 
-        KThreeVector tRefElectricField;
-        Double_t tRefPotential;
+        // fill in the order of the serial calculation, so the bin on the axis gets the same content
+        for( unsigned int tRow = 0; tRow < tRows.size(); tRow++ )
+        {
+            for( unsigned int tBin = 0; tBin < tRows[ tRow ].size(); tBin++ )
+            {
+                const MapBin& tMapBin = tRows[ tRow ][ tBin ];
+                Map->SetBinContent( tMapBin.fBinX, tMapBin.fBinY, tMapBin.fValue );
+            }
+        }
 
-        Double_t tRelError = 0.;
+        fMap=Map;
 
-        vismsg(eNormal) << "start calculating potential map" << eom;
-        for( int i=0; i<fZsteps; i++)
+        return;
+    }
+
+    void KSROOTPotentialPainter::MapRow( KSElectricField* tElField, KSElectricField* tRefField, int i, double tDeltaZ, double tDeltaR, std::vector< MapBin >& aBins )
+    {
+        double tZ = fZmin + i* tDeltaZ;
+        double tR;
+
+        // sample points of the row, alternating between -R and +R
+        std::vector< KThreeVector > tPositions;
+        for ( int j=fRsteps; j>=0;j--)
+        {
+            tR = j * tDeltaR;
+            if(fYAxis=="y")
+            {
+                tPositions.push_back( KThreeVector(0.,-tR,tZ) );
+                tPositions.push_back( KThreeVector(0.,tR,tZ) );
+            }
+            else
+            {
+                tPositions.push_back( KThreeVector(-tR,0.,tZ) );
+                tPositions.push_back( KThreeVector(tR,0.,tZ) );
+            }
+        }
+
+        std::vector< double > tValues( tPositions.size(), 0. );
+        if(fCalcPot==0)
         {
-            tZ = fZmin + i* tDeltaZ;
-            vismsg( eNormal ) << "Electric Field: Z Position: " << i <<"/" << fZsteps << reom;
+            // the electric field of the whole row is calculated in one batch
+            std::vector< double > tTimes( tPositions.size(), 0.0 );
+            std::vector< KThreeVector > ElectricFields;
+            tElField->CalculateFields( tPositions, tTimes, ElectricFields );
 
-            for ( int j=fRsteps; j>=0;j--)
+            if( !fComparison )
             {
-                tR = j * tDeltaR;
+                for( unsigned int k = 0; k < tPositions.size(); k++ )
+                    tValues[k] = ElectricFields[k].Magnitude();
+            }
+            else
+            {
+                std::vector< KThreeVector > tRefElectricFields;
+                tRefField->CalculateFields( tPositions, tTimes, tRefElectricFields );
 
-                if(fCalcPot==0)
+                for( unsigned int k = 0; k < tPositions.size(); k++ )
+                    tValues[k] = fabs((ElectricFields[k].X()-tRefElectricFields[k].X())+(ElectricFields[k].Y()-tRefElectricFields[k].Y())+(ElectricFields[k].Z()-tRefElectricFields[k].Z()));
+            }
+        }
+        else
+        {
+            double tPotential;
+            double tRefPotential;
+            for( unsigned int k = 0; k < tPositions.size(); k++ )
+            {
+                tElField->CalculatePotential(tPositions[k],0.0,tPotential);
+                if( !fComparison )
                 {
-                    if( !fComparison )
-                    {
-                        if(fYAxis=="y") tPosition.SetComponents(0.,-tR,tZ);
-                        else if(fYAxis=="x") tPosition.SetComponents(-tR,0.,tZ);
-                        else vismsg(eError) << "Please use x or y for the Y-Axis and z for the X-Axis. All other combinations are not yet included" << eom;
-
-                        tElField->CalculateField(tPosition,0.0,ElectricField);
-                        Map->SetBinContent(i+1,fRsteps-j+1,ElectricField.Magnitude());
-
-                        if(fYAxis=="y") tPosition.SetComponents(0.,tR,tZ);
-                        else if(fYAxis=="x") tPosition.SetComponents(tR,0.,tZ);
-                        else vismsg(eError) << "Please use x or y for the Y-Axis and z for the X-Axis. All other combinations are not yet included" << eom;
-
-                        tElField->CalculateField(tPosition,0.0,ElectricField);
-                        Map->SetBinContent(i+1,fRsteps+j+1,ElectricField.Magnitude());
-                    }
-                    else
-                    {
-                        if(fYAxis=="y") tPosition.SetComponents(0.,-tR,tZ);
-                        else if(fYAxis=="x") tPosition.SetComponents(-tR,0.,tZ);
-                        else vismsg(eError) << "Please use x or y for the Y-Axis and z for the X-Axis. All other combinations are not yet included" << eom;
-
-                        tElField->CalculateField(tPosition,0.0,ElectricField);
-                        tRefField->CalculateField(tPosition,0.0,tRefElectricField);
-
-                        tRelError = fabs((ElectricField.X()-tRefElectricField.X())+(ElectricField.Y()-tRefElectricField.Y())+(ElectricField.Z()-tRefElectricField.Z()));
-                        Map->SetBinContent(i+1,fRsteps-j+1,tRelError);
-
-                        if(fYAxis=="y") tPosition.SetComponents(0.,tR,tZ);
-                        else if(fYAxis=="x") tPosition.SetComponents(tR,0.,tZ);
-                        else vismsg(eError) << "Please use x or y for the Y-Axis and z for the X-Axis. All other combinations are not yet included" << eom;
-
-                        tElField->CalculateField(tPosition,0.0,ElectricField);
-                        tRefField->CalculateField(tPosition,0.0,tRefElectricField);
-
-                        tRelError = fabs((ElectricField.X()-tRefElectricField.X())+(ElectricField.Y()-tRefElectricField.Y())+(ElectricField.Z()-tRefElectricField.Z()));
-                        Map->SetBinContent(i+1,fRsteps+j+1,tRelError);
-                    }
+                    tValues[k] = tPotential;
                 }
                 else
                 {
-                    if( !fComparison )
-                    {
-                        if(fYAxis=="y") tPosition.SetComponents(0.,-tR,tZ);
-                        else if(fYAxis=="x") tPosition.SetComponents(-tR,0.,tZ);
-                        else vismsg(eError) << "Please use x or y for the Y-Axis and z for the X-Axis. All other combinations are not yet included" << eom;
-
-                        tElField->CalculatePotential(tPosition,0.0,tPotential);
-                        Map->SetBinContent(i+1,fRsteps-j+1,tPotential);
-
-                        if(fYAxis=="y") tPosition.SetComponents(0.,tR,tZ);
-                        else if(fYAxis=="x") tPosition.SetComponents(tR,0.,tZ);
-                        else vismsg(eError) << "Please use x or y for the Y-Axis and z for the X-Axis. All other combinations are not yet included" << eom;
-
-                        tElField->CalculatePotential(tPosition,0.0,tPotential);
-                        Map->SetBinContent(i+1,fRsteps+j+1,tPotential);
-                    }
-                    else
-                    {
-                        if(fYAxis=="y") tPosition.SetComponents(0.,-tR,tZ);
-                        else if(fYAxis=="x") tPosition.SetComponents(-tR,0.,tZ);
-                        else vismsg(eError) << "Please use x or y for the Y-Axis and z for the X-Axis. All other combinations are not yet included" << eom;
-
-                        tElField->CalculatePotential(tPosition,0.0,tPotential);
-                        tRefField->CalculatePotential(tPosition,0.0,tRefPotential);
-                        tRelError = fabs(tPotential-tRefPotential);
-                        Map->SetBinContent(i+1,fRsteps-j+1,tRelError);
-
-                        if(fYAxis=="y") tPosition.SetComponents(0.,tR,tZ);
-                        else if(fYAxis=="x") tPosition.SetComponents(tR,0.,tZ);
-                        else vismsg(eError) << "Please use x or y for the Y-Axis and z for the X-Axis. All other combinations are not yet included" << eom;
-
-                        tElField->CalculatePotential(tPosition,0.0,tPotential);
-                        tRefField->CalculatePotential(tPosition,0.0,tRefPotential);
-                        tRelError = fabs(tPotential-tRefPotential);
-                        Map->SetBinContent(i+1,fRsteps+j+1,tRelError);
-                    }
+                    tRefField->CalculatePotential(tPositions[k],0.0,tRefPotential);
+                    tValues[k] = fabs(tPotential-tRefPotential);
                 }
             }
+        }
 
+        for ( int j=fRsteps; j>=0;j--)
+        {
+            Fill( aBins, i+1, fRsteps-j+1, tValues[ 2*(fRsteps-j) ] );
+            Fill( aBins, i+1, fRsteps+j+1, tValues[ 2*(fRsteps-j)+1 ] );
         }
 
-        fMap=Map;
+        return;
+    }
+
+    void KSROOTPotentialPainter::Fill( std::vector< MapBin >& aBins, int aBinX, int aBinY, double aValue )
+    {
+        MapBin tBin;
+        tBin.fBinX = aBinX;
+        tBin.fBinY = aBinY;
+        tBin.fValue = aValue;
+        aBins.push_back( tBin );
+        return;
+    }
+
+    KSROOTPotentialPainter::RowLoop::RowLoop( KSROOTPotentialPainter* aPainter, KSElectricField* aField, KSElectricField* aReferenceField, double aDeltaZ, double aDeltaR, std::vector< std::vector< MapBin > >& aRows ) :
+            KSParallelLoop(),
+            fPainter( aPainter ),
+            fField( aField ),
+            fReferenceField( aReferenceField ),
+            fDeltaZ( aDeltaZ ),
+            fDeltaR( aDeltaR ),
+            fRows( aRows )
+    {
+    }
+    KSROOTPotentialPainter::RowLoop::~RowLoop()
+    {
+    }
 
+    void KSROOTPotentialPainter::RowLoop::Iteration( const unsigned int& anIndex )
+    {
+        fPainter->MapRow( fField, fReferenceField, anIndex, fDeltaZ, fDeltaR, fRows[ anIndex ] );
+        return;
+    }
+    void KSROOTPotentialPainter::RowLoop::Progress( const unsigned int& aFinished, const unsigned int& aCount )
+    {
+        vismsg( eNormal ) << "Electric Field: Z Position: " << aFinished <<"/" << aCount << reom;
         return;
     }
 
@@ -15,6 +15,7 @@ namespace katrin
         fResolvedPath( "" ),
         fResolvedBase( "" ),
         fResolvedName( "" ),
+        fSkippedNames(),
         fState( eClosed )
     {
     }
@@ -60,12 +61,17 @@ namespace katrin
     {
         return fResolvedName;
     }
+    const vector< string >& KFile::GetSkippedNames() const
+    {
+        return fSkippedNames;
+    }
 
     bool KFile::Open( Mode aMode )
     {
         if( fState == eClosed )
         {
             string tFileName;
+            fSkippedNames.clear();
 
             //first look through explicit filenames
             vector< string >::iterator tNameIt;
@@ -85,6 +91,7 @@ namespace katrin
                     fState = eOpen;
                     return true;
                 }
+                fSkippedNames.push_back( tFileName );
 
             }
 
@@ -109,6 +116,7 @@ namespace katrin
                         fState = eOpen;
                         return true;
                     }
+                    fSkippedNames.push_back( tFileName );
                 }
             }
 
@@ -130,6 +138,7 @@ namespace katrin
 						fState = eOpen;
 						return true;
 					}
+					fSkippedNames.push_back( tFileName );
 				}
             }
 
@@ -151,6 +160,7 @@ namespace katrin
 						fState = eOpen;
 						return true;
 					}
+					fSkippedNames.push_back( tFileName );
 				}
             }
 
@@ -170,6 +180,7 @@ namespace katrin
                     fState = eOpen;
                     return true;
                 }
+                fSkippedNames.push_back( tFileName );
             }
 
             filemsg << "could not open file with the following specifications:" << ret;
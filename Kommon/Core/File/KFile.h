@@ -61,6 +61,9 @@ namespace katrin
             const std::string& GetBase() const;
             const std::string& GetName() const;
 
+            //candidate names tried by the last call to Open that could not be opened
+            const std::vector< std::string >& GetSkippedNames() const;
+
         protected:
             std::vector< std::string > fPaths;
             std::string fDefaultPath;
@@ -70,6 +73,7 @@ namespace katrin
             std::string fResolvedPath;
             std::string fResolvedBase;
             std::string fResolvedName;
+            std::vector< std::string > fSkippedNames;
 
         public:
             typedef enum
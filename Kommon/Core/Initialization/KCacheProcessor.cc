@@ -0,0 +1,608 @@
+#include "KCacheProcessor.hh"
+#include "KVariableProcessor.hh"
+#include "KIncludeProcessor.hh"
+#include "KInitializationMessage.hh"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <set>
+
+#include <unistd.h>
+
+using namespace std;
+
+namespace katrin
+{
+
+    namespace
+    {
+        const string sCacheHeader = string( "KXMLCache 2" );
+
+        void WriteString( ostream& aStream, const string& aString )
+        {
+            aStream << aString.size() << ':' << aString;
+            return;
+        }
+
+        //reads numbers and length prefixed strings from the cache file content
+        class CacheReader
+        {
+            public:
+                CacheReader( const string& aContent, const size_t& aPosition ) :
+                        fContent( aContent ),
+                        fPosition( aPosition )
+                {
+                }
+
+                bool ReadNumber( size_t& aNumber )
+                {
+                    while( fPosition < fContent.size() && (fContent[ fPosition ] == ' ' || fContent[ fPosition ] == '\n') )
+                    {
+                        fPosition++;
+                    }
+                    if( fPosition >= fContent.size() || fContent[ fPosition ] < '0' || fContent[ fPosition ] > '9' )
+                    {
+                        return false;
+                    }
+                    aNumber = 0;
+                    while( fPosition < fContent.size() && fContent[ fPosition ] >= '0' && fContent[ fPosition ] <= '9' )
+                    {
+                        aNumber = 10 * aNumber + (fContent[ fPosition ] - '0');
+                        fPosition++;
+                    }
+                    return true;
+                }
+                bool ReadString( string& aString )
+                {
+                    size_t tSize;
+                    if( ReadNumber( tSize ) == false || fPosition >= fContent.size() || fContent[ fPosition ] != ':' || tSize > fContent.size() - fPosition - 1 )
+                    {
+                        return false;
+                    }
+                    aString.assign( fContent, fPosition + 1, tSize );
+                    fPosition += tSize + 1;
+                    return true;
+                }
+
+            private:
+                const string& fContent;
+                size_t fPosition;
+        };
+    }
+
+    KCacheProcessor::KCacheProcessor() :
+            fCacheFile( "" ),
+            fExternalMap(),
+            fVariableProcessor( NULL ),
+            fIncludeProcessor( NULL ),
+            fDepth( 0 ),
+            fFailed( false ),
+            fFiles(),
+            fRecords(),
+            fStrings(),
+            fStringIndices()
+    {
+    }
+    KCacheProcessor::KCacheProcessor( const VariableMap& anExternalMap ) :
+            fCacheFile( "" ),
+            fExternalMap( anExternalMap ),
+            fVariableProcessor( NULL ),
+            fIncludeProcessor( NULL ),
+            fDepth( 0 ),
+            fFailed( false ),
+            fFiles(),
+            fRecords(),
+            fStrings(),
+            fStringIndices()
+    {
+    }
+    KCacheProcessor::~KCacheProcessor()
+    {
+        Clear();
+    }
+
+    void KCacheProcessor::SetCacheFile( const string& aCacheFile )
+    {
+        fCacheFile = aCacheFile;
+        return;
+    }
+    const string& KCacheProcessor::GetCacheFile() const
+    {
+        return fCacheFile;
+    }
+    void KCacheProcessor::SetVariableProcessor( const KVariableProcessor* aProcessor )
+    {
+        fVariableProcessor = aProcessor;
+        return;
+    }
+    void KCacheProcessor::SetIncludeProcessor( const KIncludeProcessor* aProcessor )
+    {
+        fIncludeProcessor = aProcessor;
+        return;
+    }
+
+    bool KCacheProcessor::Load()
+    {
+        Clear();
+
+        string tContent;
+        if( ReadFile( fCacheFile, tContent ) == false )
+        {
+            return false;
+        }
+
+        if( tContent.compare( 0, sCacheHeader.size() + 1, sCacheHeader + string( "\n" ) ) != 0 )
+        {
+            initmsg( eWarning ) << "ignoring configuration cache <" << fCacheFile << "> with unknown format" << eom;
+            return false;
+        }
+        CacheReader tReader( tContent, sCacheHeader.size() + 1 );
+
+        //every parsed file must still have the same content
+        size_t tCount;
+        string tName;
+        string tHash;
+        string tFileContent;
+        if( tReader.ReadNumber( tCount ) == false )
+        {
+            return false;
+        }
+        for( size_t tIndex = 0; tIndex < tCount; tIndex++ )
+        {
+            if( tReader.ReadString( tName ) == false || tReader.ReadString( tHash ) == false )
+            {
+                initmsg( eWarning ) << "ignoring damaged configuration cache <" << fCacheFile << ">" << eom;
+                Clear();
+                return false;
+            }
+            if( ReadFile( tName, tFileContent ) == false || Hash( tFileContent ) != tHash )
+            {
+                initmsg_debug( "configuration cache is out of date, file <" << tName << "> has changed" << eom );
+                Clear();
+                return false;
+            }
+            fFiles.push_back( tName );
+        }
+
+        //no include candidate that was skipped may have appeared since
+        if( tReader.ReadNumber( tCount ) == false )
+        {
+            Clear();
+            return false;
+        }
+        for( size_t tIndex = 0; tIndex < tCount; tIndex++ )
+        {
+            if( tReader.ReadString( tName ) == false )
+            {
+                initmsg( eWarning ) << "ignoring damaged configuration cache <" << fCacheFile << ">" << eom;
+                Clear();
+                return false;
+            }
+            if( ifstream( tName.c_str() ).is_open() == true )
+            {
+                initmsg_debug( "configuration cache is out of date, file <" << tName << "> now exists" << eom );
+                Clear();
+                return false;
+            }
+        }
+
+        //every external variable that was looked up must still have the same value
+        if( tReader.ReadNumber( tCount ) == false )
+        {
+            Clear();
+            return false;
+        }
+        for( size_t tIndex = 0; tIndex < tCount; tIndex++ )
+        {
+            if( tReader.ReadString( tName ) == false || tReader.ReadString( tHash ) == false )
+            {
+                initmsg( eWarning ) << "ignoring damaged configuration cache <" << fCacheFile << ">" << eom;
+                Clear();
+                return false;
+            }
+            if( HashVariable( fExternalMap, tName ) != tHash )
+            {
+                initmsg_debug( "configuration cache is out of date, variable <" << tName << "> has changed" << eom );
+                Clear();
+                return false;
+            }
+        }
+
+        //the table of paths and file names, then the token records
+        bool tValid = tReader.ReadNumber( tCount );
+        for( size_t tIndex = 0; tValid == true && tIndex < tCount; tIndex++ )
+        {
+            fStrings.push_back( string() );
+            tValid = tReader.ReadString( fStrings.back() );
+        }
+        tValid = tValid && tReader.ReadNumber( tCount );
+        if( tValid == true )
+        {
+            fRecords.resize( tCount );
+        }
+        size_t tType = 0;
+        size_t tLine = 0;
+        size_t tColumn = 0;
+        for( size_t tIndex = 0; tValid == true && tIndex < tCount; tIndex++ )
+        {
+            Record& tRecord = fRecords[ tIndex ];
+            tValid = tReader.ReadNumber( tType ) && tReader.ReadNumber( tLine ) && tReader.ReadNumber( tColumn ) && tReader.ReadString( tRecord.fValue ) && tReader.ReadNumber( tRecord.fPath ) && tReader.ReadNumber( tRecord.fFile );
+            tValid = tValid && tType <= (size_t) (eErrorToken) && tRecord.fPath < fStrings.size() && tRecord.fFile < fStrings.size();
+            tRecord.fType = (TokenType) (tType);
+            tRecord.fLine = (int) (tLine);
+            tRecord.fColumn = (int) (tColumn);
+        }
+        if( tValid == false )
+        {
+            initmsg( eWarning ) << "ignoring damaged configuration cache <" << fCacheFile << ">" << eom;
+            Clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    void KCacheProcessor::Replay()
+    {
+        //the stream is already complete, so it must not be recorded again
+        fFailed = true;
+
+        KBeginParsingToken tBeginParsing;
+        KBeginFileToken tBeginFile;
+        KBeginElementToken tBeginElement;
+        KBeginAttributeToken tBeginAttribute;
+        KAttributeDataToken tAttributeData;
+        KEndAttributeToken tEndAttribute;
+        KMidElementToken tMidElement;
+        KElementDataToken tElementData;
+        KEndElementToken tEndElement;
+        KEndFileToken tEndFile;
+        KEndParsingToken tEndParsing;
+        KCommentToken tComment;
+        KErrorToken tError;
+
+        for( vector< Record >::const_iterator tIt = fRecords.begin(); tIt != fRecords.end(); tIt++ )
+        {
+            switch( tIt->fType )
+            {
+                case eBeginParsingToken :
+                    Prepare( &tBeginParsing, *tIt );
+                    KProcessor::ProcessToken( &tBeginParsing );
+                    break;
+                case eBeginFileToken :
+                    Prepare( &tBeginFile, *tIt );
+                    KProcessor::ProcessToken( &tBeginFile );
+                    break;
+                case eBeginElementToken :
+                    Prepare( &tBeginElement, *tIt );
+                    KProcessor::ProcessToken( &tBeginElement );
+                    break;
+                case eBeginAttributeToken :
+                    Prepare( &tBeginAttribute, *tIt );
+                    KProcessor::ProcessToken( &tBeginAttribute );
+                    break;
+                case eAttributeDataToken :
+                    Prepare( &tAttributeData, *tIt );
+                    KProcessor::ProcessToken( &tAttributeData );
+                    break;
+                case eEndAttributeToken :
+                    Prepare( &tEndAttribute, *tIt );
+                    KProcessor::ProcessToken( &tEndAttribute );
+                    break;
+                case eMidElementToken :
+                    Prepare( &tMidElement, *tIt );
+                    KProcessor::ProcessToken( &tMidElement );
+                    break;
+                case eElementDataToken :
+                    Prepare( &tElementData, *tIt );
+                    KProcessor::ProcessToken( &tElementData );
+                    break;
+                case eEndElementToken :
+                    Prepare( &tEndElement, *tIt );
+                    KProcessor::ProcessToken( &tEndElement );
+                    break;
+                case eEndFileToken :
+                    Prepare( &tEndFile, *tIt );
+                    KProcessor::ProcessToken( &tEndFile );
+                    break;
+                case eEndParsingToken :
+                    Prepare( &tEndParsing, *tIt );
+                    KProcessor::ProcessToken( &tEndParsing );
+                    break;
+                case eCommentToken :
+                    Prepare( &tComment, *tIt );
+                    KProcessor::ProcessToken( &tComment );
+                    break;
+                case eErrorToken :
+                    Prepare( &tError, *tIt );
+                    KProcessor::ProcessToken( &tError );
+                    break;
+            }
+        }
+
+        Clear();
+        return;
+    }
+
+    void KCacheProcessor::ProcessToken( KBeginParsingToken* aToken )
+    {
+        fDepth++;
+        Add( eBeginParsingToken, aToken );
+        KProcessor::ProcessToken( aToken );
+        return;
+    }
+    void KCacheProcessor::ProcessToken( KBeginFileToken* aToken )
+    {
+        fFiles.push_back( aToken->GetValue() );
+        Add( eBeginFileToken, aToken );
+        KProcessor::ProcessToken( aToken );
+        return;
+    }
+    void KCacheProcessor::ProcessToken( KBeginElementToken* aToken )
+    {
+        Add( eBeginElementToken, aToken );
+        KProcessor::ProcessToken( aToken );
+        return;
+    }
+    void KCacheProcessor::ProcessToken( KBeginAttributeToken* aToken )
+    {
+        Add( eBeginAttributeToken, aToken );
+        KProcessor::ProcessToken( aToken );
+        return;
+    }
+    void KCacheProcessor::ProcessToken( KAttributeDataToken* aToken )
+    {
+        Add( eAttributeDataToken, aToken );
+        KProcessor::ProcessToken( aToken );
+        return;
+    }
+    void KCacheProcessor::ProcessToken( KEndAttributeToken* aToken )
+    {
+        Add( eEndAttributeToken, aToken );
+        KProcessor::ProcessToken( aToken );
+        return;
+    }
+    void KCacheProcessor::ProcessToken( KMidElementToken* aToken )
+    {
+        Add( eMidElementToken, aToken );
+        KProcessor::ProcessToken( aToken );
+        return;
+    }
+    void KCacheProcessor::ProcessToken( KElementDataToken* aToken )
+    {
+        Add( eElementDataToken, aToken );
+        KProcessor::ProcessToken( aToken );
+        return;
+    }
+    void KCacheProcessor::ProcessToken( KEndElementToken* aToken )
+    {
+        Add( eEndElementToken, aToken );
+        KProcessor::ProcessToken( aToken );
+        return;
+    }
+    void KCacheProcessor::ProcessToken( KEndFileToken* aToken )
+    {
+        Add( eEndFileToken, aToken );
+        KProcessor::ProcessToken( aToken );
+        return;
+    }
+    void KCacheProcessor::ProcessToken( KEndParsingToken* aToken )
+    {
+        Add( eEndParsingToken, aToken );
+        KProcessor::ProcessToken( aToken );
+
+        //the outermost end parsing token completes the stream
+        fDepth--;
+        if( fDepth == 0 )
+        {
+            Store();
+        }
+        return;
+    }
+    void KCacheProcessor::ProcessToken( KCommentToken* aToken )
+    {
+        Add( eCommentToken, aToken );
+        KProcessor::ProcessToken( aToken );
+        return;
+    }
+    void KCacheProcessor::ProcessToken( KErrorToken* aToken )
+    {
+        //a stream with errors is never stored
+        fFailed = true;
+        KProcessor::ProcessToken( aToken );
+        return;
+    }
+
+    string KCacheProcessor::Hash( const string& aString )
+    {
+        //64 bit FNV-1a
+        unsigned long long tHash = 14695981039346656037ULL;
+        for( string::const_iterator tIt = aString.begin(); tIt != aString.end(); tIt++ )
+        {
+            tHash ^= (unsigned char) (*tIt);
+            tHash *= 1099511628211ULL;
+        }
+
+        ostringstream tStream;
+        tStream << hex << setw( 16 ) << setfill( '0' ) << tHash;
+        return tStream.str();
+    }
+
+    void KCacheProcessor::Add( const TokenType& aType, KToken* aToken )
+    {
+        if( fFailed == true || fCacheFile.empty() )
+        {
+            return;
+        }
+        Record tRecord;
+        tRecord.fType = aType;
+        tRecord.fLine = aToken->GetLine();
+        tRecord.fColumn = aToken->GetColumn();
+        tRecord.fValue = aToken->GetValue();
+        tRecord.fPath = Intern( aToken->GetPath() );
+        tRecord.fFile = Intern( aToken->GetFile() );
+        fRecords.push_back( tRecord );
+        return;
+    }
+    size_t KCacheProcessor::Intern( const string& aString )
+    {
+        map< string, size_t >::iterator tIt = fStringIndices.find( aString );
+        if( tIt != fStringIndices.end() )
+        {
+            return tIt->second;
+        }
+        fStrings.push_back( aString );
+        fStringIndices.insert( make_pair( aString, fStrings.size() - 1 ) );
+        return fStrings.size() - 1;
+    }
+    void KCacheProcessor::Prepare( KToken* aToken, const Record& aRecord )
+    {
+        aToken->SetValue( aRecord.fValue );
+        aToken->SetPath( fStrings[ aRecord.fPath ] );
+        aToken->SetFile( fStrings[ aRecord.fFile ] );
+        aToken->SetLine( aRecord.fLine );
+        aToken->SetColumn( aRecord.fColumn );
+        return;
+    }
+
+    void KCacheProcessor::Store()
+    {
+        if( fFailed == true || fCacheFile.empty() )
+        {
+            Clear();
+            return;
+        }
+
+        ostringstream tStream;
+        tStream << sCacheHeader << '\n';
+
+        //hash every file once
+        set< string > tNames;
+        string tContent;
+        ostringstream tFileStream;
+        for( vector< string >::iterator tIt = fFiles.begin(); tIt != fFiles.end(); tIt++ )
+        {
+            if( tNames.insert( *tIt ).second == false )
+            {
+                continue;
+            }
+            if( ReadFile( *tIt, tContent ) == false )
+            {
+                initmsg( eWarning ) << "not storing configuration cache, cannot read file <" << *tIt << ">" << eom;
+                Clear();
+                return;
+            }
+            WriteString( tFileStream, *tIt );
+            WriteString( tFileStream, Hash( tContent ) );
+            tFileStream << '\n';
+        }
+        tStream << tNames.size() << '\n' << tFileStream.str();
+
+        //include candidates earlier in the search order that did not exist
+        set< string > tSkipped;
+        if( fIncludeProcessor != NULL )
+        {
+            tSkipped.insert( fIncludeProcessor->GetSkippedFiles().begin(), fIncludeProcessor->GetSkippedFiles().end() );
+        }
+        tStream << tSkipped.size() << '\n';
+        for( set< string >::const_iterator tIt = tSkipped.begin(); tIt != tSkipped.end(); tIt++ )
+        {
+            WriteString( tStream, *tIt );
+            tStream << '\n';
+        }
+
+        //the external variables the variable processor looked up, defined or not
+        set< string > tVariables;
+        if( fVariableProcessor != NULL )
+        {
+            tVariables = fVariableProcessor->GetExternalReferences();
+        }
+        else
+        {
+            for( VariableMap::const_iterator tIt = fExternalMap.begin(); tIt != fExternalMap.end(); tIt++ )
+            {
+                tVariables.insert( tIt->first );
+            }
+        }
+        tStream << tVariables.size() << '\n';
+        for( set< string >::const_iterator tIt = tVariables.begin(); tIt != tVariables.end(); tIt++ )
+        {
+            WriteString( tStream, *tIt );
+            WriteString( tStream, HashVariable( fExternalMap, *tIt ) );
+            tStream << '\n';
+        }
+
+        tStream << fStrings.size() << '\n';
+        for( size_t tIndex = 0; tIndex < fStrings.size(); tIndex++ )
+        {
+            WriteString( tStream, fStrings[ tIndex ] );
+            tStream << '\n';
+        }
+
+        tStream << fRecords.size() << '\n';
+        for( vector< Record >::const_iterator tIt = fRecords.begin(); tIt != fRecords.end(); tIt++ )
+        {
+            tStream << (int) (tIt->fType) << ' ' << tIt->fLine << ' ' << tIt->fColumn << ' ';
+            WriteString( tStream, tIt->fValue );
+            tStream << ' ' << tIt->fPath << ' ' << tIt->fFile << '\n';
+        }
+
+        //write to a temporary file of this process first, so a concurrent run never sees half a cache
+        ostringstream tTemporaryName;
+        tTemporaryName << fCacheFile << "." << getpid() << ".tmp";
+        string tTemporary = tTemporaryName.str();
+        ofstream tFile( tTemporary.c_str(), ios::out | ios::binary | ios::trunc );
+        if( tFile.is_open() )
+        {
+            tFile << tStream.str();
+            tFile.close();
+        }
+        if( !tFile || rename( tTemporary.c_str(), fCacheFile.c_str() ) != 0 )
+        {
+            initmsg( eWarning ) << "unable to write configuration cache <" << fCacheFile << ">" << eom;
+            remove( tTemporary.c_str() );
+        }
+        else
+        {
+            initmsg_debug( "stored configuration cache <" << fCacheFile << "> with <" << fRecords.size() << "> tokens" << eom );
+        }
+
+        Clear();
+        return;
+    }
+
+    void KCacheProcessor::Clear()
+    {
+        fRecords.clear();
+        fStrings.clear();
+        fStringIndices.clear();
+        fFiles.clear();
+        return;
+    }
+
+    bool KCacheProcessor::ReadFile( const string& aName, string& aContent )
+    {
+        ifstream tFile( aName.c_str(), ios::in | ios::binary );
+        if( !tFile.is_open() )
+        {
+            return false;
+        }
+        ostringstream tStream;
+        tStream << tFile.rdbuf();
+        aContent = tStream.str();
+        return true;
+    }
+
+    string KCacheProcessor::HashVariable( const VariableMap& aMap, const string& aName )
+    {
+        VariableMap::const_iterator tIt = aMap.find( aName );
+        if( tIt == aMap.end() )
+        {
+            return string( "undefined" );
+        }
+        return Hash( tIt->second );
+    }
+
+}
@@ -0,0 +1,101 @@
+#ifndef Kommon_KCacheProcessor_hh_
+#define Kommon_KCacheProcessor_hh_
+
+#include "KProcessor.hh"
+
+#include <map>
+#include <vector>
+
+namespace katrin
+{
+
+    class KVariableProcessor;
+    class KIncludeProcessor;
+
+    //records the fully expanded token stream and stores it in a cache file.
+    //the cache file lists the hashes of all parsed files, the include candidates
+    //that did not exist and the external variables that were looked up, so a later
+    //run with unchanged inputs can load and replay the stream without tokenizing
+    //and expanding the configuration.
+    class KCacheProcessor :
+        public KProcessor
+    {
+        private:
+            typedef std::map< std::string, std::string > VariableMap;
+
+            typedef enum
+            {
+                eBeginParsingToken, eBeginFileToken, eBeginElementToken, eBeginAttributeToken, eAttributeDataToken, eEndAttributeToken, eMidElementToken, eElementDataToken, eEndElementToken, eEndFileToken, eEndParsingToken, eCommentToken, eErrorToken
+            } TokenType;
+
+            class Record
+            {
+                public:
+                    TokenType fType;
+                    int fLine;
+                    int fColumn;
+                    std::string fValue;
+                    size_t fPath;
+                    size_t fFile;
+            };
+
+        public:
+            KCacheProcessor();
+            KCacheProcessor( const VariableMap& anExternalMap );
+            virtual ~KCacheProcessor();
+
+            void SetCacheFile( const std::string& aCacheFile );
+            const std::string& GetCacheFile() const;
+
+            //processors upstream in the chain that report the variables and include files used
+            void SetVariableProcessor( const KVariableProcessor* aProcessor );
+            void SetIncludeProcessor( const KIncludeProcessor* aProcessor );
+
+            //loads the cache file, returns false if it is missing or out of date
+            bool Load();
+
+            //sends the loaded token stream down the chain
+            void Replay();
+
+            virtual void ProcessToken( KBeginParsingToken* aToken );
+            virtual void ProcessToken( KBeginFileToken* aToken );
+            virtual void ProcessToken( KBeginElementToken* aToken );
+            virtual void ProcessToken( KBeginAttributeToken* aToken );
+            virtual void ProcessToken( KAttributeDataToken* aToken );
+            virtual void ProcessToken( KEndAttributeToken* aToken );
+            virtual void ProcessToken( KMidElementToken* aToken );
+            virtual void ProcessToken( KElementDataToken* aToken );
+            virtual void ProcessToken( KEndElementToken* aToken );
+            virtual void ProcessToken( KEndFileToken* aToken );
+            virtual void ProcessToken( KEndParsingToken* aToken );
+            virtual void ProcessToken( KCommentToken* aToken );
+            virtual void ProcessToken( KErrorToken* aToken );
+
+            static std::string Hash( const std::string& aString );
+
+        private:
+            void Add( const TokenType& aType, KToken* aToken );
+            size_t Intern( const std::string& aString );
+            void Prepare( KToken* aToken, const Record& aRecord );
+            void Store();
+            void Clear();
+
+            static bool ReadFile( const std::string& aName, std::string& aContent );
+            static std::string HashVariable( const VariableMap& aMap, const std::string& aName );
+
+            std::string fCacheFile;
+            VariableMap fExternalMap;
+            const KVariableProcessor* fVariableProcessor;
+            const KIncludeProcessor* fIncludeProcessor;
+
+            int fDepth;
+            bool fFailed;
+            std::vector< std::string > fFiles;
+            std::vector< Record > fRecords;
+            std::vector< std::string > fStrings;
+            std::map< std::string, size_t > fStringIndices;
+    };
+
+}
+
+#endif
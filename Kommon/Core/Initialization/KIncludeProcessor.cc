@@ -23,7 +23,9 @@ namespace katrin
         fAttributeState( eAttributeInactive ),
         fNames(),
         fPaths(),
-        fBases()
+        fBases(),
+        fDefaultPaths(),
+        fSkippedFiles()
     {
     }
 
@@ -38,6 +40,11 @@ namespace katrin
             fDefaultPaths.push_back( path );
     }
 
+    const vector< string >& KIncludeProcessor::GetSkippedFiles() const
+    {
+        return fSkippedFiles;
+    }
+
     void KIncludeProcessor::ProcessToken( KBeginElementToken* aToken )
     {
         if( fElementState == eElementInactive )
@@ -253,6 +260,8 @@ namespace katrin
                 initmsg( eError ) << ">" << eom;
             }
 
+            fSkippedFiles.insert( fSkippedFiles.end(), aFile->GetSkippedNames().begin(), aFile->GetSkippedNames().end() );
+
             fElementState = eElementInactive;
             fNames.clear();
             fPaths.clear();
@@ -25,6 +25,9 @@ namespace katrin
 
             void AddDefaultPath(const std::string& path);
 
+            //files searched for before each include was found, in search order
+            const std::vector< std::string >& GetSkippedFiles() const;
+
         private:
             void Reset();
 
@@ -45,6 +48,7 @@ namespace katrin
             std::vector< std::string > fBases;
 
             std::vector< std::string > fDefaultPaths;
+            std::vector< std::string > fSkippedFiles;
     };
 
 }
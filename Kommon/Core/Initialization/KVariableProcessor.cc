@@ -16,6 +16,7 @@ namespace katrin
             fName( "" ),
             fValue( "" ),
             fExternalMap( new VariableMap() ),
+            fExternalReferences(),
             fGlobalMap( new VariableMap() ),
             fLocalMap( new VariableMap() ),
             fLocalMapStack()
@@ -28,6 +29,7 @@ namespace katrin
             fName( "" ),
             fValue( "" ),
             fExternalMap( new VariableMap( anExternalMap ) ),
+            fExternalReferences(),
             fGlobalMap( new VariableMap() ),
             fLocalMap( new VariableMap() ),
             fLocalMapStack()
@@ -41,6 +43,16 @@ namespace katrin
         delete fLocalMap;
     }
 
+    const set< string >& KVariableProcessor::GetExternalReferences() const
+    {
+        return fExternalReferences;
+    }
+    KVariableProcessor::VariableIt KVariableProcessor::FindExternal( const string& aName )
+    {
+        fExternalReferences.insert( aName );
+        return fExternalMap->find( aName );
+    }
+
     void KVariableProcessor::ProcessToken( KBeginFileToken* aToken )
     {
         if( fElementState == eElementInactive )
@@ -232,7 +244,7 @@ namespace katrin
 
         if( fElementState == eActiveLocalDefine )
         {
-            VariableIt ExternalIt = fExternalMap->find( fName );
+            VariableIt ExternalIt = FindExternal( fName );
             if( ExternalIt == fExternalMap->end() )
             {
                 VariableIt GlobalIt = fGlobalMap->find( fName );
@@ -270,7 +282,7 @@ namespace katrin
 
         if( fElementState == eActiveGlobalDefine )
         {
-            VariableIt ExternalIt = fExternalMap->find( fName );
+            VariableIt ExternalIt = FindExternal( fName );
             if( ExternalIt == fExternalMap->end() )
             {
                 VariableIt LocalIt = fLocalMap->find( fName );
@@ -314,7 +326,7 @@ namespace katrin
                 VariableIt LocalIt = fLocalMap->find( fName );
                 if( LocalIt == fLocalMap->end() )
                 {
-                    VariableIt ExternalIt = fExternalMap->find( fName );
+                    VariableIt ExternalIt = FindExternal( fName );
                     if( ExternalIt == fExternalMap->end() )
                     {
                         fExternalMap->insert( VariableEntry( fName, fValue ) );
@@ -351,7 +363,7 @@ namespace katrin
             }
             else
             {
-                VariableIt ExternalIt = fExternalMap->find( fName );
+                VariableIt ExternalIt = FindExternal( fName );
                 if( ExternalIt != fExternalMap->end() )
                 {
                     initmsg( eError ) << "tried to locally undefine external variable with name <" << fName << ">" << ret;
@@ -388,7 +400,7 @@ namespace katrin
             }
             else
             {
-                VariableIt ExternalIt = fExternalMap->find( fName );
+                VariableIt ExternalIt = FindExternal( fName );
                 if( ExternalIt != fExternalMap->end() )
                 {
                     initmsg( eError ) << "tried to globally undefine external variable with name <" << fName << ">" << ret;
@@ -418,7 +430,7 @@ namespace katrin
 
         if( fElementState == eActiveExternalUndefine )
         {
-            VariableIt ExternalIt = fExternalMap->find( fName );
+            VariableIt ExternalIt = FindExternal( fName );
             if( ExternalIt != fExternalMap->end() )
             {
                 fExternalMap->erase( ExternalIt );
@@ -552,7 +564,7 @@ namespace katrin
                     tDefaultValue = tBuffer.substr(tNameValueSepPos + 1);
                 }
 
-                VariableIt ExternalVariable = fExternalMap->find( tVarName );
+                VariableIt ExternalVariable = FindExternal( tVarName );
                 if( ExternalVariable != fExternalMap->end() )
                 {
                     tBuffer = ExternalVariable->second;
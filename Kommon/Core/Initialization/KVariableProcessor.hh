@@ -5,6 +5,7 @@
 
 #include <stack>
 #include <map>
+#include <set>
 
 namespace katrin
 {
@@ -33,8 +34,12 @@ namespace katrin
             virtual void ProcessToken( KEndElementToken* aToken );
             virtual void ProcessToken( KEndFileToken* aToken );
 
+            //names of all external variables looked up so far, whether they were defined or not
+            const std::set< std::string >& GetExternalReferences() const;
+
         private:
             void Evaluate( KToken* aToken );
+            VariableIt FindExternal( const std::string& aName );
 
             typedef enum
             {
@@ -51,6 +56,7 @@ namespace katrin
             std::string fName;
             std::string fValue;
             VariableMap* fExternalMap;
+            std::set< std::string > fExternalReferences;
             VariableMap* fGlobalMap;
             VariableMap* fLocalMap;
             std::stack< VariableMap* > fLocalMapStack;
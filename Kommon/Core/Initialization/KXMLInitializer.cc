@@ -17,6 +17,8 @@
 #include "KFormulaProcessor.hh"
 #endif
 
+#include <sys/stat.h>
+
 extern char** environ;
 
 using namespace std;
@@ -115,7 +117,7 @@ pair<string, KTextFile> KXMLInitializer::GetConfigFile()
 }
 
 KXMLTokenizer* KXMLInitializer::SetupProcessChain( const map<string, string>& tVariables,
-        const string& includePath)
+        const string& includePath, KCacheProcessor* tCacheProcessor)
 {
     KXMLTokenizer* tTokenizer = new KXMLTokenizer();
     KVariableProcessor* tVariableProcessor = new KVariableProcessor( tVariables );
@@ -144,7 +146,16 @@ KXMLTokenizer* KXMLInitializer::SetupProcessChain( const map<string, string>& tV
 
     tLoopProcessor->InsertAfter( tIncludeProcessor );
     tConditionProcessor->InsertAfter( tLoopProcessor );
-    tPrintProcessor->InsertAfter( tConditionProcessor );
+    if (tCacheProcessor) {
+        // the cache sees the fully expanded stream, print statements are replayed from it
+        tCacheProcessor->InsertAfter( tConditionProcessor );
+        tCacheProcessor->SetVariableProcessor( tVariableProcessor );
+        tCacheProcessor->SetIncludeProcessor( tIncludeProcessor );
+        tPrintProcessor->InsertAfter( tCacheProcessor );
+    }
+    else {
+        tPrintProcessor->InsertAfter( tConditionProcessor );
+    }
     fConfigSerializer->InsertAfter( tPrintProcessor );
 
     tTagProcessor->InsertAfter( fConfigSerializer.get() );
@@ -153,6 +164,27 @@ KXMLTokenizer* KXMLInitializer::SetupProcessChain( const map<string, string>& tV
     return tTokenizer;
 }
 
+string KXMLInitializer::GetCacheFile(const string& configFileName)
+{
+    // the cache is only used on request, by option or environment variable
+    if (fArguments.OptionTable().find("KASPER_CONFIG_CACHE") == fArguments.OptionTable().end())
+        return "";
+
+    string cacheDir = fArguments.GetOption("KASPER_CONFIG_CACHE");
+    if (cacheDir == "0" || cacheDir == "no" || cacheDir == "false")
+        return "";
+
+    if (cacheDir.empty() || cacheDir == "1" || cacheDir == "yes" || cacheDir == "true") {
+        cacheDir = fArguments.GetOption("KASPERSYS").AsString() + "/cache";
+        mkdir(cacheDir.c_str(), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+        cacheDir += "/Config";
+    }
+    mkdir(cacheDir.c_str(), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+
+    // the key covers the configuration and the command line, file contents and variables are checked on load
+    return cacheDir + "/" + KCacheProcessor::Hash(configFileName + "\n" + fArguments.CommandLine()) + ".xmlcache";
+}
+
 
 
 void KXMLInitializer::Configure(int argc, char** argv)
@@ -163,7 +195,20 @@ void KXMLInitializer::Configure(int argc, char** argv)
 
     pair<string, KTextFile> tConfig = GetConfigFile();
 
-    KXMLTokenizer* tokenizer = SetupProcessChain(fArguments.OptionTable(), tConfig.first);
+    string cacheFile = GetCacheFile(tConfig.second.GetName());
+    KCacheProcessor* cacheProcessor = nullptr;
+    if (!cacheFile.empty()) {
+        cacheProcessor = new KCacheProcessor(fArguments.OptionTable());
+        cacheProcessor->SetCacheFile(cacheFile);
+    }
+
+    KXMLTokenizer* tokenizer = SetupProcessChain(fArguments.OptionTable(), tConfig.first, cacheProcessor);
+
+    if (cacheProcessor && cacheProcessor->Load()) {
+        initmsg(eNormal) << "Using cached configuration '" << cacheFile << "'" << eom;
+        cacheProcessor->Replay();
+        return;
+    }
 
     tokenizer->ProcessFile( &tConfig.second );
 }
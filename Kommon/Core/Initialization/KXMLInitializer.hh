@@ -10,6 +10,7 @@
 #include "KTextFile.h"
 #include "KSerializationProcessor.hh"
 #include "KXMLTokenizer.hh"
+#include "KCacheProcessor.hh"
 
 #include <string>
 #include <vector>
@@ -38,7 +39,8 @@ protected:
     void ParseCommandLine(int argc, char** argv);
     std::pair<std::string, KTextFile> GetConfigFile();
     KXMLTokenizer* SetupProcessChain(const std::map<std::string, std::string>& tVariables,
-         const std::string& tIncludepaths);
+         const std::string& tIncludepaths, KCacheProcessor* tCacheProcessor = nullptr);
+    std::string GetCacheFile(const std::string& configFileName);
 
     KArgumentList fArguments;
     std::unique_ptr<KSerializationProcessor> fConfigSerializer;
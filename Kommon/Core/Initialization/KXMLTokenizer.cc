@@ -11,6 +11,8 @@ namespace katrin
     KXMLTokenizer::KXMLTokenizer() :
                 KProcessor(),
                 fFile( NULL ),
+                fText( "" ),
+                fPosition( 0 ),
                 fPath( "" ),
                 fName( "" ),
                 fLine( 0 ),
@@ -102,7 +104,13 @@ namespace katrin
             fName = fFile->GetName();
             fLine = 1;
             fColumn = 1;
-            fChar = fFile->File()->get();
+
+            //read the whole file in one block, the lexer then works on the buffer
+            ostringstream tStream;
+            tStream << fFile->File()->rdbuf();
+            fText = tStream.str();
+            fPosition = 0;
+            fChar = fText.empty() ? '\0' : fText[ 0 ];
 
             fBeginFile->SetPath( fPath );
             fBeginElement->SetPath( fPath );
@@ -541,6 +549,8 @@ namespace katrin
         fLine = 0;
         fColumn = 0;
         fChar = '\0';
+        fText.clear();
+        fPosition = 0;
 
         fState = &KXMLTokenizer::ParseEnd;
         return;
@@ -622,7 +632,7 @@ namespace katrin
         //calculate adjustments to the line and column numbers
         int ColumnChange;
         int LineChange;
-        if( AtExactly( fNewLine ) )
+        if( fChar == fNewLine[ 0 ] )
         {
             //if the current character is a newline, a successful increment will make the column number 1 and the line number jump by one.
             ColumnChange = 1 - fColumn;
@@ -637,13 +647,15 @@ namespace katrin
 
         //increment the iterator
         initmsg_debug( "popping the iterator" << eom )
-        fChar = fFile->File()->get();
+        fPosition++;
 
         //make sure that incrementing didn't put the iterator at the end
         if( AtEnd() )
         {
+            fChar = '\0';
             return;
         }
+        fChar = fText[ fPosition ];
 
         //apply the calculated column and line adjustments
         fColumn = fColumn + ColumnChange;
@@ -654,8 +666,8 @@ namespace katrin
     }
     bool KXMLTokenizer::AtEnd()
     {
-        //if iterator is at EOF, return true
-        if( fFile->File()->good() == false )
+        //if iterator is past the last buffered character, return true
+        if( fPosition >= fText.size() )
         {
             return true;
         }
@@ -686,49 +698,14 @@ namespace katrin
             return false;
         }
 
-        //match the string
-        bool tMatched = true;
-        string::const_iterator tIter = aString.begin();
-        while( tIter != aString.end() )
-        {
-            //grab a character
-            initmsg_debug( "file character is <" << fChar << ">, comparison character is <" << *tIter << ">" << eom )
-
-            //if that puts us at the end, try to go back and return false
-            if( AtEnd() )
-            {
-                initmsg_debug( "hit the end" << eom )
-                tMatched = false;
-                break;
-            }
-            //if a mismatch is found, try to go back and return false
-            if( fChar != *tIter )
-            {
-                initmsg_debug( "<" << fChar << "> seriously does not match <" << *tIter << ">" << eom )
-                tMatched = false;
-                break;
-            }
-
-            initmsg_debug( "popping the iterator" << eom )
-
-            fChar = fFile->File()->get();
-            tIter++;
-        }
-
-        //go back
-        while( tIter != aString.begin() )
+        //match the string against the buffer, a match running past the end fails
+        if( fText.compare( fPosition, aString.size(), aString ) != 0 )
         {
-            initmsg_debug( "unpopping the iterator" << eom )
-
-            fFile->File()->unget();
-            tIter--;
+            initmsg_debug( "<" << fText.substr( fPosition, aString.size() ) << "> does not match <" << aString << ">" << eom )
+            return false;
         }
 
-        //reset to character that we were originally on
-        fFile->File()->unget();
-        fChar = fFile->File()->get();
-
-        return tMatched;
+        return true;
     }
 
     string KXMLTokenizer::Trim( const string& aBuffer )
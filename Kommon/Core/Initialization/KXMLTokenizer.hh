@@ -37,6 +37,8 @@ namespace katrin
             bool AtExactly( const std::string& aString );
 
             KTextFile* fFile;
+            std::string fText;
+            size_t fPosition;
             std::string fPath;
             std::string fName;
             int fLine;
@@ -0,0 +1,593 @@
+/**
+ * @file KMathExpression.cxx
+ *
+ * @date 19.10.2026
+ */
+
+#include "KMathExpression.h"
+#include "KException.h"
+#include "KConst.h"
+
+#include <cmath>
+#include <cctype>
+#include <cstdlib>
+#include <map>
+
+using namespace std;
+
+namespace katrin
+{
+
+namespace
+{
+
+struct KMathExpressionFunction
+{
+    KMathExpression::EOperation fOperation;
+    size_t fMinArguments;
+    size_t fMaxArguments;
+};
+
+const map<string, KMathExpressionFunction>& FunctionTable()
+{
+    static const map<string, KMathExpressionFunction> sTable = {
+        { "sin", { KMathExpression::eSin, 1, 1 } },
+        { "cos", { KMathExpression::eCos, 1, 1 } },
+        { "tan", { KMathExpression::eTan, 1, 1 } },
+        { "asin", { KMathExpression::eASin, 1, 1 } },
+        { "acos", { KMathExpression::eACos, 1, 1 } },
+        { "atan", { KMathExpression::eATan, 1, 1 } },
+        { "atan2", { KMathExpression::eATan2, 2, 2 } },
+        { "sinh", { KMathExpression::eSinh, 1, 1 } },
+        { "cosh", { KMathExpression::eCosh, 1, 1 } },
+        { "tanh", { KMathExpression::eTanh, 1, 1 } },
+        { "exp", { KMathExpression::eExp, 1, 1 } },
+        { "log", { KMathExpression::eLog, 1, 1 } },
+        { "log10", { KMathExpression::eLog10, 1, 1 } },
+        { "sqrt", { KMathExpression::eSqrt, 1, 1 } },
+        { "abs", { KMathExpression::eAbs, 1, 1 } },
+        { "fabs", { KMathExpression::eAbs, 1, 1 } },
+        { "floor", { KMathExpression::eFloor, 1, 1 } },
+        { "ceil", { KMathExpression::eCeil, 1, 1 } },
+        { "sign", { KMathExpression::eSign, 1, 1 } },
+        { "pow", { KMathExpression::ePower, 2, 2 } },
+        { "power", { KMathExpression::ePower, 2, 2 } },
+        { "min", { KMathExpression::eMin, 2, 2 } },
+        { "max", { KMathExpression::eMax, 2, 2 } },
+        { "gaus", { KMathExpression::eGaus, 1, 3 } }
+    };
+    return sTable;
+}
+
+// the TMath constants, which are called without arguments
+const map<string, double>& ConstantTable()
+{
+    static const map<string, double> sTable = {
+        { "pi", M_PI },
+        { "twopi", 2. * M_PI },
+        { "piover2", M_PI / 2. },
+        { "piover4", M_PI / 4. },
+        { "invpi", 1. / M_PI },
+        { "e", M_E },
+        { "sqrt2", M_SQRT2 },
+        { "ln10", M_LN10 },
+        { "loge", M_LOG10E },
+        { "c", KConst::C() },
+        { "qe", KConst::Q() },
+        { "hbar", KConst::Hbar() },
+        { "k", KConst::kB() },
+        { "na", KConst::N_A() }
+    };
+    return sTable;
+}
+
+size_t Arity(KMathExpression::EOperation operation)
+{
+    switch (operation) {
+        case KMathExpression::eConstant:
+        case KMathExpression::eVariable:
+            return 0;
+        case KMathExpression::eAdd:
+        case KMathExpression::eSubtract:
+        case KMathExpression::eMultiply:
+        case KMathExpression::eDivide:
+        case KMathExpression::eModulo:
+        case KMathExpression::ePower:
+        case KMathExpression::eLess:
+        case KMathExpression::eLessEqual:
+        case KMathExpression::eGreater:
+        case KMathExpression::eGreaterEqual:
+        case KMathExpression::eEqual:
+        case KMathExpression::eNotEqual:
+        case KMathExpression::eAnd:
+        case KMathExpression::eOr:
+        case KMathExpression::eATan2:
+        case KMathExpression::eMin:
+        case KMathExpression::eMax:
+            return 2;
+        case KMathExpression::eSelect:
+        case KMathExpression::eGaus:
+            return 3;
+        default:
+            return 1;
+    }
+}
+
+// applies an operation to its arguments, shared by constant folding and evaluation
+inline double Apply(KMathExpression::EOperation operation, const double* a)
+{
+    switch (operation) {
+        case KMathExpression::eNegate: return -a[0];
+        case KMathExpression::eNot: return (a[0] == 0.) ? 1. : 0.;
+        case KMathExpression::eAdd: return a[0] + a[1];
+        case KMathExpression::eSubtract: return a[0] - a[1];
+        case KMathExpression::eMultiply: return a[0] * a[1];
+        case KMathExpression::eDivide: return a[0] / a[1];
+        case KMathExpression::eModulo: return fmod(a[0], a[1]);
+        case KMathExpression::ePower: return pow(a[0], a[1]);
+        case KMathExpression::eLess: return (a[0] < a[1]) ? 1. : 0.;
+        case KMathExpression::eLessEqual: return (a[0] <= a[1]) ? 1. : 0.;
+        case KMathExpression::eGreater: return (a[0] > a[1]) ? 1. : 0.;
+        case KMathExpression::eGreaterEqual: return (a[0] >= a[1]) ? 1. : 0.;
+        case KMathExpression::eEqual: return (a[0] == a[1]) ? 1. : 0.;
+        case KMathExpression::eNotEqual: return (a[0] != a[1]) ? 1. : 0.;
+        case KMathExpression::eAnd: return (a[0] != 0. && a[1] != 0.) ? 1. : 0.;
+        case KMathExpression::eOr: return (a[0] != 0. || a[1] != 0.) ? 1. : 0.;
+        case KMathExpression::eSelect: return (a[0] != 0.) ? a[1] : a[2];
+        case KMathExpression::eSin: return sin(a[0]);
+        case KMathExpression::eCos: return cos(a[0]);
+        case KMathExpression::eTan: return tan(a[0]);
+        case KMathExpression::eASin: return asin(a[0]);
+        case KMathExpression::eACos: return acos(a[0]);
+        case KMathExpression::eATan: return atan(a[0]);
+        case KMathExpression::eSinh: return sinh(a[0]);
+        case KMathExpression::eCosh: return cosh(a[0]);
+        case KMathExpression::eTanh: return tanh(a[0]);
+        case KMathExpression::eExp: return exp(a[0]);
+        case KMathExpression::eLog: return log(a[0]);
+        case KMathExpression::eLog10: return log10(a[0]);
+        case KMathExpression::eSqrt: return sqrt(a[0]);
+        case KMathExpression::eAbs: return fabs(a[0]);
+        case KMathExpression::eFloor: return floor(a[0]);
+        case KMathExpression::eCeil: return ceil(a[0]);
+        case KMathExpression::eSign: return (a[0] > 0.) ? 1. : ((a[0] < 0.) ? -1. : 0.);
+        case KMathExpression::eATan2: return atan2(a[0], a[1]);
+        case KMathExpression::eMin: return (a[1] < a[0]) ? a[1] : a[0];
+        case KMathExpression::eMax: return (a[1] > a[0]) ? a[1] : a[0];
+        case KMathExpression::eGaus: {
+            // same convention as TMath::Gaus without normalization
+            if (a[2] == 0.)
+                return 1.e30;
+            double arg = (a[0] - a[1]) / a[2];
+            return exp(-0.5 * arg * arg);
+        }
+        default: return 0.;
+    }
+}
+
+// recursive descent parser, emits the program in postfix order
+class KMathExpressionParser
+{
+public:
+    KMathExpressionParser(const string& formula, const vector<string>& variables,
+            vector<KMathExpression::Instruction>& program) :
+        fFormula(formula), fVariables(variables), fProgram(program), fPosition(0), fDepth(0), fMaxDepth(0)
+    { }
+
+    size_t Parse()
+    {
+        fProgram.clear();
+        SkipSpace();
+        if (fPosition == fFormula.size())
+            Fail("empty expression");
+        ParseConditional();
+        SkipSpace();
+        if (fPosition != fFormula.size())
+            FailUnsupported();
+        return fMaxDepth;
+    }
+
+private:
+    void Fail(const string& message) const
+    {
+        throw KException() << "KMathExpression: " << message << " at position " << fPosition << " in <" << fFormula << ">";
+    }
+
+    void FailUnsupported() const
+    {
+        const char c = fFormula[fPosition];
+        if (c == '=' || c == '&' || c == '|' || c == '<' || c == '>')
+            Fail(string("unsupported operator '") + c + "'");
+        if (c == '{' || c == '}' || c == ';')
+            Fail(string("unsupported statement syntax '") + c + "'");
+        if (c == '[')
+            Fail("unsupported array access");
+        Fail(string("unexpected character '") + c + "'");
+    }
+
+    void SkipSpace()
+    {
+        while (fPosition < fFormula.size() && isspace(static_cast<unsigned char>(fFormula[fPosition])))
+            fPosition++;
+    }
+
+    bool Accept(const char* token)
+    {
+        SkipSpace();
+        size_t length = char_traits<char>::length(token);
+        if (fFormula.compare(fPosition, length, token) == 0) {
+            fPosition += length;
+            return true;
+        }
+        return false;
+    }
+
+    void Expect(const char* token)
+    {
+        if (!Accept(token))
+            Fail(string("expected '") + token + "'");
+    }
+
+    void EmitConstant(double value)
+    {
+        KMathExpression::Instruction instruction = { KMathExpression::eConstant, value, 0 };
+        fProgram.push_back(instruction);
+        Push(1);
+    }
+
+    void EmitVariable(size_t index)
+    {
+        KMathExpression::Instruction instruction = { KMathExpression::eVariable, 0., index };
+        fProgram.push_back(instruction);
+        Push(1);
+    }
+
+    void Emit(KMathExpression::EOperation operation)
+    {
+        const size_t arity = Arity(operation);
+
+        // fold the operation if all operands are constants
+        bool constant = (fProgram.size() >= arity);
+        for (size_t i = 0; constant && i < arity; i++)
+            constant = (fProgram[fProgram.size() - arity + i].fOperation == KMathExpression::eConstant);
+
+        if (constant) {
+            double arguments[3];
+            for (size_t i = 0; i < arity; i++)
+                arguments[i] = fProgram[fProgram.size() - arity + i].fValue;
+            fProgram.resize(fProgram.size() - arity);
+            fDepth -= arity;
+            EmitConstant(Apply(operation, arguments));
+            return;
+        }
+
+        KMathExpression::Instruction instruction = { operation, 0., 0 };
+        fProgram.push_back(instruction);
+        fDepth -= arity;
+        Push(1);
+    }
+
+    void Push(size_t n)
+    {
+        fDepth += n;
+        if (fDepth > fMaxDepth)
+            fMaxDepth = fDepth;
+    }
+
+    // a ? b : c, both branches are evaluated and the condition selects one of them
+    void ParseConditional()
+    {
+        ParseOr();
+        if (Accept("?")) {
+            ParseConditional();
+            Expect(":");
+            ParseConditional();
+            Emit(KMathExpression::eSelect);
+        }
+    }
+
+    void ParseOr()
+    {
+        ParseAnd();
+        while (Accept("||")) {
+            ParseAnd();
+            Emit(KMathExpression::eOr);
+        }
+    }
+
+    void ParseAnd()
+    {
+        ParseComparison();
+        while (Accept("&&")) {
+            ParseComparison();
+            Emit(KMathExpression::eAnd);
+        }
+    }
+
+    void ParseComparison()
+    {
+        ParseSum();
+        while (true) {
+            KMathExpression::EOperation operation;
+            if (Accept("<="))
+                operation = KMathExpression::eLessEqual;
+            else if (Accept(">="))
+                operation = KMathExpression::eGreaterEqual;
+            else if (Accept("=="))
+                operation = KMathExpression::eEqual;
+            else if (Accept("!="))
+                operation = KMathExpression::eNotEqual;
+            else if (Accept("<"))
+                operation = KMathExpression::eLess;
+            else if (Accept(">"))
+                operation = KMathExpression::eGreater;
+            else
+                return;
+            ParseSum();
+            Emit(operation);
+        }
+    }
+
+    void ParseSum()
+    {
+        ParseProduct();
+        while (true) {
+            if (Accept("+")) {
+                ParseProduct();
+                Emit(KMathExpression::eAdd);
+            }
+            else if (Accept("-")) {
+                ParseProduct();
+                Emit(KMathExpression::eSubtract);
+            }
+            else
+                return;
+        }
+    }
+
+    void ParseProduct()
+    {
+        ParseUnary();
+        while (true) {
+            SkipSpace();
+            if (fFormula.compare(fPosition, 2, "**") == 0)
+                return;
+            if (Accept("*")) {
+                ParseUnary();
+                Emit(KMathExpression::eMultiply);
+            }
+            else if (Accept("/")) {
+                ParseUnary();
+                Emit(KMathExpression::eDivide);
+            }
+            else if (Accept("%")) {
+                ParseUnary();
+                Emit(KMathExpression::eModulo);
+            }
+            else
+                return;
+        }
+    }
+
+    void ParseUnary()
+    {
+        if (Accept("-")) {
+            ParseUnary();
+            Emit(KMathExpression::eNegate);
+        }
+        else if (Accept("+")) {
+            ParseUnary();
+        }
+        else if (Accept("!")) {
+            ParseUnary();
+            Emit(KMathExpression::eNot);
+        }
+        else
+            ParsePower();
+    }
+
+    void ParsePower()
+    {
+        ParsePrimary();
+        // right associative, -2^2 is -(2^2) and 2^-1 is allowed
+        if (Accept("^") || Accept("**")) {
+            ParseUnary();
+            Emit(KMathExpression::ePower);
+        }
+    }
+
+    void ParsePrimary()
+    {
+        SkipSpace();
+        if (fPosition >= fFormula.size())
+            Fail("unexpected end of expression");
+
+        const char c = fFormula[fPosition];
+
+        if (Accept("(")) {
+            ParseConditional();
+            Expect(")");
+            return;
+        }
+
+        if (Accept("[")) {
+            SkipSpace();
+            const size_t start = fPosition;
+            while (fPosition < fFormula.size() && isdigit(static_cast<unsigned char>(fFormula[fPosition])))
+                fPosition++;
+            if (start == fPosition)
+                Fail("expected parameter index");
+            const size_t index = strtoul(fFormula.substr(start, fPosition - start).c_str(), nullptr, 10);
+            if (index >= fVariables.size())
+                Fail("parameter index out of range");
+            Expect("]");
+            EmitVariable(index);
+            return;
+        }
+
+        if (isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            const char* begin = fFormula.c_str() + fPosition;
+            char* end = nullptr;
+            const double value = strtod(begin, &end);
+            if (end == begin)
+                Fail("invalid number");
+            fPosition += end - begin;
+            EmitConstant(value);
+            return;
+        }
+
+        if (isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            const size_t start = fPosition;
+            while (fPosition < fFormula.size() &&
+                    (isalnum(static_cast<unsigned char>(fFormula[fPosition])) || fFormula[fPosition] == '_' ||
+                     fFormula.compare(fPosition, 2, "::") == 0))
+                fPosition += (fFormula[fPosition] == ':') ? 2 : 1;
+            ParseName(fFormula.substr(start, fPosition - start));
+            return;
+        }
+
+        FailUnsupported();
+    }
+
+    void ParseName(const string& name)
+    {
+        // variables are matched exactly, before the case insensitive names
+        for (size_t index = 0; index < fVariables.size(); index++) {
+            if (name == fVariables[index]) {
+                EmitVariable(index);
+                return;
+            }
+        }
+
+        string key = name;
+        if (key.compare(0, 7, "TMath::") == 0)
+            key = key.substr(7);
+        for (size_t i = 0; i < key.size(); i++)
+            key[i] = tolower(static_cast<unsigned char>(key[i]));
+
+        SkipSpace();
+        const bool call = (fPosition < fFormula.size() && fFormula[fPosition] == '(');
+
+        if (!call) {
+            if (key == "pi") {
+                EmitConstant(M_PI);
+                return;
+            }
+            if (key == "e") {
+                EmitConstant(M_E);
+                return;
+            }
+            Fail("unknown name <" + name + ">");
+        }
+
+        map<string, double>::const_iterator constant = ConstantTable().find(key);
+        if (constant != ConstantTable().end() && FunctionTable().find(key) == FunctionTable().end()) {
+            Expect("(");
+            if (!Accept(")"))
+                Fail("constant <" + name + "> takes no arguments");
+            EmitConstant(constant->second);
+            return;
+        }
+
+        map<string, KMathExpressionFunction>::const_iterator it = FunctionTable().find(key);
+        if (it == FunctionTable().end())
+            Fail("unsupported function <" + name + ">");
+        const KMathExpressionFunction& function = it->second;
+
+        Expect("(");
+        size_t count = 0;
+        if (!Accept(")")) {
+            do {
+                ParseConditional();
+                count++;
+            } while (Accept(","));
+            Expect(")");
+        }
+        if (count < function.fMinArguments || count > function.fMaxArguments)
+            Fail("wrong number of arguments for <" + name + ">");
+
+        // default mean and width of gaus
+        if (function.fOperation == KMathExpression::eGaus) {
+            if (count < 2)
+                EmitConstant(0.);
+            if (count < 3)
+                EmitConstant(1.);
+        }
+
+        Emit(function.fOperation);
+    }
+
+    const string& fFormula;
+    const vector<string>& fVariables;
+    vector<KMathExpression::Instruction>& fProgram;
+    size_t fPosition;
+    size_t fDepth;
+    size_t fMaxDepth;
+};
+
+}
+
+KMathExpression::KMathExpression() :
+    fFormula(),
+    fNVariables(0),
+    fProgram(),
+    fStackSize(0)
+{ }
+
+KMathExpression::KMathExpression(const string& formula, const vector<string>& variables) :
+    fFormula(),
+    fNVariables(0),
+    fProgram(),
+    fStackSize(0)
+{
+    Compile(formula, variables);
+}
+
+KMathExpression::~KMathExpression()
+{ }
+
+void KMathExpression::Compile(const string& formula, const vector<string>& variables)
+{
+    vector<Instruction> program;
+    KMathExpressionParser parser(formula, variables, program);
+    fStackSize = parser.Parse();
+
+    fFormula = formula;
+    fNVariables = variables.size();
+    fProgram.swap(program);
+}
+
+double KMathExpression::Evaluate(const double* values) const
+{
+    // most formulas fit on the local stack, deeper ones get a heap stack
+    double localStack[32];
+    vector<double> heapStack;
+    double* stack = localStack;
+    if (fStackSize > 32) {
+        heapStack.resize(fStackSize);
+        stack = &heapStack[0];
+    }
+
+    size_t top = 0;
+    for (vector<Instruction>::const_iterator it = fProgram.begin(); it != fProgram.end(); ++it) {
+        switch (it->fOperation) {
+            case eConstant:
+                stack[top++] = it->fValue;
+                break;
+            case eVariable:
+                stack[top++] = values[it->fIndex];
+                break;
+            default: {
+                const size_t arity = Arity(it->fOperation);
+                top -= arity;
+                stack[top] = Apply(it->fOperation, stack + top);
+                top++;
+                break;
+            }
+        }
+    }
+
+    return (top > 0) ? stack[top - 1] : 0.;
+}
+
+}
@@ -0,0 +1,88 @@
+/**
+ * @file KMathExpression.h
+ *
+ * @date 19.10.2026
+ */
+
+#ifndef KMATHEXPRESSION_H_
+#define KMATHEXPRESSION_H_
+
+#include <string>
+#include <vector>
+
+namespace katrin
+{
+
+/**
+    @brief Arithmetic expression, compiled once into a stack program.
+
+    The formula is parsed when it is compiled and translated into a short
+    sequence of instructions, constant subexpressions are folded. Evaluation
+    walks this sequence on a local stack, so it does not allocate and a
+    compiled expression can be evaluated from several threads at once.
+
+    The syntax follows the ROOT formula syntax for the common cases:
+    - numbers, the named variables and the constants pi and e
+    - + - * / % and ^ or ** for powers, unary signs
+    - comparisons < <= > >= == != and the logical && || !, which yield 1 or 0
+    - the conditional a ? b : c, which evaluates both branches
+    - the functions sin, cos, tan, asin, acos, atan, atan2, sinh, cosh, tanh,
+      exp, log, log10, sqrt, abs, fabs, pow, min, max, floor, ceil, sign, gaus,
+      also with a "TMath::" prefix and the TMath capitalization
+    - the TMath constants Pi(), TwoPi(), PiOver2(), PiOver4(), InvPi(), E(),
+      Sqrt2(), Ln10(), LogE(), C(), Qe(), Hbar(), K() and Na(), with the
+      physical values taken from KConst
+    - parameters [0], [1], ... which are mapped onto the variables in order
+
+    Syntax errors, unknown names and unsupported constructs throw a KException
+    whose message names the offending construct and its position.
+*/
+class KMathExpression
+{
+public:
+    KMathExpression();
+    KMathExpression(const std::string& formula, const std::vector<std::string>& variables = std::vector<std::string>(1, "x"));
+    virtual ~KMathExpression();
+
+    void Compile(const std::string& formula, const std::vector<std::string>& variables = std::vector<std::string>(1, "x"));
+
+    const std::string& GetFormula() const { return fFormula; }
+    size_t GetNVariables() const { return fNVariables; }
+    bool IsCompiled() const { return !fProgram.empty(); }
+
+    /// evaluates the expression, values holds one entry per variable
+    double Evaluate(const double* values) const;
+    double Evaluate(const std::vector<double>& values) const { return Evaluate(values.empty() ? nullptr : &values[0]); }
+    double Evaluate(double x) const { return Evaluate(&x); }
+
+    double operator()(double x) const { return Evaluate(&x); }
+
+public:
+    enum EOperation {
+        eConstant, eVariable,
+        eNegate, eNot,
+        eAdd, eSubtract, eMultiply, eDivide, eModulo, ePower,
+        eLess, eLessEqual, eGreater, eGreaterEqual, eEqual, eNotEqual, eAnd, eOr, eSelect,
+        eSin, eCos, eTan, eASin, eACos, eATan, eSinh, eCosh, eTanh,
+        eExp, eLog, eLog10, eSqrt, eAbs, eFloor, eCeil, eSign,
+        eATan2, eMin, eMax,
+        eGaus
+    };
+
+    struct Instruction
+    {
+        EOperation fOperation;
+        double fValue;
+        size_t fIndex;
+    };
+
+private:
+    std::string fFormula;
+    size_t fNVariables;
+    std::vector<Instruction> fProgram;
+    size_t fStackSize;
+};
+
+}
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ * @file KMathTabulatedDistribution.cxx
+ *
+ * @date 19.10.2026
+ */
+
+#include "KMathTabulatedDistribution.h"
+#include "KException.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace katrin
+{
+
+KMathTabulatedDistribution::KMathTabulatedDistribution() :
+    fX(),
+    fDensity(),
+    fCumulative(),
+    fIntegral(0.),
+    fLinear(true)
+{ }
+
+KMathTabulatedDistribution::~KMathTabulatedDistribution()
+{ }
+
+void KMathTabulatedDistribution::SetHistogram(const vector<double>& edges, const vector<double>& contents)
+{
+    if (contents.empty() || edges.size() != contents.size() + 1)
+        throw KException() << "KMathTabulatedDistribution: need one more bin edge than bin contents.";
+
+    // contents are counts per bin, the table stores densities
+    vector<double> density(contents.size());
+    for (size_t i = 0; i < contents.size(); i++) {
+        const double width = edges[i + 1] - edges[i];
+        if (!(width > 0.))
+            throw KException() << "KMathTabulatedDistribution: bin edges must be increasing.";
+        density[i] = contents[i] / width;
+    }
+
+    SetPoints(edges, density, false);
+}
+
+void KMathTabulatedDistribution::Clear()
+{
+    fX.clear();
+    fDensity.clear();
+    fCumulative.clear();
+    fIntegral = 0.;
+}
+
+void KMathTabulatedDistribution::SetPoints(const vector<double>& x, const vector<double>& density, bool linear)
+{
+    Clear();
+
+    for (size_t i = 0; i < density.size(); i++) {
+        if (!(density[i] >= 0.))
+            throw KException() << "KMathTabulatedDistribution: density is negative or not a number at x = " << x[i] << ".";
+    }
+
+    fLinear = linear;
+    fX = x;
+    fDensity = density;
+
+    const size_t nBins = fX.size() - 1;
+    fCumulative.resize(nBins + 1);
+    fCumulative[0] = 0.;
+    for (size_t i = 0; i < nBins; i++) {
+        const double width = fX[i + 1] - fX[i];
+        const double area = fLinear ? 0.5 * (fDensity[i] + fDensity[i + 1]) * width : fDensity[i] * width;
+        fCumulative[i + 1] = fCumulative[i] + area;
+    }
+
+    fIntegral = fCumulative.back();
+    if (!(fIntegral > 0.)) {
+        Clear();
+        throw KException() << "KMathTabulatedDistribution: integral of the density is not positive.";
+    }
+
+    for (size_t i = 0; i <= nBins; i++)
+        fCumulative[i] /= fIntegral;
+    fCumulative.back() = 1.;
+}
+
+double KMathTabulatedDistribution::Sample(double uniform) const
+{
+    if (fCumulative.empty())
+        return 0.;
+
+    // bin with fCumulative[i] <= uniform < fCumulative[i+1], empty bins are skipped by upper_bound
+    const size_t nBins = fX.size() - 1;
+    size_t bin = upper_bound(fCumulative.begin(), fCumulative.end(), uniform) - fCumulative.begin();
+    bin = (bin == 0) ? 0 : min(bin - 1, nBins - 1);
+
+    const double width = fX[bin + 1] - fX[bin];
+    const double area = (fCumulative[bin + 1] - fCumulative[bin]) * fIntegral;
+    if (!(area > 0.))
+        return fX[bin];
+
+    const double remainder = max(0., uniform - fCumulative[bin]) * fIntegral;
+
+    double t;
+    if (!fLinear) {
+        t = remainder / fDensity[bin];
+    }
+    else {
+        // solve a*t + (b-a)*t^2/(2*width) = remainder for t, in the form that is stable for b ~ a
+        const double a = fDensity[bin];
+        const double slope = (fDensity[bin + 1] - a) / width;
+        t = 2. * remainder / (a + sqrt(max(0., a * a + 2. * slope * remainder)));
+    }
+
+    return fX[bin] + min(max(t, 0.), width);
+}
+
+}
@@ -0,0 +1,76 @@
+/**
+ * @file KMathTabulatedDistribution.h
+ *
+ * @date 19.10.2026
+ */
+
+#ifndef KMATHTABULATEDDISTRIBUTION_H_
+#define KMATHTABULATEDDISTRIBUTION_H_
+
+#include <vector>
+#include <cstddef>
+
+namespace katrin
+{
+
+/**
+    @brief Random sampling from a tabulated one dimensional density by inversion of its CDF.
+
+    The table is filled once, either from a density function evaluated on an equidistant grid,
+    which is interpolated linearly between the grid points, or from histogram bins with a constant
+    density inside each bin. A sample costs one binary search over the cumulative table and the
+    inversion inside one bin. Sampling does not modify the table, so it can be done from several
+    threads with their own uniform random numbers.
+*/
+class KMathTabulatedDistribution
+{
+public:
+    KMathTabulatedDistribution();
+    virtual ~KMathTabulatedDistribution();
+
+    /// tabulates density(x) at nPoints equidistant points in [xMin, xMax]
+    template<class XCallableT>
+    void SetFunction(const XCallableT& density, double xMin, double xMax, size_t nPoints = 1000);
+
+    /// uses bin contents with nBins + 1 bin edges
+    void SetHistogram(const std::vector<double>& edges, const std::vector<double>& contents);
+
+    void Clear();
+    bool IsEmpty() const { return fCumulative.empty(); }
+
+    double GetMin() const { return fX.empty() ? 0. : fX.front(); }
+    double GetMax() const { return fX.empty() ? 0. : fX.back(); }
+    double GetIntegral() const { return fIntegral; }
+
+    /// maps a uniform number in [0,1) onto the distribution
+    double Sample(double uniform) const;
+
+private:
+    void SetPoints(const std::vector<double>& x, const std::vector<double>& density, bool linear);
+
+    std::vector<double> fX;
+    std::vector<double> fDensity;
+    std::vector<double> fCumulative;
+    double fIntegral;
+    bool fLinear;
+};
+
+template<class XCallableT>
+inline void KMathTabulatedDistribution::SetFunction(const XCallableT& density, double xMin, double xMax, size_t nPoints)
+{
+    if (nPoints < 2)
+        nPoints = 2;
+
+    std::vector<double> x(nPoints);
+    std::vector<double> values(nPoints);
+    for (size_t i = 0; i < nPoints; i++) {
+        x[i] = xMin + (xMax - xMin) * (double) i / (double) (nPoints - 1);
+        values[i] = density(x[i]);
+    }
+
+    SetPoints(x, values, true);
+}
+
+}
+
+#endif
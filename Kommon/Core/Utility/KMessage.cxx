@@ -37,6 +37,8 @@ namespace katrin
             fDefaultDescription( "UNKNOWN" ),
 
             fSeverity( eNormal ),
+            fActive( true ),
+            fMaxVerbosity( eNormal ),
 
             fColorPrefix( &KMessage::fNormalColorPrefix ),
             fDescription( &KMessage::fNormalDescription ),
@@ -52,6 +54,7 @@ namespace katrin
     {
         fMessageLine.setf( KMessageTable::GetInstance().GetFormat(), std::ios::floatfield );
         fMessageLine.precision( KMessageTable::GetInstance().GetPrecision() );
+        UpdateVerbosity();
         KMessageTable::GetInstance().Add( this );
     }
     KMessage::~KMessage()
@@ -72,6 +75,7 @@ namespace katrin
     void KMessage::SetSeverity( const KMessageSeverity& aSeverity )
     {
         fSeverity = aSeverity;
+        fActive = IsActive( fSeverity );
 
         switch( fSeverity )
         {
@@ -108,6 +112,21 @@ namespace katrin
 
         return;
     }
+    void KMessage::UpdateVerbosity()
+    {
+        //a message without a stream to go to is never shown, whatever the verbosity
+        fMaxVerbosity = eError - 1;
+        if( (fTerminalStream != NULL) && (fTerminalVerbosity > fMaxVerbosity) )
+        {
+            fMaxVerbosity = fTerminalVerbosity;
+        }
+        if( (fLogStream != NULL) && (fLogVerbosity > fMaxVerbosity) )
+        {
+            fMaxVerbosity = fLogVerbosity;
+        }
+        fActive = IsActive( fSeverity );
+        return;
+    }
     void KMessage::Flush()
     {
         if( (fSeverity <= fTerminalVerbosity) && (fTerminalStream != NULL) && (fTerminalStream->good() == true) )
@@ -189,21 +208,25 @@ namespace katrin
     void KMessage::SetTerminalVerbosity( const KMessageSeverity& aVerbosity )
     {
         fTerminalVerbosity = aVerbosity;
+        UpdateVerbosity();
         return;
     }
     void KMessage::SetTerminalStream( ostream* aTerminalStream )
     {
         fTerminalStream = aTerminalStream;
+        UpdateVerbosity();
         return;
     }
     void KMessage::SetLogVerbosity( const KMessageSeverity& aVerbosity )
     {
         fLogVerbosity = aVerbosity;
+        UpdateVerbosity();
         return;
     }
     void KMessage::SetLogStream( ostream* aLogStream )
     {
         fLogStream = aLogStream;
+        UpdateVerbosity();
         return;
     }
 
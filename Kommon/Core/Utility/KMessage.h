@@ -77,6 +77,12 @@ namespace katrin
         public:
             KMessage& operator()( const KMessageSeverity& );
 
+            /**
+             * Tells whether a message of the given severity reaches the terminal or the log,
+             * can be used to skip expensive preparation of message content.
+             */
+            bool IsActive( const KMessageSeverity& aSeverity ) const;
+
             template< class XPrintable >
             KMessage& operator<<( const XPrintable& aFragment );
             KMessage& operator<<( const KMessageNewline& );
@@ -86,6 +92,7 @@ namespace katrin
 
         private:
             void SetSeverity( const KMessageSeverity& aSeverity );
+            void UpdateVerbosity();
             void Flush();
             void Shutdown();
 
@@ -117,6 +124,11 @@ namespace katrin
         private:
             KMessageSeverity fSeverity;
 
+            //false while the current message is shown nowhere, all fragments are dropped unformatted then
+            bool fActive;
+            //highest severity shown by the terminal or the log
+            KMessageSeverity fMaxVerbosity;
+
             std::string KMessage::*fColorPrefix;
             std::string KMessage::*fDescription;
             std::string KMessage::*fColorSuffix;
@@ -158,20 +170,39 @@ namespace katrin
         return TypeName;
     }
 
+    inline bool KMessage::IsActive( const KMessageSeverity& aSeverity ) const
+    {
+        //errors are always processed, since they shut down the program
+        return (aSeverity <= fMaxVerbosity) || (aSeverity == eError);
+    }
+
     inline KMessage& KMessage::operator()( const KMessageSeverity& aSeverity )
     {
+        if( IsActive( aSeverity ) == false )
+        {
+            fSeverity = aSeverity;
+            fActive = false;
+            return *this;
+        }
         SetSeverity( aSeverity );
         return *this;
     }
 
     template< class XPrintable >
-    KMessage& KMessage::operator<<( const XPrintable& aFragment )
+    inline KMessage& KMessage::operator<<( const XPrintable& aFragment )
     {
-        fMessageLine << aFragment;
+        if( fActive == true )
+        {
+            fMessageLine << aFragment;
+        }
         return *this;
     }
     inline KMessage& KMessage::operator<<( const KMessageNewline& )
     {
+        if( fActive == false )
+        {
+            return *this;
+        }
         fMessageLines.push_back( std::pair< std::string, char >( fMessageLine.str(), '\n' ) );
         fMessageLine.clear();
         fMessageLine.str( "" );
@@ -179,6 +210,10 @@ namespace katrin
     }
     inline KMessage& KMessage::operator<<( const KMessageOverline& )
     {
+        if( fActive == false )
+        {
+            return *this;
+        }
         fMessageLines.push_back( std::pair< std::string, char >( fMessageLine.str(), '\r' ) );
         fMessageLine.clear();
         fMessageLine.str( "" );
@@ -186,6 +221,10 @@ namespace katrin
     }
     inline KMessage& KMessage::operator<<( const KMessageNewlineEnd& )
     {
+        if( fActive == false )
+        {
+            return *this;
+        }
         fMessageLines.push_back( std::pair< std::string, char >( fMessageLine.str(), '\n' ) );
         fMessageLine.clear();
         fMessageLine.str( "" );
@@ -194,6 +233,10 @@ namespace katrin
     }
     inline KMessage& KMessage::operator<<( const KMessageOverlineEnd& )
     {
+        if( fActive == false )
+        {
+            return *this;
+        }
         fMessageLines.push_back( std::pair< std::string, char >( fMessageLine.str(), '\r' ) );
         fMessageLine.clear();
         fMessageLine.str( "" );
@@ -0,0 +1,114 @@
+#include "KMathExpression.h"
+#include "KException.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace katrin;
+
+namespace
+{
+
+unsigned int sFailures = 0;
+
+void CheckValue(const string& formula, double x, double expected)
+{
+    try {
+        KMathExpression expression(formula);
+        double value = expression.Evaluate(x);
+        if (fabs(value - expected) > 1.e-12 * (1. + fabs(expected))) {
+            cout << "<" << formula << "> at x = " << x << " gave " << value << " instead of " << expected << endl;
+            sFailures++;
+        }
+    }
+    catch (KException& exception) {
+        cout << "<" << formula << "> did not compile: " << exception.what() << endl;
+        sFailures++;
+    }
+}
+
+void CheckError(const string& formula, const string& construct)
+{
+    try {
+        KMathExpression expression(formula);
+        cout << "<" << formula << "> compiled, but should have failed" << endl;
+        sFailures++;
+    }
+    catch (KException& exception) {
+        if (string(exception.what()).find(construct) == string::npos) {
+            cout << "error for <" << formula << "> does not mention <" << construct << ">: " << exception.what() << endl;
+            sFailures++;
+        }
+    }
+}
+
+}
+
+//checks operator precedence and associativity, the supported TMath constants and the error messages
+int main()
+{
+    // precedence
+    CheckValue("1+2*3", 0., 7.);
+    CheckValue("(1+2)*3", 0., 9.);
+    CheckValue("2*3^2", 0., 18.);
+    CheckValue("-2^2", 0., -4.);
+    CheckValue("2^-1", 0., .5);
+    CheckValue("1-2-3", 0., -4.);
+    CheckValue("8/4/2", 0., 1.);
+    CheckValue("7%4*2", 0., 6.);
+    CheckValue("1+1==2", 0., 1.);
+    CheckValue("1<2 && 3<2 || 1", 0., 1.);
+    CheckValue("!0+1", 0., 2.);
+    CheckValue("2*x+1", 3., 7.);
+
+    // powers are right associative
+    CheckValue("2^3^2", 0., 512.);
+    CheckValue("2**3**2", 0., 512.);
+    CheckValue("x^2^-1", 4., 2.);
+
+    // conditional
+    CheckValue("x>0 ? 1 : -1", 2., 1.);
+    CheckValue("x>0 ? 1 : -1", -2., -1.);
+    CheckValue("x<0 ? -1 : x==0 ? 0 : 1", 0., 0.);
+    CheckValue("x<0 ? -1 : x==0 ? 0 : 1", 5., 1.);
+    CheckValue("1 + (x>1 ? x : 1)*2", 3., 7.);
+    CheckValue("max(x>1 ? x : 1, 2)", 3., 3.);
+
+    // functions and constants
+    CheckValue("TMath::Pi()", 0., M_PI);
+    CheckValue("TMath::TwoPi()*x", 1., 2. * M_PI);
+    CheckValue("TMath::E()", 0., M_E);
+    CheckValue("TMath::C()", 0., 299792458.);
+    CheckValue("TMath::Sqrt(TMath::Abs(x))", -4., 2.);
+    CheckValue("TMath::Power(x,3)", 2., 8.);
+    CheckValue("pi*e", 0., M_PI * M_E);
+    CheckValue("gaus(x,1,2)", 1., 1.);
+    CheckValue("[0]*2", 3., 6.);
+
+    // errors name the unsupported construct
+    CheckError("", "empty expression");
+    CheckError("1+", "unexpected end of expression");
+    CheckError("(1+2", "expected ')'");
+    CheckError("foo", "unknown name <foo>");
+    CheckError("TMath::Landau(x)", "unsupported function <TMath::Landau>");
+    CheckError("TMath::Pi(2)", "constant <TMath::Pi> takes no arguments");
+    CheckError("sin(1,2)", "wrong number of arguments for <sin>");
+    CheckError("[1]", "parameter index out of range");
+    CheckError("x>0 ? 1", "expected ':'");
+    CheckError("x = 1", "unsupported operator '='");
+    CheckError("x & 1", "unsupported operator '&'");
+    CheckError("x; 1", "unsupported statement syntax ';'");
+    CheckError("x[0]", "unsupported array access");
+    CheckError("1 $ 2", "unexpected character '$'");
+
+    if (sFailures != 0) {
+        cout << "TestMathExpression failed with " << sFailures << " errors" << endl;
+        return EXIT_FAILURE;
+    }
+    cout << "TestMathExpression passed" << endl;
+    return EXIT_SUCCESS;
+}
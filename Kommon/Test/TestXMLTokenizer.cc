@@ -0,0 +1,236 @@
+#include "KXMLTokenizer.hh"
+#include "KTextFile.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace katrin;
+
+namespace
+{
+
+//writes one line per token with its type, line, column and value
+class KTokenRecorder :
+    public KProcessor
+{
+    public:
+        vector< string > fRecords;
+
+        virtual void ProcessToken( KBeginParsingToken* aToken ) { Record( "begin_parsing", aToken ); }
+        virtual void ProcessToken( KBeginFileToken* aToken ) { Record( "begin_file", aToken ); }
+        virtual void ProcessToken( KBeginElementToken* aToken ) { Record( "begin_element", aToken ); }
+        virtual void ProcessToken( KBeginAttributeToken* aToken ) { Record( "begin_attribute", aToken ); }
+        virtual void ProcessToken( KAttributeDataToken* aToken ) { Record( "attribute_data", aToken ); }
+        virtual void ProcessToken( KEndAttributeToken* aToken ) { Record( "end_attribute", aToken ); }
+        virtual void ProcessToken( KMidElementToken* aToken ) { Record( "mid_element", aToken ); }
+        virtual void ProcessToken( KElementDataToken* aToken ) { Record( "element_data", aToken ); }
+        virtual void ProcessToken( KEndElementToken* aToken ) { Record( "end_element", aToken ); }
+        virtual void ProcessToken( KEndFileToken* aToken ) { Record( "end_file", aToken ); }
+        virtual void ProcessToken( KEndParsingToken* aToken ) { Record( "end_parsing", aToken ); }
+        virtual void ProcessToken( KCommentToken* aToken ) { Record( "comment", aToken ); }
+        virtual void ProcessToken( KErrorToken* aToken ) { Record( "error", aToken ); }
+
+    private:
+        void Record( const char* aType, KToken* aToken )
+        {
+            ostringstream tRecord;
+            tRecord << aType << " " << aToken->GetLine() << " " << aToken->GetColumn() << " <" << aToken->GetValue() << ">";
+            fRecords.push_back( tRecord.str() );
+        }
+};
+
+unsigned int Compare( const string& aName, const string& aContent, const char* const* anExpected )
+{
+    {
+        ofstream tStream( aName.c_str(), ios::binary );
+        tStream << aContent;
+    }
+
+    KXMLTokenizer tTokenizer;
+    KTokenRecorder tRecorder;
+    KProcessor::Connect( &tTokenizer, &tRecorder );
+
+    KTextFile tFile;
+    tFile.AddToNames( aName );
+    tTokenizer.ProcessFile( &tFile );
+
+    KProcessor::Disconnect( &tTokenizer, &tRecorder );
+
+    unsigned int tFailures = 0;
+    unsigned int tIndex = 0;
+    for( ; anExpected[ tIndex ] != NULL; tIndex++ )
+    {
+        if( tIndex >= tRecorder.fRecords.size() )
+        {
+            cout << aName << ": missing token <" << anExpected[ tIndex ] << ">" << endl;
+            tFailures++;
+            continue;
+        }
+        if( tRecorder.fRecords[ tIndex ] != anExpected[ tIndex ] )
+        {
+            cout << aName << ": token " << tIndex << " is <" << tRecorder.fRecords[ tIndex ] << ">, expected <" << anExpected[ tIndex ] << ">" << endl;
+            tFailures++;
+        }
+    }
+    for( ; tIndex < tRecorder.fRecords.size(); tIndex++ )
+    {
+        cout << aName << ": unexpected token <" << tRecorder.fRecords[ tIndex ] << ">" << endl;
+        tFailures++;
+    }
+    return tFailures;
+}
+
+const char* const sPlainContent =
+    "<!-- leading comment with <angles> and \"quotes\" -->\n"
+    "<define name=\"radius\" value=\"2.5\"/>\n"
+    "<geometry>\n"
+    "\t<tube_surface name=\"tube\" z1=\"-1.\" z2=\"{[radius]*2}\" r=\"[radius]\" longitudinal_mesh_count=\"10\">\n"
+    "\t\t<!-- nested <!-- comment --> inside -->\n"
+    "\t\t<note>  some element data\n"
+    "spanning lines  </note>\n"
+    "\t</tube_surface>\n"
+    "\t<empty/>\n"
+    "\t<spaced   a=\"1\"   b=\"x y z\"  />\n"
+    "</geometry>\n"
+    "<if condition=\"{[radius] gt 1}\"><print name=\"p\" value=\"big\"/></if>\n";
+
+const char* const sWindowsContent =
+    "<windows a=\"1\">\r\n"
+    "\t<b c=\"2\"/>\r\n"
+    "</windows>\r\n";
+
+const char* const sErrorContent =
+    "<broken a = \"1\"/>\n";
+
+//the stream of the character by character tokenizer for the contents above
+const char* const sPlainTokens[] =
+{
+    "begin_parsing 0 0 <>",
+    "begin_file 0 0 <./TestXMLTokenizerPlain.xml>",
+    "comment 1 1 < leading comment with <angles> and \"quotes\" >",
+    "element_data 0 0 < >",
+    "begin_element 2 1 <define>",
+    "begin_attribute 2 9 <name>",
+    "attribute_data 2 13 <radius>",
+    "end_attribute 2 9 <name>",
+    "begin_attribute 2 23 <value>",
+    "attribute_data 2 28 <2.5>",
+    "end_attribute 2 23 <value>",
+    "mid_element 2 34 <define>",
+    "end_element 2 34 <define>",
+    "element_data 0 0 < >",
+    "begin_element 3 1 <geometry>",
+    "mid_element 3 10 <geometry>",
+    "begin_element 4 2 <tube_surface>",
+    "begin_attribute 4 16 <name>",
+    "attribute_data 4 20 <tube>",
+    "end_attribute 4 16 <name>",
+    "begin_attribute 4 28 <z1>",
+    "attribute_data 4 30 <-1.>",
+    "end_attribute 4 28 <z1>",
+    "begin_attribute 4 37 <z2>",
+    "attribute_data 4 39 <{[radius]*2}>",
+    "end_attribute 4 37 <z2>",
+    "begin_attribute 4 55 <r>",
+    "attribute_data 4 56 <[radius]>",
+    "end_attribute 4 55 <r>",
+    "begin_attribute 4 68 <longitudinal_mesh_count>",
+    "attribute_data 4 91 <10>",
+    "end_attribute 4 68 <longitudinal_mesh_count>",
+    "mid_element 4 96 <tube_surface>",
+    "comment 5 3 < nested <!-- comment --> inside >",
+    "begin_element 6 3 <note>",
+    "mid_element 6 8 <note>",
+    "element_data 0 0 <some element data spanning lines>",
+    "end_element 7 17 <note>",
+    "end_element 8 2 <tube_surface>",
+    "begin_element 9 2 <empty>",
+    "mid_element 9 8 <empty>",
+    "end_element 9 8 <empty>",
+    "begin_element 10 2 <spaced>",
+    "begin_attribute 10 12 <a>",
+    "attribute_data 10 13 <1>",
+    "end_attribute 10 12 <a>",
+    "begin_attribute 10 20 <b>",
+    "attribute_data 10 21 <x y z>",
+    "end_attribute 10 20 <b>",
+    "mid_element 10 31 <spaced>",
+    "end_element 10 31 <spaced>",
+    "element_data 0 0 < >",
+    "end_element 11 1 <geometry>",
+    "element_data 0 0 < >",
+    "begin_element 12 1 <if>",
+    "begin_attribute 12 5 <condition>",
+    "attribute_data 12 14 <{[radius] gt 1}>",
+    "end_attribute 12 5 <condition>",
+    "mid_element 12 32 <if>",
+    "begin_element 12 33 <print>",
+    "begin_attribute 12 40 <name>",
+    "attribute_data 12 44 <p>",
+    "end_attribute 12 40 <name>",
+    "begin_attribute 12 49 <value>",
+    "attribute_data 12 54 <big>",
+    "end_attribute 12 49 <value>",
+    "mid_element 12 60 <print>",
+    "end_element 12 60 <print>",
+    "end_element 12 62 <if>",
+    "element_data 0 0 < >",
+    "end_file 0 0 <./TestXMLTokenizerPlain.xml>",
+    "end_parsing 0 0 <>",
+    NULL
+};
+
+const char* const sWindowsTokens[] =
+{
+    "begin_parsing 0 0 <>",
+    "begin_file 0 0 <./TestXMLTokenizerWindows.xml>",
+    "begin_element 1 1 <windows>",
+    "begin_attribute 1 10 <a>",
+    "attribute_data 1 11 <1>",
+    "end_attribute 1 10 <a>",
+    "mid_element 1 15 <windows>",
+    "begin_element 2 2 <b>",
+    "begin_attribute 2 5 <c>",
+    "attribute_data 2 6 <2>",
+    "end_attribute 2 5 <c>",
+    "mid_element 2 10 <b>",
+    "end_element 2 10 <b>",
+    "end_element 3 1 <windows>",
+    "end_file 0 0 <./TestXMLTokenizerWindows.xml>",
+    "end_parsing 0 0 <>",
+    NULL
+};
+
+const char* const sErrorTokens[] =
+{
+    "begin_parsing 0 0 <>",
+    "begin_file 0 0 <./TestXMLTokenizerError.xml>",
+    "begin_element 1 1 <broken>",
+    "error 1 10 <got unknown character < >>",
+    "end_parsing 0 0 <>",
+    NULL
+};
+
+}
+
+//checks that the tokenizer reports the same token stream, lines and columns as the character by character tokenizer it replaced
+int main()
+{
+    unsigned int tFailures = 0;
+    tFailures += Compare( "TestXMLTokenizerPlain.xml", sPlainContent, sPlainTokens );
+    tFailures += Compare( "TestXMLTokenizerWindows.xml", sWindowsContent, sWindowsTokens );
+    tFailures += Compare( "TestXMLTokenizerError.xml", sErrorContent, sErrorTokens );
+
+    if( tFailures != 0 )
+    {
+        cout << "TestXMLTokenizer failed with " << tFailures << " errors" << endl;
+        return EXIT_FAILURE;
+    }
+    cout << "TestXMLTokenizer passed" << endl;
+    return EXIT_SUCCESS;
+}